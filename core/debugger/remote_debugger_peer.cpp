@@ -104,10 +104,13 @@ void RemoteDebuggerPeerTCP::_write_out() {
 			out_queue.pop_front();
 			mutex.unlock();
 			int size = 0;
-			Error err = encode_variant(var, nullptr, size);
-			ERR_CONTINUE(err != OK || size > out_buf.size() - 4); // 4 bytes separator.
+			Error err = encode_variant(var, out_buf, 4, size); // 4 bytes separator.
+			if (unlikely(out_buf.size() > get_max_message_size())) {
+				out_buf.resize(get_max_message_size()); // Shrink back after an oversized message.
+			}
+			ERR_CONTINUE(err != OK || size > out_buf.size() - 4);
+			buf = out_buf.ptrw();
 			encode_uint32(size, buf);
-			encode_variant(var, buf + 4, size);
 			out_left = size + 4;
 			out_pos = 0;
 		}
@@ -861,15 +861,11 @@ static GDExtensionInt gdextension_string_to_latin1_chars(GDExtensionConstStringP
 }
 static GDExtensionInt gdextension_string_to_utf8_chars(GDExtensionConstStringPtr p_self, char *r_text, GDExtensionInt p_max_write_length) {
 	String *self = (String *)p_self;
-	CharString cs = self->utf8();
-	GDExtensionInt len = cs.length();
-	if (r_text) {
-		const char *s_text = cs.ptr();
-		for (GDExtensionInt i = 0; i < MIN(len, p_max_write_length); i++) {
-			r_text[i] = s_text[i];
-		}
+	if (r_text && p_max_write_length > 0) {
+		// Encodes straight into the caller's buffer, without a temporary CharString.
+		self->utf8_to_buffer(r_text, (int)MIN(p_max_write_length, (GDExtensionInt)INT32_MAX));
 	}
-	return len;
+	return self->utf8_byte_length();
 }
 static GDExtensionInt gdextension_string_to_utf16_chars(GDExtensionConstStringPtr p_self, char16_t *r_text, GDExtensionInt p_max_write_length) {
 	String *self = (String *)p_self;
@@ -32,6 +32,8 @@
 
 #include "core/config/project_settings.h"
 #include "core/io/zip_io.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_Hector.h"
 
 #include "thirdparty/misc/fastlz.h"
 
@@ -84,16 +86,9 @@ int Compression::compress(uint8_t *p_dst, const uint8_t *p_src, int p_src_size,
 
 		} break;
 		case MODE_ZSTD: {
-			ZSTD_CCtx *cctx = ZSTD_createCCtx();
-			ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, zstd_level);
-			if (zstd_long_distance_matching) {
-				ZSTD_CCtx_setParameter(cctx, ZSTD_c_enableLongDistanceMatching, 1);
-				ZSTD_CCtx_setParameter(cctx, ZSTD_c_windowLog, zstd_window_log_size);
-			}
-			int max_dst_size = get_max_compressed_buffer_size(p_src_size, MODE_ZSTD);
-			int ret = ZSTD_compressCCtx(cctx, p_dst, max_dst_size, p_src, p_src_size, zstd_level);
-			ZSTD_freeCCtx(cctx);
-			return ret;
+			// Creating a context costs more than compressing a small buffer, keep one per thread.
+			static thread_local ZstdContext context;
+			return context.compress(p_dst, get_max_compressed_buffer_size(p_src_size, MODE_ZSTD), p_src, p_src_size);
 		} break;
 	}
 
@@ -187,13 +182,8 @@ int Compression::decompress(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p
 			return total;
 		} break;
 		case MODE_ZSTD: {
-			ZSTD_DCtx *dctx = ZSTD_createDCtx();
-			if (zstd_long_distance_matching) {
-				ZSTD_DCtx_setParameter(dctx, ZSTD_d_windowLogMax, zstd_window_log_size);
-			}
-			int ret = ZSTD_decompressDCtx(dctx, p_dst, p_dst_max_size, p_src, p_src_size);
-			ZSTD_freeDCtx(dctx);
-			return ret;
+			static thread_local ZstdContext context;
+			return context.decompress(p_dst, p_dst_max_size, p_src, p_src_size);
 		} break;
 	}
 
@@ -349,6 +339,148 @@ int Compression::decompress_dynamic(Hector<uint8_t> *p_dst_vect, int p_max_dst_s
 	}
 }
 
+/**
+	Builds a raw content dictionary out of sample buffers (e.g. typical packets or save blocks).
+	zstd can reference any part of such a dictionary as if it preceded the data, and closer content is cheaper
+	to reference, so identical samples are only stored once and the most frequent ones are placed at the end.
+	Samples which are equally frequent keep their order, so the most recent ones are closest.
+*/
+Hector<uint8_t> Compression::zstd_build_dictionary(const Hector<Hector<uint8_t>> &p_samples, int p_max_size) {
+	ERR_FAIL_COND_V(p_max_size <= 0, Hector<uint8_t>());
+
+	const int sample_count = p_samples.size();
+	LocalHector<int> counts;
+	counts.resize(sample_count);
+	HashMap<uint32_t, int> first_by_hash;
+	for (int i = 0; i < sample_count; i++) {
+		const Hector<uint8_t> &sample = p_samples[i];
+		counts[i] = 0;
+		if (sample.is_empty()) {
+			continue;
+		}
+		uint32_t hash = hash_murmur3_buffer(sample.ptr(), sample.size());
+		HashMap<uint32_t, int>::Iterator E = first_by_hash.find(hash);
+		if (!E) {
+			first_by_hash.insert(hash, i);
+			counts[i] = 1;
+		} else if (p_samples[E->value] == sample) {
+			counts[E->value]++;
+		} else {
+			counts[i] = 1; // Hash collision, keep it as a distinct sample.
+		}
+	}
+
+	// Sort by frequency, then by position, least important first.
+	LocalHector<int64_t> order;
+	for (int i = 0; i < sample_count; i++) {
+		if (counts[i] > 0) {
+			order.push_back(int64_t(counts[i]) * sample_count + i);
+		}
+	}
+	order.sort();
+
+	// Take samples from the most important one until the dictionary is full.
+	int total = 0;
+	uint32_t first = order.size();
+	while (first > 0 && total < p_max_size) {
+		first--;
+		total += p_samples[order[first] % sample_count].size();
+	}
+
+	Hector<uint8_t> dictionary;
+	dictionary.resize(MIN(total, p_max_size));
+	uint8_t *w = dictionary.ptrw();
+	int skip = total - dictionary.size(); // Only the tail of the least important sample may fit.
+	int pos = 0;
+	for (uint32_t i = first; i < order.size(); i++) {
+		const Hector<uint8_t> &sample = p_samples[order[i] % sample_count];
+		int size = sample.size() - skip;
+		memcpy(w + pos, sample.ptr() + skip, size);
+		pos += size;
+		skip = 0;
+	}
+	return dictionary;
+}
+
+void Compression::ZstdContext::_clear_dictionary() {
+	if (cctx) {
+		ZSTD_CCtx_refCDict(cctx, nullptr);
+	}
+	if (dctx) {
+		ZSTD_DCtx_refDDict(dctx, nullptr);
+	}
+	if (cdict) {
+		ZSTD_freeCDict(cdict);
+		cdict = nullptr;
+	}
+	if (ddict) {
+		ZSTD_freeDDict(ddict);
+		ddict = nullptr;
+	}
+	dictionary.clear();
+}
+
+Error Compression::ZstdContext::set_dictionary(const Hector<uint8_t> &p_dictionary) {
+	_clear_dictionary();
+	if (p_dictionary.is_empty()) {
+		return OK;
+	}
+	dictionary = p_dictionary;
+	cdict = ZSTD_createCDict(dictionary.ptr(), dictionary.size(), zstd_level);
+	ddict = ZSTD_createDDict(dictionary.ptr(), dictionary.size());
+	if (!cdict || !ddict) {
+		_clear_dictionary();
+		ERR_FAIL_V_MSG(ERR_INVALID_DATA, "Unable to create zstd dictionary.");
+	}
+	return OK;
+}
+
+int Compression::ZstdContext::compress(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p_src, int p_src_size) {
+	if (!cctx) {
+		cctx = ZSTD_createCCtx();
+		ERR_FAIL_NULL_V(cctx, -1);
+	}
+	ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, zstd_level);
+	ZSTD_CCtx_setParameter(cctx, ZSTD_c_enableLongDistanceMatching, zstd_long_distance_matching ? 1 : 0);
+	ZSTD_CCtx_setParameter(cctx, ZSTD_c_windowLog, zstd_long_distance_matching ? zstd_window_log_size : 0);
+	ZSTD_CCtx_setParameter(cctx, ZSTD_c_checksumFlag, checksum ? 1 : 0);
+	// Referencing is cheap, and it also restores the dictionary after a failed call reset the context.
+	ZSTD_CCtx_refCDict(cctx, cdict);
+
+	size_t ret = ZSTD_compress2(cctx, p_dst, p_dst_max_size, p_src, p_src_size);
+	if (ZSTD_isError(ret)) {
+		ZSTD_CCtx_reset(cctx, ZSTD_reset_session_only);
+		return -1;
+	}
+	return ret;
+}
+
+int Compression::ZstdContext::decompress(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p_src, int p_src_size) {
+	if (!dctx) {
+		dctx = ZSTD_createDCtx();
+		ERR_FAIL_NULL_V(dctx, -1);
+	}
+	ZSTD_DCtx_setParameter(dctx, ZSTD_d_windowLogMax, zstd_long_distance_matching ? zstd_window_log_size : 0);
+	ZSTD_DCtx_refDDict(dctx, ddict);
+
+	size_t ret = ZSTD_decompressDCtx(dctx, p_dst, p_dst_max_size, p_src, p_src_size);
+	if (ZSTD_isError(ret)) {
+		ZSTD_DCtx_reset(dctx, ZSTD_reset_session_only);
+		return -1;
+	}
+	return ret;
+}
+
+Compression::ZstdContext::~ZstdContext() {
+	_clear_dictionary();
+	if (cctx) {
+		ZSTD_freeCCtx(cctx);
+	}
+	if (dctx) {
+		ZSTD_freeDCtx(dctx);
+	}
+}
+
 int Compression::zlib_level = Z_DEFAULT_COMPRESSION;
 int Compression::gzip_level = Z_DEFAULT_COMPRESSION;
 int Compression::zstd_level = 3;
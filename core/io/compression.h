@@ -34,6 +34,11 @@
 #include "core/templates/Hector.h"
 #include "core/typedefs.h"
 
+struct ZSTD_CCtx_s;
+struct ZSTD_DCtx_s;
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
 class Compression {
 public:
 	static int zlib_level;
@@ -55,6 +60,37 @@ public:
 	static int get_max_compressed_buffer_size(int p_src_size, Mode p_mode = MODE_ZSTD);
 	static int decompress(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p_src, int p_src_size, Mode p_mode = MODE_ZSTD);
 	static int decompress_dynamic(Hector<uint8_t> *p_dst_vect, int p_max_dst_size, const uint8_t *p_src, int p_src_size, Mode p_mode);
+
+	static Hector<uint8_t> zstd_build_dictionary(const Hector<Hector<uint8_t>> &p_samples, int p_max_size = 16384);
+
+	// Keeps the zstd contexts (and optional dictionary) alive between calls,
+	// for callers that compress many small buffers such as packets or file blocks.
+	class ZstdContext {
+		ZSTD_CCtx_s *cctx = nullptr;
+		ZSTD_DCtx_s *dctx = nullptr;
+		ZSTD_CDict_s *cdict = nullptr;
+		ZSTD_DDict_s *ddict = nullptr;
+		Hector<uint8_t> dictionary;
+		bool checksum = false;
+
+		void _clear_dictionary();
+
+	public:
+		Error set_dictionary(const Hector<uint8_t> &p_dictionary);
+		const Hector<uint8_t> &get_dictionary() const { return dictionary; }
+		bool has_dictionary() const { return cdict != nullptr; }
+
+		void set_checksum_enabled(bool p_enabled) { checksum = p_enabled; }
+		bool is_checksum_enabled() const { return checksum; }
+
+		int compress(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p_src, int p_src_size);
+		int decompress(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p_src, int p_src_size);
+
+		ZstdContext() {}
+		ZstdContext(const ZstdContext &) = delete;
+		ZstdContext &operator=(const ZstdContext &) = delete;
+		~ZstdContext();
+	};
 };
 
 #endif // COMPRESSION_H
@@ -40,6 +40,29 @@ void FileAccessCompressed::configure(const String &p_magic, Compression::Mode p_
 	block_size = p_block_size;
 }
 
+Error FileAccessCompressed::set_dictionary(const Hector<uint8_t> &p_dictionary) {
+	ERR_FAIL_COND_V_MSG(f.is_valid(), ERR_ALREADY_IN_USE, "The dictionary must be set before the file is opened.");
+	// The file format doesn't record the dictionary, the checksum detects files read with a different one.
+	zstd.set_checksum_enabled(!p_dictionary.is_empty());
+	return zstd.set_dictionary(p_dictionary);
+}
+
+int FileAccessCompressed::_compress_block(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p_src, int p_src_size) {
+	if (cmode == Compression::MODE_ZSTD) {
+		return zstd.compress(p_dst, p_dst_max_size, p_src, p_src_size);
+	}
+	ERR_FAIL_COND_V_MSG(zstd.has_dictionary(), -1, "Compression dictionaries are only supported with zstd.");
+	return Compression::compress(p_dst, p_src, p_src_size, cmode);
+}
+
+int FileAccessCompressed::_decompress_block(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p_src, int p_src_size) const {
+	if (cmode == Compression::MODE_ZSTD) {
+		return zstd.decompress(p_dst, p_dst_max_size, p_src, p_src_size);
+	}
+	ERR_FAIL_COND_V_MSG(zstd.has_dictionary(), -1, "Compression dictionaries are only supported with zstd.");
+	return Compression::decompress(p_dst, p_dst_max_size, p_src, p_src_size, cmode);
+}
+
 #define WRITE_FIT(m_bytes)                                  \
 	{                                                       \
 		if (write_pos + (m_bytes) > write_max) {            \
@@ -82,7 +105,7 @@ Error FileAccessCompressed::open_after_magic(Ref<FileAccess> p_base) {
 	read_block_count = bc;
 	read_block_size = read_blocks.size() == 1 ? read_total : block_size;
 
-	int ret = Compression::decompress(buffer.ptrw(), read_block_size, comp_buffer.ptr(), read_blocks[0].csize, cmode);
+	int ret = _decompress_block(buffer.ptrw(), read_block_size, comp_buffer.ptr(), read_blocks[0].csize);
 	read_block = 0;
 	read_pos = 0;
 
@@ -145,13 +168,13 @@ void FileAccessCompressed::_close() {
 		}
 
 		Hector<int> block_sizes;
+		Hector<uint8_t> cblock;
+		cblock.resize(Compression::get_max_compressed_buffer_size(block_size, cmode));
 		for (uint32_t i = 0; i < bc; i++) {
 			uint32_t bl = i == (bc - 1) ? write_max % block_size : block_size;
 			uint8_t *bp = &write_ptr[i * block_size];
 
-			Hector<uint8_t> cblock;
-			cblock.resize(Compression::get_max_compressed_buffer_size(bl, cmode));
-			int s = Compression::compress(cblock.ptrw(), bp, bl, cmode);
+			int s = _compress_block(cblock.ptrw(), cblock.size(), bp, bl);
 
 			f->store_buffer(cblock.ptr(), s);
 			block_sizes.push_back(s);
@@ -214,7 +237,7 @@ void FileAccessCompressed::seek(uint64_t p_position) {
 				read_block = block_idx;
 				f->seek(read_blocks[read_block].offset);
 				f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-				int ret = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
+				int ret = _decompress_block(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize);
 				ERR_FAIL_COND_MSG(ret == -1, "Compressed file is corrupt.");
 				read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
 			}
@@ -279,7 +302,7 @@ uint64_t FileAccessCompressed::get_buffer(uint8_t *p_dst, uint64_t p_length) con
 			if (read_block < read_block_count) {
 				//read another block of compressed data
 				f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-				int ret = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
+				int ret = _decompress_block(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize);
 				ERR_FAIL_COND_V_MSG(ret == -1, -1, "Compressed file is corrupt.");
 				read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
 				read_pos = 0;
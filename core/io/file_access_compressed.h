@@ -63,10 +63,17 @@ class FileAccessCompressed : public FileAccess {
 	mutable Hector<uint8_t> buffer;
 	Ref<FileAccess> f;
 
+	// Reused for every block, holds the dictionary if any.
+	mutable Compression::ZstdContext zstd;
+
+	int _compress_block(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p_src, int p_src_size);
+	int _decompress_block(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p_src, int p_src_size) const;
+
 	void _close();
 
 public:
 	void configure(const String &p_magic, Compression::Mode p_mode = Compression::MODE_ZSTD, uint32_t p_block_size = 4096);
+	Error set_dictionary(const Hector<uint8_t> &p_dictionary);
 
 	Error open_after_magic(Ref<FileAccess> p_base);
 
@@ -109,6 +109,16 @@ static Error _decode_string(const uint8_t *&buf, int &len, int *r_len, String &r
 	return OK;
 }
 
+// Reuses the storage of a packed array being replaced by one of the same type.
+// Copy on write keeps this safe when the previous value is still referenced elsewhere.
+template <typename T>
+static void _take_packed_array(Variant &r_variant, Hector<T> &r_data) {
+	if (r_variant.get_type() == GetTypeInfo<Hector<T>>::VARIANT_TYPE) {
+		r_data = r_variant;
+		r_variant = Variant();
+	}
+}
+
 Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len, bool p_allow_objects, int p_depth) {
 	ERR_FAIL_COND_V_MSG(p_depth > Variant::MAX_RECURSION_DEPTH, ERR_OUT_OF_MEMORY, "Variant is too deep. Bailing.");
 	const uint8_t *buf = p_buffer;
@@ -845,10 +855,14 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				(*r_len) += 4; // Size of count number.
 			}
 
+			// Every element takes at least 4 bytes, so the array can be allocated at once.
+			ERR_FAIL_COND_V(count > len / 4, ERR_INVALID_DATA);
+
 			Array varr;
 			if (builtin_type != Variant::VARIANT_MAX) {
 				varr.set_typed(builtin_type, class_name, script);
 			}
+			varr.resize(count);
 
 			for (int i = 0; i < count; i++) {
 				int used = 0;
@@ -857,7 +871,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				ERR_FAIL_COND_V_MSG(err != OK, err, "Error when trying to decode Variant.");
 				buf += used;
 				len -= used;
-				varr.push_back(v);
+				varr.set(i, v);
 				if (r_len) {
 					(*r_len) += used;
 				}
@@ -876,13 +890,13 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			ERR_FAIL_COND_V(count < 0 || count > len, ERR_INVALID_DATA);
 
 			Hector<uint8_t> data;
+			_take_packed_array(r_variant, data);
 
 			if (count) {
 				data.resize(count);
-				uint8_t *w = data.ptrw();
-				for (int32_t i = 0; i < count; i++) {
-					w[i] = buf[i];
-				}
+				memcpy(data.ptrw(), buf, count);
+			} else {
+				data.clear();
 			}
 
 			r_variant = data;
@@ -904,14 +918,20 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			ERR_FAIL_COND_V(count < 0 || count * 4 > len, ERR_INVALID_DATA);
 
 			Hector<int32_t> data;
+			_take_packed_array(r_variant, data);
 
 			if (count) {
-				//const int*rbuf=(const int*)buf;
 				data.resize(count);
 				int32_t *w = data.ptrw();
+#ifdef BIG_ENDIAN_ENABLED
 				for (int32_t i = 0; i < count; i++) {
 					w[i] = decode_uint32(&buf[i * 4]);
 				}
+#else
+				memcpy(w, buf, count * 4);
+#endif
+			} else {
+				data.clear();
 			}
 			r_variant = Variant(data);
 			if (r_len) {
@@ -928,14 +948,20 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			ERR_FAIL_COND_V(count < 0 || count * 8 > len, ERR_INVALID_DATA);
 
 			Hector<int64_t> data;
+			_take_packed_array(r_variant, data);
 
 			if (count) {
-				//const int*rbuf=(const int*)buf;
 				data.resize(count);
 				int64_t *w = data.ptrw();
+#ifdef BIG_ENDIAN_ENABLED
 				for (int64_t i = 0; i < count; i++) {
 					w[i] = decode_uint64(&buf[i * 8]);
 				}
+#else
+				memcpy(w, buf, count * 8);
+#endif
+			} else {
+				data.clear();
 			}
 			r_variant = Variant(data);
 			if (r_len) {
@@ -952,14 +978,20 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			ERR_FAIL_COND_V(count < 0 || count * 4 > len, ERR_INVALID_DATA);
 
 			Hector<float> data;
+			_take_packed_array(r_variant, data);
 
 			if (count) {
-				//const float*rbuf=(const float*)buf;
 				data.resize(count);
 				float *w = data.ptrw();
+#ifdef BIG_ENDIAN_ENABLED
 				for (int32_t i = 0; i < count; i++) {
 					w[i] = decode_float(&buf[i * 4]);
 				}
+#else
+				memcpy(w, buf, count * 4);
+#endif
+			} else {
+				data.clear();
 			}
 			r_variant = data;
 
@@ -977,13 +1009,20 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			ERR_FAIL_COND_V(count < 0 || count * 8 > len, ERR_INVALID_DATA);
 
 			Hector<double> data;
+			_take_packed_array(r_variant, data);
 
 			if (count) {
 				data.resize(count);
 				double *w = data.ptrw();
+#ifdef BIG_ENDIAN_ENABLED
 				for (int64_t i = 0; i < count; i++) {
 					w[i] = decode_double(&buf[i * 8]);
 				}
+#else
+				memcpy(w, buf, count * 8);
+#endif
+			} else {
+				data.clear();
 			}
 			r_variant = data;
 
@@ -1254,16 +1293,17 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 }
 
 static void _encode_string(const String &p_string, uint8_t *&buf, int &r_len) {
-	CharString utf8 = p_string.utf8();
+	// The buffer was sized by a previous call without one, encode in place.
+	const int utf8_len = p_string.utf8_byte_length();
 
 	if (buf) {
-		encode_uint32(utf8.length(), buf);
+		encode_uint32(utf8_len, buf);
 		buf += 4;
-		memcpy(buf, utf8.get_data(), utf8.length());
-		buf += utf8.length();
+		p_string.utf8_to_buffer((char *)buf, utf8_len);
+		buf += utf8_len;
 	}
 
-	r_len += 4 + utf8.length();
+	r_len += 4 + utf8_len;
 	while (r_len % 4) {
 		r_len++; //pad
 		if (buf) {
@@ -1272,6 +1312,47 @@ static void _encode_string(const String &p_string, uint8_t *&buf, int &r_len) {
 	}
 }
 
+static uint32_t _get_typed_array_header(const Array &p_array, bool p_full_objects) {
+	if (!p_array.is_typed()) {
+		return HEADER_DATA_FIELD_TYPED_ARRAY_NONE;
+	}
+	Ref<Script> script = p_array.get_typed_script();
+	if (script.is_valid()) {
+		return p_full_objects ? HEADER_DATA_FIELD_TYPED_ARRAY_SCRIPT : HEADER_DATA_FIELD_TYPED_ARRAY_CLASS_NAME;
+	} else if (p_array.get_typed_class_name() != StringName()) {
+		return HEADER_DATA_FIELD_TYPED_ARRAY_CLASS_NAME;
+	}
+	// No need to check `p_full_objects` since for `Variant::OBJECT`
+	// `array.get_typed_class_name()` should be non-empty.
+	return HEADER_DATA_FIELD_TYPED_ARRAY_BUILTIN;
+}
+
+static Error _encode_typed_array_info(const Array &p_array, bool p_full_objects, uint8_t *&buf, int &r_len) {
+	if (!p_array.is_typed()) {
+		return OK;
+	}
+	Variant variant = p_array.get_typed_script();
+	Ref<Script> script = variant;
+	if (script.is_valid()) {
+		if (p_full_objects) {
+			String path = script->get_path();
+			ERR_FAIL_COND_V_MSG(path.is_empty() || !path.begins_with("res://"), ERR_UNAVAILABLE, "Failed to encode a path to a custom script for an array type.");
+			_encode_string(path, buf, r_len);
+		} else {
+			_encode_string(EncodedObjectAsID::get_class_static(), buf, r_len);
+		}
+	} else if (p_array.get_typed_class_name() != StringName()) {
+		_encode_string(p_full_objects ? p_array.get_typed_class_name().operator String() : EncodedObjectAsID::get_class_static(), buf, r_len);
+	} else {
+		if (buf) {
+			encode_uint32(p_array.get_typed_builtin(), buf);
+			buf += 4;
+		}
+		r_len += 4;
+	}
+	return OK;
+}
+
 Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects, int p_depth) {
 	ERR_FAIL_COND_V_MSG(p_depth > Variant::MAX_RECURSION_DEPTH, ERR_OUT_OF_MEMORY, "Potential infinite recursion detected. Bailing.");
 	uint8_t *buf = r_buffer;
@@ -1311,19 +1392,7 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			}
 		} break;
 		case Variant::ARRAY: {
-			Array array = p_variant;
-			if (array.is_typed()) {
-				Ref<Script> script = array.get_typed_script();
-				if (script.is_valid()) {
-					header |= p_full_objects ? HEADER_DATA_FIELD_TYPED_ARRAY_SCRIPT : HEADER_DATA_FIELD_TYPED_ARRAY_CLASS_NAME;
-				} else if (array.get_typed_class_name() != StringName()) {
-					header |= HEADER_DATA_FIELD_TYPED_ARRAY_CLASS_NAME;
-				} else {
-					// No need to check `p_full_objects` since for `Variant::OBJECT`
-					// `array.get_typed_class_name()` should be non-empty.
-					header |= HEADER_DATA_FIELD_TYPED_ARRAY_BUILTIN;
-				}
-			}
+			header |= _get_typed_array_header(p_variant, p_full_objects);
 		} break;
 #ifdef REAL_T_IS_DOUBLE
 		case Variant::HECTOR2:
@@ -1754,21 +1823,16 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			}
 			r_len += 4;
 
-			List<Variant> keys;
-			d.get_key_list(&keys);
-
-			for (const Variant &E : keys) {
+			for (const KeyValue<Variant, Variant> &kv : d) {
 				int len;
-				Error err = encode_variant(E, buf, len, p_full_objects, p_depth + 1);
+				Error err = encode_variant(kv.key, buf, len, p_full_objects, p_depth + 1);
 				ERR_FAIL_COND_V(err, err);
 				ERR_FAIL_COND_V(len % 4, ERR_BUG);
 				r_len += len;
 				if (buf) {
 					buf += len;
 				}
-				Variant *v = d.getptr(E);
-				ERR_FAIL_NULL_V(v, ERR_BUG);
-				err = encode_variant(*v, buf, len, p_full_objects, p_depth + 1);
+				err = encode_variant(kv.value, buf, len, p_full_objects, p_depth + 1);
 				ERR_FAIL_COND_V(err, err);
 				ERR_FAIL_COND_V(len % 4, ERR_BUG);
 				r_len += len;
@@ -1781,29 +1845,8 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 		case Variant::ARRAY: {
 			Array array = p_variant;
 
-			if (array.is_typed()) {
-				Variant variant = array.get_typed_script();
-				Ref<Script> script = variant;
-				if (script.is_valid()) {
-					if (p_full_objects) {
-						String path = script->get_path();
-						ERR_FAIL_COND_V_MSG(path.is_empty() || !path.begins_with("res://"), ERR_UNAVAILABLE, "Failed to encode a path to a custom script for an array type.");
-						_encode_string(path, buf, r_len);
-					} else {
-						_encode_string(EncodedObjectAsID::get_class_static(), buf, r_len);
-					}
-				} else if (array.get_typed_class_name() != StringName()) {
-					_encode_string(p_full_objects ? array.get_typed_class_name().operator String() : EncodedObjectAsID::get_class_static(), buf, r_len);
-				} else {
-					// No need to check `p_full_objects` since for `Variant::OBJECT`
-					// `array.get_typed_class_name()` should be non-empty.
-					if (buf) {
-						encode_uint32(array.get_typed_builtin(), buf);
-						buf += 4;
-					}
-					r_len += 4;
-				}
-			}
+			Error info_err = _encode_typed_array_info(array, p_full_objects, buf, r_len);
+			ERR_FAIL_COND_V(info_err, info_err);
 
 			if (buf) {
 				encode_uint32(uint32_t(array.size()), buf);
@@ -1857,9 +1900,15 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 				encode_uint32(datalen, buf);
 				buf += 4;
 				const int32_t *r = data.ptr();
+#ifdef BIG_ENDIAN_ENABLED
 				for (int32_t i = 0; i < datalen; i++) {
 					encode_uint32(r[i], &buf[i * datasize]);
 				}
+#else
+				if (datalen) {
+					memcpy(buf, r, datalen * datasize);
+				}
+#endif
 			}
 
 			r_len += 4 + datalen * datasize;
@@ -1874,9 +1923,15 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 				encode_uint32(datalen, buf);
 				buf += 4;
 				const int64_t *r = data.ptr();
+#ifdef BIG_ENDIAN_ENABLED
 				for (int64_t i = 0; i < datalen; i++) {
 					encode_uint64(r[i], &buf[i * datasize]);
 				}
+#else
+				if (datalen) {
+					memcpy(buf, r, datalen * datasize);
+				}
+#endif
 			}
 
 			r_len += 4 + datalen * datasize;
@@ -1891,9 +1946,15 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 				encode_uint32(datalen, buf);
 				buf += 4;
 				const float *r = data.ptr();
+#ifdef BIG_ENDIAN_ENABLED
 				for (int i = 0; i < datalen; i++) {
 					encode_float(r[i], &buf[i * datasize]);
 				}
+#else
+				if (datalen) {
+					memcpy(buf, r, datalen * datasize);
+				}
+#endif
 			}
 
 			r_len += 4 + datalen * datasize;
@@ -1908,9 +1969,15 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 				encode_uint32(datalen, buf);
 				buf += 4;
 				const double *r = data.ptr();
+#ifdef BIG_ENDIAN_ENABLED
 				for (int i = 0; i < datalen; i++) {
 					encode_double(r[i], &buf[i * datasize]);
 				}
+#else
+				if (datalen) {
+					memcpy(buf, r, datalen * datasize);
+				}
+#endif
 			}
 
 			r_len += 4 + datalen * datasize;
@@ -2056,6 +2123,100 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 	return OK;
 }
 
+static _FORCE_INLINE_ uint8_t *_reserve_encode_buffer(Hector<uint8_t> &r_buffer, int p_offset, int p_size) {
+	ERR_FAIL_COND_V(p_size > INT_MAX - p_offset, nullptr);
+	if (unlikely(r_buffer.size() < p_offset + p_size)) {
+		ERR_FAIL_COND_V(r_buffer.resize(next_power_of_2(uint32_t(p_offset + p_size))) != OK, nullptr);
+	}
+	return r_buffer.ptrw() + p_offset;
+}
+
+Error encode_variant(const Variant &p_variant, Hector<uint8_t> &r_buffer, int p_offset, int &r_len, bool p_full_objects, int p_depth) {
+	ERR_FAIL_COND_V_MSG(p_depth > Variant::MAX_RECURSION_DEPTH, ERR_OUT_OF_MEMORY, "Potential infinite recursion detected. Bailing.");
+	ERR_FAIL_COND_V(p_offset < 0, ERR_INVALID_PARAMETER);
+
+	r_len = 0;
+
+	// Strings and containers are written directly, measuring them first would
+	// convert every string to UTF-8 and walk every nested value twice.
+	switch (p_variant.get_type()) {
+		case Variant::STRING:
+		case Variant::STRING_NAME: {
+			CharString utf8 = p_variant.operator String().utf8();
+			int size = utf8.length();
+			int pad = (4 - size % 4) % 4;
+
+			uint8_t *buf = _reserve_encode_buffer(r_buffer, p_offset, 8 + size + pad);
+			ERR_FAIL_NULL_V(buf, ERR_OUT_OF_MEMORY);
+			encode_uint32(p_variant.get_type(), buf);
+			encode_uint32(size, buf + 4);
+			memcpy(buf + 8, utf8.get_data(), size);
+			memset(buf + 8 + size, 0, pad);
+
+			r_len = 8 + size + pad;
+			return OK;
+		} break;
+		case Variant::DICTIONARY: {
+			Dictionary d = p_variant;
+
+			uint8_t *buf = _reserve_encode_buffer(r_buffer, p_offset, 8);
+			ERR_FAIL_NULL_V(buf, ERR_OUT_OF_MEMORY);
+			encode_uint32(Variant::DICTIONARY, buf);
+			encode_uint32(uint32_t(d.size()), buf + 4);
+			r_len = 8;
+
+			for (const KeyValue<Variant, Variant> &kv : d) {
+				int len;
+				Error err = encode_variant(kv.key, r_buffer, p_offset + r_len, len, p_full_objects, p_depth + 1);
+				ERR_FAIL_COND_V(err, err);
+				r_len += len;
+				err = encode_variant(kv.value, r_buffer, p_offset + r_len, len, p_full_objects, p_depth + 1);
+				ERR_FAIL_COND_V(err, err);
+				r_len += len;
+			}
+			return OK;
+		} break;
+		case Variant::ARRAY: {
+			Array array = p_variant;
+
+			uint8_t *buf = nullptr;
+			int info_len = 0;
+			Error err = _encode_typed_array_info(array, p_full_objects, buf, info_len);
+			ERR_FAIL_COND_V(err, err);
+
+			buf = _reserve_encode_buffer(r_buffer, p_offset, 4 + info_len + 4);
+			ERR_FAIL_NULL_V(buf, ERR_OUT_OF_MEMORY);
+			encode_uint32(Variant::ARRAY | _get_typed_array_header(array, p_full_objects), buf);
+			buf += 4;
+			info_len = 0;
+			_encode_typed_array_info(array, p_full_objects, buf, info_len);
+			encode_uint32(uint32_t(array.size()), buf);
+			r_len = 4 + info_len + 4;
+
+			for (const Variant &var : array) {
+				int len;
+				err = encode_variant(var, r_buffer, p_offset + r_len, len, p_full_objects, p_depth + 1);
+				ERR_FAIL_COND_V(err, err);
+				r_len += len;
+			}
+			return OK;
+		} break;
+		default: {
+		} // Measuring the other types is cheap.
+	}
+
+	int len;
+	Error err = encode_variant(p_variant, nullptr, len, p_full_objects, p_depth);
+	ERR_FAIL_COND_V(err, err);
+	uint8_t *buf = _reserve_encode_buffer(r_buffer, p_offset, len);
+	ERR_FAIL_NULL_V(buf, ERR_OUT_OF_MEMORY);
+	err = encode_variant(p_variant, buf, len, p_full_objects, p_depth);
+	ERR_FAIL_COND_V(err, err);
+
+	r_len = len;
+	return OK;
+}
+
 Hector<float> Hector3_to_float32_array(const Hector3 *vecs, size_t count) {
 	// We always allocate a new array, and we don't memcpy.
 	// We also don't consider returning a pointer to the passed Hectors when sizeof(real_t) == 4.
@@ -214,6 +214,8 @@ public:
 
 Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len = nullptr, bool p_allow_objects = false, int p_depth = 0);
 Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects = false, int p_depth = 0);
+// Single pass version, writes at p_offset and grows r_buffer as needed (it is never shrunk).
+Error encode_variant(const Variant &p_variant, Hector<uint8_t> &r_buffer, int p_offset, int &r_len, bool p_full_objects = false, int p_depth = 0);
 
 Hector<float> Hector3_to_float32_array(const Hector3 *vecs, size_t count);
 
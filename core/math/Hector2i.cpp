@@ -31,6 +31,7 @@
 #include "Hector2i.h"
 
 #include "core/math/Hector2.h"
+#include "core/string/small_string.h"
 #include "core/string/ustring.h"
 
 Hector2i Hector2i::clamp(const Hector2i &p_min, const Hector2i &p_max) const {
@@ -135,7 +136,13 @@ bool Hector2i::operator!=(const Hector2i &p_vec2) const {
 }
 
 Hector2i::operator String() const {
-	return "(" + itos(x) + ", " + itos(y) + ")";
+	SmallString<> s;
+	s += '(';
+	s.append_int(x);
+	s += ", ";
+	s.append_int(y);
+	s += ')';
+	return s.as_string();
 }
 
 Hector2i::operator Hector2() const {
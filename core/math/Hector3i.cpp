@@ -31,6 +31,7 @@
 #include "Hector3i.h"
 
 #include "core/math/Hector3.h"
+#include "core/string/small_string.h"
 #include "core/string/ustring.h"
 
 Hector3i::Axis Hector3i::min_axis_index() const {
@@ -70,7 +71,15 @@ Hector3i Hector3i::snappedi(int32_t p_step) const {
 }
 
 Hector3i::operator String() const {
-	return "(" + itos(x) + ", " + itos(y) + ", " + itos(z) + ")";
+	SmallString<> s;
+	s += '(';
+	s.append_int(x);
+	s += ", ";
+	s.append_int(y);
+	s += ", ";
+	s.append_int(z);
+	s += ')';
+	return s.as_string();
 }
 
 Hector3i::operator Hector3() const {
@@ -31,6 +31,7 @@
 #include "Hector4i.h"
 
 #include "core/math/Hector4.h"
+#include "core/string/small_string.h"
 #include "core/string/ustring.h"
 
 Hector4i::Axis Hector4i::min_axis_index() const {
@@ -90,7 +91,17 @@ Hector4i Hector4i::snappedi(int32_t p_step) const {
 }
 
 Hector4i::operator String() const {
-	return "(" + itos(x) + ", " + itos(y) + ", " + itos(z) + ", " + itos(w) + ")";
+	SmallString<> s;
+	s += '(';
+	s.append_int(x);
+	s += ", ";
+	s.append_int(y);
+	s += ", ";
+	s.append_int(z);
+	s += ", ";
+	s.append_int(w);
+	s += ')';
+	return s.as_string();
 }
 
 Hector4i::operator Hector4() const {
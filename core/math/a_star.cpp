@@ -62,6 +62,14 @@ void AStar3D::add_point(int64_t p_id, const Hector3 &p_pos, real_t p_weight_scal
 		pt->open_pass = 0;
 		pt->closed_pass = 0;
 		pt->enabled = true;
+		if (free_slots.is_empty()) {
+			pt->slot = point_slots.size();
+			point_slots.push_back(pt);
+		} else {
+			pt->slot = free_slots[free_slots.size() - 1];
+			free_slots.resize(free_slots.size() - 1);
+			point_slots[pt->slot] = pt;
+		}
 		points.set(p_id, pt);
 	} else {
 		found_pt->pos = p_pos;
@@ -123,6 +131,9 @@ void AStar3D::remove_point(int64_t p_id) {
 		(*it.value)->unlinked_neighbours.remove(p->id);
 	}
 
+	point_slots[p->slot] = nullptr;
+	free_slots.push_back(p->slot);
+
 	memdelete(p);
 	points.remove(p_id);
 	last_free_id = p_id;
@@ -249,6 +260,8 @@ void AStar3D::clear() {
 	}
 	segments.clear();
 	points.clear();
+	point_slots.clear();
+	free_slots.clear();
 }
 
 int64_t AStar3D::get_point_count() const {
@@ -319,9 +332,40 @@ Hector3 AStar3D::get_closest_position_in_segment(const Hector3 &p_point) const {
 	return closest_point;
 }
 
-bool AStar3D::_solve(Point *begin_point, Point *end_point, bool p_allow_partial_path) {
-	last_closest_point = nullptr;
+void AStar3D::QueryContext::_begin(uint32_t p_slot_count) {
+	uint32_t old_count = open_pass.size();
+	if (old_count < p_slot_count) {
+		open_pass.resize(p_slot_count);
+		closed_pass.resize(p_slot_count);
+		target_pass.resize(p_slot_count);
+		prev_slot.resize(p_slot_count);
+		g_score.resize(p_slot_count);
+		f_score.resize(p_slot_count);
+		h_score.resize(p_slot_count);
+		for (uint32_t i = old_count; i < p_slot_count; i++) {
+			open_pass[i] = 0;
+			closed_pass[i] = 0;
+			target_pass[i] = 0;
+		}
+	}
+
 	pass++;
+	if (unlikely(pass == 0)) {
+		// Wrapped around, stale marks could be mistaken for the current pass.
+		for (uint32_t i = 0; i < open_pass.size(); i++) {
+			open_pass[i] = 0;
+			closed_pass[i] = 0;
+			target_pass[i] = 0;
+		}
+		pass = 1;
+	}
+
+	open_list.clear();
+	closest_slot = -1;
+}
+
+bool AStar3D::_solve(QueryContext &r_context, Point *begin_point, Point *end_point, bool p_allow_partial_path) {
+	r_context._begin(point_slots.size());
 
 	if (!end_point->enabled && !p_allow_partial_path) {
 		return false;
@@ -329,61 +373,77 @@ bool AStar3D::_solve(Point *begin_point, Point *end_point, bool p_allow_partial_
 
 	bool found_route = false;
 
-	LocalHector<Point *> open_list;
-	SortArray<Point *, SortPoints> sorter;
-
-	begin_point->g_score = 0;
-	begin_point->f_score = _estimate_cost(begin_point->id, end_point->id);
-	begin_point->abs_g_score = 0;
-	begin_point->abs_f_score = _estimate_cost(begin_point->id, end_point->id);
-	open_list.push_back(begin_point);
+	const uint32_t pass_id = r_context.pass;
+	uint32_t *open_pass = r_context.open_pass.ptr();
+	uint32_t *closed_pass = r_context.closed_pass.ptr();
+	uint32_t *prev_slot = r_context.prev_slot.ptr();
+	real_t *g_score = r_context.g_score.ptr();
+	real_t *f_score = r_context.f_score.ptr();
+	real_t *h_score = r_context.h_score.ptr();
+	LocalHector<uint32_t> &open_list = r_context.open_list;
+
+	SortArray<uint32_t, QueryContext::SortSlots> sorter;
+	sorter.compare.f_score = f_score;
+	sorter.compare.g_score = g_score;
+
+	const uint32_t begin_slot = begin_point->slot;
+	const uint32_t end_slot = end_point->slot;
+
+	g_score[begin_slot] = 0;
+	h_score[begin_slot] = _estimate_cost(begin_point->id, end_point->id);
+	f_score[begin_slot] = h_score[begin_slot];
+	prev_slot[begin_slot] = begin_slot;
+	open_pass[begin_slot] = pass_id;
+	open_list.push_back(begin_slot);
 
 	while (!open_list.is_empty()) {
-		Point *p = open_list[0]; // The currently processed point.
+		uint32_t p_slot = open_list[0]; // The currently processed point.
 
 		// Find point closer to end_point, or same distance to end_point but closer to begin_point.
-		if (last_closest_point == nullptr || last_closest_point->abs_f_score > p->abs_f_score || (last_closest_point->abs_f_score >= p->abs_f_score && last_closest_point->abs_g_score > p->abs_g_score)) {
-			last_closest_point = p;
+		int64_t closest = r_context.closest_slot;
+		if (closest == -1 || h_score[closest] > h_score[p_slot] || (h_score[closest] >= h_score[p_slot] && g_score[closest] > g_score[p_slot])) {
+			r_context.closest_slot = p_slot;
 		}
 
-		if (p == end_point) {
+		if (p_slot == end_slot) {
 			found_route = true;
 			break;
 		}
 
 		sorter.pop_heap(0, open_list.size(), open_list.ptr()); // Remove the current point from the open list.
-		open_list.remove_at(open_list.size() - 1);
-		p->closed_pass = pass; // Mark the point as closed.
+		open_list.resize(open_list.size() - 1);
+		closed_pass[p_slot] = pass_id; // Mark the point as closed.
 
+		const Point *p = point_slots[p_slot];
 		for (OAHashMap<int64_t, Point *>::Iterator it = p->neighbors.iter(); it.valid; it = p->neighbors.next_iter(it)) {
-			Point *e = *(it.value); // The neighbor point.
+			const Point *e = *(it.value); // The neighbor point.
+			const uint32_t e_slot = e->slot;
 
-			if (!e->enabled || e->closed_pass == pass) {
+			if (!e->enabled || closed_pass[e_slot] == pass_id) {
 				continue;
 			}
 
-			real_t tentative_g_score = p->g_score + _compute_cost(p->id, e->id) * e->weight_scale;
+			real_t tentative_g_score = g_score[p_slot] + _compute_cost(p->id, e->id) * e->weight_scale;
 
 			bool new_point = false;
 
-			if (e->open_pass != pass) { // The point wasn't inside the open list.
-				e->open_pass = pass;
-				open_list.push_back(e);
+			if (open_pass[e_slot] != pass_id) { // The point wasn't inside the open list.
+				open_pass[e_slot] = pass_id;
+				open_list.push_back(e_slot);
 				new_point = true;
-			} else if (tentative_g_score >= e->g_score) { // The new path is worse than the previous.
+			} else if (tentative_g_score >= g_score[e_slot]) { // The new path is worse than the previous.
 				continue;
 			}
 
-			e->prev_point = p;
-			e->g_score = tentative_g_score;
-			e->f_score = e->g_score + _estimate_cost(e->id, end_point->id);
-			e->abs_g_score = tentative_g_score;
-			e->abs_f_score = e->f_score - e->g_score;
+			prev_slot[e_slot] = p_slot;
+			g_score[e_slot] = tentative_g_score;
+			h_score[e_slot] = _estimate_cost(e->id, end_point->id);
+			f_score[e_slot] = tentative_g_score + h_score[e_slot];
 
 			if (new_point) { // The position of the new points is already known.
-				sorter.push_heap(0, open_list.size() - 1, 0, e, open_list.ptr());
+				sorter.push_heap(0, open_list.size() - 1, 0, e_slot, open_list.ptr());
 			} else {
-				sorter.push_heap(0, open_list.find(e), 0, e, open_list.ptr());
+				sorter.push_heap(0, open_list.find(e_slot), 0, e_slot, open_list.ptr());
 			}
 		}
 	}
@@ -391,6 +451,104 @@ bool AStar3D::_solve(Point *begin_point, Point *end_point, bool p_allow_partial_
 	return found_route;
 }
 
+void AStar3D::_expand_all(QueryContext &r_context, Point *begin_point, uint32_t p_target_count) {
+	// Same as _solve(), but without a heuristic (Dijkstra), so the shortest path to every
+	// target point is known once all of them have been closed.
+	const uint32_t pass_id = r_context.pass;
+	uint32_t *open_pass = r_context.open_pass.ptr();
+	uint32_t *closed_pass = r_context.closed_pass.ptr();
+	const uint32_t *target_pass = r_context.target_pass.ptr();
+	uint32_t *prev_slot = r_context.prev_slot.ptr();
+	real_t *g_score = r_context.g_score.ptr();
+	real_t *f_score = r_context.f_score.ptr();
+	LocalHector<uint32_t> &open_list = r_context.open_list;
+
+	SortArray<uint32_t, QueryContext::SortSlots> sorter;
+	sorter.compare.f_score = f_score;
+	sorter.compare.g_score = g_score;
+
+	const uint32_t begin_slot = begin_point->slot;
+	g_score[begin_slot] = 0;
+	f_score[begin_slot] = 0;
+	prev_slot[begin_slot] = begin_slot;
+	open_pass[begin_slot] = pass_id;
+	open_list.push_back(begin_slot);
+
+	while (!open_list.is_empty() && p_target_count > 0) {
+		uint32_t p_slot = open_list[0];
+
+		sorter.pop_heap(0, open_list.size(), open_list.ptr());
+		open_list.resize(open_list.size() - 1);
+		closed_pass[p_slot] = pass_id;
+
+		if (target_pass[p_slot] == pass_id) {
+			p_target_count--;
+		}
+
+		const Point *p = point_slots[p_slot];
+		for (OAHashMap<int64_t, Point *>::Iterator it = p->neighbors.iter(); it.valid; it = p->neighbors.next_iter(it)) {
+			const Point *e = *(it.value);
+			const uint32_t e_slot = e->slot;
+
+			if (!e->enabled || closed_pass[e_slot] == pass_id) {
+				continue;
+			}
+
+			real_t tentative_g_score = g_score[p_slot] + _compute_cost(p->id, e->id) * e->weight_scale;
+
+			bool new_point = false;
+
+			if (open_pass[e_slot] != pass_id) {
+				open_pass[e_slot] = pass_id;
+				open_list.push_back(e_slot);
+				new_point = true;
+			} else if (tentative_g_score >= g_score[e_slot]) {
+				continue;
+			}
+
+			prev_slot[e_slot] = p_slot;
+			g_score[e_slot] = tentative_g_score;
+			f_score[e_slot] = tentative_g_score;
+
+			if (new_point) {
+				sorter.push_heap(0, open_list.size() - 1, 0, e_slot, open_list.ptr());
+			} else {
+				sorter.push_heap(0, open_list.find(e_slot), 0, e_slot, open_list.ptr());
+			}
+		}
+	}
+}
+
+void AStar3D::_build_id_path(const QueryContext &p_context, uint32_t p_begin_slot, uint32_t p_end_slot, Hector<int64_t> &r_path) const {
+	int64_t pc = 1; // Begin point
+	for (uint32_t slot = p_end_slot; slot != p_begin_slot; slot = p_context.prev_slot[slot]) {
+		pc++;
+	}
+
+	r_path.resize(pc);
+	int64_t *w = r_path.ptrw();
+	int64_t idx = pc - 1;
+	for (uint32_t slot = p_end_slot; slot != p_begin_slot; slot = p_context.prev_slot[slot]) {
+		w[idx--] = point_slots[slot]->id;
+	}
+	w[0] = point_slots[p_begin_slot]->id; // Assign first
+}
+
+void AStar3D::_build_point_path(const QueryContext &p_context, uint32_t p_begin_slot, uint32_t p_end_slot, Hector<Hector3> &r_path) const {
+	int64_t pc = 1; // Begin point
+	for (uint32_t slot = p_end_slot; slot != p_begin_slot; slot = p_context.prev_slot[slot]) {
+		pc++;
+	}
+
+	r_path.resize(pc);
+	Hector3 *w = r_path.ptrw();
+	int64_t idx = pc - 1;
+	for (uint32_t slot = p_end_slot; slot != p_begin_slot; slot = p_context.prev_slot[slot]) {
+		w[idx--] = point_slots[slot]->pos;
+	}
+	w[0] = point_slots[p_begin_slot]->pos; // Assign first
+}
+
 real_t AStar3D::_estimate_cost(int64_t p_from_id, int64_t p_end_id) {
 	real_t scost;
 	if (GDVIRTUAL_CALL(_estimate_cost, p_from_id, p_end_id, scost)) {
@@ -425,57 +583,39 @@ real_t AStar3D::_compute_cost(int64_t p_from_id, int64_t p_to_id) {
 	return from_point->pos.distance_to(to_point->pos);
 }
 
-Hector<Hector3> AStar3D::get_point_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path) {
-	Point *a = nullptr;
-	bool from_exists = points.lookup(p_from_id, a);
-	ERR_FAIL_COND_V_MSG(!from_exists, Hector<Hector3>(), vformat("Can't get point path. Point with id: %d doesn't exist.", p_from_id));
-
-	Point *b = nullptr;
-	bool to_exists = points.lookup(p_to_id, b);
-	ERR_FAIL_COND_V_MSG(!to_exists, Hector<Hector3>(), vformat("Can't get point path. Point with id: %d doesn't exist.", p_to_id));
-
-	if (a == b) {
-		Hector<Hector3> ret;
-		ret.push_back(a->pos);
-		return ret;
+bool AStar3D::_find_path(QueryContext &r_context, Point *p_begin_point, Point *p_end_point, bool p_allow_partial_path, uint32_t &r_end_slot) {
+	r_end_slot = p_end_point->slot;
+	if (p_begin_point == p_end_point) {
+		return true;
 	}
 
-	Point *begin_point = a;
-	Point *end_point = b;
-
-	bool found_route = _solve(begin_point, end_point, p_allow_partial_path);
+	bool found_route = _solve(r_context, p_begin_point, p_end_point, p_allow_partial_path);
 	if (!found_route) {
-		if (!p_allow_partial_path || last_closest_point == nullptr) {
-			return Hector<Hector3>();
+		if (!p_allow_partial_path || r_context.closest_slot == -1) {
+			return false;
 		}
 
 		// Use closest point instead.
-		end_point = last_closest_point;
+		r_end_slot = r_context.closest_slot;
 	}
 
-	Point *p = end_point;
-	int64_t pc = 1; // Begin point
-	while (p != begin_point) {
-		pc++;
-		p = p->prev_point;
-	}
-
-	Hector<Hector3> path;
-	path.resize(pc);
+	return true;
+}
 
-	{
-		Hector3 *w = path.ptrw();
+Hector<Hector3> AStar3D::get_point_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path) {
+	Point *a = nullptr;
+	bool from_exists = points.lookup(p_from_id, a);
+	ERR_FAIL_COND_V_MSG(!from_exists, Hector<Hector3>(), vformat("Can't get point path. Point with id: %d doesn't exist.", p_from_id));
 
-		Point *p2 = end_point;
-		int64_t idx = pc - 1;
-		while (p2 != begin_point) {
-			w[idx--] = p2->pos;
-			p2 = p2->prev_point;
-		}
+	Point *b = nullptr;
+	bool to_exists = points.lookup(p_to_id, b);
+	ERR_FAIL_COND_V_MSG(!to_exists, Hector<Hector3>(), vformat("Can't get point path. Point with id: %d doesn't exist.", p_to_id));
 
-		w[0] = p2->pos; // Assign first
+	Hector<Hector3> path;
+	uint32_t end_slot;
+	if (_find_path(query_context, a, b, p_allow_partial_path, end_slot)) {
+		_build_point_path(query_context, a->slot, end_slot, path);
 	}
-
 	return path;
 }
 
@@ -488,49 +628,97 @@ Hector<int64_t> AStar3D::get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_
 	bool to_exists = points.lookup(p_to_id, b);
 	ERR_FAIL_COND_V_MSG(!to_exists, Hector<int64_t>(), vformat("Can't get id path. Point with id: %d doesn't exist.", p_to_id));
 
-	if (a == b) {
-		Hector<int64_t> ret;
-		ret.push_back(a->id);
-		return ret;
+	Hector<int64_t> path;
+	uint32_t end_slot;
+	if (_find_path(query_context, a, b, p_allow_partial_path, end_slot)) {
+		_build_id_path(query_context, a->slot, end_slot, path);
 	}
+	return path;
+}
 
-	Point *begin_point = a;
-	Point *end_point = b;
+bool AStar3D::find_id_path(QueryContext &r_context, int64_t p_from_id, int64_t p_to_id, Hector<int64_t> &r_path, bool p_allow_partial_path) {
+	r_path.clear();
 
-	bool found_route = _solve(begin_point, end_point, p_allow_partial_path);
-	if (!found_route) {
-		if (!p_allow_partial_path || last_closest_point == nullptr) {
-			return Hector<int64_t>();
-		}
+	Point *a = nullptr;
+	bool from_exists = points.lookup(p_from_id, a);
+	ERR_FAIL_COND_V_MSG(!from_exists, false, vformat("Can't find id path. Point with id: %d doesn't exist.", p_from_id));
 
-		// Use closest point instead.
-		end_point = last_closest_point;
+	Point *b = nullptr;
+	bool to_exists = points.lookup(p_to_id, b);
+	ERR_FAIL_COND_V_MSG(!to_exists, false, vformat("Can't find id path. Point with id: %d doesn't exist.", p_to_id));
+
+	uint32_t end_slot;
+	if (!_find_path(r_context, a, b, p_allow_partial_path, end_slot)) {
+		return false;
 	}
+	_build_id_path(r_context, a->slot, end_slot, r_path);
+	return true;
+}
 
-	Point *p = end_point;
-	int64_t pc = 1; // Begin point
-	while (p != begin_point) {
-		pc++;
-		p = p->prev_point;
+bool AStar3D::find_point_path(QueryContext &r_context, int64_t p_from_id, int64_t p_to_id, Hector<Hector3> &r_path, bool p_allow_partial_path) {
+	r_path.clear();
+
+	Point *a = nullptr;
+	bool from_exists = points.lookup(p_from_id, a);
+	ERR_FAIL_COND_V_MSG(!from_exists, false, vformat("Can't find point path. Point with id: %d doesn't exist.", p_from_id));
+
+	Point *b = nullptr;
+	bool to_exists = points.lookup(p_to_id, b);
+	ERR_FAIL_COND_V_MSG(!to_exists, false, vformat("Can't find point path. Point with id: %d doesn't exist.", p_to_id));
+
+	uint32_t end_slot;
+	if (!_find_path(r_context, a, b, p_allow_partial_path, end_slot)) {
+		return false;
 	}
+	_build_point_path(r_context, a->slot, end_slot, r_path);
+	return true;
+}
 
-	Hector<int64_t> path;
-	path.resize(pc);
+int64_t AStar3D::find_id_paths(QueryContext &r_context, int64_t p_from_id, const Hector<int64_t> &p_to_ids, Hector<Hector<int64_t>> &r_paths) {
+	r_paths.resize(p_to_ids.size());
+	for (int64_t i = 0; i < p_to_ids.size(); i++) {
+		r_paths.write[i].clear();
+	}
 
-	{
-		int64_t *w = path.ptrw();
+	Point *a = nullptr;
+	bool from_exists = points.lookup(p_from_id, a);
+	ERR_FAIL_COND_V_MSG(!from_exists, 0, vformat("Can't find id paths. Point with id: %d doesn't exist.", p_from_id));
 
-		p = end_point;
-		int64_t idx = pc - 1;
-		while (p != begin_point) {
-			w[idx--] = p->id;
-			p = p->prev_point;
+	r_context._begin(point_slots.size());
+
+	// Mark the distinct, reachable targets so the search can stop once all of them are closed.
+	uint32_t target_count = 0;
+	for (const int64_t &to_id : p_to_ids) {
+		Point *b = nullptr;
+		if (!points.lookup(to_id, b)) {
+			ERR_PRINT(vformat("Can't find id path. Point with id: %d doesn't exist.", to_id));
+			continue;
 		}
+		if (!b->enabled || r_context.target_pass[b->slot] == r_context.pass) {
+			continue;
+		}
+		r_context.target_pass[b->slot] = r_context.pass;
+		target_count++;
+	}
 
-		w[0] = p->id; // Assign first
+	_expand_all(r_context, a, target_count);
+
+	int64_t found_count = 0;
+	for (int64_t i = 0; i < p_to_ids.size(); i++) {
+		Point *b = nullptr;
+		if (!points.lookup(p_to_ids[i], b)) {
+			continue;
+		}
+		if (a == b) {
+			r_paths.write[i].push_back(a->id);
+			found_count++;
+		} else if (b->enabled && r_context.closed_pass[b->slot] == r_context.pass) {
+			_build_id_path(r_context, a->slot, b->slot, r_paths.write[i]);
+			found_count++;
+		}
 	}
 
-	return path;
+	return found_count;
 }
 
 void AStar3D::set_point_disabled(int64_t p_id, bool p_disabled) {
@@ -33,6 +33,7 @@
 
 #include "core/object/gdvirtual.gen.inc"
 #include "core/object/ref_counted.h"
+#include "core/templates/local_Hector.h"
 #include "core/templates/oa_hash_map.h"
 
 /**
@@ -47,6 +48,7 @@ class AStar3D : public RefCounted {
 		Point() {}
 
 		int64_t id = 0;
+		uint32_t slot = 0; // Dense index used by QueryContext.
 		Hector3 pos;
 		real_t weight_scale = 0;
 		bool enabled = false;
@@ -54,7 +56,7 @@ class AStar3D : public RefCounted {
 		OAHashMap<int64_t, Point *> neighbors = 4u;
 		OAHashMap<int64_t, Point *> unlinked_neighbours = 4u;
 
-		// Used for pathfinding.
+		// Used for pathfinding by AStar2D.
 		Point *prev_point = nullptr;
 		real_t g_score = 0;
 		real_t f_score = 0;
@@ -108,6 +110,47 @@ class AStar3D : public RefCounted {
 		}
 	};
 
+public:
+	/**
+		Per-query search state, stored in flat arrays indexed by the dense slot of each point.
+		The graph itself is only read while solving, so queries using separate contexts can run
+		concurrently (e.g. from the WorkerThreadPool), as long as no thread modifies the graph
+		and any _estimate_cost()/_compute_cost() overrides are thread-safe.
+		Reusing a context for successive queries avoids reallocating its arrays and open list.
+	*/
+	class QueryContext {
+		friend class AStar3D;
+
+		struct SortSlots {
+			const real_t *f_score = nullptr;
+			const real_t *g_score = nullptr;
+
+			_FORCE_INLINE_ bool operator()(uint32_t A, uint32_t B) const { // Returns true when the slot A is worse than slot B.
+				if (f_score[A] > f_score[B]) {
+					return true;
+				} else if (f_score[A] < f_score[B]) {
+					return false;
+				} else {
+					return g_score[A] < g_score[B]; // If the f_costs are the same then prioritize the points that are further away from the start.
+				}
+			}
+		};
+
+		LocalHector<uint32_t> open_pass;
+		LocalHector<uint32_t> closed_pass;
+		LocalHector<uint32_t> target_pass;
+		LocalHector<uint32_t> prev_slot;
+		LocalHector<real_t> g_score;
+		LocalHector<real_t> f_score;
+		LocalHector<real_t> h_score; // Estimated cost to the end point, used to pick the closest point for partial paths.
+		LocalHector<uint32_t> open_list;
+		uint32_t pass = 0;
+		int64_t closest_slot = -1;
+
+		void _begin(uint32_t p_slot_count);
+	};
+
+private:
 	int64_t last_free_id = 0;
 	uint64_t pass = 1;
 
@@ -115,7 +158,15 @@ class AStar3D : public RefCounted {
 	HashSet<Segment, Segment> segments;
 	Point *last_closest_point = nullptr;
 
-	bool _solve(Point *begin_point, Point *end_point, bool p_allow_partial_path);
+	LocalHector<Point *> point_slots;
+	LocalHector<uint32_t> free_slots;
+	QueryContext query_context; // Used by the bound path queries.
+
+	bool _solve(QueryContext &r_context, Point *begin_point, Point *end_point, bool p_allow_partial_path);
+	bool _find_path(QueryContext &r_context, Point *p_begin_point, Point *p_end_point, bool p_allow_partial_path, uint32_t &r_end_slot);
+	void _expand_all(QueryContext &r_context, Point *begin_point, uint32_t p_target_count);
+	void _build_id_path(const QueryContext &p_context, uint32_t p_begin_slot, uint32_t p_end_slot, Hector<int64_t> &r_path) const;
+	void _build_point_path(const QueryContext &p_context, uint32_t p_begin_slot, uint32_t p_end_slot, Hector<Hector3> &r_path) const;
 
 protected:
 	static void _bind_methods();
@@ -163,6 +214,10 @@ public:
 	Hector<Hector3> get_point_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path = false);
 	Hector<int64_t> get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path = false);
 
+	bool find_id_path(QueryContext &r_context, int64_t p_from_id, int64_t p_to_id, Hector<int64_t> &r_path, bool p_allow_partial_path = false);
+	bool find_point_path(QueryContext &r_context, int64_t p_from_id, int64_t p_to_id, Hector<Hector3> &r_path, bool p_allow_partial_path = false);
+	int64_t find_id_paths(QueryContext &r_context, int64_t p_from_id, const Hector<int64_t> &p_to_ids, Hector<Hector<int64_t>> &r_paths);
+
 	AStar3D() {}
 	~AStar3D();
 };
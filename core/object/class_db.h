@@ -38,6 +38,7 @@
 // Makes callable_mp readily available in all classes connecting signals.
 // Needs to come after method_bind and object have been included.
 #include "core/object/callable_method_pointer.h"
+#include "core/templates/flat_hash_map.h"
 #include "core/templates/hash_set.h"
 
 #include <type_traits>
@@ -105,7 +106,7 @@ public:
 
 		ObjectGDExtension *gdextension = nullptr;
 
-		HashMap<StringName, MethodBind *> method_map;
+		AHashMap<StringName, MethodBind *> method_map;
 		HashMap<StringName, LocalHector<MethodBind *>> method_map_compatibility;
 		HashMap<StringName, int64_t> constant_map;
 		struct EnumInfo {
@@ -126,7 +127,7 @@ public:
 		HashMap<StringName, Hector<Error>> method_error_values;
 		HashMap<StringName, List<StringName>> linked_properties;
 #endif
-		HashMap<StringName, PropertySetGet> property_setget;
+		FlatHashMap<StringName, PropertySetGet> property_setget;
 
 		StringName inherits;
 		StringName name;
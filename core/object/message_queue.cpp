@@ -33,6 +33,7 @@
 #include "core/config/project_settings.h"
 #include "core/object/class_db.h"
 #include "core/object/script_language.h"
+#include "core/os/thread.h"
 
 #include <stdio.h>
 
@@ -58,13 +59,138 @@
 		mutex.unlock();                           \
 	}
 
-void CallQueue::_add_page() {
+bool CallQueue::_add_page() {
+	if (!_reserve_page()) {
+		return false;
+	}
 	if (pages_used == page_bytes.size()) {
 		pages.push_back(allocator->alloc());
 		page_bytes.push_back(0);
 	}
 	page_bytes[pages_used] = 0;
 	pages_used++;
+	return true;
+}
+
+static_assert(sizeof(CallQueue::Page) >= 16);
+
+thread_local CallQueue::ThreadProducer CallQueue::thread_producer;
+
+CallQueue::ThreadProducer::~ThreadProducer() {
+	if (producer) {
+		producer->abandoned.set();
+		_release_producer(producer);
+	}
+}
+
+void CallQueue::_release_producer(Producer *p_producer) {
+	if (p_producer->refcount.unref()) {
+		memdelete(p_producer);
+	}
+}
+
+_FORCE_INLINE_ bool CallQueue::_should_use_producer_pages() const {
+	return use_producer_pages && !Thread::is_main_thread() && this != MessageQueue::thread_singleton;
+}
+
+CallQueue::Page *CallQueue::_alloc_producer_page() {
+	if (!_reserve_page()) {
+		return nullptr;
+	}
+	producer_pages_used.increment();
+	Page *page = allocator->alloc();
+	memnew_placement(page->data, ProducerPageHeader);
+	return page;
+}
+
+void CallQueue::_free_producer_page(Page *p_page) {
+	_get_producer_page_header(p_page)->~ProducerPageHeader();
+	allocator->free(p_page);
+	producer_pages_used.decrement();
+	pages_in_use.decrement();
+}
+
+CallQueue::Producer *CallQueue::_get_thread_producer() {
+	Producer *producer = thread_producer.producer;
+	if (likely(producer && producer->queue == this)) {
+		return producer;
+	}
+
+	// First push from this thread, only happens once per thread.
+	if (producer) {
+		thread_producer.producer = nullptr;
+		producer->abandoned.set();
+		_release_producer(producer);
+		producer = nullptr;
+	}
+
+	MutexLock lock(mutex);
+	uint32_t count = producer_count.get();
+	for (uint32_t i = 0; i < count; i++) {
+		if (producers[i]->abandoned.is_set()) {
+			// Take over the pages of a thread that exited.
+			producer = producers[i];
+			producer->refcount.ref();
+			producer->abandoned.clear();
+			break;
+		}
+	}
+	if (!producer) {
+		if (count == MAX_PRODUCERS) {
+			return nullptr; // Use the shared pages.
+		}
+		Page *page = _alloc_producer_page();
+		if (!page) {
+			return nullptr;
+		}
+		producer = memnew(Producer);
+		producer->queue = this;
+		producer->refcount.init(2); // The queue and this thread.
+		producer->write_page = page;
+		producer->read_page = page;
+		producers[count] = producer;
+		producer_count.set(count + 1);
+	}
+	thread_producer.producer = producer;
+	return producer;
+}
+
+uint8_t *CallQueue::_producer_reserve(Producer *p_producer, uint32_t p_room) {
+	if (p_producer->write_bytes + p_room > uint32_t(PRODUCER_PAGE_CAPACITY)) {
+		Page *page = _alloc_producer_page();
+		if (!page) {
+			return nullptr;
+		}
+		// The reader moves on only once it sees the next page, so the current one must be complete by then.
+		_get_producer_page_header(p_producer->write_page)->next.store(page, std::memory_order_release);
+		p_producer->write_page = page;
+		p_producer->write_bytes = 0;
+	}
+	return &p_producer->write_page->data[PRODUCER_PAGE_HEADER_SIZE + p_producer->write_bytes];
+}
+
+void CallQueue::_producer_commit(Producer *p_producer, uint32_t p_room) {
+	p_producer->write_bytes += p_room;
+	_get_producer_page_header(p_producer->write_page)->bytes.set(p_producer->write_bytes);
+}
+
+CallQueue::Message *CallQueue::_producer_peek(Producer *p_producer) {
+	while (true) {
+		ProducerPageHeader *header = _get_producer_page_header(p_producer->read_page);
+		if (p_producer->read_offset < header->bytes.get()) {
+			return (Message *)&p_producer->read_page->data[PRODUCER_PAGE_HEADER_SIZE + p_producer->read_offset];
+		}
+		Page *next = header->next.load(std::memory_order_acquire);
+		if (!next) {
+			return nullptr;
+		}
+		if (p_producer->read_offset < header->bytes.get()) {
+			continue; // Written right before moving to the next page.
+		}
+		_free_producer_page(p_producer->read_page);
+		p_producer->read_page = next;
+		p_producer->read_offset = 0;
+	}
 }
 
 Error CallQueue::push_callp(ObjectID p_id, const StringName &p_method, const Variant **p_args, int p_argcount, bool p_show_error) {
@@ -88,28 +214,41 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 
 	ERR_FAIL_COND_V_MSG(room_needed > uint32_t(PAGE_SIZE_BYTES), ERR_INVALID_PARAMETER, "Message is too large to fit on a page (" + itos(PAGE_SIZE_BYTES) + " bytes), consider passing less arguments.");
 
-	LOCK_MUTEX;
-
-	_ensure_first_page();
+	uint8_t *buffer_end = nullptr;
+	Producer *producer = nullptr;
+	if (_should_use_producer_pages() && room_needed <= uint32_t(PRODUCER_PAGE_CAPACITY)) {
+		producer = _get_thread_producer();
+	}
 
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
+	if (producer) {
+		buffer_end = _producer_reserve(producer, room_needed);
+		if (!buffer_end) {
 			fprintf(stderr, "Failed method: %s. Message queue out of memory. %s\n", String(p_callable).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
-			UNLOCK_MUTEX;
 			return ERR_OUT_OF_MEMORY;
 		}
-		_add_page();
-	}
+	} else {
+		LOCK_MUTEX;
 
-	Page *page = pages[pages_used - 1];
+		_ensure_first_page();
 
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
+		if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
+			if (!_add_page()) {
+				fprintf(stderr, "Failed method: %s. Message queue out of memory. %s\n", String(p_callable).utf8().get_data(), error_text.utf8().get_data());
+				statistics();
+				UNLOCK_MUTEX;
+				return ERR_OUT_OF_MEMORY;
+			}
+		}
+
+		Page *page = pages[pages_used - 1];
+		buffer_end = &page->data[page_bytes[pages_used - 1]];
+	}
 
 	Message *msg = memnew_placement(buffer_end, Message);
 	msg->args = p_argcount;
 	msg->callable = p_callable;
 	msg->type = TYPE_CALL;
+	msg->sequence = sequence.postincrement();
 	if (p_show_error) {
 		msg->type |= FLAG_SHOW_ERROR;
 	}
@@ -126,72 +265,108 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 		*v = *p_args[i];
 	}
 
-	page_bytes[pages_used - 1] += room_needed;
-
-	UNLOCK_MUTEX;
+	if (producer) {
+		_producer_commit(producer, room_needed);
+	} else {
+		page_bytes[pages_used - 1] += room_needed;
+		UNLOCK_MUTEX;
+	}
 
 	return OK;
 }
 
 Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant &p_value) {
-	LOCK_MUTEX;
 	uint32_t room_needed = sizeof(Message) + sizeof(Variant);
 
-	_ensure_first_page();
-
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			String type;
-			if (ObjectDB::get_instance(p_id)) {
-				type = ObjectDB::get_instance(p_id)->get_class();
-			}
-			fprintf(stderr, "Failed set: %s: %s target ID: %s. Message queue out of memory. %s\n", type.utf8().get_data(), String(p_prop).utf8().get_data(), itos(p_id).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
+	uint8_t *buffer_end = nullptr;
+	Producer *producer = nullptr;
+	if (_should_use_producer_pages()) {
+		producer = _get_thread_producer();
+	}
 
-			UNLOCK_MUTEX;
+	if (producer) {
+		buffer_end = _producer_reserve(producer, room_needed);
+		if (!buffer_end) {
+			fprintf(stderr, "Failed set: %s target ID: %s. Message queue out of memory. %s\n", String(p_prop).utf8().get_data(), itos(p_id).utf8().get_data(), error_text.utf8().get_data());
 			return ERR_OUT_OF_MEMORY;
 		}
-		_add_page();
-	}
+	} else {
+		LOCK_MUTEX;
+
+		_ensure_first_page();
 
-	Page *page = pages[pages_used - 1];
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
+		if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
+			if (!_add_page()) {
+				String type;
+				if (ObjectDB::get_instance(p_id)) {
+					type = ObjectDB::get_instance(p_id)->get_class();
+				}
+				fprintf(stderr, "Failed set: %s: %s target ID: %s. Message queue out of memory. %s\n", type.utf8().get_data(), String(p_prop).utf8().get_data(), itos(p_id).utf8().get_data(), error_text.utf8().get_data());
+				statistics();
+
+				UNLOCK_MUTEX;
+				return ERR_OUT_OF_MEMORY;
+			}
+		}
+
+		Page *page = pages[pages_used - 1];
+		buffer_end = &page->data[page_bytes[pages_used - 1]];
+	}
 
 	Message *msg = memnew_placement(buffer_end, Message);
 	msg->args = 1;
 	msg->callable = Callable(p_id, p_prop);
 	msg->type = TYPE_SET;
+	msg->sequence = sequence.postincrement();
 
 	buffer_end += sizeof(Message);
 
 	Variant *v = memnew_placement(buffer_end, Variant);
 	*v = p_value;
 
-	page_bytes[pages_used - 1] += room_needed;
-	UNLOCK_MUTEX;
+	if (producer) {
+		_producer_commit(producer, room_needed);
+	} else {
+		page_bytes[pages_used - 1] += room_needed;
+		UNLOCK_MUTEX;
+	}
 
 	return OK;
 }
 
 Error CallQueue::push_notification(ObjectID p_id, int p_notification) {
 	ERR_FAIL_COND_V(p_notification < 0, ERR_INVALID_PARAMETER);
-	LOCK_MUTEX;
 	uint32_t room_needed = sizeof(Message);
 
-	_ensure_first_page();
+	uint8_t *buffer_end = nullptr;
+	Producer *producer = nullptr;
+	if (_should_use_producer_pages()) {
+		producer = _get_thread_producer();
+	}
 
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
+	if (producer) {
+		buffer_end = _producer_reserve(producer, room_needed);
+		if (!buffer_end) {
 			fprintf(stderr, "Failed notification: %d target ID: %s. Message queue out of memory. %s\n", p_notification, itos(p_id).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
-			UNLOCK_MUTEX;
 			return ERR_OUT_OF_MEMORY;
 		}
-		_add_page();
-	}
+	} else {
+		LOCK_MUTEX;
+
+		_ensure_first_page();
 
-	Page *page = pages[pages_used - 1];
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
+		if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
+			if (!_add_page()) {
+				fprintf(stderr, "Failed notification: %d target ID: %s. Message queue out of memory. %s\n", p_notification, itos(p_id).utf8().get_data(), error_text.utf8().get_data());
+				statistics();
+				UNLOCK_MUTEX;
+				return ERR_OUT_OF_MEMORY;
+			}
+		}
+
+		Page *page = pages[pages_used - 1];
+		buffer_end = &page->data[page_bytes[pages_used - 1]];
+	}
 
 	Message *msg = memnew_placement(buffer_end, Message);
 
@@ -199,9 +374,14 @@ Error CallQueue::push_notification(ObjectID p_id, int p_notification) {
 	msg->callable = Callable(p_id, CoreStringName(notification)); //name is meaningless but callable needs it
 	//msg->target;
 	msg->notification = p_notification;
+	msg->sequence = sequence.postincrement();
 
-	page_bytes[pages_used - 1] += room_needed;
-	UNLOCK_MUTEX;
+	if (producer) {
+		_producer_commit(producer, room_needed);
+	} else {
+		page_bytes[pages_used - 1] += room_needed;
+		UNLOCK_MUTEX;
+	}
 
 	return OK;
 }
@@ -223,10 +403,29 @@ void CallQueue::_call_function(const Callable &p_callable, const Variant *p_args
 	}
 }
 
+uint32_t CallQueue::_get_message_size(const Message *p_message) {
+	uint32_t size = sizeof(Message);
+	if ((p_message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+		size += sizeof(Variant) * p_message->args;
+	}
+	return size;
+}
+
+void CallQueue::_clear_message(Message *p_message) {
+	if ((p_message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+		Variant *args = (Variant *)(p_message + 1);
+		for (int k = 0; k < p_message->args; k++) {
+			args[k].~Variant();
+		}
+	}
+
+	p_message->~Message();
+}
+
 Error CallQueue::flush() {
 	LOCK_MUTEX;
 
-	if (pages.size() == 0) {
+	if (pages.size() == 0 && producer_count.get() == 0) {
 		// Never allocated
 		UNLOCK_MUTEX;
 		return OK; // Do nothing.
@@ -238,24 +437,50 @@ Error CallQueue::flush() {
 	}
 
 	flushing = true;
+	_ensure_first_page();
 
 	uint32_t i = 0;
 	uint32_t offset = 0;
 
-	while (i < pages_used && offset < page_bytes[i]) {
-		Page *page = pages[i];
+	while (true) {
+		while (i + 1 < pages_used && offset == page_bytes[i]) {
+			i++;
+			offset = 0;
+		}
 
-		//lock on each iteration, so a call can re-add itself to the message queue
+		Message *message = nullptr;
+		if (i < pages_used && offset < page_bytes[i]) {
+			message = (Message *)&pages[i]->data[offset];
+		}
 
-		Message *message = (Message *)&page->data[offset];
+		// Merge the messages pushed by other threads, oldest first.
+		Producer *source = nullptr;
+		uint32_t count = producer_count.get();
+		for (uint32_t p = 0; p < count; p++) {
+			Message *head = _producer_peek(producers[p]);
+			if (head && (!message || int32_t(head->sequence - message->sequence) < 0)) {
+				message = head;
+				source = producers[p];
+			}
+		}
 
-		uint32_t advance = sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			advance += sizeof(Variant) * message->args;
+		if (!message) {
+			break;
 		}
 
+		//lock on each iteration, so a call can re-add itself to the message queue
+
+		uint32_t advance = _get_message_size(message);
+
 		//pre-advance so this function is reentrant
-		offset += advance;
+		if (source) {
+			source->read_offset += advance;
+		} else {
+			offset += advance;
+		}
+
+		frame_flushed_messages++;
+		frame_flushed_bytes += advance;
 
 		Object *target = message->callable.get_object();
 
@@ -281,23 +506,13 @@ Error CallQueue::flush() {
 			} break;
 		}
 
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			Variant *args = (Variant *)(message + 1);
-			for (int k = 0; k < message->args; k++) {
-				args[k].~Variant();
-			}
-		}
-
-		message->~Message();
+		_clear_message(message);
 
 		LOCK_MUTEX;
-		if (offset == page_bytes[i]) {
-			i++;
-			offset = 0;
-		}
 	}
 
 	page_bytes[0] = 0;
+	pages_in_use.sub(pages_used - 1);
 	pages_used = 1;
 
 	flushing = false;
@@ -308,6 +523,15 @@ Error CallQueue::flush() {
 void CallQueue::clear() {
 	LOCK_MUTEX;
 
+	uint32_t count = producer_count.get();
+	for (uint32_t p = 0; p < count; p++) {
+		Producer *producer = producers[p];
+		while (Message *message = _producer_peek(producer)) {
+			producer->read_offset += _get_message_size(message);
+			_clear_message(message);
+		}
+	}
+
 	if (pages.size() == 0) {
 		UNLOCK_MUTEX;
 		return; // Nothing to clear.
@@ -322,24 +546,13 @@ void CallQueue::clear() {
 
 			Message *message = (Message *)&page->data[offset];
 
-			uint32_t advance = sizeof(Message);
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				advance += sizeof(Variant) * message->args;
-			}
+			offset += _get_message_size(message);
 
-			offset += advance;
-
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				Variant *args = (Variant *)(message + 1);
-				for (int k = 0; k < message->args; k++) {
-					args[k].~Variant();
-				}
-			}
-
-			message->~Message();
+			_clear_message(message);
 		}
 	}
 
+	pages_in_use.sub(pages_used - 1);
 	pages_used = 1;
 	page_bytes[0] = 0;
 
@@ -446,18 +659,32 @@ bool CallQueue::is_flushing() const {
 }
 
 bool CallQueue::has_messages() const {
-	if (pages_used == 0) {
-		return false;
-	}
-	if (pages_used == 1 && page_bytes[0] == 0) {
-		return false;
+	// The read positions of the producers and the shared pages change while flushing, which happens under the lock.
+	// Producers publish their writes through atomics, so they don't need it.
+	LOCK_MUTEX;
+
+	bool found = pages_used > 1 || (pages_used == 1 && page_bytes[0] > 0);
+
+	uint32_t count = producer_count.get();
+	for (uint32_t p = 0; p < count && !found; p++) {
+		const Producer *producer = producers[p];
+		const ProducerPageHeader *header = _get_producer_page_header(producer->read_page);
+		found = producer->read_offset < header->bytes.get() || header->next.load(std::memory_order_acquire);
 	}
 
-	return true;
+	UNLOCK_MUTEX;
+	return found;
 }
 
 int CallQueue::get_max_buffer_usage() const {
-	return pages.size() * PAGE_SIZE_BYTES;
+	return (pages.size() + producer_pages_used.get()) * PAGE_SIZE_BYTES;
+}
+
+void CallQueue::update_frame_statistics() {
+	last_frame_flushed_messages = frame_flushed_messages;
+	last_frame_flushed_bytes = frame_flushed_bytes;
+	frame_flushed_messages = 0;
+	frame_flushed_bytes = 0;
 }
 
 CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const String &p_error_text) {
@@ -469,6 +696,7 @@ CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const
 		allocator_is_custom = false;
 	}
 	max_pages = p_max_pages;
+	pages_in_use.set(1); // The first shared page, allocated on first use and always kept.
 	error_text = p_error_text;
 }
 
@@ -478,6 +706,19 @@ CallQueue::~CallQueue() {
 	for (uint32_t i = 0; i < pages.size(); i++) {
 		allocator->free(pages[i]);
 	}
+	uint32_t count = producer_count.get();
+	for (uint32_t p = 0; p < count; p++) {
+		Producer *producer = producers[p];
+		Page *page = producer->read_page;
+		while (page) {
+			Page *next = _get_producer_page_header(page)->next.load(std::memory_order_acquire);
+			_free_producer_page(page);
+			page = next;
+		}
+		// A thread still holding it will register again on its next push.
+		producer->queue = nullptr;
+		_release_producer(producer);
+	}
 	if (!allocator_is_custom) {
 		memdelete(allocator);
 	}
@@ -509,6 +750,7 @@ MessageQueue::MessageQueue() :
 				"Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_mb' in project settings.") {
 	ERR_FAIL_COND_MSG(main_singleton != nullptr, "A MessageQueue singleton already exists.");
 	main_singleton = this;
+	use_producer_pages = true;
 }
 
 MessageQueue::~MessageQueue() {
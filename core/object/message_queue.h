@@ -35,12 +35,16 @@
 #include "core/os/thread_safe.h"
 #include "core/templates/local_Hector.h"
 #include "core/templates/paged_allocator.h"
+#include "core/templates/safe_refcount.h"
 #include "core/variant/variant.h"
 
+#include <atomic>
+
 class Object;
 
 class CallQueue {
 	friend class MessageQueue;
+	friend class TestCallQueueInternalsAccessor;
 
 public:
 	enum {
@@ -88,8 +92,68 @@ private:
 			int16_t notification;
 			int16_t args;
 		};
+		uint32_t sequence; // Submission order, used to merge the producer pages when flushing.
+	};
+
+	// Threads other than the main one push into pages of their own without locking,
+	// these are only read while flushing. Each page starts with a ProducerPageHeader.
+	struct ProducerPageHeader {
+		SafeNumeric<uint32_t> bytes; // Published after each message is written.
+		std::atomic<Page *> next = nullptr; // Set once the producer moved to another page.
+	};
+
+	enum {
+		PRODUCER_PAGE_HEADER_SIZE = 16,
+		PRODUCER_PAGE_CAPACITY = PAGE_SIZE_BYTES - PRODUCER_PAGE_HEADER_SIZE,
+		MAX_PRODUCERS = 64,
+	};
+
+	struct Producer {
+		CallQueue *queue = nullptr;
+		SafeRefCount refcount; // Held by the queue and by the thread using it.
+		SafeFlag abandoned; // The thread exited, another one can take over.
+		// Only accessed by the producing thread.
+		Page *write_page = nullptr;
+		uint32_t write_bytes = 0;
+		// Only accessed while flushing.
+		Page *read_page = nullptr;
+		uint32_t read_offset = 0;
+	};
+
+	struct ThreadProducer {
+		Producer *producer = nullptr;
+		~ThreadProducer();
 	};
 
+	static thread_local ThreadProducer thread_producer;
+
+	bool use_producer_pages = false;
+	Producer *producers[MAX_PRODUCERS] = {};
+	SafeNumeric<uint32_t> producer_count;
+	SafeNumeric<uint32_t> producer_pages_used;
+	SafeNumeric<uint32_t> pages_in_use; // Shared and producer pages holding messages, both count against max_pages.
+	SafeNumeric<uint32_t> sequence;
+
+	uint64_t frame_flushed_messages = 0;
+	uint64_t frame_flushed_bytes = 0;
+	uint64_t last_frame_flushed_messages = 0;
+	uint64_t last_frame_flushed_bytes = 0;
+
+	static _FORCE_INLINE_ ProducerPageHeader *_get_producer_page_header(Page *p_page) {
+		return (ProducerPageHeader *)p_page->data;
+	}
+
+	Page *_alloc_producer_page();
+	void _free_producer_page(Page *p_page);
+	Producer *_get_thread_producer();
+	uint8_t *_producer_reserve(Producer *p_producer, uint32_t p_room);
+	void _producer_commit(Producer *p_producer, uint32_t p_room);
+	Message *_producer_peek(Producer *p_producer);
+	static void _release_producer(Producer *p_producer);
+	bool _should_use_producer_pages() const;
+	static uint32_t _get_message_size(const Message *p_message);
+	static void _clear_message(Message *p_message);
+
 	_FORCE_INLINE_ void _ensure_first_page() {
 		if (unlikely(pages.is_empty())) {
 			pages.push_back(allocator->alloc());
@@ -98,7 +162,15 @@ private:
 		}
 	}
 
-	void _add_page();
+	_FORCE_INLINE_ bool _reserve_page() {
+		if (pages_in_use.increment() > max_pages) {
+			pages_in_use.decrement();
+			return false;
+		}
+		return true;
+	}
+
+	bool _add_page();
 
 	void _call_function(const Callable &p_callable, const Variant *p_args, int p_argcount, bool p_show_error);
 
@@ -153,6 +225,11 @@ public:
 	bool is_flushing() const;
 	int get_max_buffer_usage() const;
 
+	// Messages and bytes flushed during the last frame.
+	void update_frame_statistics();
+	uint64_t get_frame_flushed_messages() const { return last_frame_flushed_messages; }
+	uint64_t get_frame_flushed_bytes() const { return last_frame_flushed_bytes; }
+
 	CallQueue(Allocator *p_custom_allocator = 0, uint32_t p_max_pages = 8192, const String &p_error_text = String());
 	virtual ~CallQueue();
 };
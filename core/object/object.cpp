@@ -1074,8 +1074,10 @@ void Object::add_user_signal(const MethodInfo &p_signal) {
 	ERR_FAIL_COND_MSG(ClassDB::has_signal(get_class_name(), p_signal.name), "User signal's name conflicts with a built-in signal of '" + get_class_name() + "'.");
 	ERR_FAIL_COND_MSG(signal_map.has(p_signal.name), "Trying to add already existing signal '" + p_signal.name + "'.");
 	SignalData s;
+	s.name = p_signal.name;
 	s.user = p_signal;
 	signal_map[p_signal.name] = s;
+	_signal_map_changed();
 }
 
 bool Object::_has_user_signal(const StringName &p_name) const {
@@ -1097,6 +1099,7 @@ void Object::_remove_user_signal(const StringName &p_name) {
 	}
 
 	signal_map.erase(p_name);
+	_signal_map_changed();
 }
 
 Error Object::_emit_signal(const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
@@ -1127,12 +1130,23 @@ Error Object::_emit_signal(const Variant **p_args, int p_argcount, Callable::Cal
 	return emit_signalp(signal, args, argc);
 }
 
+static _FORCE_INLINE_ uint64_t _signal_mask_bit(const StringName &p_name) {
+	return uint64_t(1) << (p_name.hash() & 63);
+}
+
 Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int p_argcount) {
 	if (_block_signals) {
 		return ERR_CANT_ACQUIRE_RESOURCE; //no emit, signals blocked
 	}
 
-	SignalData *s = signal_map.getptr(p_name);
+	// Most emissions repeat the previous signal or have no connections at all.
+	SignalData *s = emit_cache.load(std::memory_order_relaxed);
+	if (!s || s->name != p_name) {
+		s = (signal_map_mask & _signal_mask_bit(p_name)) ? signal_map.getptr(p_name) : nullptr;
+		if (s) {
+			emit_cache.store(s, std::memory_order_relaxed);
+		}
+	}
 	if (!s) {
 #ifdef DEBUG_ENABLED
 		bool signal_is_valid = ClassDB::has_signal(get_class_name(), p_name);
@@ -1149,29 +1163,24 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 
 	// Ensure that disconnecting the signal or even deleting the object
 	// will not affect the signal calling.
-	Callable *slot_callables = (Callable *)alloca(sizeof(Callable) * s->slot_map.size());
-	uint32_t *slot_flags = (uint32_t *)alloca(sizeof(uint32_t) * s->slot_map.size());
-	uint32_t slot_count = 0;
-
-	for (const KeyValue<Callable, SignalData::Slot> &slot_kv : s->slot_map) {
-		memnew_placement(&slot_callables[slot_count], Callable(slot_kv.value.conn.callable));
-		slot_flags[slot_count] = slot_kv.value.conn.flags;
-		++slot_count;
+	if (s->emit_slots_dirty) {
+		_update_emit_slots(s);
 	}
-
-	DEV_ASSERT(slot_count == s->slot_map.size());
+	const Hector<SignalData::EmitSlot> slots = s->emit_slots;
+	const SignalData::EmitSlot *slot_ptr = slots.ptr();
+	uint32_t slot_count = slots.size();
 
 	// Disconnect all one-shot connections before emitting to prevent recursion.
 	for (uint32_t i = 0; i < slot_count; ++i) {
-		bool disconnect = slot_flags[i] & CONNECT_ONE_SHOT;
+		bool disconnect = slot_ptr[i].flags & CONNECT_ONE_SHOT;
 #ifdef TOOLS_ENABLED
-		if (disconnect && (slot_flags[i] & CONNECT_PERSIST) && Engine::get_singleton()->is_editor_hint()) {
+		if (disconnect && (slot_ptr[i].flags & CONNECT_PERSIST) && Engine::get_singleton()->is_editor_hint()) {
 			// This signal was connected from the editor, and is being edited. Just don't disconnect for now.
 			disconnect = false;
 		}
 #endif
 		if (disconnect) {
-			_disconnect(p_name, slot_callables[i]);
+			_disconnect(p_name, slot_ptr[i].callable);
 		}
 	}
 
@@ -1180,10 +1189,19 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 	Error err = OK;
 
 	for (uint32_t i = 0; i < slot_count; ++i) {
-		const Callable &callable = slot_callables[i];
-		const uint32_t &flags = slot_flags[i];
-
-		if (!callable.is_valid()) {
+		const Callable &callable = slot_ptr[i].callable;
+		const uint32_t &flags = slot_ptr[i].flags;
+
+		if (slot_ptr[i].method) {
+			Object *target = ObjectDB::get_instance(callable.get_object_id());
+			if (!target) {
+				// Target might have been deleted during signal callback, this is expected and OK.
+				continue;
+			}
+			if (!target->script_instance && _emit_validated_call(target, slot_ptr[i].method, p_args, p_argcount)) {
+				continue;
+			}
+		} else if (!callable.is_valid()) {
 			// Target might have been deleted during signal callback, this is expected and OK.
 			continue;
 		}
@@ -1217,11 +1235,79 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		}
 	}
 
-	for (uint32_t i = 0; i < slot_count; ++i) {
-		slot_callables[i].~Callable();
+	return err;
+}
+
+void Object::_signal_map_changed() {
+	// Erasing and inserting may move the entries, and erasing may clear bits of the mask.
+	emit_cache.store(nullptr, std::memory_order_relaxed);
+	signal_map_mask = 0;
+	for (const KeyValue<StringName, SignalData> &E : signal_map) {
+		signal_map_mask |= _signal_mask_bit(E.key);
 	}
+}
 
-	return err;
+// Objects and typed containers are checked and converted by callp(), which validated_call() skips.
+static bool _has_plain_argument_types(const MethodBind *p_method) {
+	for (int i = 0; i < p_method->get_argument_count(); i++) {
+		const PropertyInfo info = p_method->get_argument_info(i);
+		if (info.type == Variant::OBJECT || info.hint == PROPERTY_HINT_ARRAY_TYPE || info.hint == PROPERTY_HINT_DICTIONARY_TYPE) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void Object::_update_emit_slots(SignalData *p_signal) {
+	p_signal->emit_slots.resize(p_signal->slot_map.size());
+	SignalData::EmitSlot *slot_ptr = p_signal->emit_slots.ptrw();
+
+	for (const KeyValue<Callable, SignalData::Slot> &slot_kv : p_signal->slot_map) {
+		const Connection &conn = slot_kv.value.conn;
+		slot_ptr->callable = conn.callable;
+		slot_ptr->flags = conn.flags;
+		slot_ptr->method = nullptr;
+
+		// Connections to native methods without bound arguments can skip the method lookup
+		// and the argument conversions, as long as the target has no script and every argument
+		// is passed with the exact type of its parameter.
+		if (conn.callable.is_standard() && !(conn.flags & CONNECT_DEFERRED)) {
+			Object *target = conn.callable.get_object();
+			if (target) {
+				MethodBind *method = ClassDB::get_method(target->get_class_name(), conn.callable.get_method());
+				if (method && !method->is_vararg() && !method->has_return() && _has_plain_argument_types(method)) {
+					slot_ptr->method = method;
+				}
+			}
+		}
+		slot_ptr++;
+	}
+
+	p_signal->emit_slots_dirty = false;
+}
+
+bool Object::_emit_validated_call(Object *p_target, MethodBind *p_method, const Variant **p_args, int p_argcount) {
+	if (p_method->get_argument_count() != p_argcount) {
+		return false;
+	}
+
+	for (int i = 0; i < p_argcount; i++) {
+		Variant::Type type = p_method->get_argument_type(i);
+		if (type == Variant::NIL) {
+			continue; // Takes any Variant.
+		}
+		if (p_args[i]->get_type() != type) {
+			return false; // Needs a conversion, leave it to the regular call.
+		}
+	}
+
+#ifdef DEBUG_ENABLED
+	_ObjectDebugLock target_lock(p_target);
+#endif
+	_emitting = true;
+	p_method->validated_call(p_target, p_args, nullptr);
+	_emitting = false;
+	return true;
 }
 
 void Object::_add_user_signal(const String &p_name, const Array &p_args) {
@@ -1404,6 +1490,8 @@ Error Object::connect(const StringName &p_signal, const Callable &p_callable, ui
 
 		signal_map[p_signal] = SignalData();
 		s = &signal_map[p_signal];
+		s->name = p_signal;
+		_signal_map_changed();
 	}
 
 	//compare with the base callable, so binds can be ignored
@@ -1434,6 +1522,8 @@ Error Object::connect(const StringName &p_signal, const Callable &p_callable, ui
 
 	//use callable version as key, so binds can be ignored
 	s->slot_map[*p_callable.get_base_comparator()] = slot;
+	s->emit_slots.clear();
+	s->emit_slots_dirty = true;
 
 	return OK;
 }
@@ -1509,10 +1599,13 @@ bool Object::_disconnect(const StringName &p_signal, const Callable &p_callable,
 	}
 
 	s->slot_map.erase(*p_callable.get_base_comparator());
+	s->emit_slots.clear();
+	s->emit_slots_dirty = true;
 
 	if (s->slot_map.is_empty() && ClassDB::has_signal(get_class_name(), p_signal)) {
 		//not user signal, delete
 		signal_map.erase(p_signal);
+		_signal_map_changed();
 	}
 
 	return true;
@@ -2146,6 +2239,7 @@ Object::~Object() {
 
 		signal_map.erase(E.key);
 	}
+	_signal_map_changed();
 
 	// Disconnect signals that connect to this object.
 	while (connections.size()) {
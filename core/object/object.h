@@ -36,6 +36,7 @@
 #include "core/object/object_id.h"
 #include "core/os/rw_lock.h"
 #include "core/os/spin_lock.h"
+#include "core/templates/a_hash_map.h"
 #include "core/templates/hash_map.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
@@ -604,12 +605,28 @@ private:
 			List<Connection>::Element *cE = nullptr;
 		};
 
+		struct EmitSlot {
+			Callable callable;
+			uint32_t flags = 0;
+			MethodBind *method = nullptr; // Native method of the target without Object or typed container parameters, called with validated_call() when the argument types match.
+		};
+
+		StringName name;
 		MethodInfo user;
 		HashMap<Callable, Slot, HashableHasher<Callable>> slot_map;
+		// Snapshot of slot_map, rebuilt on the first emission after a connection changed.
+		// Emitting holds a reference to it, so connecting and disconnecting while emitting is safe.
+		Hector<EmitSlot> emit_slots;
+		bool emit_slots_dirty = true;
 		bool removable = false;
 	};
 
-	HashMap<StringName, SignalData> signal_map;
+	AHashMap<StringName, SignalData> signal_map;
+	// Lets emit_signalp() skip the signal_map lookup: a bit per name hash to reject
+	// signals without an entry, and the entry found by the last emission.
+	// Both are reset by _signal_map_changed() whenever entries are added or removed.
+	uint64_t signal_map_mask = 0;
+	std::atomic<SignalData *> emit_cache = nullptr;
 	List<Connection> connections;
 #ifdef DEBUG_ENABLED
 	SafeRefCount _lock_index;
@@ -622,6 +639,9 @@ private:
 	void _postinitialize();
 	bool _can_translate = true;
 	bool _emitting = false;
+	void _signal_map_changed();
+	void _update_emit_slots(SignalData *p_signal);
+	bool _emit_validated_call(Object *p_target, MethodBind *p_method, const Variant **p_args, int p_argcount);
 #ifdef TOOLS_ENABLED
 	bool _edited = false;
 	uint32_t _edited_version = 0;
@@ -920,6 +940,20 @@ public:
 		return emit_signalp(p_name, sizeof...(p_args) == 0 ? nullptr : (const Variant **)argptrs, sizeof...(p_args));
 	}
 
+	// Same as emit_signal(), but the arguments are converted to the given types first,
+	// so native receivers declared with those types can be called without conversion.
+	// The types are not checked against the signal's declaration; they must match it.
+	// For example: `emit_typed_signal<double>(SceneStringName(value_changed), value)`.
+	template <typename... P>
+	Error emit_typed_signal(const StringName &p_name, const std::decay_t<P> &...p_args) { // Not deduced, P must be given.
+		const Variant args[sizeof...(P) + 1] = { Variant(p_args)..., Variant() }; // +1 makes sure zero sized arrays are also supported.
+		const Variant *argptrs[sizeof...(P) + 1];
+		for (uint32_t i = 0; i < sizeof...(P); i++) {
+			argptrs[i] = &args[i];
+		}
+		return emit_signalp(p_name, sizeof...(P) == 0 ? nullptr : (const Variant **)argptrs, sizeof...(P));
+	}
+
 	MTVIRTUAL Error emit_signalp(const StringName &p_name, const Variant **p_args, int p_argcount);
 	MTVIRTUAL bool has_signal(const StringName &p_name) const;
 	MTVIRTUAL void get_signal_list(List<MethodInfo> *p_signals) const;
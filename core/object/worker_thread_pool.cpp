@@ -30,6 +30,9 @@
 
 #include "worker_thread_pool.h"
 
+#include "core/debugger/engine_debugger.h"
+#include "core/io/file_access.h"
+
 #include "core/object/script_language.h"
 #include "core/os/os.h"
 #include "core/os/safe_binary_mutex.h"
@@ -44,6 +47,44 @@ void WorkerThreadPool::Task::free_template_userdata() {
 	memdelete(btu);
 }
 
+void WorkerThreadPool::TaskDeque::push(Task *p_task) {
+	lock.lock();
+	tasks.push_back(p_task);
+	count.increment();
+	lock.unlock();
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::TaskDeque::pop() {
+	Task *task = nullptr;
+	lock.lock();
+	if (head < tasks.size()) {
+		task = tasks[tasks.size() - 1];
+		tasks.resize(tasks.size() - 1);
+		if (head == tasks.size()) {
+			head = 0;
+			tasks.clear();
+		}
+		count.decrement();
+	}
+	lock.unlock();
+	return task;
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::TaskDeque::steal() {
+	Task *task = nullptr;
+	lock.lock();
+	if (head < tasks.size()) {
+		task = tasks[head++];
+		if (head == tasks.size()) {
+			head = 0;
+			tasks.clear();
+		}
+		count.decrement();
+	}
+	lock.unlock();
+	return task;
+}
+
 WorkerThreadPool *WorkerThreadPool::singleton = nullptr;
 
 #ifdef THREADS_ENABLED
@@ -83,30 +124,53 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 
 #ifdef THREADS_ENABLED
 	bool low_priority = p_task->low_priority;
+
+	// Groups and their tasks may be gone by the time the event is recorded.
+	bool trace = tracing.is_set();
+	TaskID trace_task = INVALID_TASK_ID;
+	uint64_t trace_begin = 0;
+	uint64_t trace_queued = 0;
+	if (unlikely(trace)) {
+		trace_task = p_task->group ? p_task->group->self : p_task->self;
+		trace_begin = OS::get_singleton()->get_ticks_usec();
+		trace_queued = p_task->post_usec ? trace_begin - p_task->post_usec : 0;
+	}
+	uint32_t trace_description = p_task->trace_description;
 #endif
 
+	LocalHector<Task *> released_tasks;
+
 	if (p_task->group) {
 		// Handling a group
+		Group *group = p_task->group;
 		bool do_post = false;
 
 		while (true) {
-			uint32_t work_index = p_task->group->index.postincrement();
+			// Claim a range of elements. Ranges start large and shrink as fewer elements remain,
+			// so there are few atomic operations and threads finishing early still balance the load.
+			uint32_t remaining = group->max - MIN(group->index.get(), group->max);
+			uint32_t chunk = MAX(1u, remaining / (group->tasks_used * 2));
+			uint32_t from = group->index.postadd(chunk);
 
-			if (work_index >= p_task->group->max) {
+			if (from >= group->max) {
 				break;
 			}
-			if (p_task->native_group_func) {
-				p_task->native_group_func(p_task->native_func_userdata, work_index);
-			} else if (p_task->template_userdata) {
-				p_task->template_userdata->callback_indexed(work_index);
-			} else {
-				p_task->callable.call(work_index);
+			uint32_t to = MIN(from + chunk, group->max);
+
+			for (uint32_t work_index = from; work_index < to; work_index++) {
+				if (p_task->native_group_func) {
+					p_task->native_group_func(p_task->native_func_userdata, work_index);
+				} else if (p_task->template_userdata) {
+					p_task->template_userdata->callback_indexed(work_index);
+				} else {
+					p_task->callable.call(work_index);
+				}
 			}
 
 			// This is the only way to ensure posting is done when all tasks are really complete.
-			uint32_t completed_amount = p_task->group->completed_index.increment();
+			uint32_t completed_amount = group->completed_index.add(to - from);
 
-			if (completed_amount == p_task->group->max) {
+			if (completed_amount == group->max) {
 				do_post = true;
 			}
 		}
@@ -155,10 +219,22 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 				threads[i].signaled = true;
 			}
 		}
+		// Tasks that were only waiting for this one are posted below, once the state is restored.
+		for (Task *continuation : p_task->continuations) {
+			continuation->pending_dependencies--;
+			if (continuation->pending_dependencies == 0) {
+				released_tasks.push_back(continuation);
+			}
+		}
+		p_task->continuations.clear();
 	}
 
 #ifdef THREADS_ENABLED
 	{
+		if (unlikely(trace)) {
+			_record_trace_event(&curr_thread, TRACE_EVENT_TASK, trace_task, trace_description, trace_begin, trace_queued);
+		}
+
 		curr_thread.current_task = prev_task;
 		if (low_priority) {
 			low_priority_threads_used--;
@@ -176,14 +252,49 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 	set_current_thread_safe_for_nodes(safe_for_nodes_backup);
 	MessageQueue::set_thread_singleton_override(call_queue_backup);
 #endif
+
+	if (!released_tasks.is_empty()) {
+		MutexLock<BinaryMutex> lock(task_mutex);
+		for (Task *task : released_tasks) {
+			_post_tasks(&task, 1, !task->low_priority, lock);
+		}
+	}
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::_take_deque_task(ThreadData *p_thread_data) {
+	if (p_thread_data->deque.count.get()) {
+		Task *task = p_thread_data->deque.pop();
+		if (task) {
+			deque_task_count.decrement();
+			return task;
+		}
+	}
+
+	if (!deque_task_count.get()) {
+		return nullptr;
+	}
+
+	uint32_t thread_count = threads.size();
+	for (uint32_t i = 1; i < thread_count; i++) {
+		TaskDeque &victim = threads[(p_thread_data->index + i) % thread_count].deque;
+		if (victim.count.get()) {
+			Task *task = victim.steal();
+			if (task) {
+				deque_task_count.decrement();
+				return task;
+			}
+		}
+	}
+
+	return nullptr;
 }
 
 void WorkerThreadPool::_thread_function(void *p_user) {
 	ThreadData *thread_data = (ThreadData *)p_user;
 
 	while (true) {
-		Task *task_to_process = nullptr;
-		{
+		Task *task_to_process = singleton->_take_deque_task(thread_data);
+		if (!task_to_process) {
 			MutexLock lock(singleton->task_mutex);
 
 			bool exit = singleton->_handle_runlevel(thread_data, lock);
@@ -196,8 +307,12 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 			if (singleton->task_queue.first()) {
 				task_to_process = singleton->task_queue.first()->self();
 				singleton->task_queue.remove(singleton->task_queue.first());
-			} else {
+			} else if (!singleton->deque_task_count.get()) {
+				uint64_t idle_begin = singleton->tracing.is_set() ? OS::get_singleton()->get_ticks_usec() : 0;
 				thread_data->cond_var.wait(lock);
+				if (idle_begin) {
+					singleton->_record_trace_event(thread_data, TRACE_EVENT_IDLE, INVALID_TASK_ID, 0, idle_begin);
+				}
 			}
 		}
 
@@ -230,9 +345,20 @@ void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high
 
 	ThreadData *caller_pool_thread = thread_ids.has(Thread::get_caller_id()) ? &threads[thread_ids[Thread::get_caller_id()]] : nullptr;
 
+	if (tracing.is_set()) {
+		uint64_t now = OS::get_singleton()->get_ticks_usec();
+		for (uint32_t i = 0; i < p_count; i++) {
+			p_tasks[i]->post_usec = now;
+		}
+	}
+
 	for (uint32_t i = 0; i < p_count; i++) {
 		p_tasks[i]->low_priority = !p_high_priority;
-		if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
+		if (p_high_priority && caller_pool_thread) {
+			caller_pool_thread->deque.push(p_tasks[i]);
+			deque_task_count.increment();
+			to_process++;
+		} else if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
 			task_queue.add_last(&p_tasks[i]->task_elem);
 			if (!p_high_priority) {
 				low_priority_threads_used++;
@@ -328,7 +454,7 @@ WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *
 	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description);
 }
 
-WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description) {
+WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, const TaskID *p_dependencies, uint32_t p_dependency_count) {
 	MutexLock<BinaryMutex> lock(task_mutex);
 
 	// Get a free task
@@ -340,9 +466,26 @@ WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable,
 	task->native_func_userdata = p_userdata;
 	task->description = p_description;
 	task->template_userdata = p_template_userdata;
+	if (tracing.is_set()) {
+		task->trace_description = _get_trace_description(p_description);
+	}
 	tasks.insert(id, task);
 
-	_post_tasks(&task, 1, p_high_priority, lock);
+	for (uint32_t i = 0; i < p_dependency_count; i++) {
+		// Tasks already waited for are gone, so they are complete too.
+		Task **dependency = tasks.getptr(p_dependencies[i]);
+		if (dependency && !(*dependency)->completed) {
+			(*dependency)->continuations.push_back(task);
+			task->pending_dependencies++;
+		}
+	}
+
+	if (task->pending_dependencies) {
+		// Posted by the last dependency to complete.
+		task->low_priority = !p_high_priority;
+	} else {
+		_post_tasks(&task, 1, p_high_priority, lock);
+	}
 
 	return id;
 }
@@ -351,6 +494,14 @@ WorkerThreadPool::TaskID WorkerThreadPool::add_task(const Callable &p_action, bo
 	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description);
 }
 
+WorkerThreadPool::TaskID WorkerThreadPool::add_native_task_with_dependencies(void (*p_func)(void *), void *p_userdata, const Hector<TaskID> &p_dependencies, bool p_high_priority, const String &p_description) {
+	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description, p_dependencies.ptr(), p_dependencies.size());
+}
+
+WorkerThreadPool::TaskID WorkerThreadPool::add_task_with_dependencies(const Callable &p_action, const Hector<TaskID> &p_dependencies, bool p_high_priority, const String &p_description) {
+	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description, p_dependencies.ptr(), p_dependencies.size());
+}
+
 bool WorkerThreadPool::is_task_completed(TaskID p_task_id) const {
 	MutexLock task_lock(task_mutex);
 	const Task *const *taskp = tasks.getptr(p_task_id);
@@ -451,6 +602,7 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 
 	while (true) {
 		Task *task_to_process = nullptr;
+		bool take_deque_task = false;
 		bool relock_unlockables = false;
 		{
 			MutexLock lock(task_mutex);
@@ -479,7 +631,7 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				if (was_signaled) {
 					// This thread was awaken for some additional reason, but it's about to exit.
 					// Let's find out what may be pending and forward the requests.
-					uint32_t to_process = task_queue.first() ? 1 : 0;
+					uint32_t to_process = _has_queued_tasks() ? 1 : 0;
 					uint32_t to_promote = p_caller_pool_thread->current_task->low_priority && low_priority_task_queue.first() ? 1 : 0;
 					if (to_process || to_promote) {
 						// This thread must be left alone since it won't loop again.
@@ -497,18 +649,26 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				}
 			}
 
-			if (singleton->task_queue.first()) {
+			if (deque_task_count.get()) {
+				// The awaited task may well be in the deque of this thread.
+				take_deque_task = true;
+			} else if (singleton->task_queue.first()) {
 				task_to_process = task_queue.first()->self();
 				task_queue.remove(task_queue.first());
 			}
 
-			if (!task_to_process) {
+			if (!task_to_process && !take_deque_task) {
 				p_caller_pool_thread->awaited_task = p_task;
 
 				_unlock_unlockable_mutexes();
 				relock_unlockables = true;
 
+				uint64_t wait_begin = tracing.is_set() ? OS::get_singleton()->get_ticks_usec() : 0;
 				p_caller_pool_thread->cond_var.wait(lock);
+				if (wait_begin) {
+					bool yielding = p_task == ThreadData::YIELDING;
+					_record_trace_event(p_caller_pool_thread, TRACE_EVENT_WAIT, yielding ? TaskID(INVALID_TASK_ID) : p_task->self, yielding ? 0 : p_task->trace_description, wait_begin);
+				}
 
 				p_caller_pool_thread->awaited_task = nullptr;
 			}
@@ -518,6 +678,10 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 			_lock_unlockable_mutexes();
 		}
 
+		if (take_deque_task) {
+			task_to_process = _take_deque_task(p_caller_pool_thread);
+		}
+
 		if (task_to_process) {
 			_process_task(task_to_process);
 		}
@@ -543,7 +707,7 @@ bool WorkerThreadPool::_handle_runlevel(ThreadData *p_thread_data, MutexLock<Bin
 		} break;
 		case RUNLEVEL_PRE_EXIT_LANGUAGES: {
 			if (!p_thread_data->pre_exited_languages) {
-				if (!task_queue.first() && !low_priority_task_queue.first()) {
+				if (!_has_queued_tasks() && !low_priority_task_queue.first()) {
 					p_thread_data->pre_exited_languages = true;
 					runlevel_data.pre_exit_languages.num_idle_threads++;
 					control_cond_var.notify_all();
@@ -633,6 +797,7 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 	} else {
 		group->tasks_used = p_tasks;
 		tasks_posted = (Task **)alloca(sizeof(Task *) * p_tasks);
+		uint32_t trace_description = tracing.is_set() ? _get_trace_description(p_description) : 0;
 		for (int i = 0; i < p_tasks; i++) {
 			Task *task = task_allocator.alloc();
 			task->native_group_func = p_func;
@@ -641,6 +806,7 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 			task->group = group;
 			task->callable = p_callable;
 			task->template_userdata = p_template_userdata;
+			task->trace_description = trace_description;
 			tasks_posted[i] = task;
 			// No task ID is used.
 		}
@@ -763,6 +929,9 @@ void WorkerThreadPool::init(int p_thread_count, float p_low_priority_task_ratio)
 	print_verbose(vformat("WorkerThreadPool: %d threads, %d max low-priority.", p_thread_count, max_low_priority_threads));
 
 	threads.resize(p_thread_count);
+	if (tracing.is_set()) {
+		_allocate_trace_buffers();
+	}
 
 	for (uint32_t i = 0; i < threads.size(); i++) {
 		threads[i].index = i;
@@ -818,11 +987,221 @@ void WorkerThreadPool::finish() {
 		}
 	}
 
+	for (ThreadData &data : threads) {
+		if (data.trace.events) {
+			memdelete_arr(data.trace.events);
+		}
+	}
+
 	threads.clear();
 }
 
+uint32_t WorkerThreadPool::_get_trace_description(const String &p_description) {
+	if (p_description.is_empty()) {
+		return 0;
+	}
+	uint32_t *id = trace_description_ids.getptr(p_description);
+	if (id) {
+		return *id;
+	}
+	if (trace_descriptions.is_empty()) {
+		trace_descriptions.push_back(String()); // Index zero means no description.
+	}
+	uint32_t new_id = trace_descriptions.size();
+	trace_descriptions.push_back(p_description);
+	trace_description_ids.insert(p_description, new_id);
+	return new_id;
+}
+
+void WorkerThreadPool::_allocate_trace_buffers() {
+	for (ThreadData &data : threads) {
+		if (!data.trace.events) {
+			data.trace.events = memnew_arr(TraceEvent, TRACE_BUFFER_SIZE);
+		}
+	}
+}
+
+void WorkerThreadPool::_record_trace_event(ThreadData *p_thread_data, TraceEventType p_type, TaskID p_task, uint32_t p_description, uint64_t p_begin_usec, uint64_t p_queued_usec) {
+	TraceBuffer &trace = p_thread_data->trace;
+	uint64_t index = trace.written.get();
+	TraceEvent &event = trace.events[index & (TRACE_BUFFER_SIZE - 1)];
+	event.begin_usec = p_begin_usec;
+	event.end_usec = OS::get_singleton()->get_ticks_usec();
+	event.queued_usec = p_queued_usec;
+	event.task = p_task;
+	event.description = p_description;
+	event.type = p_type;
+	trace.written.set(index + 1);
+}
+
+void WorkerThreadPool::_read_trace_events(const ThreadData &p_thread_data, uint64_t &r_from, LocalHector<TraceEvent> &r_events) const {
+	const TraceBuffer &trace = p_thread_data.trace;
+	if (!trace.events) {
+		return;
+	}
+
+	uint64_t written = trace.written.get();
+	uint64_t from = MAX(r_from, written > TRACE_BUFFER_SIZE ? written - TRACE_BUFFER_SIZE : 0);
+	uint32_t base = r_events.size();
+	for (uint64_t i = from; i < written; i++) {
+		r_events.push_back(trace.events[i & (TRACE_BUFFER_SIZE - 1)]);
+	}
+	r_from = written;
+
+	// The owner thread may have reused the oldest slots while they were being copied,
+	// including the one it is writing right now.
+	uint64_t valid_from = trace.written.get() + 1;
+	valid_from = valid_from > TRACE_BUFFER_SIZE ? valid_from - TRACE_BUFFER_SIZE : 0;
+	if (valid_from > from) {
+		uint32_t skip = MIN(valid_from, written) - from;
+		for (uint32_t i = base; i + skip < r_events.size(); i++) {
+			r_events[i] = r_events[i + skip];
+		}
+		r_events.resize(r_events.size() - skip);
+	}
+}
+
+void WorkerThreadPool::set_tracing_enabled(bool p_enabled) {
+	MutexLock lock(task_mutex);
+	if (p_enabled) {
+		// Buffers are only freed by finish(), as threads may still be recording.
+		_allocate_trace_buffers();
+	}
+	tracing.set_to(p_enabled);
+}
+
+Error WorkerThreadPool::save_trace(const String &p_path) {
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(f.is_null(), err, vformat("Cannot open file '%s' to save the task trace.", p_path));
+
+	Hector<String> descriptions;
+	{
+		MutexLock lock(task_mutex);
+		descriptions = trace_descriptions;
+	}
+
+	// Chrome trace event format, which can be loaded in chrome://tracing or Perfetto.
+	f->store_string("{\"traceEvents\":[\n");
+	f->store_string("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,\"args\":{\"name\":\"WorkerThreadPool\"}}");
+	for (uint32_t i = 0; i < threads.size(); i++) {
+		f->store_string(vformat(",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%d,\"args\":{\"name\":\"Worker %d\"}}", i, i));
+	}
+
+	LocalHector<TraceEvent> events;
+	for (uint32_t i = 0; i < threads.size(); i++) {
+		uint64_t from = 0;
+		events.clear();
+		_read_trace_events(threads[i], from, events);
+
+		for (const TraceEvent &event : events) {
+			String description = event.description < (uint32_t)descriptions.size() ? descriptions[event.description] : String();
+			String name;
+			String category;
+			String args;
+			switch (event.type) {
+				case TRACE_EVENT_TASK: {
+					name = description.is_empty() ? String("Task") : description;
+					category = "task";
+					args = vformat("\"id\":%d,\"queued_usec\":%d", event.task, event.queued_usec);
+				} break;
+				case TRACE_EVENT_WAIT: {
+					name = event.task == INVALID_TASK_ID ? String("Yield") : "Wait: " + (description.is_empty() ? String("Task") : description);
+					category = "wait";
+					args = vformat("\"awaited_id\":%d", event.task);
+				} break;
+				case TRACE_EVENT_IDLE: {
+					name = "Idle";
+					category = "idle";
+				} break;
+			}
+			f->store_string(vformat(",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%d,\"dur\":%d,\"pid\":0,\"tid\":%d,\"args\":{%s}}",
+					name.json_escape(), category, event.begin_usec, event.end_usec - event.begin_usec, i, args));
+		}
+	}
+
+	f->store_string("\n],\"displayTimeUnit\":\"ms\"}\n");
+	return OK;
+}
+
+void WorkerThreadPool::update_frame_profile() {
+	bool profiling = EngineDebugger::is_profiling("servers");
+	if (profiling != tracing_for_profiler) {
+		tracing_for_profiler = profiling;
+		if (profiling && !tracing.is_set()) {
+			set_tracing_enabled(true);
+			profiler_enabled_tracing = true;
+		} else if (!profiling && profiler_enabled_tracing) {
+			set_tracing_enabled(false);
+			profiler_enabled_tracing = false;
+		}
+		// Don't report what was traced before profiling started.
+		for (ThreadData &data : threads) {
+			data.trace.profiled = data.trace.written.get();
+		}
+		return;
+	}
+	if (!profiling) {
+		return;
+	}
+
+	Hector<String> descriptions;
+	{
+		MutexLock lock(task_mutex);
+		descriptions = trace_descriptions;
+	}
+
+	LocalHector<TraceEvent> events;
+	for (ThreadData &data : threads) {
+		_read_trace_events(data, data.trace.profiled, events);
+	}
+
+	// Nested tasks run by collaborative waits are counted in the time of the waiting task too.
+	HashMap<uint32_t, uint64_t> task_time;
+	uint64_t queued_time = 0;
+	uint64_t wait_time = 0;
+	uint64_t idle_time = 0;
+	for (const TraceEvent &event : events) {
+		uint64_t time = event.end_usec - event.begin_usec;
+		switch (event.type) {
+			case TRACE_EVENT_TASK: {
+				uint64_t *total = task_time.getptr(event.description);
+				if (total) {
+					*total += time;
+				} else {
+					task_time.insert(event.description, time);
+				}
+				queued_time += event.queued_usec;
+			} break;
+			case TRACE_EVENT_WAIT: {
+				wait_time += time;
+			} break;
+			case TRACE_EVENT_IDLE: {
+				idle_time += time;
+			} break;
+		}
+	}
+
+	Array values;
+	for (const KeyValue<uint32_t, uint64_t> &E : task_time) {
+		String description = E.key < (uint32_t)descriptions.size() ? descriptions[E.key] : String();
+		values.push_back(description.is_empty() ? String("Unnamed Tasks") : description);
+		values.push_back(USEC_TO_SEC(E.value));
+	}
+	values.push_back("Queue Wait");
+	values.push_back(USEC_TO_SEC(queued_time));
+	values.push_back("Collaborative Wait");
+	values.push_back(USEC_TO_SEC(wait_time));
+	values.push_back("Idle");
+	values.push_back(USEC_TO_SEC(idle_time));
+
+	values.push_front("worker_thread_pool");
+	EngineDebugger::profiler_add_frame_data("servers", values);
+}
+
 void WorkerThreadPool::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("add_task", "action", "high_priority", "description"), &WorkerThreadPool::add_task, DEFVAL(false), DEFVAL(String()));
+	ClassDB::bind_method(D_METHOD("add_task_with_dependencies", "action", "dependencies", "high_priority", "description"), &WorkerThreadPool::add_task_with_dependencies, DEFVAL(false), DEFVAL(String()));
 	ClassDB::bind_method(D_METHOD("is_task_completed", "task_id"), &WorkerThreadPool::is_task_completed);
 	ClassDB::bind_method(D_METHOD("wait_for_task_completion", "task_id"), &WorkerThreadPool::wait_for_task_completion);
 
@@ -830,6 +1209,10 @@ void WorkerThreadPool::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("is_group_task_completed", "group_id"), &WorkerThreadPool::is_group_task_completed);
 	ClassDB::bind_method(D_METHOD("get_group_processed_element_count", "group_id"), &WorkerThreadPool::get_group_processed_element_count);
 	ClassDB::bind_method(D_METHOD("wait_for_group_task_completion", "group_id"), &WorkerThreadPool::wait_for_group_task_completion);
+
+	ClassDB::bind_method(D_METHOD("set_tracing_enabled", "enabled"), &WorkerThreadPool::set_tracing_enabled);
+	ClassDB::bind_method(D_METHOD("is_tracing_enabled"), &WorkerThreadPool::is_tracing_enabled);
+	ClassDB::bind_method(D_METHOD("save_trace", "path"), &WorkerThreadPool::save_trace);
 }
 
 WorkerThreadPool::WorkerThreadPool() {
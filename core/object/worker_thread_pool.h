@@ -35,6 +35,7 @@
 #include "core/os/memory.h"
 #include "core/os/os.h"
 #include "core/os/semaphore.h"
+#include "core/os/spin_lock.h"
 #include "core/os/thread.h"
 #include "core/templates/local_Hector.h"
 #include "core/templates/paged_allocator.h"
@@ -88,6 +89,10 @@ private:
 		bool low_priority = false;
 		BaseTemplateUserdata *template_userdata = nullptr;
 		int pool_thread_index = -1;
+		uint32_t pending_dependencies = 0; // Posted once it reaches zero.
+		LocalHector<Task *> continuations; // Tasks depending on this one.
+		uint64_t post_usec = 0; // Only set while tracing.
+		uint32_t trace_description = 0;
 
 		void free_template_userdata();
 		Task() :
@@ -107,6 +112,45 @@ private:
 
 	BinaryMutex task_mutex;
 
+	// High priority tasks posted from a pool thread go to a deque of its own. The owner
+	// takes the newest task, so nested work stays on the same thread, while idle threads
+	// steal the oldest one without going through task_mutex.
+	struct TaskDeque {
+		SpinLock lock;
+		LocalHector<Task *> tasks;
+		uint32_t head = 0;
+		SafeNumeric<uint32_t> count;
+
+		void push(Task *p_task);
+		Task *pop();
+		Task *steal();
+	};
+
+	enum TraceEventType : uint8_t {
+		TRACE_EVENT_TASK,
+		TRACE_EVENT_WAIT, // Blocked in a collaborative wait, with nothing else to process.
+		TRACE_EVENT_IDLE,
+	};
+
+	struct TraceEvent {
+		uint64_t begin_usec = 0;
+		uint64_t end_usec = 0;
+		uint64_t queued_usec = 0;
+		TaskID task = INVALID_TASK_ID; // Group ID for group tasks, awaited task for waits.
+		uint32_t description = 0;
+		TraceEventType type = TRACE_EVENT_TASK;
+	};
+
+	static const uint32_t TRACE_BUFFER_SIZE = 16384; // Must be a power of two.
+
+	// Only written by the owner thread, so events are recorded without any lock.
+	// Readers copy the events and discard the ones overwritten meanwhile.
+	struct TraceBuffer {
+		TraceEvent *events = nullptr;
+		SafeNumeric<uint64_t> written;
+		uint64_t profiled = 0; // Events already sent to the profiler.
+	};
+
 	struct ThreadData {
 		static Task *const YIELDING; // Too bad constexpr doesn't work here.
 
@@ -119,6 +163,8 @@ private:
 		Task *current_task = nullptr;
 		Task *awaited_task = nullptr; // Null if not awaiting the condition variable, or special value (YIELDING).
 		ConditionVariable cond_var;
+		TaskDeque deque;
+		TraceBuffer trace;
 
 		ThreadData() :
 				signaled(false),
@@ -166,15 +212,30 @@ private:
 
 	uint64_t last_task = 1;
 
+	SafeNumeric<uint32_t> deque_task_count; // Tasks in the deques of all threads, so idle threads know they can steal.
+
+	SafeFlag tracing;
+	bool tracing_for_profiler = false;
+	bool profiler_enabled_tracing = false;
+	HashMap<String, uint32_t> trace_description_ids; // Protected by task_mutex, like trace_descriptions.
+	Hector<String> trace_descriptions;
+
 	static void _thread_function(void *p_user);
 
 	void _process_task(Task *task);
+	Task *_take_deque_task(ThreadData *p_thread_data);
+	_FORCE_INLINE_ bool _has_queued_tasks() const { return task_queue.first() || deque_task_count.get(); }
 
 	void _post_tasks(Task **p_tasks, uint32_t p_count, bool p_high_priority, MutexLock<BinaryMutex> &p_lock);
 	void _notify_threads(const ThreadData *p_current_thread_data, uint32_t p_process_count, uint32_t p_promote_count);
 
 	bool _try_promote_low_priority_task();
 
+	uint32_t _get_trace_description(const String &p_description);
+	void _allocate_trace_buffers();
+	void _record_trace_event(ThreadData *p_thread_data, TraceEventType p_type, TaskID p_task, uint32_t p_description, uint64_t p_begin_usec, uint64_t p_queued_usec = 0);
+	void _read_trace_events(const ThreadData &p_thread_data, uint64_t &r_from, LocalHector<TraceEvent> &r_events) const;
+
 	static WorkerThreadPool *singleton;
 
 #ifdef THREADS_ENABLED
@@ -186,7 +247,7 @@ private:
 	static thread_local UnlockableLocks unlockable_locks[MAX_UNLOCKABLE_LOCKS];
 #endif
 
-	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description);
+	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, const TaskID *p_dependencies = nullptr, uint32_t p_dependency_count = 0);
 	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description);
 
 	template <typename C, typename M, typename U>
@@ -237,6 +298,20 @@ public:
 	TaskID add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority = false, const String &p_description = String());
 	TaskID add_task(const Callable &p_action, bool p_high_priority = false, const String &p_description = String());
 
+	// Tasks with dependencies are posted once all the tasks they depend on have completed,
+	// without any thread waiting for them. They can still be waited for like any other task.
+	template <typename C, typename M, typename U>
+	TaskID add_template_task_with_dependencies(C *p_instance, M p_method, U p_userdata, const Hector<TaskID> &p_dependencies, bool p_high_priority = false, const String &p_description = String()) {
+		typedef TaskUserData<C, M, U> TUD;
+		TUD *ud = memnew(TUD);
+		ud->instance = p_instance;
+		ud->method = p_method;
+		ud->userdata = p_userdata;
+		return _add_task(Callable(), nullptr, nullptr, ud, p_high_priority, p_description, p_dependencies.ptr(), p_dependencies.size());
+	}
+	TaskID add_native_task_with_dependencies(void (*p_func)(void *), void *p_userdata, const Hector<TaskID> &p_dependencies, bool p_high_priority = false, const String &p_description = String());
+	TaskID add_task_with_dependencies(const Callable &p_action, const Hector<TaskID> &p_dependencies, bool p_high_priority = false, const String &p_description = String());
+
 	bool is_task_completed(TaskID p_task_id) const;
 	Error wait_for_task_completion(TaskID p_task_id);
 
@@ -260,6 +335,13 @@ public:
 
 	_FORCE_INLINE_ int get_thread_count() const { return threads.size(); }
 
+	// Tracing records which task ran on which thread, how long it was queued, and the time
+	// pool threads spend blocked in collaborative waits or idle.
+	void set_tracing_enabled(bool p_enabled);
+	bool is_tracing_enabled() const { return tracing.is_set(); }
+	Error save_trace(const String &p_path);
+	void update_frame_profile();
+
 	static WorkerThreadPool *get_singleton() { return singleton; }
 	static int get_thread_index();
 	static TaskID get_caller_task_id();
@@ -31,6 +31,7 @@
 #include "memory.h"
 
 #include "core/error/error_macros.h"
+#include "core/os/small_object_allocator.h"
 #include "core/templates/safe_refcount.h"
 
 #include <stdio.h>
@@ -62,6 +63,7 @@ void operator delete(void *p_mem, void *p_pointer, size_t check, const char *p_d
 #ifdef DEBUG_ENABLED
 SafeNumeric<uint64_t> Memory::mem_usage;
 SafeNumeric<uint64_t> Memory::max_usage;
+SafeNumeric<uint64_t> Memory::alloc_total;
 #endif
 
 SafeNumeric<uint64_t> Memory::alloc_count;
@@ -98,6 +100,40 @@ void Memory::free_aligned_static(void *p_memory) {
 	free(p);
 }
 
+// Small blocks come from the SmallObjectAllocator, the rest from the system allocator.
+
+static _FORCE_INLINE_ void *_alloc_block(size_t p_bytes) {
+	void *mem = SmallObjectAllocator::alloc(p_bytes);
+	return mem ? mem : malloc(p_bytes);
+}
+
+static _FORCE_INLINE_ void _free_block(void *p_mem) {
+	if (!SmallObjectAllocator::free(p_mem)) {
+		free(p_mem);
+	}
+}
+
+static void *_realloc_block(void *p_mem, size_t p_bytes) {
+	size_t block_size = SmallObjectAllocator::get_block_size(p_mem);
+	if (block_size == 0) {
+		return realloc(p_mem, p_bytes);
+	}
+	if (p_bytes == 0) {
+		SmallObjectAllocator::free(p_mem);
+		return nullptr;
+	}
+	if (p_bytes <= block_size && p_bytes > block_size / 2) {
+		return p_mem; // Still a good fit.
+	}
+
+	void *mem = _alloc_block(p_bytes);
+	if (mem) {
+		memcpy(mem, p_mem, MIN(block_size, p_bytes));
+		SmallObjectAllocator::free(p_mem);
+	}
+	return mem;
+}
+
 void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 #ifdef DEBUG_ENABLED
 	bool prepad = true;
@@ -105,7 +141,7 @@ void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 	bool prepad = p_pad_align;
 #endif
 
-	void *mem = malloc(p_bytes + (prepad ? DATA_OFFSET : 0));
+	void *mem = _alloc_block(p_bytes + (prepad ? DATA_OFFSET : 0));
 
 	ERR_FAIL_NULL_V(mem, nullptr);
 
@@ -120,6 +156,7 @@ void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 #ifdef DEBUG_ENABLED
 		uint64_t new_mem_usage = mem_usage.add(p_bytes);
 		max_usage.exchange_if_greater(new_mem_usage);
+		alloc_total.increment();
 #endif
 		return s8 + DATA_OFFSET;
 	} else {
@@ -151,15 +188,16 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 		} else {
 			mem_usage.sub(*s - p_bytes);
 		}
+		alloc_total.increment();
 #endif
 
 		if (p_bytes == 0) {
-			free(mem);
+			_free_block(mem);
 			return nullptr;
 		} else {
 			*s = p_bytes;
 
-			mem = (uint8_t *)realloc(mem, p_bytes + DATA_OFFSET);
+			mem = (uint8_t *)_realloc_block(mem, p_bytes + DATA_OFFSET);
 			ERR_FAIL_NULL_V(mem, nullptr);
 
 			s = (uint64_t *)(mem + SIZE_OFFSET);
@@ -169,7 +207,7 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 			return mem + DATA_OFFSET;
 		}
 	} else {
-		mem = (uint8_t *)realloc(mem, p_bytes);
+		mem = (uint8_t *)_realloc_block(mem, p_bytes);
 
 		ERR_FAIL_COND_V(mem == nullptr && p_bytes > 0, nullptr);
 
@@ -198,9 +236,9 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 		mem_usage.sub(*s);
 #endif
 
-		free(mem);
+		_free_block(mem);
 	} else {
-		free(mem);
+		_free_block(mem);
 	}
 }
 
@@ -224,6 +262,14 @@ uint64_t Memory::get_mem_max_usage() {
 #endif
 }
 
+uint64_t Memory::get_alloc_total() {
+#ifdef DEBUG_ENABLED
+	return alloc_total.get();
+#else
+	return 0;
+#endif
+}
+
 _GlobalNil::_GlobalNil() {
 	left = this;
 	right = this;
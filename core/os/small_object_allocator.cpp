@@ -0,0 +1,573 @@
+/**************************************************************************/
+/*  small_object_allocator.cpp                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "small_object_allocator.h"
+
+#if defined(SMALL_OBJECT_ALLOCATOR_ENABLED) && !defined(SANITIZERS_ENABLED)
+
+#include "core/os/mutex.h"
+
+#include <stdlib.h>
+#include <atomic>
+#include <new>
+
+namespace {
+
+constexpr uint32_t SLAB_SHIFT = 16;
+constexpr size_t SLAB_SIZE = size_t(1) << SLAB_SHIFT;
+constexpr size_t SLAB_HEADER_SIZE = 128;
+constexpr uint32_t SLABS_PER_CHUNK = 16;
+constexpr uint32_t MAX_EMPTY_SLABS = SLABS_PER_CHUNK * 2; // Kept around for reuse, the rest goes back to the system.
+
+// Two-level map of the slabs, indexed by address, so any pointer can be checked without a lock.
+// Entries are only cleared once a whole chunk has no block in use, right before it's given back
+// to the system, so no valid pointer can be looked up while its entry changes.
+#if UINTPTR_MAX > 0xFFFFFFFFu
+constexpr uint32_t PAGEMAP_BITS = 48 - SLAB_SHIFT;
+#else
+constexpr uint32_t PAGEMAP_BITS = 32 - SLAB_SHIFT;
+#endif
+constexpr uint32_t PAGEMAP_LEAF_BITS = 16;
+constexpr uint32_t PAGEMAP_ROOT_BITS = PAGEMAP_BITS - PAGEMAP_LEAF_BITS;
+constexpr uintptr_t PAGEMAP_LEAF_MASK = (uintptr_t(1) << PAGEMAP_LEAF_BITS) - 1;
+
+constexpr uint32_t block_sizes[SmallObjectAllocator::SIZE_CLASS_COUNT] = {
+	16, 32, 48, 64, 80, 96, 112, 128,
+	160, 192, 224, 256,
+	320, 384, 448, 512,
+	640, 768, 896, 1024
+};
+
+struct Heap;
+
+struct Slab {
+	std::atomic<Heap *> owner{ nullptr };
+	std::atomic<void *> remote_free{ nullptr }; // Pushed by other threads, taken all at once by the owner.
+	void *free_list = nullptr;
+	uint8_t *unused = nullptr; // Blocks from here to the end were never allocated.
+	uint8_t *end = nullptr;
+	uint32_t size_class = 0;
+	uint32_t used = 0; // Includes blocks freed remotely but not reclaimed yet.
+	bool full = false;
+	Slab *prev = nullptr;
+	Slab *next = nullptr;
+
+	Slab *chunk = nullptr; // First slab of the chunk this one was carved from.
+	// Only used in the first slab of a chunk.
+	void *chunk_memory = nullptr;
+	uint32_t chunk_empty_slabs = 0;
+};
+
+static_assert(sizeof(Slab) <= SLAB_HEADER_SIZE);
+
+struct SizeClass {
+	Slab *current = nullptr;
+	Slab *partial = nullptr;
+	Slab *full = nullptr;
+
+	// Only written by the owner thread.
+	std::atomic<uint64_t> allocations{ 0 };
+	std::atomic<uint64_t> frees{ 0 };
+	std::atomic<uint64_t> remote_frees{ 0 };
+	std::atomic<uint64_t> slabs{ 0 };
+};
+
+struct Heap {
+	SizeClass classes[SmallObjectAllocator::SIZE_CLASS_COUNT];
+	Heap *prev = nullptr;
+	Heap *next = nullptr;
+};
+
+std::atomic<uint8_t *> pagemap[size_t(1) << PAGEMAP_ROOT_BITS];
+std::atomic<bool> enabled(true);
+std::atomic<bool> register_failed(false); // Once set, the allocator stays off for good.
+
+BinaryMutex global_mutex; // Protects everything below.
+Heap *heaps = nullptr;
+Slab *empty_slabs = nullptr;
+uint32_t empty_slab_count = 0;
+Slab *orphan_slabs[SmallObjectAllocator::SIZE_CLASS_COUNT] = {};
+uint64_t orphan_slab_count[SmallObjectAllocator::SIZE_CLASS_COUNT] = {};
+uint64_t retired_stats[SmallObjectAllocator::SIZE_CLASS_COUNT][3] = {}; // From exited threads.
+
+thread_local Heap *thread_heap = nullptr;
+thread_local bool thread_heap_released = false;
+
+void _release_thread_heap();
+
+struct HeapReleaser {
+	~HeapReleaser() {
+		_release_thread_heap();
+	}
+};
+
+thread_local HeapReleaser heap_releaser;
+
+_FORCE_INLINE_ uint32_t _get_size_class(size_t p_bytes) {
+	if (p_bytes <= 128) {
+		return p_bytes ? uint32_t(p_bytes - 1) >> 4 : 0;
+	} else if (p_bytes <= 256) {
+		return 8 + (uint32_t(p_bytes - 129) >> 5);
+	} else if (p_bytes <= 512) {
+		return 12 + (uint32_t(p_bytes - 257) >> 6);
+	} else {
+		return 16 + (uint32_t(p_bytes - 513) >> 7);
+	}
+}
+
+_FORCE_INLINE_ void _count(std::atomic<uint64_t> &p_counter, uint64_t p_amount = 1) {
+	p_counter.store(p_counter.load(std::memory_order_relaxed) + p_amount, std::memory_order_relaxed);
+}
+
+_FORCE_INLINE_ Slab *_find_slab(const void *p_ptr) {
+	uintptr_t page = uintptr_t(p_ptr) >> SLAB_SHIFT;
+	if (page >> PAGEMAP_BITS) {
+		return nullptr;
+	}
+	const uint8_t *leaf = pagemap[page >> PAGEMAP_LEAF_BITS].load(std::memory_order_acquire);
+	if (!leaf || !leaf[page & PAGEMAP_LEAF_MASK]) {
+		return nullptr;
+	}
+	return (Slab *)(page << SLAB_SHIFT);
+}
+
+bool _register_slab(const void *p_slab) {
+	uintptr_t page = uintptr_t(p_slab) >> SLAB_SHIFT;
+	if (page >> PAGEMAP_BITS) {
+		return false;
+	}
+	std::atomic<uint8_t *> &root = pagemap[page >> PAGEMAP_LEAF_BITS];
+	uint8_t *leaf = root.load(std::memory_order_acquire);
+	if (!leaf) {
+		leaf = (uint8_t *)calloc(PAGEMAP_LEAF_MASK + 1, 1);
+		if (!leaf) {
+			return false;
+		}
+		root.store(leaf, std::memory_order_release);
+	}
+	leaf[page & PAGEMAP_LEAF_MASK] = 1;
+	return true;
+}
+
+void _unregister_slab(const void *p_slab) {
+	uintptr_t page = uintptr_t(p_slab) >> SLAB_SHIFT;
+	uint8_t *leaf = pagemap[page >> PAGEMAP_LEAF_BITS].load(std::memory_order_acquire);
+	leaf[page & PAGEMAP_LEAF_MASK] = 0;
+}
+
+void _list_push(Slab *&r_list, Slab *p_slab) {
+	p_slab->prev = nullptr;
+	p_slab->next = r_list;
+	if (r_list) {
+		r_list->prev = p_slab;
+	}
+	r_list = p_slab;
+}
+
+void _list_remove(Slab *&r_list, Slab *p_slab) {
+	if (p_slab->prev) {
+		p_slab->prev->next = p_slab->next;
+	} else {
+		r_list = p_slab->next;
+	}
+	if (p_slab->next) {
+		p_slab->next->prev = p_slab->prev;
+	}
+	p_slab->prev = nullptr;
+	p_slab->next = nullptr;
+}
+
+void _collect_remote_frees(Slab *p_slab) {
+	void *block = p_slab->remote_free.exchange(nullptr, std::memory_order_acquire);
+	while (block) {
+		void *next = *(void **)block;
+		*(void **)block = p_slab->free_list;
+		p_slab->free_list = block;
+		p_slab->used--;
+		block = next;
+	}
+}
+
+_FORCE_INLINE_ bool _has_free_blocks(const Slab *p_slab) {
+	return p_slab->free_list || p_slab->unused != p_slab->end;
+}
+
+// Must be called with global_mutex locked.
+Slab *_new_slab() {
+	if (!empty_slabs) {
+		uint8_t *chunk = (uint8_t *)malloc((SLABS_PER_CHUNK + 1) * SLAB_SIZE);
+		if (!chunk) {
+			return nullptr;
+		}
+		uint8_t *first = (uint8_t *)((uintptr_t(chunk) + SLAB_SIZE - 1) & ~uintptr_t(SLAB_SIZE - 1));
+		for (uint32_t i = 0; i < SLABS_PER_CHUNK; i++) {
+			if (!_register_slab(first + i * SLAB_SIZE)) {
+				// Out of the range covered by the map (e.g. tagged pointers), or out of memory for it.
+				// Later chunks would most likely fail the same way, so leave every block to the
+				// system allocator from now on.
+				for (uint32_t j = 0; j < i; j++) {
+					_unregister_slab(first + j * SLAB_SIZE);
+				}
+				free(chunk);
+				register_failed.store(true, std::memory_order_relaxed);
+				return nullptr;
+			}
+		}
+		Slab *head = (Slab *)first;
+		for (uint32_t i = 0; i < SLABS_PER_CHUNK; i++) {
+			Slab *slab = new (first + i * SLAB_SIZE) Slab;
+			slab->chunk = head;
+			_list_push(empty_slabs, slab);
+		}
+		head->chunk_memory = chunk;
+		head->chunk_empty_slabs = SLABS_PER_CHUNK;
+		empty_slab_count += SLABS_PER_CHUNK;
+	}
+
+	Slab *slab = empty_slabs;
+	_list_remove(empty_slabs, slab);
+	slab->chunk->chunk_empty_slabs--;
+	empty_slab_count--;
+	return slab;
+}
+
+// Must be called with global_mutex locked.
+void _free_slab(Slab *p_slab) {
+	p_slab->owner.store(nullptr, std::memory_order_relaxed);
+	p_slab->free_list = nullptr;
+	p_slab->used = 0;
+	p_slab->full = false;
+	_list_push(empty_slabs, p_slab);
+	empty_slab_count++;
+
+	Slab *head = p_slab->chunk;
+	head->chunk_empty_slabs++;
+	if (head->chunk_empty_slabs < SLABS_PER_CHUNK || empty_slab_count <= MAX_EMPTY_SLABS) {
+		return;
+	}
+
+	// The whole chunk is unused and enough empty slabs are left without it, give it back.
+	void *chunk_memory = head->chunk_memory;
+	for (uint32_t i = 0; i < SLABS_PER_CHUNK; i++) {
+		Slab *slab = (Slab *)((uint8_t *)head + i * SLAB_SIZE);
+		_list_remove(empty_slabs, slab);
+		_unregister_slab(slab);
+	}
+	empty_slab_count -= SLABS_PER_CHUNK;
+	free(chunk_memory);
+}
+
+Slab *_acquire_slab(Heap *p_heap, uint32_t p_size_class) {
+	SizeClass &sc = p_heap->classes[p_size_class];
+	while (true) {
+		Slab *slab = nullptr;
+		{
+			MutexLock lock(global_mutex);
+			slab = orphan_slabs[p_size_class];
+			if (slab) {
+				_list_remove(orphan_slabs[p_size_class], slab);
+				orphan_slab_count[p_size_class]--;
+				slab->owner.store(p_heap, std::memory_order_relaxed);
+				slab->full = false;
+			} else {
+				slab = _new_slab();
+				if (!slab) {
+					return nullptr;
+				}
+				uint32_t block_size = block_sizes[p_size_class];
+				slab->owner.store(p_heap, std::memory_order_relaxed);
+				slab->size_class = p_size_class;
+				slab->unused = (uint8_t *)slab + SLAB_HEADER_SIZE;
+				slab->end = slab->unused + (SLAB_SIZE - SLAB_HEADER_SIZE) / block_size * block_size;
+			}
+		}
+		_count(sc.slabs);
+
+		_collect_remote_frees(slab);
+		if (_has_free_blocks(slab)) {
+			return slab;
+		}
+		// Adopted with all its blocks still in use.
+		slab->full = true;
+		_list_push(sc.full, slab);
+	}
+}
+
+Slab *_refill(Heap *p_heap, uint32_t p_size_class) {
+	SizeClass &sc = p_heap->classes[p_size_class];
+
+	Slab *current = sc.current;
+	if (current) {
+		_collect_remote_frees(current);
+		if (_has_free_blocks(current)) {
+			return current;
+		}
+		current->full = true;
+		_list_push(sc.full, current);
+		sc.current = nullptr;
+	}
+
+	if (!sc.partial) {
+		// Blocks freed by other threads are only reclaimed when there is nothing else left.
+		Slab *slab = sc.full;
+		while (slab) {
+			Slab *next = slab->next;
+			_collect_remote_frees(slab);
+			if (_has_free_blocks(slab)) {
+				_list_remove(sc.full, slab);
+				slab->full = false;
+				_list_push(sc.partial, slab);
+			}
+			slab = next;
+		}
+	}
+
+	Slab *slab = sc.partial;
+	if (slab) {
+		_list_remove(sc.partial, slab);
+	} else {
+		slab = _acquire_slab(p_heap, p_size_class);
+	}
+	sc.current = slab;
+	return slab;
+}
+
+Heap *_create_heap() {
+	void *mem = malloc(sizeof(Heap));
+	if (!mem) {
+		return nullptr;
+	}
+	Heap *heap = new (mem) Heap();
+	{
+		MutexLock lock(global_mutex);
+		heap->next = heaps;
+		if (heaps) {
+			heaps->prev = heap;
+		}
+		heaps = heap;
+	}
+	(void)&heap_releaser; // Makes sure the heap is released when the thread exits.
+	thread_heap = heap;
+	return heap;
+}
+
+_FORCE_INLINE_ Heap *_get_heap() {
+	Heap *heap = thread_heap;
+	if (likely(heap)) {
+		return heap;
+	}
+	if (thread_heap_released) {
+		return nullptr; // Thread is exiting.
+	}
+	return _create_heap();
+}
+
+void _release_thread_heap() {
+	Heap *heap = thread_heap;
+	thread_heap = nullptr;
+	thread_heap_released = true;
+	if (!heap) {
+		return;
+	}
+
+	MutexLock lock(global_mutex);
+	for (uint32_t i = 0; i < SmallObjectAllocator::SIZE_CLASS_COUNT; i++) {
+		SizeClass &sc = heap->classes[i];
+		Slab *lists[3] = { sc.current, sc.partial, sc.full };
+		for (Slab *slab : lists) {
+			while (slab) {
+				Slab *next = slab->next;
+				_collect_remote_frees(slab);
+				if (slab->used == 0) {
+					_free_slab(slab);
+				} else {
+					// Blocks still in use, keep it for the next thread allocating this size.
+					slab->owner.store(nullptr, std::memory_order_relaxed);
+					_list_push(orphan_slabs[i], slab);
+					orphan_slab_count[i]++;
+				}
+				slab = next;
+			}
+		}
+		retired_stats[i][0] += sc.allocations.load(std::memory_order_relaxed);
+		retired_stats[i][1] += sc.frees.load(std::memory_order_relaxed);
+		retired_stats[i][2] += sc.remote_frees.load(std::memory_order_relaxed);
+	}
+
+	if (heap->prev) {
+		heap->prev->next = heap->next;
+	} else {
+		heaps = heap->next;
+	}
+	if (heap->next) {
+		heap->next->prev = heap->prev;
+	}
+	heap->~Heap();
+	free(heap);
+}
+
+} // namespace
+
+void *SmallObjectAllocator::alloc(size_t p_bytes) {
+	if (p_bytes > MAX_SIZE || !enabled.load(std::memory_order_relaxed) || register_failed.load(std::memory_order_relaxed)) {
+		return nullptr;
+	}
+	Heap *heap = _get_heap();
+	if (unlikely(!heap)) {
+		return nullptr;
+	}
+
+	uint32_t size_class = _get_size_class(p_bytes);
+	SizeClass &sc = heap->classes[size_class];
+	Slab *slab = sc.current;
+	if (unlikely(!slab || !_has_free_blocks(slab))) {
+		slab = _refill(heap, size_class);
+		if (unlikely(!slab)) {
+			return nullptr;
+		}
+	}
+
+	void *block;
+	if (slab->free_list) {
+		block = slab->free_list;
+		slab->free_list = *(void **)block;
+	} else {
+		block = slab->unused;
+		slab->unused += block_sizes[size_class];
+	}
+	slab->used++;
+	_count(sc.allocations);
+	return block;
+}
+
+bool SmallObjectAllocator::free(void *p_ptr) {
+	Slab *slab = _find_slab(p_ptr);
+	if (!slab) {
+		return false;
+	}
+
+	Heap *heap = _get_heap();
+	if (likely(heap && slab->owner.load(std::memory_order_relaxed) == heap)) {
+		*(void **)p_ptr = slab->free_list;
+		slab->free_list = p_ptr;
+		slab->used--;
+
+		SizeClass &sc = heap->classes[slab->size_class];
+		_count(sc.frees);
+		if (slab != sc.current) {
+			if (slab->full) {
+				_list_remove(sc.full, slab);
+				slab->full = false;
+				_list_push(sc.partial, slab);
+			}
+			if (slab->used == 0) {
+				_list_remove(sc.partial, slab);
+				sc.slabs.store(sc.slabs.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+				MutexLock lock(global_mutex);
+				_free_slab(slab);
+			}
+		}
+	} else {
+		// Once pushed, the owner may give the slab back at any time, so it can't be read after.
+		const uint32_t size_class = slab->size_class;
+		void *head = slab->remote_free.load(std::memory_order_relaxed);
+		do {
+			*(void **)p_ptr = head;
+		} while (!slab->remote_free.compare_exchange_weak(head, p_ptr, std::memory_order_release, std::memory_order_relaxed));
+
+		if (heap) {
+			_count(heap->classes[size_class].remote_frees);
+		}
+	}
+	return true;
+}
+
+size_t SmallObjectAllocator::get_block_size(const void *p_ptr) {
+	const Slab *slab = _find_slab(p_ptr);
+	return slab ? block_sizes[slab->size_class] : 0;
+}
+
+void SmallObjectAllocator::set_enabled(bool p_enabled) {
+	enabled.store(p_enabled, std::memory_order_relaxed);
+}
+
+bool SmallObjectAllocator::is_enabled() {
+	return enabled.load(std::memory_order_relaxed) && !register_failed.load(std::memory_order_relaxed);
+}
+
+SmallObjectAllocator::SizeClassStats SmallObjectAllocator::get_size_class_stats(uint32_t p_size_class) {
+	SizeClassStats stats;
+	if (p_size_class >= SIZE_CLASS_COUNT) {
+		return stats;
+	}
+
+	MutexLock lock(global_mutex);
+	stats.block_size = block_sizes[p_size_class];
+	stats.allocations = retired_stats[p_size_class][0];
+	stats.frees = retired_stats[p_size_class][1];
+	stats.remote_frees = retired_stats[p_size_class][2];
+	stats.slabs = orphan_slab_count[p_size_class];
+	for (Heap *heap = heaps; heap; heap = heap->next) {
+		const SizeClass &sc = heap->classes[p_size_class];
+		stats.allocations += sc.allocations.load(std::memory_order_relaxed);
+		stats.frees += sc.frees.load(std::memory_order_relaxed);
+		stats.remote_frees += sc.remote_frees.load(std::memory_order_relaxed);
+		stats.slabs += sc.slabs.load(std::memory_order_relaxed);
+	}
+	stats.frees += stats.remote_frees;
+	return stats;
+}
+
+#else // Sanitizers need to see every allocation, and some builds prefer the system allocator.
+
+void *SmallObjectAllocator::alloc(size_t p_bytes) {
+	return nullptr;
+}
+
+bool SmallObjectAllocator::free(void *p_ptr) {
+	return false;
+}
+
+size_t SmallObjectAllocator::get_block_size(const void *p_ptr) {
+	return 0;
+}
+
+void SmallObjectAllocator::set_enabled(bool p_enabled) {
+}
+
+bool SmallObjectAllocator::is_enabled() {
+	return false;
+}
+
+SmallObjectAllocator::SizeClassStats SmallObjectAllocator::get_size_class_stats(uint32_t p_size_class) {
+	return SizeClassStats();
+}
+
+#endif // SMALL_OBJECT_ALLOCATOR_ENABLED && !SANITIZERS_ENABLED
@@ -0,0 +1,73 @@
+/**************************************************************************/
+/*  small_object_allocator.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef SMALL_OBJECT_ALLOCATOR_H
+#define SMALL_OBJECT_ALLOCATOR_H
+
+#include "core/typedefs.h"
+
+#include <stddef.h>
+
+// Size-class allocator used by Memory for small blocks.
+// Every thread allocates from 64 KiB slabs of its own, one size class per slab, so the
+// common case takes no lock. Blocks freed by another thread are pushed to a lock-free
+// list of their slab, which the owner reclaims once it runs out of local blocks.
+// Slabs of exited threads are adopted by the next thread needing that size class.
+// Only a few empty slabs are kept for reuse, the rest is given back to the system.
+class SmallObjectAllocator {
+public:
+	static constexpr uint32_t MAX_SIZE = 1024;
+	static constexpr uint32_t SIZE_CLASS_COUNT = 20;
+
+	struct SizeClassStats {
+		uint32_t block_size = 0;
+		uint64_t allocations = 0;
+		uint64_t frees = 0;
+		uint64_t remote_frees = 0; // Frees done by a thread that doesn't own the block, included in frees.
+		uint64_t slabs = 0;
+	};
+
+	// Returns nullptr if the block is too large or the allocator can't be used, in which
+	// case the system allocator should be used instead.
+	static void *alloc(size_t p_bytes);
+	// Returns false if the block doesn't belong to this allocator.
+	static bool free(void *p_ptr);
+	// Returns zero if the block doesn't belong to this allocator.
+	static size_t get_block_size(const void *p_ptr);
+
+	// Disabling only affects new allocations, blocks already allocated can still be freed.
+	// The allocator turns itself off for good if the system returns memory it can't track.
+	static void set_enabled(bool p_enabled);
+	static bool is_enabled();
+
+	static SizeClassStats get_size_class_stats(uint32_t p_size_class);
+};
+
+#endif // SMALL_OBJECT_ALLOCATOR_H
@@ -31,6 +31,7 @@
 #include "node_path.h"
 
 #include "core/string/print_string.h"
+#include "core/string/small_string.h"
 
 void NodePath::_update_hash_cache() const {
 	uint32_t h = data->absolute ? 1 : 0;
@@ -212,15 +213,15 @@ StringName NodePath::get_concatenated_names() const {
 
 	if (!data->concatenated_path) {
 		int pc = data->path.size();
-		String concatenated;
+		SmallString<64> concatenated;
 		const StringName *sn = data->path.ptr();
 		for (int i = 0; i < pc; i++) {
 			if (i > 0) {
-				concatenated += "/";
+				concatenated += '/';
 			}
 			concatenated += sn[i].operator String();
 		}
-		data->concatenated_path = concatenated;
+		data->concatenated_path = concatenated.as_string_name();
 	}
 	return data->concatenated_path;
 }
@@ -230,15 +231,15 @@ StringName NodePath::get_concatenated_subnames() const {
 
 	if (!data->concatenated_subpath) {
 		int spc = data->subpath.size();
-		String concatenated;
+		SmallString<64> concatenated;
 		const StringName *ssn = data->subpath.ptr();
 		for (int i = 0; i < spc; i++) {
 			if (i > 0) {
-				concatenated += ":";
+				concatenated += ':';
 			}
 			concatenated += ssn[i].operator String();
 		}
-		data->concatenated_subpath = concatenated;
+		data->concatenated_subpath = concatenated.as_string_name();
 	}
 	return data->concatenated_subpath;
 }
@@ -401,37 +402,39 @@ NodePath::NodePath(const String &p_path) {
 		return;
 	}
 
-	String path = p_path;
+	// Names are looked up from a SmallString instead of allocating a substring
+	// for each of them, most of them already exist as StringNames.
+	const char32_t *path = p_path.ptr();
+	int path_len = p_path.length();
 	Hector<StringName> subpath;
 
 	bool absolute = (path[0] == '/');
 	bool last_is_slash = true;
 	int slices = 0;
-	int subpath_pos = path.find(":");
+	int subpath_pos = p_path.find(":");
 
 	if (subpath_pos != -1) {
 		int from = subpath_pos + 1;
 
-		for (int i = from; i <= path.length(); i++) {
+		for (int i = from; i <= path_len; i++) {
 			if (path[i] == ':' || path[i] == 0) {
-				String str = path.substr(from, i - from);
-				if (str.is_empty()) {
+				if (i == from) {
 					if (path[i] == 0) {
 						continue; // Allow end-of-path :
 					}
 
 					ERR_FAIL_MSG("Invalid NodePath '" + p_path + "'.");
 				}
-				subpath.push_back(str);
+				subpath.push_back(SmallString<>(path + from, i - from).as_string_name());
 
 				from = i + 1;
 			}
 		}
 
-		path = path.substr(0, subpath_pos);
+		path_len = subpath_pos;
 	}
 
-	for (int i = (int)absolute; i < path.length(); i++) {
+	for (int i = (int)absolute; i < path_len; i++) {
 		if (path[i] == '/') {
 			last_is_slash = true;
 		} else {
@@ -461,12 +464,11 @@ NodePath::NodePath(const String &p_path) {
 	int from = (int)absolute;
 	int slice = 0;
 
-	for (int i = (int)absolute; i < path.length() + 1; i++) {
-		if (path[i] == '/' || path[i] == 0) {
+	for (int i = (int)absolute; i < path_len + 1; i++) {
+		if (i == path_len || path[i] == '/') {
 			if (!last_is_slash) {
-				String name = path.substr(from, i - from);
 				ERR_FAIL_INDEX(slice, data->path.size());
-				data->path.write[slice++] = name;
+				data->path.write[slice++] = SmallString<>(path + from, i - from).as_string_name();
 			}
 			from = i + 1;
 			last_is_slash = true;
@@ -0,0 +1,235 @@
+/**************************************************************************/
+/*  small_string.h                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef SMALL_STRING_H
+#define SMALL_STRING_H
+
+#include "core/string/string_name.h"
+#include "core/string/ustring.h"
+
+// A string with inline storage for short contents, for building temporary
+// names, keys and numbers without a heap allocation. Only when the contents
+// grow past INLINE_CAPACITY characters is a String used as storage.
+// Converting to String allocates once, with the exact length. Converting to
+// StringName does not allocate at all if the name already exists.
+//
+// This is not a replacement for String: String has to stay a single pointer
+// to CowData, as that layout is shared with GDExtension.
+template <int INLINE_CAPACITY = 32>
+class SmallString {
+	char32_t inline_buffer[INLINE_CAPACITY];
+	String heap_buffer;
+	int string_length = 0;
+
+	_FORCE_INLINE_ bool _is_inline() const {
+		return heap_buffer.is_empty();
+	}
+
+	_FORCE_INLINE_ char32_t *_ptrw() {
+		return _is_inline() ? inline_buffer : heap_buffer.ptrw();
+	}
+
+	void _reserve(int p_length);
+
+public:
+	SmallString &append(char32_t p_char);
+	SmallString &append(const char32_t *p_str, int p_clip_to_len = -1);
+	SmallString &append(const char *p_str);
+	SmallString &append(const String &p_string);
+	SmallString &append_int(int64_t p_num, int p_base = 10, bool p_capitalize_hex = false);
+	SmallString &append_uint(uint64_t p_num, int p_base = 10, bool p_capitalize_hex = false);
+
+	_FORCE_INLINE_ SmallString &operator+=(char32_t p_char) { return append(p_char); }
+	_FORCE_INLINE_ SmallString &operator+=(const char32_t *p_str) { return append(p_str); }
+	_FORCE_INLINE_ SmallString &operator+=(const char *p_str) { return append(p_str); }
+	_FORCE_INLINE_ SmallString &operator+=(const String &p_string) { return append(p_string); }
+
+	_FORCE_INLINE_ int length() const { return string_length; }
+	_FORCE_INLINE_ bool is_empty() const { return string_length == 0; }
+	_FORCE_INLINE_ bool is_inline() const { return _is_inline(); }
+
+	// Null-terminated.
+	_FORCE_INLINE_ const char32_t *get_data() const {
+		return _is_inline() ? inline_buffer : heap_buffer.ptr();
+	}
+
+	_FORCE_INLINE_ char32_t operator[](int p_index) const {
+		DEV_ASSERT(p_index >= 0 && p_index <= string_length);
+		return get_data()[p_index];
+	}
+
+	void clear();
+
+	_FORCE_INLINE_ uint32_t hash() const { return String::hash(get_data(), string_length); }
+
+	bool operator==(const String &p_string) const;
+	_FORCE_INLINE_ bool operator!=(const String &p_string) const { return !(*this == p_string); }
+
+	String as_string() const;
+	StringName as_string_name() const;
+
+	_FORCE_INLINE_ operator String() const { return as_string(); }
+
+	SmallString() { inline_buffer[0] = 0; }
+	explicit SmallString(const char32_t *p_str, int p_clip_to_len = -1) {
+		inline_buffer[0] = 0;
+		append(p_str, p_clip_to_len);
+	}
+	explicit SmallString(const String &p_string) {
+		inline_buffer[0] = 0;
+		append(p_string);
+	}
+};
+
+template <int INLINE_CAPACITY>
+void SmallString<INLINE_CAPACITY>::_reserve(int p_length) {
+	// One more for the terminating null character.
+	if (_is_inline() ? p_length < INLINE_CAPACITY : p_length < heap_buffer.size()) {
+		return;
+	}
+
+	const bool was_inline = _is_inline();
+	heap_buffer.resize(next_power_of_2(p_length + 1));
+	if (was_inline) {
+		memcpy(heap_buffer.ptrw(), inline_buffer, (string_length + 1) * sizeof(char32_t));
+	}
+}
+
+template <int INLINE_CAPACITY>
+SmallString<INLINE_CAPACITY> &SmallString<INLINE_CAPACITY>::append(char32_t p_char) {
+	_reserve(string_length + 1);
+	char32_t *buf = _ptrw();
+	buf[string_length++] = p_char;
+	buf[string_length] = 0;
+	return *this;
+}
+
+template <int INLINE_CAPACITY>
+SmallString<INLINE_CAPACITY> &SmallString<INLINE_CAPACITY>::append(const char32_t *p_str, int p_clip_to_len) {
+	int len = 0;
+	while ((p_clip_to_len < 0 || len < p_clip_to_len) && p_str[len]) {
+		++len;
+	}
+	_reserve(string_length + len);
+	char32_t *buf = _ptrw();
+	memcpy(buf + string_length, p_str, len * sizeof(char32_t));
+	string_length += len;
+	buf[string_length] = 0;
+	return *this;
+}
+
+template <int INLINE_CAPACITY>
+SmallString<INLINE_CAPACITY> &SmallString<INLINE_CAPACITY>::append(const char *p_str) {
+	const int len = strlen(p_str);
+	_reserve(string_length + len);
+	char32_t *buf = _ptrw();
+	for (int i = 0; i < len; i++) {
+		buf[string_length++] = (uint8_t)p_str[i];
+	}
+	buf[string_length] = 0;
+	return *this;
+}
+
+template <int INLINE_CAPACITY>
+SmallString<INLINE_CAPACITY> &SmallString<INLINE_CAPACITY>::append(const String &p_string) {
+	return append(p_string.get_data(), p_string.length());
+}
+
+template <int INLINE_CAPACITY>
+SmallString<INLINE_CAPACITY> &SmallString<INLINE_CAPACITY>::append_int(int64_t p_num, int p_base, bool p_capitalize_hex) {
+	if (p_num < 0) {
+		append('-');
+		// Negate as unsigned, so INT64_MIN does not overflow.
+		return append_uint(~(uint64_t)p_num + 1, p_base, p_capitalize_hex);
+	}
+	return append_uint((uint64_t)p_num, p_base, p_capitalize_hex);
+}
+
+template <int INLINE_CAPACITY>
+SmallString<INLINE_CAPACITY> &SmallString<INLINE_CAPACITY>::append_uint(uint64_t p_num, int p_base, bool p_capitalize_hex) {
+	int chars = 0;
+	uint64_t n = p_num;
+	do {
+		n /= p_base;
+		chars++;
+	} while (n);
+
+	_reserve(string_length + chars);
+	char32_t *buf = _ptrw();
+	string_length += chars;
+	buf[string_length] = 0;
+
+	char32_t *c = buf + string_length;
+	n = p_num;
+	do {
+		const int mod = n % p_base;
+		*(--c) = mod >= 10 ? (p_capitalize_hex ? 'A' : 'a') + (mod - 10) : '0' + mod;
+		n /= p_base;
+	} while (n);
+	return *this;
+}
+
+template <int INLINE_CAPACITY>
+void SmallString<INLINE_CAPACITY>::clear() {
+	// Keep the heap buffer, if any, to be reused.
+	string_length = 0;
+	_ptrw()[0] = 0;
+}
+
+template <int INLINE_CAPACITY>
+bool SmallString<INLINE_CAPACITY>::operator==(const String &p_string) const {
+	if (p_string.length() != string_length) {
+		return false;
+	}
+	return memcmp(get_data(), p_string.get_data(), string_length * sizeof(char32_t)) == 0;
+}
+
+template <int INLINE_CAPACITY>
+String SmallString<INLINE_CAPACITY>::as_string() const {
+	if (string_length == 0) {
+		return String();
+	}
+	return String(get_data(), string_length);
+}
+
+template <int INLINE_CAPACITY>
+StringName SmallString<INLINE_CAPACITY>::as_string_name() const {
+	if (string_length == 0) {
+		return StringName();
+	}
+	// Most names built at runtime already exist, only allocate a String for new ones.
+	StringName name = StringName::search(get_data());
+	if (name == StringName()) {
+		name = StringName(as_string());
+	}
+	return name;
+}
+
+#endif // SMALL_STRING_H
@@ -63,6 +63,20 @@ bool StringName::_Data::operator!=(const char *p_name) const {
 	return !operator==(p_name);
 }
 
+bool StringName::_Data::operator==(const char32_t *p_name) const {
+	if (cname) {
+		// Compare without converting either side to a String.
+		const char *c = cname;
+		while (*c && (uint8_t)*c == *p_name) {
+			c++;
+			p_name++;
+		}
+		return *c == 0 && *p_name == 0;
+	} else {
+		return name == p_name;
+	}
+}
+
 StringName _scs_create(const char *p_chr, bool p_static) {
 	return (p_chr[0] ? StringName(StaticCString::create(p_chr), p_static) : StringName());
 }
@@ -76,7 +90,9 @@ void StringName::setup() {
 }
 
 void StringName::cleanup() {
-	MutexLock lock(mutex);
+	for (TableShard &shard : shards) {
+		shard.mutex.lock();
+	}
 
 #ifdef DEBUG_ENABLED
 	if (unlikely(debug_stringname)) {
@@ -129,14 +145,16 @@ void StringName::cleanup() {
 		print_verbose(vformat("StringName: %d unclaimed string names at exit.", lost_strings));
 	}
 	configured = false;
+
+	for (TableShard &shard : shards) {
+		shard.mutex.unlock();
+	}
 }
 
 void StringName::unref() {
 	ERR_FAIL_COND(!configured);
 
 	if (_data && _data->refcount.unref()) {
-		MutexLock lock(mutex);
-
 		if (CoreGlobals::leak_reporting_enabled && _data->static_count.get() > 0) {
 			if (_data->cname) {
 				ERR_PRINT("BUG: Unreferenced static string to 0: " + String(_data->cname));
@@ -144,18 +162,27 @@ void StringName::unref() {
 				ERR_PRINT("BUG: Unreferenced static string to 0: " + String(_data->name));
 			}
 		}
-		if (_data->prev) {
-			_data->prev->next = _data->next;
-		} else {
-			if (_table[_data->idx] != _data) {
-				ERR_PRINT("BUG!");
+
+		{
+			// Other threads may still find the entry until it is unlinked,
+			// but can't reference it anymore as its refcount is zero.
+			MutexLock lock(_get_shard_mutex(_data->idx));
+
+			if (_data->prev) {
+				_data->prev->next = _data->next;
+			} else {
+				if (_table[_data->idx] != _data) {
+					ERR_PRINT("BUG!");
+				}
+				_table[_data->idx] = _data->next;
 			}
-			_table[_data->idx] = _data->next;
-		}
 
-		if (_data->next) {
-			_data->next->prev = _data->prev;
+			if (_data->next) {
+				_data->next->prev = _data->prev;
+			}
 		}
+
+		// Deleted once unlinked, so freeing the name doesn't hold the shard.
 		memdelete(_data);
 	}
 
@@ -275,12 +302,12 @@ StringName::StringName(const char *p_name, bool p_static) {
 		return; //empty, ignore
 	}
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = String::hash(p_name);
 
 	uint32_t idx = hash & STRING_TABLE_MASK;
 
+	MutexLock lock(_get_shard_mutex(idx));
+
 	_data = _table[idx];
 
 	while (_data) {
@@ -334,12 +361,12 @@ StringName::StringName(const StaticCString &p_static_string, bool p_static) {
 
 	ERR_FAIL_COND(!p_static_string.ptr || !p_static_string.ptr[0]);
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = String::hash(p_static_string.ptr);
 
 	uint32_t idx = hash & STRING_TABLE_MASK;
 
+	MutexLock lock(_get_shard_mutex(idx));
+
 	_data = _table[idx];
 
 	while (_data) {
@@ -394,11 +421,11 @@ StringName::StringName(const String &p_name, bool p_static) {
 		return;
 	}
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = p_name.hash();
 	uint32_t idx = hash & STRING_TABLE_MASK;
 
+	MutexLock lock(_get_shard_mutex(idx));
+
 	_data = _table[idx];
 
 	while (_data) {
@@ -452,11 +479,11 @@ StringName StringName::search(const char *p_name) {
 		return StringName();
 	}
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = String::hash(p_name);
 	uint32_t idx = hash & STRING_TABLE_MASK;
 
+	MutexLock lock(_get_shard_mutex(idx));
+
 	_Data *_data = _table[idx];
 
 	while (_data) {
@@ -488,12 +515,12 @@ StringName StringName::search(const char32_t *p_name) {
 		return StringName();
 	}
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = String::hash(p_name);
 
 	uint32_t idx = hash & STRING_TABLE_MASK;
 
+	MutexLock lock(_get_shard_mutex(idx));
+
 	_Data *_data = _table[idx];
 
 	while (_data) {
@@ -514,12 +541,12 @@ StringName StringName::search(const char32_t *p_name) {
 StringName StringName::search(const String &p_name) {
 	ERR_FAIL_COND_V(p_name.is_empty(), StringName());
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = p_name.hash();
 
 	uint32_t idx = hash & STRING_TABLE_MASK;
 
+	MutexLock lock(_get_shard_mutex(idx));
+
 	_Data *_data = _table[idx];
 
 	while (_data) {
@@ -48,7 +48,12 @@ class StringName {
 	enum {
 		STRING_TABLE_BITS = 16,
 		STRING_TABLE_LEN = 1 << STRING_TABLE_BITS,
-		STRING_TABLE_MASK = STRING_TABLE_LEN - 1
+		STRING_TABLE_MASK = STRING_TABLE_LEN - 1,
+		// The table is split in shards with a lock each, so threads
+		// interning different names rarely wait for each other.
+		STRING_TABLE_SHARD_BITS = 6,
+		STRING_TABLE_SHARD_COUNT = 1 << STRING_TABLE_SHARD_BITS,
+		STRING_TABLE_SHARD_MASK = STRING_TABLE_SHARD_COUNT - 1
 	};
 
 	struct _Data {
@@ -64,6 +69,7 @@ class StringName {
 		bool operator!=(const String &p_name) const;
 		bool operator==(const char *p_name) const;
 		bool operator!=(const char *p_name) const;
+		bool operator==(const char32_t *p_name) const;
 
 		int idx = 0;
 		uint32_t hash = 0;
@@ -74,6 +80,16 @@ class StringName {
 
 	static inline _Data *_table[STRING_TABLE_LEN];
 
+	struct alignas(64) TableShard {
+		Mutex mutex;
+	};
+
+	static inline TableShard shards[STRING_TABLE_SHARD_COUNT];
+
+	_FORCE_INLINE_ static Mutex &_get_shard_mutex(uint32_t p_idx) {
+		return shards[p_idx & STRING_TABLE_SHARD_MASK].mutex;
+	}
+
 	_Data *_data = nullptr;
 
 	void unref();
@@ -1373,6 +1373,11 @@ static const int reverse_caps_table[CAPS_LEN - 1][2] = {
 };
 
 static int _find_upper(int ch) {
+	if (ch < 0x80) {
+		// Only the ASCII letters change case, skip the table search.
+		return (ch >= 'a' && ch <= 'z') ? ch - ('a' - 'A') : ch;
+	}
+
 	int low = 0;
 	int high = CAPS_LEN - 1;
 	int middle;
@@ -1393,6 +1398,10 @@ static int _find_upper(int ch) {
 }
 
 static int _find_lower(int ch) {
+	if (ch < 0x80) {
+		return (ch >= 'A' && ch <= 'Z') ? ch + ('a' - 'A') : ch;
+	}
+
 	int low = 0;
 	int high = CAPS_LEN - 2;
 	int middle;
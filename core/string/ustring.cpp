@@ -35,6 +35,7 @@
 #include "core/math/math_funcs.h"
 #include "core/os/memory.h"
 #include "core/string/print_string.h"
+#include "core/string/small_string.h"
 #include "core/string/string_name.h"
 #include "core/string/translation_server.h"
 #include "core/string/ucaps.h"
@@ -45,6 +46,14 @@
 #include <stdlib.h>
 #include <cstdint>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define USTRING_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define USTRING_NEON
+#include <arm_neon.h>
+#endif
+
 #ifdef _MSC_VER
 #define _CRT_SECURE_NO_WARNINGS // to disable build-time warning which suggested to use strcpy_s instead strcpy
 #endif
@@ -59,6 +68,207 @@ static _FORCE_INLINE_ char32_t lower_case(char32_t c) {
 	return (is_ascii_upper_case(c) ? (c + ('a' - 'A')) : c);
 }
 
+/* ASCII and search fast paths */
+
+// Text is mostly ASCII, so the UTF-8 conversions and case changes check 16
+// characters at a time and convert them at once when none needs Unicode
+// handling. SSE2 and NEON are part of the x86_64 and arm64 baselines, other
+// architectures use plain loops (or 64-bit integers for bytes).
+
+static constexpr int UTF8_ASCII_CHUNK = 16;
+
+// True if the 16 bytes are all ASCII, and none is a null character (or a
+// carriage return when p_skip_cr is set).
+static _FORCE_INLINE_ bool _utf8_is_ascii_chunk(const uint8_t *p_src, bool p_skip_cr) {
+#if defined(USTRING_SSE2)
+	const __m128i v = _mm_loadu_si128((const __m128i *)p_src);
+	__m128i special = _mm_cmpeq_epi8(v, _mm_setzero_si128());
+	if (p_skip_cr) {
+		special = _mm_or_si128(special, _mm_cmpeq_epi8(v, _mm_set1_epi8('\r')));
+	}
+	// The sign bit is set for non-ASCII bytes.
+	return _mm_movemask_epi8(_mm_or_si128(v, special)) == 0;
+#elif defined(USTRING_NEON)
+	const uint8x16_t v = vld1q_u8(p_src);
+	if (vmaxvq_u8(v) >= 0x80 || vminvq_u8(v) == 0) {
+		return false;
+	}
+	return !p_skip_cr || vmaxvq_u8(vceqq_u8(v, vdupq_n_u8('\r'))) == 0;
+#else
+	for (int i = 0; i < UTF8_ASCII_CHUNK; i += 8) {
+		uint64_t w;
+		memcpy(&w, p_src + i, 8);
+		const uint64_t ones = 0x0101010101010101ULL;
+		const uint64_t highs = 0x8080808080808080ULL;
+		// Non-ASCII bytes, then null bytes.
+		uint64_t special = (w & highs) | ((w - ones) & ~w & highs);
+		if (p_skip_cr) {
+			const uint64_t cr = w ^ (ones * '\r');
+			special |= (cr - ones) & ~cr & highs;
+		}
+		if (special) {
+			return false;
+		}
+	}
+	return true;
+#endif
+}
+
+static _FORCE_INLINE_ void _utf8_ascii_chunk_to_utf32(const uint8_t *p_src, char32_t *p_dst) {
+#if defined(USTRING_SSE2)
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i v = _mm_loadu_si128((const __m128i *)p_src);
+	const __m128i lo = _mm_unpacklo_epi8(v, zero);
+	const __m128i hi = _mm_unpackhi_epi8(v, zero);
+	_mm_storeu_si128((__m128i *)p_dst, _mm_unpacklo_epi16(lo, zero));
+	_mm_storeu_si128((__m128i *)(p_dst + 4), _mm_unpackhi_epi16(lo, zero));
+	_mm_storeu_si128((__m128i *)(p_dst + 8), _mm_unpacklo_epi16(hi, zero));
+	_mm_storeu_si128((__m128i *)(p_dst + 12), _mm_unpackhi_epi16(hi, zero));
+#elif defined(USTRING_NEON)
+	const uint8x16_t v = vld1q_u8(p_src);
+	const uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+	const uint16x8_t hi = vmovl_u8(vget_high_u8(v));
+	vst1q_u32((uint32_t *)p_dst, vmovl_u16(vget_low_u16(lo)));
+	vst1q_u32((uint32_t *)(p_dst + 4), vmovl_u16(vget_high_u16(lo)));
+	vst1q_u32((uint32_t *)(p_dst + 8), vmovl_u16(vget_low_u16(hi)));
+	vst1q_u32((uint32_t *)(p_dst + 12), vmovl_u16(vget_high_u16(hi)));
+#else
+	for (int i = 0; i < UTF8_ASCII_CHUNK; i++) {
+		p_dst[i] = p_src[i];
+	}
+#endif
+}
+
+// True if the 16 characters are all ASCII.
+static _FORCE_INLINE_ bool _utf32_is_ascii_chunk(const char32_t *p_src) {
+#if defined(USTRING_SSE2)
+	const __m128i v0 = _mm_loadu_si128((const __m128i *)p_src);
+	const __m128i v1 = _mm_loadu_si128((const __m128i *)(p_src + 4));
+	const __m128i v2 = _mm_loadu_si128((const __m128i *)(p_src + 8));
+	const __m128i v3 = _mm_loadu_si128((const __m128i *)(p_src + 12));
+	const __m128i all = _mm_or_si128(_mm_or_si128(v0, v1), _mm_or_si128(v2, v3));
+	const __m128i non_ascii = _mm_andnot_si128(_mm_set1_epi32(0x7f), all);
+	return _mm_movemask_epi8(_mm_cmpeq_epi32(non_ascii, _mm_setzero_si128())) == 0xffff;
+#elif defined(USTRING_NEON)
+	const uint32_t *src = (const uint32_t *)p_src;
+	const uint32x4_t all = vorrq_u32(vorrq_u32(vld1q_u32(src), vld1q_u32(src + 4)), vorrq_u32(vld1q_u32(src + 8), vld1q_u32(src + 12)));
+	return vmaxvq_u32(all) < 0x80;
+#else
+	uint32_t all = 0;
+	for (int i = 0; i < UTF8_ASCII_CHUNK; i++) {
+		all |= p_src[i];
+	}
+	return all < 0x80;
+#endif
+}
+
+static _FORCE_INLINE_ void _utf32_ascii_chunk_to_utf8(const char32_t *p_src, uint8_t *p_dst) {
+#if defined(USTRING_SSE2)
+	// The values are below 0x80, so the saturating packs keep them as they are.
+	const __m128i lo = _mm_packs_epi32(_mm_loadu_si128((const __m128i *)p_src), _mm_loadu_si128((const __m128i *)(p_src + 4)));
+	const __m128i hi = _mm_packs_epi32(_mm_loadu_si128((const __m128i *)(p_src + 8)), _mm_loadu_si128((const __m128i *)(p_src + 12)));
+	_mm_storeu_si128((__m128i *)p_dst, _mm_packus_epi16(lo, hi));
+#elif defined(USTRING_NEON)
+	const uint32_t *src = (const uint32_t *)p_src;
+	const uint16x8_t lo = vcombine_u16(vmovn_u32(vld1q_u32(src)), vmovn_u32(vld1q_u32(src + 4)));
+	const uint16x8_t hi = vcombine_u16(vmovn_u32(vld1q_u32(src + 8)), vmovn_u32(vld1q_u32(src + 12)));
+	vst1q_u8(p_dst, vcombine_u8(vmovn_u16(lo), vmovn_u16(hi)));
+#else
+	for (int i = 0; i < UTF8_ASCII_CHUNK; i++) {
+		p_dst[i] = (uint8_t)p_src[i];
+	}
+#endif
+}
+
+// Moves the 16 ASCII characters in [p_first, p_last] by p_offset, to change their case.
+static _FORCE_INLINE_ void _utf32_ascii_chunk_change_case(const char32_t *p_src, char32_t *p_dst, char32_t p_first, char32_t p_last, int p_offset) {
+#if defined(USTRING_SSE2)
+	const __m128i below = _mm_set1_epi32((int)p_first - 1);
+	const __m128i above = _mm_set1_epi32((int)p_last + 1);
+	const __m128i offset = _mm_set1_epi32(p_offset);
+	for (int i = 0; i < UTF8_ASCII_CHUNK; i += 4) {
+		const __m128i v = _mm_loadu_si128((const __m128i *)(p_src + i));
+		const __m128i in_range = _mm_and_si128(_mm_cmpgt_epi32(v, below), _mm_cmplt_epi32(v, above));
+		_mm_storeu_si128((__m128i *)(p_dst + i), _mm_add_epi32(v, _mm_and_si128(in_range, offset)));
+	}
+#elif defined(USTRING_NEON)
+	const uint32x4_t first = vdupq_n_u32(p_first);
+	const uint32x4_t last = vdupq_n_u32(p_last);
+	const uint32x4_t offset = vdupq_n_u32((uint32_t)p_offset);
+	for (int i = 0; i < UTF8_ASCII_CHUNK; i += 4) {
+		const uint32x4_t v = vld1q_u32((const uint32_t *)(p_src + i));
+		const uint32x4_t in_range = vandq_u32(vcgeq_u32(v, first), vcleq_u32(v, last));
+		vst1q_u32((uint32_t *)(p_dst + i), vaddq_u32(v, vandq_u32(in_range, offset)));
+	}
+#else
+	for (int i = 0; i < UTF8_ASCII_CHUNK; i++) {
+		const char32_t c = p_src[i];
+		p_dst[i] = (c >= p_first && c <= p_last) ? c + p_offset : c;
+	}
+#endif
+}
+
+// Index of the first p_char in [p_from, p_to), or -1.
+static _FORCE_INLINE_ int _find_char(const char32_t *p_src, int p_from, int p_to, char32_t p_char) {
+	int i = p_from;
+	// Skip 8 characters at a time while there's no match, the loop below finds its exact position.
+#if defined(USTRING_SSE2)
+	const __m128i needle = _mm_set1_epi32((int)p_char);
+	for (; i + 8 <= p_to; i += 8) {
+		const __m128i a = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(p_src + i)), needle);
+		const __m128i b = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(p_src + i + 4)), needle);
+		if (_mm_movemask_epi8(_mm_or_si128(a, b))) {
+			break;
+		}
+	}
+#elif defined(USTRING_NEON)
+	const uint32x4_t needle = vdupq_n_u32(p_char);
+	for (; i + 8 <= p_to; i += 8) {
+		const uint32x4_t a = vceqq_u32(vld1q_u32((const uint32_t *)(p_src + i)), needle);
+		const uint32x4_t b = vceqq_u32(vld1q_u32((const uint32_t *)(p_src + i + 4)), needle);
+		if (vmaxvq_u32(vorrq_u32(a, b))) {
+			break;
+		}
+	}
+#endif
+	for (; i < p_to; i++) {
+		if (p_src[i] == p_char) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+// Index of the last p_char in [0, p_from], or -1.
+static _FORCE_INLINE_ int _rfind_char(const char32_t *p_src, int p_from, char32_t p_char) {
+	int i = p_from;
+#if defined(USTRING_SSE2)
+	const __m128i needle = _mm_set1_epi32((int)p_char);
+	for (; i >= 7; i -= 8) {
+		const __m128i a = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(p_src + i - 7)), needle);
+		const __m128i b = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(p_src + i - 3)), needle);
+		if (_mm_movemask_epi8(_mm_or_si128(a, b))) {
+			break;
+		}
+	}
+#elif defined(USTRING_NEON)
+	const uint32x4_t needle = vdupq_n_u32(p_char);
+	for (; i >= 7; i -= 8) {
+		const uint32x4_t a = vceqq_u32(vld1q_u32((const uint32_t *)(p_src + i - 7)), needle);
+		const uint32x4_t b = vceqq_u32(vld1q_u32((const uint32_t *)(p_src + i - 3)), needle);
+		if (vmaxvq_u32(vorrq_u32(a, b))) {
+			break;
+		}
+	}
+#endif
+	for (; i >= 0; i--) {
+		if (p_src[i] == p_char) {
+			return i;
+		}
+	}
+	return -1;
+}
+
 const char CharString::_null = 0;
 const char16_t Char16String::_null = 0;
 const char32_t String::_null = 0;
@@ -1719,12 +1929,20 @@ String String::to_upper() const {
 	upper.resize(size());
 	const char32_t *old_ptr = ptr();
 	char32_t *upper_ptrw = upper.ptrw();
+	const int len = length();
 
-	while (*old_ptr) {
-		*upper_ptrw++ = _find_upper(*old_ptr++);
+	for (int i = 0; i < len; i += UTF8_ASCII_CHUNK) {
+		const int chunk_len = MIN(UTF8_ASCII_CHUNK, len - i);
+		if (chunk_len == UTF8_ASCII_CHUNK && _utf32_is_ascii_chunk(old_ptr + i)) {
+			_utf32_ascii_chunk_change_case(old_ptr + i, upper_ptrw + i, 'a', 'z', 'A' - 'a');
+		} else {
+			for (int j = i; j < i + chunk_len; j++) {
+				upper_ptrw[j] = _find_upper(old_ptr[j]);
+			}
+		}
 	}
 
-	*upper_ptrw = 0;
+	upper_ptrw[len] = 0;
 
 	return upper;
 }
@@ -1738,12 +1956,20 @@ String String::to_lower() const {
 	lower.resize(size());
 	const char32_t *old_ptr = ptr();
 	char32_t *lower_ptrw = lower.ptrw();
+	const int len = length();
 
-	while (*old_ptr) {
-		*lower_ptrw++ = _find_lower(*old_ptr++);
+	for (int i = 0; i < len; i += UTF8_ASCII_CHUNK) {
+		const int chunk_len = MIN(UTF8_ASCII_CHUNK, len - i);
+		if (chunk_len == UTF8_ASCII_CHUNK && _utf32_is_ascii_chunk(old_ptr + i)) {
+			_utf32_ascii_chunk_change_case(old_ptr + i, lower_ptrw + i, 'A', 'Z', 'a' - 'A');
+		} else {
+			for (int j = i; j < i + chunk_len; j++) {
+				lower_ptrw[j] = _find_lower(old_ptr[j]);
+			}
+		}
 	}
 
-	*lower_ptrw = 0;
+	lower_ptrw[len] = 0;
 
 	return lower;
 }
@@ -1919,7 +2145,11 @@ String String::num_uint64(uint64_t p_num, int base, bool capitalize_hex) {
 String String::num_real(double p_num, bool p_trailing) {
 	if (p_num == (double)(int64_t)p_num) {
 		if (p_trailing) {
-			return num_int64((int64_t)p_num) + ".0";
+			// Build it inline to allocate only the resulting string.
+			SmallString<24> s;
+			s.append_int((int64_t)p_num);
+			s.append(".0");
+			return s.as_string();
 		} else {
 			return num_int64((int64_t)p_num);
 		}
@@ -2085,14 +2315,32 @@ Error String::parse_utf8(const char *p_utf8, int p_len, bool p_skip_cr) {
 		}
 	}
 
+	if (p_len < 0) {
+		p_len = strlen(p_utf8);
+	}
+
 	bool decode_error = false;
 	bool decode_failed = false;
 	{
 		const char *ptrtmp = p_utf8;
-		const char *ptrtmp_limit = p_len >= 0 ? &p_utf8[p_len] : nullptr;
+		const char *ptrtmp_limit = &p_utf8[p_len];
 		int skip = 0;
+		int ascii_check_delay = 0;
 		uint8_t c_start = 0;
 		while (ptrtmp != ptrtmp_limit && *ptrtmp) {
+			if (skip == 0 && ascii_check_delay == 0 && ptrtmp_limit - ptrtmp >= UTF8_ASCII_CHUNK) {
+				if (_utf8_is_ascii_chunk((const uint8_t *)ptrtmp, p_skip_cr)) {
+					ptrtmp += UTF8_ASCII_CHUNK;
+					cstr_size += UTF8_ASCII_CHUNK;
+					str_size += UTF8_ASCII_CHUNK;
+					continue;
+				}
+				// Go through this chunk one byte at a time before checking the next one.
+				ascii_check_delay = UTF8_ASCII_CHUNK;
+			}
+			if (ascii_check_delay > 0) {
+				ascii_check_delay--;
+			}
 #if CHAR_MIN == 0
 			uint8_t c = *ptrtmp;
 #else
@@ -2163,8 +2411,22 @@ Error String::parse_utf8(const char *p_utf8, int p_len, bool p_skip_cr) {
 	dst[str_size] = 0;
 
 	int skip = 0;
+	int ascii_check_delay = 0;
 	uint32_t unichar = 0;
 	while (cstr_size) {
+		if (skip == 0 && ascii_check_delay == 0 && cstr_size >= UTF8_ASCII_CHUNK) {
+			if (_utf8_is_ascii_chunk((const uint8_t *)p_utf8, p_skip_cr)) {
+				_utf8_ascii_chunk_to_utf32((const uint8_t *)p_utf8, dst);
+				dst += UTF8_ASCII_CHUNK;
+				p_utf8 += UTF8_ASCII_CHUNK;
+				cstr_size -= UTF8_ASCII_CHUNK;
+				continue;
+			}
+			ascii_check_delay = UTF8_ASCII_CHUNK;
+		}
+		if (ascii_check_delay > 0) {
+			ascii_check_delay--;
+		}
 #if CHAR_MIN == 0
 		uint8_t c = *p_utf8;
 #else
@@ -2243,48 +2505,51 @@ Error String::parse_utf8(const char *p_utf8, int p_len, bool p_skip_cr) {
 	}
 }
 
-CharString String::utf8() const {
-	int l = length();
-	if (!l) {
-		return CharString();
-	}
-
-	const char32_t *d = &operator[](0);
-	int fl = 0;
-	for (int i = 0; i < l; i++) {
-		uint32_t c = d[i];
-		if (c <= 0x7f) { // 7 bits.
-			fl += 1;
-		} else if (c <= 0x7ff) { // 11 bits
-			fl += 2;
-		} else if (c <= 0xffff) { // 16 bits
-			fl += 3;
-		} else if (c <= 0x001fffff) { // 21 bits
-			fl += 4;
-		} else if (c <= 0x03ffffff) { // 26 bits
-			fl += 5;
-			print_unicode_error(vformat("Invalid unicode codepoint (%x)", c));
-		} else if (c <= 0x7fffffff) { // 31 bits
-			fl += 6;
-			print_unicode_error(vformat("Invalid unicode codepoint (%x)", c));
-		} else {
-			fl += 1;
-			print_unicode_error(vformat("Invalid unicode codepoint (%x), cannot represent as UTF-8", c), true);
-		}
+static _FORCE_INLINE_ int _utf8_char_length(uint32_t p_char) {
+	if (p_char <= 0x7f) { // 7 bits.
+		return 1;
+	} else if (p_char <= 0x7ff) { // 11 bits
+		return 2;
+	} else if (p_char <= 0xffff) { // 16 bits
+		return 3;
+	} else if (p_char <= 0x001fffff) { // 21 bits
+		return 4;
+	} else if (p_char <= 0x03ffffff) { // 26 bits
+		return 5;
+	} else if (p_char <= 0x7fffffff) { // 31 bits
+		return 6;
+	} else {
+		return 3; // Replacement character.
 	}
+}
 
-	CharString utf8s;
-	if (fl == 0) {
-		return utf8s;
-	}
-
-	utf8s.resize(fl + 1);
-	uint8_t *cdst = (uint8_t *)utf8s.get_data();
+// Encodes as many whole characters as fit in p_dst_size bytes, returns the number of bytes written.
+static int _utf32_to_utf8(const char32_t *p_src, int p_len, uint8_t *p_dst, int p_dst_size) {
+	uint8_t *cdst = p_dst;
+	const uint8_t *cdst_limit = p_dst + p_dst_size;
 
 #define APPEND_CHAR(m_c) *(cdst++) = m_c
 
-	for (int i = 0; i < l; i++) {
-		uint32_t c = d[i];
+	int i = 0;
+	int ascii_check_delay = 0;
+	while (i < p_len) {
+		if (ascii_check_delay == 0 && p_len - i >= UTF8_ASCII_CHUNK && cdst_limit - cdst >= UTF8_ASCII_CHUNK) {
+			if (_utf32_is_ascii_chunk(p_src + i)) {
+				_utf32_ascii_chunk_to_utf8(p_src + i, cdst);
+				cdst += UTF8_ASCII_CHUNK;
+				i += UTF8_ASCII_CHUNK;
+				continue;
+			}
+			ascii_check_delay = UTF8_ASCII_CHUNK;
+		}
+		if (ascii_check_delay > 0) {
+			ascii_check_delay--;
+		}
+
+		uint32_t c = p_src[i++];
+		if (unlikely(cdst_limit - cdst < 6) && cdst_limit - cdst < _utf8_char_length(c)) {
+			break;
+		}
 
 		if (c <= 0x7f) { // 7 bits.
 			APPEND_CHAR(c);
@@ -2314,15 +2579,72 @@ CharString String::utf8() const {
 			APPEND_CHAR(uint32_t(0x80 | ((c >> 6) & 0x3f))); // Lower lower middle 6 bits.
 			APPEND_CHAR(uint32_t(0x80 | (c & 0x3f))); // Bottom 6 bits.
 		} else {
-			// the string is a valid UTF32, so it should never happen ...
-			print_unicode_error(vformat("Non scalar value (%x)", c), true);
-			APPEND_CHAR(uint32_t(0xe0 | ((_replacement_char >> 12) & 0x0f))); // Top 4 bits.
-			APPEND_CHAR(uint32_t(0x80 | ((_replacement_char >> 6) & 0x3f))); // Middle 6 bits.
-			APPEND_CHAR(uint32_t(0x80 | (_replacement_char & 0x3f))); // Bottom 6 bits.
+			// Not a scalar value, already reported by utf8_byte_length().
+			const uint32_t replacement_char = 0xfffd;
+			APPEND_CHAR(uint32_t(0xe0 | ((replacement_char >> 12) & 0x0f))); // Top 4 bits.
+			APPEND_CHAR(uint32_t(0x80 | ((replacement_char >> 6) & 0x3f))); // Middle 6 bits.
+			APPEND_CHAR(uint32_t(0x80 | (replacement_char & 0x3f))); // Bottom 6 bits.
 		}
 	}
 #undef APPEND_CHAR
-	*cdst = 0; //trailing zero
+
+	return cdst - p_dst;
+}
+
+int String::utf8_byte_length() const {
+	const int l = length();
+	const char32_t *d = ptr();
+	int fl = 0;
+	int i = 0;
+	int ascii_check_delay = 0;
+	while (i < l) {
+		if (ascii_check_delay == 0 && l - i >= UTF8_ASCII_CHUNK) {
+			if (_utf32_is_ascii_chunk(d + i)) {
+				fl += UTF8_ASCII_CHUNK;
+				i += UTF8_ASCII_CHUNK;
+				continue;
+			}
+			ascii_check_delay = UTF8_ASCII_CHUNK;
+		}
+		if (ascii_check_delay > 0) {
+			ascii_check_delay--;
+		}
+
+		uint32_t c = d[i++];
+		if (c > 0x001fffff) {
+			if (c <= 0x7fffffff) {
+				print_unicode_error(vformat("Invalid unicode codepoint (%x)", c));
+			} else {
+				print_unicode_error(vformat("Invalid unicode codepoint (%x), cannot represent as UTF-8", c), true);
+			}
+		}
+		fl += _utf8_char_length(c);
+	}
+	return fl;
+}
+
+int String::utf8_to_buffer(char *r_buffer, int p_buffer_size) const {
+	ERR_FAIL_COND_V(p_buffer_size < 0, 0);
+	return _utf32_to_utf8(ptr(), length(), (uint8_t *)r_buffer, p_buffer_size);
+}
+
+CharString String::utf8() const {
+	int l = length();
+	if (!l) {
+		return CharString();
+	}
+
+	int fl = utf8_byte_length();
+
+	CharString utf8s;
+	if (fl == 0) {
+		return utf8s;
+	}
+
+	utf8s.resize(fl + 1);
+	uint8_t *cdst = (uint8_t *)utf8s.get_data();
+	_utf32_to_utf8(ptr(), l, cdst, fl);
+	cdst[fl] = 0; //trailing zero
 
 	return utf8s;
 }
@@ -3278,6 +3600,69 @@ String String::substr(int p_from, int p_chars) const {
 	return s;
 }
 
+// Index of the first p_key that starts in [p_from, p_last], or -1.
+template <typename T>
+static int _find_substr(const char32_t *p_src, int p_from, int p_last, const T *p_key, int p_key_len) {
+	const char32_t first = (char32_t)p_key[0];
+	int i = p_from;
+	while (i <= p_last) {
+		i = _find_char(p_src, i, p_last + 1, first);
+		if (i < 0) {
+			return -1;
+		}
+		int j = 1;
+		while (j < p_key_len && p_src[i + j] == (char32_t)p_key[j]) {
+			j++;
+		}
+		if (j == p_key_len) {
+			return i;
+		}
+		i++;
+	}
+	return -1;
+}
+
+// Index of the last p_key that starts in [0, p_from], or -1.
+template <typename T>
+static int _rfind_substr(const char32_t *p_src, int p_from, const T *p_key, int p_key_len) {
+	const char32_t first = (char32_t)p_key[0];
+	int i = p_from;
+	while (i >= 0) {
+		i = _rfind_char(p_src, i, first);
+		if (i < 0) {
+			return -1;
+		}
+		int j = 1;
+		while (j < p_key_len && p_src[i + j] == (char32_t)p_key[j]) {
+			j++;
+		}
+		if (j == p_key_len) {
+			return i;
+		}
+		i--;
+	}
+	return -1;
+}
+
+// Case-insensitive _find_substr(). The key is lowered as it is compared, so it needs no lowercase copy.
+template <typename T>
+static int _findn_substr(const char32_t *p_src, int p_from, int p_last, const T *p_key, int p_key_len) {
+	const int first = _find_lower((char32_t)p_key[0]);
+	for (int i = p_from; i <= p_last; i++) {
+		if (_find_lower(p_src[i]) != first) {
+			continue;
+		}
+		int j = 1;
+		while (j < p_key_len && _find_lower(p_src[i + j]) == _find_lower((char32_t)p_key[j])) {
+			j++;
+		}
+		if (j == p_key_len) {
+			return i;
+		}
+	}
+	return -1;
+}
+
 int String::find(const String &p_str, int p_from) const {
 	if (p_from < 0) {
 		return -1;
@@ -3291,31 +3676,7 @@ int String::find(const String &p_str, int p_from) const {
 		return -1; // won't find anything!
 	}
 
-	const char32_t *src = get_data();
-	const char32_t *str = p_str.get_data();
-
-	for (int i = p_from; i <= (len - src_len); i++) {
-		bool found = true;
-		for (int j = 0; j < src_len; j++) {
-			int read_pos = i + j;
-
-			if (read_pos >= len) {
-				ERR_PRINT("read_pos>=len");
-				return -1;
-			}
-
-			if (src[read_pos] != str[j]) {
-				found = false;
-				break;
-			}
-		}
-
-		if (found) {
-			return i;
-		}
-	}
-
-	return -1;
+	return _find_substr(get_data(), p_from, len - src_len, p_str.get_data(), src_len);
 }
 
 int String::find(const char *p_str, int p_from) const {
@@ -3331,41 +3692,7 @@ int String::find(const char *p_str, int p_from) const {
 		return -1; // won't find anything!
 	}
 
-	const char32_t *src = get_data();
-
-	if (src_len == 1) {
-		const char32_t needle = p_str[0];
-
-		for (int i = p_from; i < len; i++) {
-			if (src[i] == needle) {
-				return i;
-			}
-		}
-
-	} else {
-		for (int i = p_from; i <= (len - src_len); i++) {
-			bool found = true;
-			for (int j = 0; j < src_len; j++) {
-				int read_pos = i + j;
-
-				if (read_pos >= len) {
-					ERR_PRINT("read_pos>=len");
-					return -1;
-				}
-
-				if (src[read_pos] != (char32_t)p_str[j]) {
-					found = false;
-					break;
-				}
-			}
-
-			if (found) {
-				return i;
-			}
-		}
-	}
-
-	return -1;
+	return _find_substr(get_data(), p_from, len - src_len, p_str, src_len);
 }
 
 int String::find_char(const char32_t &p_char, int p_from) const {
@@ -3438,33 +3765,7 @@ int String::findn(const String &p_str, int p_from) const {
 		return -1; // won't find anything!
 	}
 
-	const char32_t *srcd = get_data();
-
-	for (int i = p_from; i <= (length() - src_len); i++) {
-		bool found = true;
-		for (int j = 0; j < src_len; j++) {
-			int read_pos = i + j;
-
-			if (read_pos >= length()) {
-				ERR_PRINT("read_pos>=length()");
-				return -1;
-			}
-
-			char32_t src = _find_lower(srcd[read_pos]);
-			char32_t dst = _find_lower(p_str[j]);
-
-			if (src != dst) {
-				found = false;
-				break;
-			}
-		}
-
-		if (found) {
-			return i;
-		}
-	}
-
-	return -1;
+	return _findn_substr(get_data(), p_from, length() - src_len, p_str.get_data(), src_len);
 }
 
 int String::findn(const char *p_str, int p_from) const {
@@ -3478,33 +3779,7 @@ int String::findn(const char *p_str, int p_from) const {
 		return -1; // won't find anything!
 	}
 
-	const char32_t *srcd = get_data();
-
-	for (int i = p_from; i <= (length() - src_len); i++) {
-		bool found = true;
-		for (int j = 0; j < src_len; j++) {
-			int read_pos = i + j;
-
-			if (read_pos >= length()) {
-				ERR_PRINT("read_pos>=length()");
-				return -1;
-			}
-
-			char32_t src = _find_lower(srcd[read_pos]);
-			char32_t dst = _find_lower(p_str[j]);
-
-			if (src != dst) {
-				found = false;
-				break;
-			}
-		}
-
-		if (found) {
-			return i;
-		}
-	}
-
-	return -1;
+	return _findn_substr(get_data(), p_from, length() - src_len, p_str, src_len);
 }
 
 int String::rfind(const String &p_str, int p_from) const {
@@ -3528,30 +3803,7 @@ int String::rfind(const String &p_str, int p_from) const {
 		return -1; // won't find anything!
 	}
 
-	const char32_t *src = get_data();
-
-	for (int i = p_from; i >= 0; i--) {
-		bool found = true;
-		for (int j = 0; j < src_len; j++) {
-			int read_pos = i + j;
-
-			if (read_pos >= len) {
-				ERR_PRINT("read_pos>=len");
-				return -1;
-			}
-
-			if (src[read_pos] != p_str[j]) {
-				found = false;
-				break;
-			}
-		}
-
-		if (found) {
-			return i;
-		}
-	}
-
-	return -1;
+	return _rfind_substr(get_data(), p_from, p_str.get_data(), src_len);
 }
 
 int String::rfind(const char *p_str, int p_from) const {
@@ -3578,31 +3830,7 @@ int String::rfind(const char *p_str, int p_from) const {
 		starting_point = p_from;
 	}
 
-	const char32_t *source = get_data();
-
-	for (int i = starting_point; i >= 0; i--) {
-		bool found = true;
-		for (int j = 0; j < substring_length; j++) {
-			int read_pos = i + j;
-
-			if (read_pos >= source_length) {
-				ERR_PRINT("read_pos>=source_length");
-				return -1;
-			}
-
-			const char32_t key_needle = p_str[j];
-			if (source[read_pos] != key_needle) {
-				found = false;
-				break;
-			}
-		}
-
-		if (found) {
-			return i;
-		}
-	}
-
-	return -1;
+	return _rfind_substr(get_data(), starting_point, p_str, substring_length);
 }
 
 int String::rfindn(const String &p_str, int p_from) const {
@@ -3819,78 +4047,78 @@ bool String::is_quoted() const {
 }
 
 int String::_count(const String &p_string, int p_from, int p_to, bool p_case_insensitive) const {
-	if (p_string.is_empty()) {
+	int slen = p_string.length();
+	if (slen == 0) {
 		return 0;
 	}
 	int len = length();
-	int slen = p_string.length();
 	if (len < slen) {
 		return 0;
 	}
-	String str;
-	if (p_from >= 0 && p_to >= 0) {
-		if (p_to == 0) {
-			p_to = len;
-		} else if (p_from >= p_to) {
-			return 0;
-		}
-		if (p_from == 0 && p_to == len) {
-			str = String();
-			str.copy_from_unchecked(&get_data()[0], len);
-		} else {
-			str = substr(p_from, p_to - p_from);
-		}
-	} else {
+	if (p_from < 0 || p_to < 0) {
+		return 0;
+	}
+	if (p_to == 0 || p_to > len) {
+		p_to = len;
+	}
+	if (p_from >= p_to) {
 		return 0;
 	}
+
+	// Search in place, from the end of the previous match.
+	const char32_t *src = get_data();
+	const int last = p_to - slen;
 	int c = 0;
-	int idx = -1;
-	do {
-		idx = p_case_insensitive ? str.findn(p_string) : str.find(p_string);
-		if (idx != -1) {
-			str = str.substr(idx + slen, str.length() - slen);
+	int idx = p_from;
+	if (p_case_insensitive) {
+		while ((idx = _findn_substr(src, idx, last, p_string.get_data(), slen)) != -1) {
+			idx += slen;
+			++c;
+		}
+	} else {
+		while ((idx = _find_substr(src, idx, last, p_string.get_data(), slen)) != -1) {
+			idx += slen;
 			++c;
 		}
-	} while (idx != -1);
+	}
 	return c;
 }
 
 int String::_count(const char *p_string, int p_from, int p_to, bool p_case_insensitive) const {
-	int substring_length = strlen(p_string);
-	if (substring_length == 0) {
+	int slen = strlen(p_string);
+	if (slen == 0) {
 		return 0;
 	}
-	const int source_length = length();
-
-	if (source_length < substring_length) {
+	int len = length();
+	if (len < slen) {
 		return 0;
 	}
-	String str;
-	int search_limit = p_to;
-	if (p_from >= 0 && p_to >= 0) {
-		if (p_to == 0) {
-			search_limit = source_length;
-		} else if (p_from >= p_to) {
-			return 0;
-		}
-		if (p_from == 0 && search_limit == source_length) {
-			str = String();
-			str.copy_from_unchecked(&get_data()[0], source_length);
-		} else {
-			str = substr(p_from, search_limit - p_from);
-		}
-	} else {
+	if (p_from < 0 || p_to < 0) {
+		return 0;
+	}
+	if (p_to == 0 || p_to > len) {
+		p_to = len;
+	}
+	if (p_from >= p_to) {
 		return 0;
 	}
+
+	// Search in place, from the end of the previous match.
+	const char32_t *src = get_data();
+	const int last = p_to - slen;
 	int c = 0;
-	int idx = -1;
-	do {
-		idx = p_case_insensitive ? str.findn(p_string) : str.find(p_string);
-		if (idx != -1) {
-			str = str.substr(idx + substring_length, str.length() - substring_length);
+	int idx = p_from;
+	if (p_case_insensitive) {
+		while ((idx = _findn_substr(src, idx, last, p_string, slen)) != -1) {
+			idx += slen;
 			++c;
 		}
-	} while (idx != -1);
+	} else {
+		while ((idx = _find_substr(src, idx, last, p_string, slen)) != -1) {
+			idx += slen;
+			++c;
+		}
+	}
 	return c;
 }
 
@@ -4054,11 +4282,9 @@ String String::format(const Variant &values, const String &placeholder) const {
 		}
 	} else if (values.get_type() == Variant::DICTIONARY) {
 		Dictionary d = values;
-		List<Variant> keys;
-		d.get_key_list(&keys);
 
-		for (const Variant &key : keys) {
-			new_string = new_string.replace(placeholder.replace("_", key), d[key]);
+		for (const KeyValue<Variant, Variant> &kv : d) {
+			new_string = new_string.replace(placeholder.replace("_", kv.key), kv.value);
 		}
 	} else {
 		ERR_PRINT(String("Invalid type: use Array or Dictionary.").ascii().get_data());
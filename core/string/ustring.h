@@ -404,6 +404,9 @@ public:
 
 	CharString ascii(bool p_allow_extended = false) const;
 	CharString utf8() const;
+	int utf8_byte_length() const; // Without the trailing zero.
+	// Writes as many whole characters as fit, without a trailing zero, and returns the number of bytes written.
+	int utf8_to_buffer(char *r_buffer, int p_buffer_size) const;
 	Error parse_utf8(const char *p_utf8, int p_len = -1, bool p_skip_cr = false);
 	static String utf8(const char *p_utf8, int p_len = -1);
 
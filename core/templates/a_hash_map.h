@@ -0,0 +1,514 @@
+/**************************************************************************/
+/*  a_hash_map.h                                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef A_HASH_MAP_H
+#define A_HASH_MAP_H
+
+#include "core/os/memory.h"
+#include "core/templates/hashfuncs.h"
+#include "core/templates/pair.h"
+
+#include <type_traits>
+
+/**
+ * An insertion ordered HashMap that stores keys and values in a contiguous
+ * array, instead of allocating a node per element.
+ *
+ * A separate open addressing index table (linear probing with backward
+ * shift deletion) maps hashes to positions in the element array. Iterating
+ * walks the array in insertion order, which is cache friendly.
+ *
+ * Erasing leaves a hole in the array so the order of the other elements is
+ * kept, and iterators stay valid. Holes are reclaimed when the array is
+ * full. Inserting may move the elements, invalidating pointers to values.
+ * Use HashMap if those need to stay valid.
+ */
+
+template <typename TKey, typename TValue,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>>
+class AHashMap {
+public:
+	static constexpr uint32_t MIN_CAPACITY = 8;
+	static constexpr uint32_t EMPTY_HASH = 0;
+
+private:
+	typedef KeyValue<TKey, TValue> Element;
+
+	struct IndexEntry {
+		uint32_t hash = EMPTY_HASH;
+		uint32_t element = 0;
+	};
+
+	Element *elements = nullptr;
+	uint32_t *element_hashes = nullptr; // EMPTY_HASH marks an erased element.
+	uint32_t element_capacity = 0;
+	uint32_t used_elements = 0; // Including the erased ones.
+	uint32_t num_elements = 0;
+
+	IndexEntry *index = nullptr;
+	uint32_t index_capacity = 0; // Power of 2, at least twice the element count.
+
+	_FORCE_INLINE_ uint32_t _hash(const TKey &p_key) const {
+		uint32_t hash = Hasher::hash(p_key);
+
+		if (unlikely(hash == EMPTY_HASH)) {
+			hash = EMPTY_HASH + 1;
+		}
+
+		return hash;
+	}
+
+	_FORCE_INLINE_ bool _lookup_index_pos(const TKey &p_key, uint32_t &r_pos) const {
+		if (unlikely(num_elements == 0)) {
+			return false;
+		}
+
+		const uint32_t hash = _hash(p_key);
+		const uint32_t mask = index_capacity - 1;
+		uint32_t pos = hash & mask;
+
+		while (true) {
+			const IndexEntry &entry = index[pos];
+			if (entry.hash == EMPTY_HASH) {
+				return false;
+			}
+			if (entry.hash == hash && Comparator::compare(elements[entry.element].key, p_key)) {
+				r_pos = pos;
+				return true;
+			}
+			pos = (pos + 1) & mask;
+		}
+	}
+
+	_FORCE_INLINE_ bool _lookup_element(const TKey &p_key, uint32_t &r_element) const {
+		uint32_t pos = 0;
+		if (_lookup_index_pos(p_key, pos)) {
+			r_element = index[pos].element;
+			return true;
+		}
+		return false;
+	}
+
+	_FORCE_INLINE_ void _index_insert(uint32_t p_hash, uint32_t p_element) {
+		const uint32_t mask = index_capacity - 1;
+		uint32_t pos = p_hash & mask;
+		while (index[pos].hash != EMPTY_HASH) {
+			pos = (pos + 1) & mask;
+		}
+		index[pos].hash = p_hash;
+		index[pos].element = p_element;
+	}
+
+	void _index_erase(uint32_t p_pos) {
+		// Backward shift deletion, move back the following entries that are
+		// not in their ideal position, so probing never needs tombstones.
+		const uint32_t mask = index_capacity - 1;
+		uint32_t hole = p_pos;
+		uint32_t pos = p_pos;
+		while (true) {
+			pos = (pos + 1) & mask;
+			if (index[pos].hash == EMPTY_HASH) {
+				break;
+			}
+			const uint32_t ideal = index[pos].hash & mask;
+			// Skip entries whose ideal position is cyclically in (hole, pos].
+			if (hole <= pos ? (hole < ideal && ideal <= pos) : (hole < ideal || ideal <= pos)) {
+				continue;
+			}
+			index[hole] = index[pos];
+			hole = pos;
+		}
+		index[hole].hash = EMPTY_HASH;
+	}
+
+	void _rebuild_index(uint32_t p_index_capacity) {
+		if (p_index_capacity != index_capacity) {
+			if (index) {
+				Memory::free_static(index);
+			}
+			index_capacity = p_index_capacity;
+			index = reinterpret_cast<IndexEntry *>(Memory::alloc_static(sizeof(IndexEntry) * index_capacity));
+		}
+		for (uint32_t i = 0; i < index_capacity; i++) {
+			index[i].hash = EMPTY_HASH;
+		}
+		for (uint32_t i = 0; i < used_elements; i++) {
+			if (element_hashes[i] != EMPTY_HASH) {
+				_index_insert(element_hashes[i], i);
+			}
+		}
+	}
+
+	void _compact() {
+		// Close the holes left by erased elements, keeping the order.
+		uint32_t dst = 0;
+		for (uint32_t i = 0; i < used_elements; i++) {
+			if (element_hashes[i] == EMPTY_HASH) {
+				continue;
+			}
+			if (dst != i) {
+				// Elements are relocated as raw memory, like in the other containers.
+				memcpy((void *)&elements[dst], (const void *)&elements[i], sizeof(Element));
+				element_hashes[dst] = element_hashes[i];
+			}
+			dst++;
+		}
+		used_elements = dst;
+		_rebuild_index(index_capacity);
+	}
+
+	void _resize_elements(uint32_t p_capacity) {
+		element_capacity = p_capacity;
+		elements = reinterpret_cast<Element *>(Memory::realloc_static(elements, sizeof(Element) * element_capacity));
+		element_hashes = reinterpret_cast<uint32_t *>(Memory::realloc_static(element_hashes, sizeof(uint32_t) * element_capacity));
+	}
+
+	uint32_t _insert(const TKey &p_key, const TValue &p_value) {
+		uint32_t element = 0;
+		if (_lookup_element(p_key, element)) {
+			elements[element].value = p_value;
+			return element;
+		}
+
+		if (unlikely(used_elements == element_capacity)) {
+			if (element_capacity > 0 && used_elements - num_elements >= element_capacity / 4) {
+				_compact();
+			} else {
+				_resize_elements(MAX(MIN_CAPACITY, element_capacity * 2));
+			}
+		}
+		if (unlikely((num_elements + 1) * 2 > index_capacity)) {
+			_rebuild_index(MAX(MIN_CAPACITY * 2, index_capacity * 2));
+		}
+
+		const uint32_t hash = _hash(p_key);
+		element = used_elements++;
+		memnew_placement(&elements[element], Element(p_key, p_value));
+		element_hashes[element] = hash;
+		_index_insert(hash, element);
+		num_elements++;
+		return element;
+	}
+
+	_FORCE_INLINE_ uint32_t _first_element() const {
+		uint32_t element = 0;
+		while (element < used_elements && element_hashes[element] == EMPTY_HASH) {
+			element++;
+		}
+		return element;
+	}
+
+public:
+	_FORCE_INLINE_ uint32_t get_capacity() const { return element_capacity; }
+	_FORCE_INLINE_ uint32_t size() const { return num_elements; }
+
+	/* Standard Godot Container API */
+
+	bool is_empty() const {
+		return num_elements == 0;
+	}
+
+	void clear() {
+		if (used_elements == 0) {
+			return;
+		}
+		if constexpr (!(std::is_trivially_destructible_v<TKey> && std::is_trivially_destructible_v<TValue>)) {
+			for (uint32_t i = 0; i < used_elements; i++) {
+				if (element_hashes[i] != EMPTY_HASH) {
+					elements[i].~Element();
+				}
+			}
+		}
+		for (uint32_t i = 0; i < index_capacity; i++) {
+			index[i].hash = EMPTY_HASH;
+		}
+		used_elements = 0;
+		num_elements = 0;
+	}
+
+	TValue &get(const TKey &p_key) {
+		uint32_t element = 0;
+		bool exists = _lookup_element(p_key, element);
+		CRASH_COND_MSG(!exists, "AHashMap key not found.");
+		return elements[element].value;
+	}
+
+	const TValue &get(const TKey &p_key) const {
+		uint32_t element = 0;
+		bool exists = _lookup_element(p_key, element);
+		CRASH_COND_MSG(!exists, "AHashMap key not found.");
+		return elements[element].value;
+	}
+
+	const TValue *getptr(const TKey &p_key) const {
+		uint32_t element = 0;
+		if (_lookup_element(p_key, element)) {
+			return &elements[element].value;
+		}
+		return nullptr;
+	}
+
+	TValue *getptr(const TKey &p_key) {
+		uint32_t element = 0;
+		if (_lookup_element(p_key, element)) {
+			return &elements[element].value;
+		}
+		return nullptr;
+	}
+
+	_FORCE_INLINE_ bool has(const TKey &p_key) const {
+		uint32_t element = 0;
+		return _lookup_element(p_key, element);
+	}
+
+	bool erase(const TKey &p_key) {
+		uint32_t pos = 0;
+		if (!_lookup_index_pos(p_key, pos)) {
+			return false;
+		}
+
+		const uint32_t element = index[pos].element;
+		_index_erase(pos);
+		elements[element].~Element();
+		element_hashes[element] = EMPTY_HASH;
+		num_elements--;
+
+		// Holes at the end of the array can be reused right away.
+		while (used_elements > 0 && element_hashes[used_elements - 1] == EMPTY_HASH) {
+			used_elements--;
+		}
+		return true;
+	}
+
+	// Reserves space for a number of elements, useful to avoid many resizes and rehashes.
+	// If adding a known (possibly large) number of elements at once, must be larger than old capacity.
+	void reserve(uint32_t p_new_capacity) {
+		if (p_new_capacity == 0) {
+			return;
+		}
+		if (p_new_capacity > element_capacity) {
+			_resize_elements(p_new_capacity);
+		}
+		uint32_t new_index_capacity = MIN_CAPACITY * 2;
+		while (new_index_capacity < p_new_capacity * 2) {
+			new_index_capacity *= 2;
+		}
+		if (new_index_capacity > index_capacity) {
+			_rebuild_index(new_index_capacity);
+		}
+	}
+
+	/** Iterator API **/
+
+	struct ConstIterator {
+		_FORCE_INLINE_ const KeyValue<TKey, TValue> &operator*() const {
+			return map->elements[element];
+		}
+		_FORCE_INLINE_ const KeyValue<TKey, TValue> *operator->() const { return &map->elements[element]; }
+		_FORCE_INLINE_ ConstIterator &operator++() {
+			do {
+				element++;
+			} while (element < map->used_elements && map->element_hashes[element] == EMPTY_HASH);
+			return *this;
+		}
+		_FORCE_INLINE_ ConstIterator &operator--() {
+			while (element > 0) {
+				element--;
+				if (map->element_hashes[element] != EMPTY_HASH) {
+					return *this;
+				}
+			}
+			element = map->used_elements;
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const ConstIterator &b) const { return element == b.element; }
+		_FORCE_INLINE_ bool operator!=(const ConstIterator &b) const { return element != b.element; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return map && element < map->used_elements;
+		}
+
+		_FORCE_INLINE_ ConstIterator(const AHashMap *p_map, uint32_t p_element) :
+				map(p_map), element(p_element) {}
+		_FORCE_INLINE_ ConstIterator() {}
+
+	private:
+		const AHashMap *map = nullptr;
+		uint32_t element = 0;
+	};
+
+	struct Iterator {
+		_FORCE_INLINE_ KeyValue<TKey, TValue> &operator*() const {
+			return map->elements[element];
+		}
+		_FORCE_INLINE_ KeyValue<TKey, TValue> *operator->() const { return &map->elements[element]; }
+		_FORCE_INLINE_ Iterator &operator++() {
+			do {
+				element++;
+			} while (element < map->used_elements && map->element_hashes[element] == EMPTY_HASH);
+			return *this;
+		}
+		_FORCE_INLINE_ Iterator &operator--() {
+			while (element > 0) {
+				element--;
+				if (map->element_hashes[element] != EMPTY_HASH) {
+					return *this;
+				}
+			}
+			element = map->used_elements;
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const Iterator &b) const { return element == b.element; }
+		_FORCE_INLINE_ bool operator!=(const Iterator &b) const { return element != b.element; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return map && element < map->used_elements;
+		}
+
+		_FORCE_INLINE_ Iterator(AHashMap *p_map, uint32_t p_element) :
+				map(p_map), element(p_element) {}
+		_FORCE_INLINE_ Iterator() {}
+
+		operator ConstIterator() const {
+			return ConstIterator(map, element);
+		}
+
+	private:
+		AHashMap *map = nullptr;
+		uint32_t element = 0;
+	};
+
+	_FORCE_INLINE_ Iterator begin() {
+		return Iterator(this, _first_element());
+	}
+	_FORCE_INLINE_ Iterator end() {
+		return Iterator(this, used_elements);
+	}
+	_FORCE_INLINE_ Iterator last() {
+		return --end();
+	}
+
+	_FORCE_INLINE_ Iterator find(const TKey &p_key) {
+		uint32_t element = 0;
+		if (!_lookup_element(p_key, element)) {
+			return end();
+		}
+		return Iterator(this, element);
+	}
+
+	_FORCE_INLINE_ void remove(const Iterator &p_iter) {
+		if (p_iter) {
+			erase(p_iter->key);
+		}
+	}
+
+	_FORCE_INLINE_ ConstIterator begin() const {
+		return ConstIterator(this, _first_element());
+	}
+	_FORCE_INLINE_ ConstIterator end() const {
+		return ConstIterator(this, used_elements);
+	}
+	_FORCE_INLINE_ ConstIterator last() const {
+		return --end();
+	}
+
+	_FORCE_INLINE_ ConstIterator find(const TKey &p_key) const {
+		uint32_t element = 0;
+		if (!_lookup_element(p_key, element)) {
+			return end();
+		}
+		return ConstIterator(this, element);
+	}
+
+	/* Indexing */
+
+	const TValue &operator[](const TKey &p_key) const {
+		uint32_t element = 0;
+		bool exists = _lookup_element(p_key, element);
+		CRASH_COND(!exists);
+		return elements[element].value;
+	}
+
+	TValue &operator[](const TKey &p_key) {
+		uint32_t element = 0;
+		if (!_lookup_element(p_key, element)) {
+			element = _insert(p_key, TValue());
+		}
+		return elements[element].value;
+	}
+
+	/* Insert */
+
+	Iterator insert(const TKey &p_key, const TValue &p_value) {
+		return Iterator(this, _insert(p_key, p_value));
+	}
+
+	/* Constructors */
+
+	AHashMap(const AHashMap &p_other) {
+		reserve(p_other.num_elements);
+		for (const KeyValue<TKey, TValue> &E : p_other) {
+			insert(E.key, E.value);
+		}
+	}
+
+	void operator=(const AHashMap &p_other) {
+		if (this == &p_other) {
+			return; // Ignore self assignment.
+		}
+		clear();
+		reserve(p_other.num_elements);
+		for (const KeyValue<TKey, TValue> &E : p_other) {
+			insert(E.key, E.value);
+		}
+	}
+
+	AHashMap(uint32_t p_initial_capacity) {
+		reserve(p_initial_capacity);
+	}
+	AHashMap() {}
+
+	~AHashMap() {
+		clear();
+
+		if (elements != nullptr) {
+			Memory::free_static(elements);
+			Memory::free_static(element_hashes);
+		}
+		if (index != nullptr) {
+			Memory::free_static(index);
+		}
+	}
+};
+
+#endif // A_HASH_MAP_H
@@ -0,0 +1,530 @@
+/**************************************************************************/
+/*  flat_hash_map.h                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef FLAT_HASH_MAP_H
+#define FLAT_HASH_MAP_H
+
+#include "core/os/memory.h"
+#include "core/templates/hashfuncs.h"
+#include "core/templates/pair.h"
+
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FLAT_HASH_MAP_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+/**
+ * An unordered HashMap that stores keys and values inline, in a single
+ * array, instead of allocating a node per element (Swiss table layout).
+ *
+ * Each slot has a control byte holding 7 bits of the key hash, or a marker
+ * for empty and deleted slots. Lookups probe groups of 16 control bytes at
+ * once (with SSE2 where available) and only compare the keys whose hash
+ * bits match, so most lookups touch one group and one slot.
+ *
+ * Iteration order is unspecified and changes when the map grows. Inserting
+ * and erasing invalidate pointers to values and iterators. Use HashMap or
+ * AHashMap when the order matters.
+ */
+
+struct FlatHashMapGroup {
+	static constexpr uint32_t WIDTH = 16;
+	static constexpr uint8_t EMPTY = 0x80;
+	static constexpr uint8_t DELETED = 0xFE;
+
+#ifdef FLAT_HASH_MAP_SSE2
+	__m128i ctrl;
+
+	_FORCE_INLINE_ explicit FlatHashMapGroup(const uint8_t *p_ctrl) {
+		ctrl = _mm_loadu_si128((const __m128i *)p_ctrl);
+	}
+	_FORCE_INLINE_ uint32_t match(uint8_t p_h2) const {
+		return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)p_h2)));
+	}
+	_FORCE_INLINE_ uint32_t match_empty() const {
+		return match(EMPTY);
+	}
+	_FORCE_INLINE_ uint32_t match_empty_or_deleted() const {
+		// Only empty and deleted slots have the high bit set.
+		return (uint32_t)_mm_movemask_epi8(ctrl);
+	}
+#else
+	const uint8_t *ctrl;
+
+	_FORCE_INLINE_ explicit FlatHashMapGroup(const uint8_t *p_ctrl) {
+		ctrl = p_ctrl;
+	}
+	_FORCE_INLINE_ uint32_t match(uint8_t p_h2) const {
+		uint32_t mask = 0;
+		for (uint32_t i = 0; i < WIDTH; i++) {
+			mask |= uint32_t(ctrl[i] == p_h2) << i;
+		}
+		return mask;
+	}
+	_FORCE_INLINE_ uint32_t match_empty() const {
+		return match(EMPTY);
+	}
+	_FORCE_INLINE_ uint32_t match_empty_or_deleted() const {
+		uint32_t mask = 0;
+		for (uint32_t i = 0; i < WIDTH; i++) {
+			mask |= uint32_t(ctrl[i] >> 7) << i;
+		}
+		return mask;
+	}
+#endif
+
+	// Index of the lowest set bit, p_mask must not be zero.
+	static _FORCE_INLINE_ uint32_t lowest_bit(uint32_t p_mask) {
+#if defined(__GNUC__) || defined(__clang__)
+		return __builtin_ctz(p_mask);
+#elif defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward(&index, p_mask);
+		return index;
+#else
+		uint32_t index = 0;
+		while (!(p_mask & 1)) {
+			p_mask >>= 1;
+			index++;
+		}
+		return index;
+#endif
+	}
+};
+
+template <typename TKey, typename TValue,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>>
+class FlatHashMap {
+public:
+	static constexpr uint32_t MIN_CAPACITY = FlatHashMapGroup::WIDTH;
+
+private:
+	typedef FlatHashMapGroup Group;
+	typedef KeyValue<TKey, TValue> Element;
+
+	uint8_t *ctrl = nullptr;
+	KeyValue<TKey, TValue> *slots = nullptr;
+	uint32_t capacity = 0; // Power of 2, multiple of the group width.
+	uint32_t num_elements = 0;
+	uint32_t growth_left = 0; // Empty slots that can be filled before growing.
+
+	static _FORCE_INLINE_ uint32_t _hash(const TKey &p_key) {
+		// Group selection and the control bytes use different bits of the
+		// hash, mix it so they are not correlated.
+		return hash_fmix32(Hasher::hash(p_key));
+	}
+
+	static _FORCE_INLINE_ uint32_t _max_elements(uint32_t p_capacity) {
+		// Up to 7/8 of the slots are used.
+		return p_capacity - p_capacity / 8;
+	}
+
+	_FORCE_INLINE_ bool _lookup_pos(const TKey &p_key, uint32_t &r_pos) const {
+		if (unlikely(num_elements == 0)) {
+			return false;
+		}
+
+		const uint32_t hash = _hash(p_key);
+		const uint8_t h2 = hash & 0x7F;
+		const uint32_t group_mask = capacity / Group::WIDTH - 1;
+		uint32_t group = (hash >> 7) & group_mask;
+
+		for (uint32_t step = 1;; step++) {
+			const uint32_t base = group * Group::WIDTH;
+			const Group g(ctrl + base);
+			uint32_t match = g.match(h2);
+			while (match) {
+				const uint32_t pos = base + Group::lowest_bit(match);
+				if (Comparator::compare(slots[pos].key, p_key)) {
+					r_pos = pos;
+					return true;
+				}
+				match &= match - 1;
+			}
+			if (likely(g.match_empty())) {
+				return false;
+			}
+			// Triangular probing visits every group, as their count is a power of 2.
+			group = (group + step) & group_mask;
+		}
+	}
+
+	_FORCE_INLINE_ uint32_t _find_free_pos(uint32_t p_hash) const {
+		const uint32_t group_mask = capacity / Group::WIDTH - 1;
+		uint32_t group = (p_hash >> 7) & group_mask;
+
+		for (uint32_t step = 1;; step++) {
+			const uint32_t base = group * Group::WIDTH;
+			const uint32_t free = Group(ctrl + base).match_empty_or_deleted();
+			if (free) {
+				return base + Group::lowest_bit(free);
+			}
+			group = (group + step) & group_mask;
+		}
+	}
+
+	void _resize_and_rehash(uint32_t p_new_capacity) {
+		uint8_t *old_ctrl = ctrl;
+		KeyValue<TKey, TValue> *old_slots = slots;
+		uint32_t old_capacity = capacity;
+
+		capacity = p_new_capacity;
+		ctrl = reinterpret_cast<uint8_t *>(Memory::alloc_static(capacity));
+		slots = reinterpret_cast<KeyValue<TKey, TValue> *>(Memory::alloc_static(sizeof(KeyValue<TKey, TValue>) * capacity));
+		memset(ctrl, Group::EMPTY, capacity);
+		growth_left = _max_elements(capacity) - num_elements;
+
+		if (old_ctrl == nullptr) {
+			return;
+		}
+
+		for (uint32_t i = 0; i < old_capacity; i++) {
+			if (old_ctrl[i] & 0x80) {
+				continue;
+			}
+			// Elements are relocated as raw memory, like in the other containers.
+			const uint32_t pos = _find_free_pos(_hash(old_slots[i].key));
+			ctrl[pos] = old_ctrl[i];
+			memcpy((void *)&slots[pos], (const void *)&old_slots[i], sizeof(KeyValue<TKey, TValue>));
+		}
+
+		Memory::free_static(old_ctrl);
+		Memory::free_static(old_slots);
+	}
+
+	uint32_t _insert(const TKey &p_key, const TValue &p_value) {
+		uint32_t pos = 0;
+		if (_lookup_pos(p_key, pos)) {
+			slots[pos].value = p_value;
+			return pos;
+		}
+
+		const uint32_t hash = _hash(p_key);
+		if (unlikely(ctrl == nullptr)) {
+			_resize_and_rehash(MIN_CAPACITY);
+		}
+		pos = _find_free_pos(hash);
+
+		if (unlikely(growth_left == 0 && ctrl[pos] == Group::EMPTY)) {
+			// Out of empty slots. If many are deleted, rehashing at the same
+			// capacity is enough to reclaim them.
+			const bool grow = num_elements >= _max_elements(capacity) / 2;
+			_resize_and_rehash(grow ? capacity * 2 : capacity);
+			pos = _find_free_pos(hash);
+		}
+
+		if (ctrl[pos] == Group::EMPTY) {
+			growth_left--;
+		}
+		ctrl[pos] = hash & 0x7F;
+		memnew_placement(&slots[pos], Element(p_key, p_value));
+		num_elements++;
+		return pos;
+	}
+
+	void _erase_pos(uint32_t p_pos) {
+		slots[p_pos].~KeyValue<TKey, TValue>();
+		num_elements--;
+
+		// Probing only continues past groups with no empty slot, so if this
+		// group has one, the slot can be marked empty again.
+		const uint32_t base = p_pos & ~(Group::WIDTH - 1);
+		if (Group(ctrl + base).match_empty()) {
+			ctrl[p_pos] = Group::EMPTY;
+			growth_left++;
+		} else {
+			ctrl[p_pos] = Group::DELETED;
+		}
+	}
+
+public:
+	_FORCE_INLINE_ uint32_t get_capacity() const { return capacity; }
+	_FORCE_INLINE_ uint32_t size() const { return num_elements; }
+
+	/* Standard Godot Container API */
+
+	bool is_empty() const {
+		return num_elements == 0;
+	}
+
+	void clear() {
+		if (ctrl == nullptr) {
+			return;
+		}
+		if constexpr (!(std::is_trivially_destructible_v<TKey> && std::is_trivially_destructible_v<TValue>)) {
+			for (uint32_t i = 0; i < capacity && num_elements; i++) {
+				if (!(ctrl[i] & 0x80)) {
+					slots[i].~KeyValue<TKey, TValue>();
+					num_elements--;
+				}
+			}
+		}
+		memset(ctrl, Group::EMPTY, capacity);
+		num_elements = 0;
+		growth_left = _max_elements(capacity);
+	}
+
+	TValue &get(const TKey &p_key) {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		CRASH_COND_MSG(!exists, "FlatHashMap key not found.");
+		return slots[pos].value;
+	}
+
+	const TValue &get(const TKey &p_key) const {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		CRASH_COND_MSG(!exists, "FlatHashMap key not found.");
+		return slots[pos].value;
+	}
+
+	const TValue *getptr(const TKey &p_key) const {
+		uint32_t pos = 0;
+		if (_lookup_pos(p_key, pos)) {
+			return &slots[pos].value;
+		}
+		return nullptr;
+	}
+
+	TValue *getptr(const TKey &p_key) {
+		uint32_t pos = 0;
+		if (_lookup_pos(p_key, pos)) {
+			return &slots[pos].value;
+		}
+		return nullptr;
+	}
+
+	_FORCE_INLINE_ bool has(const TKey &p_key) const {
+		uint32_t pos = 0;
+		return _lookup_pos(p_key, pos);
+	}
+
+	bool erase(const TKey &p_key) {
+		uint32_t pos = 0;
+		if (!_lookup_pos(p_key, pos)) {
+			return false;
+		}
+		_erase_pos(pos);
+		return true;
+	}
+
+	// Reserves space for a number of elements, useful to avoid many resizes and rehashes.
+	// If adding a known (possibly large) number of elements at once, must be larger than old capacity.
+	void reserve(uint32_t p_new_capacity) {
+		if (p_new_capacity == 0) {
+			return;
+		}
+		uint32_t new_capacity = MIN_CAPACITY;
+		while (_max_elements(new_capacity) < p_new_capacity) {
+			new_capacity *= 2;
+		}
+		if (new_capacity <= capacity) {
+			return;
+		}
+		_resize_and_rehash(new_capacity);
+	}
+
+	/** Iterator API **/
+
+	struct ConstIterator {
+		_FORCE_INLINE_ const KeyValue<TKey, TValue> &operator*() const {
+			return slots[pos];
+		}
+		_FORCE_INLINE_ const KeyValue<TKey, TValue> *operator->() const { return &slots[pos]; }
+		_FORCE_INLINE_ ConstIterator &operator++() {
+			do {
+				pos++;
+			} while (pos < capacity && (ctrl[pos] & 0x80));
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const ConstIterator &b) const { return pos == b.pos; }
+		_FORCE_INLINE_ bool operator!=(const ConstIterator &b) const { return pos != b.pos; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return pos < capacity;
+		}
+
+		_FORCE_INLINE_ ConstIterator(const uint8_t *p_ctrl, const KeyValue<TKey, TValue> *p_slots, uint32_t p_capacity, uint32_t p_pos) :
+				ctrl(p_ctrl), slots(p_slots), capacity(p_capacity), pos(p_pos) {}
+		_FORCE_INLINE_ ConstIterator() {}
+
+	private:
+		const uint8_t *ctrl = nullptr;
+		const KeyValue<TKey, TValue> *slots = nullptr;
+		uint32_t capacity = 0;
+		uint32_t pos = 0;
+	};
+
+	struct Iterator {
+		_FORCE_INLINE_ KeyValue<TKey, TValue> &operator*() const {
+			return slots[pos];
+		}
+		_FORCE_INLINE_ KeyValue<TKey, TValue> *operator->() const { return &slots[pos]; }
+		_FORCE_INLINE_ Iterator &operator++() {
+			do {
+				pos++;
+			} while (pos < capacity && (ctrl[pos] & 0x80));
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const Iterator &b) const { return pos == b.pos; }
+		_FORCE_INLINE_ bool operator!=(const Iterator &b) const { return pos != b.pos; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return pos < capacity;
+		}
+
+		_FORCE_INLINE_ Iterator(const uint8_t *p_ctrl, KeyValue<TKey, TValue> *p_slots, uint32_t p_capacity, uint32_t p_pos) :
+				ctrl(p_ctrl), slots(p_slots), capacity(p_capacity), pos(p_pos) {}
+		_FORCE_INLINE_ Iterator() {}
+
+		operator ConstIterator() const {
+			return ConstIterator(ctrl, slots, capacity, pos);
+		}
+
+	private:
+		const uint8_t *ctrl = nullptr;
+		KeyValue<TKey, TValue> *slots = nullptr;
+		uint32_t capacity = 0;
+		uint32_t pos = 0;
+	};
+
+	_FORCE_INLINE_ Iterator begin() {
+		uint32_t pos = 0;
+		while (pos < capacity && (ctrl[pos] & 0x80)) {
+			pos++;
+		}
+		return Iterator(ctrl, slots, capacity, pos);
+	}
+	_FORCE_INLINE_ Iterator end() {
+		return Iterator(ctrl, slots, capacity, capacity);
+	}
+
+	_FORCE_INLINE_ Iterator find(const TKey &p_key) {
+		uint32_t pos = 0;
+		if (!_lookup_pos(p_key, pos)) {
+			return end();
+		}
+		return Iterator(ctrl, slots, capacity, pos);
+	}
+
+	_FORCE_INLINE_ void remove(const Iterator &p_iter) {
+		if (p_iter) {
+			erase(p_iter->key);
+		}
+	}
+
+	_FORCE_INLINE_ ConstIterator begin() const {
+		uint32_t pos = 0;
+		while (pos < capacity && (ctrl[pos] & 0x80)) {
+			pos++;
+		}
+		return ConstIterator(ctrl, slots, capacity, pos);
+	}
+	_FORCE_INLINE_ ConstIterator end() const {
+		return ConstIterator(ctrl, slots, capacity, capacity);
+	}
+
+	_FORCE_INLINE_ ConstIterator find(const TKey &p_key) const {
+		uint32_t pos = 0;
+		if (!_lookup_pos(p_key, pos)) {
+			return end();
+		}
+		return ConstIterator(ctrl, slots, capacity, pos);
+	}
+
+	/* Indexing */
+
+	const TValue &operator[](const TKey &p_key) const {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		CRASH_COND(!exists);
+		return slots[pos].value;
+	}
+
+	TValue &operator[](const TKey &p_key) {
+		uint32_t pos = 0;
+		if (!_lookup_pos(p_key, pos)) {
+			pos = _insert(p_key, TValue());
+		}
+		return slots[pos].value;
+	}
+
+	/* Insert */
+
+	Iterator insert(const TKey &p_key, const TValue &p_value) {
+		uint32_t pos = _insert(p_key, p_value);
+		return Iterator(ctrl, slots, capacity, pos);
+	}
+
+	/* Constructors */
+
+	FlatHashMap(const FlatHashMap &p_other) {
+		reserve(p_other.num_elements);
+		for (const KeyValue<TKey, TValue> &E : p_other) {
+			insert(E.key, E.value);
+		}
+	}
+
+	void operator=(const FlatHashMap &p_other) {
+		if (this == &p_other) {
+			return; // Ignore self assignment.
+		}
+		clear();
+		reserve(p_other.num_elements);
+		for (const KeyValue<TKey, TValue> &E : p_other) {
+			insert(E.key, E.value);
+		}
+	}
+
+	FlatHashMap(uint32_t p_initial_capacity) {
+		reserve(p_initial_capacity);
+	}
+	FlatHashMap() {}
+
+	~FlatHashMap() {
+		clear();
+
+		if (ctrl != nullptr) {
+			Memory::free_static(ctrl);
+			Memory::free_static(slots);
+		}
+	}
+};
+
+#endif // FLAT_HASH_MAP_H
@@ -0,0 +1,225 @@
+/**************************************************************************/
+/*  frame_arena.cpp                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "frame_arena.h"
+
+#include "core/error/error_macros.h"
+
+#include <string.h>
+
+thread_local FrameArena *FrameArena::current = nullptr;
+
+FrameArena::Chunk *FrameArena::_add_chunk(Buffer &p_buffer, uint64_t p_min_size) {
+	uint64_t size = MAX(chunk_size, p_min_size);
+	Chunk *chunk = (Chunk *)Memory::alloc_static(CHUNK_HEADER_SIZE + size, false);
+	CRASH_COND_MSG(!chunk, "Out of memory");
+	chunk->size = size;
+	chunk->used = 0;
+	chunk->next = p_buffer.chunks;
+	if (p_buffer.chunks) {
+		p_buffer.used += p_buffer.chunks->used;
+	}
+	p_buffer.chunks = chunk;
+	return chunk;
+}
+
+void FrameArena::_free_chunks(Chunk *p_chunk) {
+	while (p_chunk) {
+		Chunk *next = p_chunk->next;
+		Memory::free_static(p_chunk, false);
+		p_chunk = next;
+	}
+}
+
+void *FrameArena::_alloc(uint64_t p_bytes) {
+	Buffer &buffer = buffers[buffer_index];
+	uint64_t size = _block_size(p_bytes);
+	Chunk *chunk = buffer.chunks;
+	if (unlikely(!chunk || chunk->used + size > chunk->size)) {
+		chunk = _add_chunk(buffer, size);
+	}
+
+	BlockHeader *header = (BlockHeader *)(_chunk_data(chunk) + chunk->used);
+	chunk->used += size;
+	header->size = p_bytes;
+	header->frame = frame;
+	header->from_heap = 0;
+	last_block = header;
+	return header + 1;
+}
+
+void *FrameArena::_realloc(void *p_ptr, uint64_t p_bytes) {
+	BlockHeader *header = (BlockHeader *)p_ptr - 1;
+#ifdef DEV_ENABLED
+	CRASH_COND_MSG(frame - header->frame > 1, "Frame arena memory was used after its frame was recycled.");
+#endif
+
+	if (header == last_block) {
+		// The last block can grow or shrink in place while it fits its chunk.
+		Chunk *chunk = buffers[buffer_index].chunks;
+		uint64_t used = chunk->used - _block_size(header->size) + _block_size(p_bytes);
+		if (used <= chunk->size) {
+			chunk->used = used;
+			header->size = p_bytes;
+			return p_ptr;
+		}
+	} else if (p_bytes <= header->size) {
+		header->size = p_bytes;
+		return p_ptr;
+	}
+
+	void *new_ptr = _alloc(p_bytes);
+	memcpy(new_ptr, p_ptr, MIN(header->size, p_bytes));
+	return new_ptr;
+}
+
+void FrameArena::_free(void *p_ptr) {
+	BlockHeader *header = (BlockHeader *)p_ptr - 1;
+	if (header == last_block) {
+		buffers[buffer_index].chunks->used -= _block_size(header->size);
+		last_block = nullptr;
+	}
+}
+
+void FrameArena::begin_frame() {
+	frame++;
+	buffer_index ^= 1;
+	last_block = nullptr;
+
+	Buffer &buffer = buffers[buffer_index];
+	if (!buffer.chunks) {
+		return;
+	}
+
+	if (buffer.chunks->next) {
+		// The frame did not fit a single chunk, replace the chunks with one
+		// that fits all of them so following frames don't need to allocate.
+		uint64_t size = 0;
+		for (Chunk *chunk = buffer.chunks; chunk; chunk = chunk->next) {
+			size += chunk->size;
+		}
+		_free_chunks(buffer.chunks);
+		buffer.chunks = nullptr;
+		_add_chunk(buffer, size);
+	}
+
+	buffer.chunks->used = 0;
+	buffer.used = 0;
+}
+
+uint64_t FrameArena::get_used_bytes() const {
+	const Buffer &buffer = buffers[buffer_index];
+	return buffer.chunks ? buffer.used + buffer.chunks->used : 0;
+}
+
+uint64_t FrameArena::get_capacity() const {
+	uint64_t capacity = 0;
+	for (const Buffer &buffer : buffers) {
+		for (Chunk *chunk = buffer.chunks; chunk; chunk = chunk->next) {
+			capacity += chunk->size;
+		}
+	}
+	return capacity;
+}
+
+uint32_t FrameArena::get_chunk_count() const {
+	uint32_t count = 0;
+	for (const Buffer &buffer : buffers) {
+		for (Chunk *chunk = buffer.chunks; chunk; chunk = chunk->next) {
+			count++;
+		}
+	}
+	return count;
+}
+
+FrameArena::FrameArena(uint64_t p_chunk_size) {
+	chunk_size = MAX(p_chunk_size, ALIGNMENT);
+}
+
+FrameArena::~FrameArena() {
+	if (current == this) {
+		current = nullptr;
+	}
+	for (Buffer &buffer : buffers) {
+		_free_chunks(buffer.chunks);
+	}
+}
+
+void *FrameArenaAllocator::alloc(size_t p_bytes) {
+	FrameArena *arena = FrameArena::current;
+	if (likely(arena)) {
+		return arena->_alloc(p_bytes);
+	}
+
+	FrameArena::BlockHeader *header = (FrameArena::BlockHeader *)Memory::alloc_static(sizeof(FrameArena::BlockHeader) + p_bytes, false);
+	ERR_FAIL_NULL_V(header, nullptr);
+	header->size = p_bytes;
+	header->frame = 0;
+	header->from_heap = 1;
+	return header + 1;
+}
+
+void *FrameArenaAllocator::realloc(void *p_ptr, size_t p_bytes) {
+	if (!p_ptr) {
+		return alloc(p_bytes);
+	}
+
+	FrameArena::BlockHeader *header = (FrameArena::BlockHeader *)p_ptr - 1;
+	if (header->from_heap) {
+		header = (FrameArena::BlockHeader *)Memory::realloc_static(header, sizeof(FrameArena::BlockHeader) + p_bytes, false);
+		ERR_FAIL_NULL_V(header, nullptr);
+		header->size = p_bytes;
+		return header + 1;
+	}
+
+	FrameArena *arena = FrameArena::current;
+	if (likely(arena)) {
+		return arena->_realloc(p_ptr, p_bytes);
+	}
+
+	// Grown on a thread without an arena, move it to the heap.
+	void *new_ptr = alloc(p_bytes);
+	ERR_FAIL_NULL_V(new_ptr, nullptr);
+	memcpy(new_ptr, p_ptr, MIN(header->size, p_bytes));
+	return new_ptr;
+}
+
+void FrameArenaAllocator::free(void *p_ptr) {
+	if (!p_ptr) {
+		return;
+	}
+
+	FrameArena::BlockHeader *header = (FrameArena::BlockHeader *)p_ptr - 1;
+	if (header->from_heap) {
+		Memory::free_static(header, false);
+	} else if (FrameArena::current) {
+		FrameArena::current->_free(p_ptr);
+	}
+}
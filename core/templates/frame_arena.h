@@ -0,0 +1,140 @@
+/**************************************************************************/
+/*  frame_arena.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include "core/os/memory.h"
+#include "core/templates/local_Hector.h"
+#include "core/typedefs.h"
+
+// FrameArena is a linear allocator for data that only lives for the frame it
+// is created in, such as the temporaries built while culling and rendering.
+// Allocating is a pointer bump, and memory is not freed individually but
+// recycled all at once.
+//
+// The arena is double-buffered: begin_frame() switches to the other buffer
+// and recycles it, so memory allocated in a frame stays valid until the end
+// of the next one. Containers allocating from the arena must never be kept
+// for longer than that.
+
+class FrameArena {
+	friend class FrameArenaAllocator;
+
+	static constexpr uint64_t ALIGNMENT = 16;
+	static constexpr uint64_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+	struct Chunk {
+		Chunk *next = nullptr;
+		uint64_t size = 0;
+		uint64_t used = 0;
+	};
+
+	// Precedes every block, so blocks can be resized and so blocks from
+	// the heap fallback can be told apart.
+	struct BlockHeader {
+		uint64_t size;
+		uint32_t frame;
+		uint32_t from_heap;
+	};
+
+	static constexpr uint64_t CHUNK_HEADER_SIZE = (sizeof(Chunk) + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+	static_assert(sizeof(BlockHeader) == ALIGNMENT);
+
+	struct Buffer {
+		Chunk *chunks = nullptr; // The first chunk is the one being filled.
+		uint64_t used = 0; // Bytes used by the chunks that are full.
+	};
+
+	static thread_local FrameArena *current;
+
+	Buffer buffers[2];
+	uint32_t buffer_index = 0;
+	uint32_t frame = 0;
+	uint64_t chunk_size = DEFAULT_CHUNK_SIZE;
+	BlockHeader *last_block = nullptr;
+
+	_FORCE_INLINE_ static uint64_t _block_size(uint64_t p_bytes) {
+		return (p_bytes + sizeof(BlockHeader) + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+	}
+	_FORCE_INLINE_ static uint8_t *_chunk_data(Chunk *p_chunk) {
+		return (uint8_t *)p_chunk + CHUNK_HEADER_SIZE;
+	}
+
+	Chunk *_add_chunk(Buffer &p_buffer, uint64_t p_min_size);
+	void _free_chunks(Chunk *p_chunk);
+	void *_alloc(uint64_t p_bytes);
+	void *_realloc(void *p_ptr, uint64_t p_bytes);
+	void _free(void *p_ptr);
+
+public:
+	// Sets the arena used by FrameArenaAllocator on the calling thread.
+	// Threads without one fall back to the heap.
+	static void set_current(FrameArena *p_arena) { current = p_arena; }
+	_FORCE_INLINE_ static FrameArena *get_current() { return current; }
+
+	// Starts a new frame. Memory allocated two frames ago is recycled.
+	void begin_frame();
+
+	uint32_t get_frame() const { return frame; }
+	uint64_t get_used_bytes() const;
+	uint64_t get_capacity() const;
+	uint32_t get_chunk_count() const;
+
+	FrameArena(uint64_t p_chunk_size = DEFAULT_CHUNK_SIZE);
+	~FrameArena();
+};
+
+// Allocates from the frame arena of the calling thread, with the same
+// interface as DefaultAllocator. free() only reclaims memory when it is the
+// last block allocated, otherwise it is recycled with the frame.
+class FrameArenaAllocator {
+public:
+	static void *alloc(size_t p_bytes);
+	static void *realloc(void *p_ptr, size_t p_bytes);
+	static void free(void *p_ptr);
+};
+
+// Element allocator for HashMap and HashSet.
+template <typename T>
+class FrameTypedAllocator {
+public:
+	template <typename... Args>
+	_FORCE_INLINE_ T *new_allocation(const Args &&...p_args) { return memnew_placement(FrameArenaAllocator::alloc(sizeof(T)), T(p_args...)); }
+	_FORCE_INLINE_ void delete_allocation(T *p_allocation) {
+		p_allocation->~T();
+		FrameArenaAllocator::free(p_allocation);
+	}
+};
+
+template <typename T, typename U = uint32_t, bool force_trivial = false>
+using FrameLocalHector = LocalHector<T, U, force_trivial, false, FrameArenaAllocator>;
+
+#endif // FRAME_ARENA_H
@@ -89,12 +89,13 @@ public:
 		inc(pos, p_offset);
 		int to_read = p_size;
 		int dst = 0;
+		const T *read = data.ptr();
 		while (to_read) {
 			int end = pos + to_read;
 			end = MIN(end, size());
 			int total = end - pos;
 			for (int i = 0; i < total; i++) {
-				p_buf[dst++] = data[pos + i];
+				p_buf[dst++] = read[pos + i];
 			}
 			to_read -= total;
 			pos = 0;
@@ -114,12 +115,13 @@ public:
 		int pos = read_pos;
 		inc(pos, p_offset);
 		int to_read = p_max_size;
+		const T *read = data.ptr();
 		while (to_read) {
 			int end = pos + to_read;
 			end = MIN(end, size());
 			int total = end - pos;
 			for (int i = 0; i < total; i++) {
-				if (data[pos + i] == t) {
+				if (read[pos + i] == t) {
 					return i + (p_max_size - to_read);
 				}
 			}
@@ -129,6 +131,14 @@ public:
 		return -1;
 	}
 
+	// Returns the next p_size elements without consuming them, or nullptr if they wrap around the end of the buffer.
+	const T *get_read_ptr(int p_size) const {
+		if (p_size > data_left() || read_pos + p_size > size()) {
+			return nullptr;
+		}
+		return data.ptr() + read_pos;
+	}
+
 	inline int advance_read(int p_n) {
 		p_n = MIN(p_n, data_left());
 		inc(read_pos, p_n);
@@ -154,13 +164,14 @@ public:
 		int pos = write_pos;
 		int to_write = p_size;
 		int src = 0;
+		T *write = data.ptrw();
 		while (to_write) {
 			int end = pos + to_write;
 			end = MIN(end, size());
 			int total = end - pos;
 
 			for (int i = 0; i < total; i++) {
-				data.write[pos + i] = p_buf[src++];
+				write[pos + i] = p_buf[src++];
 			}
 			to_write -= total;
 			pos = 0;
@@ -0,0 +1,107 @@
+/**************************************************************************/
+/*  spsc_queue.h                                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include "core/error/error_macros.h"
+#include "core/os/memory.h"
+#include "core/typedefs.h"
+
+#include <atomic>
+
+// Bounded lock-free queue, for exactly one producer thread and one consumer thread.
+// push() must only be called by the producer, peek() and pop() only by the consumer.
+template <typename T>
+class SPSCQueue {
+	T *data = nullptr;
+	uint32_t mask = 0;
+
+	// Kept on separate cache lines, so the two threads don't contend on them.
+	alignas(64) std::atomic<uint32_t> read_pos = 0; // Written by the consumer.
+	alignas(64) std::atomic<uint32_t> write_pos = 0; // Written by the producer.
+
+public:
+	// Returns false if the queue is full.
+	_FORCE_INLINE_ bool push(const T &p_value) {
+		const uint32_t pos = write_pos.load(std::memory_order_relaxed);
+		if (pos - read_pos.load(std::memory_order_acquire) > mask) {
+			return false;
+		}
+		data[pos & mask] = p_value;
+		write_pos.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Returns nullptr if the queue is empty. The element stays valid until it's popped.
+	_FORCE_INLINE_ T *peek() {
+		const uint32_t pos = read_pos.load(std::memory_order_relaxed);
+		if (pos == write_pos.load(std::memory_order_acquire)) {
+			return nullptr;
+		}
+		return &data[pos & mask];
+	}
+
+	_FORCE_INLINE_ bool pop(T &r_value) {
+		const uint32_t pos = read_pos.load(std::memory_order_relaxed);
+		if (pos == write_pos.load(std::memory_order_acquire)) {
+			return false;
+		}
+		r_value = data[pos & mask];
+		data[pos & mask] = T(); // Release resources held by the slot.
+		read_pos.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Only exact when called from one of the two threads while the other is idle.
+	_FORCE_INLINE_ uint32_t size() const {
+		return write_pos.load(std::memory_order_acquire) - read_pos.load(std::memory_order_acquire);
+	}
+	_FORCE_INLINE_ bool is_empty() const { return size() == 0; }
+	_FORCE_INLINE_ uint32_t get_capacity() const { return mask + 1; }
+
+	SPSCQueue(const SPSCQueue &) = delete;
+	SPSCQueue &operator=(const SPSCQueue &) = delete;
+
+	explicit SPSCQueue(uint32_t p_capacity) {
+		ERR_FAIL_COND(p_capacity == 0);
+		const uint32_t capacity = next_power_of_2(p_capacity);
+		data = memnew_arr(T, capacity);
+		mask = capacity - 1;
+	}
+
+	~SPSCQueue() {
+		if (data) {
+			memdelete_arr(data);
+		}
+	}
+};
+
+#endif // SPSC_QUEUE_H
@@ -549,11 +549,20 @@ Array Array::slice(int p_begin, int p_end, int p_step, bool p_deep) const {
 	ERR_FAIL_COND_V_MSG(p_step > 0 && begin > end, result, "Slice step is positive, but bounds are decreasing.");
 	ERR_FAIL_COND_V_MSG(p_step < 0 && begin < end, result, "Slice step is negative, but bounds are increasing.");
 
+	if (p_step == 1 && begin == 0 && end == s && !p_deep) {
+		// Same as a shallow duplicate, share the storage until either array changes.
+		result._p->array = _p->array;
+		return result;
+	}
+
 	int result_size = (end - begin) / p_step + (((end - begin) % p_step != 0) ? 1 : 0);
 	result.resize(result_size);
 
+	const Variant *src = _p->array.ptr();
+	Iterator dest = result.begin();
 	for (int src_idx = begin, dest_idx = 0; dest_idx < result_size; ++dest_idx) {
-		result[dest_idx] = p_deep ? get(src_idx).duplicate(true) : get(src_idx);
+		*dest = p_deep ? src[src_idx].duplicate(true) : src[src_idx];
+		++dest;
 		src_idx += p_step;
 	}
 
@@ -49,6 +49,14 @@ struct DictionaryPrivate {
 	Variant *typed_fallback = nullptr; // Allows a typed dictionary to return dummy values when attempting an invalid access.
 };
 
+Dictionary::ConstIterator Dictionary::begin() const {
+	return _p->variant_map.begin();
+}
+
+Dictionary::ConstIterator Dictionary::end() const {
+	return _p->variant_map.end();
+}
+
 void Dictionary::get_key_list(List<Variant> *p_keys) const {
 	if (_p->variant_map.is_empty()) {
 		return;
@@ -364,10 +372,10 @@ Array Dictionary::keys() const {
 
 	varr.resize(size());
 
-	int i = 0;
+	Array::Iterator it = varr.begin();
 	for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
-		varr[i] = E.key;
-		i++;
+		*it = E.key;
+		++it;
 	}
 
 	return varr;
@@ -384,10 +392,10 @@ Array Dictionary::values() const {
 
 	varr.resize(size());
 
-	int i = 0;
+	Array::Iterator it = varr.begin();
 	for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
-		varr[i] = E.value;
-		i++;
+		*it = E.value;
+		++it;
 	}
 
 	return varr;
@@ -32,10 +32,13 @@
 #define DICTIONARY_H
 
 #include "core/string/ustring.h"
+#include "core/templates/hash_map.h"
 #include "core/templates/list.h"
 #include "core/variant/array.h"
 
 class Variant;
+struct VariantHasher;
+struct StringLikeVariantComparator;
 
 struct DictionaryPrivate;
 
@@ -46,6 +49,13 @@ class Dictionary {
 	void _unref() const;
 
 public:
+	using ConstIterator = HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::ConstIterator;
+
+	// Iterates over the key/value pairs in place, without copying them into
+	// keys() or values() arrays. The dictionary must not change meanwhile.
+	ConstIterator begin() const;
+	ConstIterator end() const;
+
 	void get_key_list(List<Variant> *p_keys) const;
 	Variant get_key_at_index(int p_index) const;
 	Variant get_value_at_index(int p_index) const;
@@ -1141,40 +1141,24 @@ Variant VariantUtilityFunctions::str_to_var(const String &p_var) {
 
 PackedByteArray VariantUtilityFunctions::var_to_bytes(const Variant &p_var) {
 	int len;
-	Error err = encode_variant(p_var, nullptr, len, false);
+	PackedByteArray barr;
+	Error err = encode_variant(p_var, barr, 0, len, false);
 	if (err != OK) {
 		return PackedByteArray();
 	}
-
-	PackedByteArray barr;
 	barr.resize(len);
-	{
-		uint8_t *w = barr.ptrw();
-		err = encode_variant(p_var, w, len, false);
-		if (err != OK) {
-			return PackedByteArray();
-		}
-	}
 
 	return barr;
 }
 
 PackedByteArray VariantUtilityFunctions::var_to_bytes_with_objects(const Variant &p_var) {
 	int len;
-	Error err = encode_variant(p_var, nullptr, len, true);
+	PackedByteArray barr;
+	Error err = encode_variant(p_var, barr, 0, len, true);
 	if (err != OK) {
 		return PackedByteArray();
 	}
-
-	PackedByteArray barr;
 	barr.resize(len);
-	{
-		uint8_t *w = barr.ptrw();
-		err = encode_variant(p_var, w, len, true);
-		if (err != OK) {
-			return PackedByteArray();
-		}
-	}
 
 	return barr;
 }
@@ -244,6 +244,7 @@ static int fixed_fps = -1;
 static MovieWriter *movie_writer = nullptr;
 static bool disable_vsync = false;
 static bool print_fps = false;
+static String profile_tasks_path;
 #ifdef TOOLS_ENABLED
 static bool editor_pseudolocalization = false;
 static bool dump_gdextension_interface = false;
@@ -650,6 +651,7 @@ void Main::print_help(const char *p_binary) {
 	print_help_option("--fixed-fps <fps>", "Force a fixed number of frames per second. This setting disables real-time synchronization.\n");
 	print_help_option("--delta-smoothing <enable>", "Enable or disable frame delta smoothing [\"enable\", \"disable\"].\n");
 	print_help_option("--print-fps", "Print the frames per second to the stdout.\n");
+	print_help_option("--profile-tasks <file>", "Trace the tasks run by the WorkerThreadPool and save the timeline to the given file in Chrome trace format when the engine quits.\n");
 #ifdef TOOLS_ENABLED
 	print_help_option("--editor-pseudolocalization", "Enable pseudolocalization for the editor and the project manager.\n");
 #endif
@@ -1720,6 +1722,14 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 			disable_vsync = true;
 		} else if (arg == "--print-fps") {
 			print_fps = true;
+		} else if (arg == "--profile-tasks") {
+			if (N) {
+				profile_tasks_path = N->get();
+				N = N->next();
+			} else {
+				OS::get_singleton()->print("Missing profile-tasks argument, aborting.\n");
+				goto error;
+			}
 #ifdef TOOLS_ENABLED
 		} else if (arg == "--editor-pseudolocalization") {
 			editor_pseudolocalization = true;
@@ -1846,6 +1856,9 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 
 	// Initialize WorkerThreadPool.
 	{
+		if (!profile_tasks_path.is_empty()) {
+			WorkerThreadPool::get_singleton()->set_tracing_enabled(true);
+		}
 #ifdef THREADS_ENABLED
 		if (editor || project_manager) {
 			WorkerThreadPool::get_singleton()->init(-1, 0.75);
@@ -4426,6 +4439,9 @@ bool Main::iteration() {
 
 	AudioServer::get_singleton()->update();
 
+	message_queue->update_frame_statistics();
+	WorkerThreadPool::get_singleton()->update_frame_profile();
+
 	if (EngineDebugger::is_active()) {
 		EngineDebugger::get_singleton()->iteration(frame_time, process_ticks, physics_process_ticks, physics_step);
 	}
@@ -4564,6 +4580,10 @@ void Main::cleanup(bool p_force) {
 
 	WorkerThreadPool::get_singleton()->exit_languages_threads();
 
+	if (!profile_tasks_path.is_empty()) {
+		WorkerThreadPool::get_singleton()->save_trace(profile_tasks_path);
+	}
+
 	ScriptServer::finish_languages();
 
 	// Sync pending commands that may have been queued from a different thread during ScriptServer finalization
@@ -106,6 +106,8 @@ public:
 		PIPELINE_COMPILATIONS_SURFACE,
 		PIPELINE_COMPILATIONS_DRAW,
 		PIPELINE_COMPILATIONS_SPECIALIZATION,
+		OBJECT_MESSAGE_QUEUE_CALLS,
+		MEMORY_MESSAGE_QUEUE_FLUSHED,
 		MONITOR_MAX
 	};
 
@@ -222,6 +222,20 @@ void ENetConnection::compress(CompressionMode p_mode) {
 	Compressor::setup(host, p_mode);
 }
 
+Error ENetConnection::compress_with_dictionary(const PackedByteArray &p_dictionary) {
+	ERR_FAIL_NULL_V_MSG(host, ERR_UNCONFIGURED, "The ENetConnection instance isn't currently active.");
+	return Compressor::setup(host, COMPRESS_ZSTD, p_dictionary);
+}
+
+PackedByteArray ENetConnection::build_compression_dictionary(const TypedArray<PackedByteArray> &p_samples, int p_max_size) {
+	Hector<Hector<uint8_t>> samples;
+	samples.resize(p_samples.size());
+	for (int i = 0; i < p_samples.size(); i++) {
+		samples.write[i] = p_samples[i];
+	}
+	return Compression::zstd_build_dictionary(samples, p_max_size);
+}
+
 double ENetConnection::pop_statistic(HostStatistic p_stat) {
 	ERR_FAIL_NULL_V_MSG(host, 0, "The ENetConnection instance isn't currently active.");
 	uint32_t *ptr = nullptr;
@@ -386,6 +400,8 @@ void ENetConnection::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("channel_limit", "limit"), &ENetConnection::channel_limit);
 	ClassDB::bind_method(D_METHOD("broadcast", "channel", "packet", "flags"), &ENetConnection::_broadcast);
 	ClassDB::bind_method(D_METHOD("compress", "mode"), &ENetConnection::compress);
+	ClassDB::bind_method(D_METHOD("compress_with_dictionary", "dictionary"), &ENetConnection::compress_with_dictionary);
+	ClassDB::bind_static_method("ENetConnection", D_METHOD("build_compression_dictionary", "samples", "max_size"), &ENetConnection::build_compression_dictionary, DEFVAL(16384));
 	ClassDB::bind_method(D_METHOD("dtls_server_setup", "server_options"), &ENetConnection::dtls_server_setup);
 	ClassDB::bind_method(D_METHOD("dtls_client_setup", "hostname", "client_options"), &ENetConnection::dtls_client_setup, DEFVAL(Ref<TLSOptions>()));
 	ClassDB::bind_method(D_METHOD("refuse_new_connections", "refuse"), &ENetConnection::refuse_new_connections);
@@ -437,6 +453,12 @@ size_t ENetConnection::Compressor::enet_compress(void *context, const ENetBuffer
 		}
 	}
 
+	if (compressor->mode == COMPRESS_ZSTD) {
+		// The context is reused for every packet, and fails when the result exceeds outLimit.
+		int ret = compressor->zstd.compress(outData, outLimit, compressor->src_mem.ptr(), ofs);
+		return ret < 0 ? 0 : ret;
+	}
+
 	Compression::Mode mode;
 
 	switch (compressor->mode) {
@@ -446,9 +468,6 @@ size_t ENetConnection::Compressor::enet_compress(void *context, const ENetBuffer
 		case COMPRESS_ZLIB: {
 			mode = Compression::MODE_DEFLATE;
 		} break;
-		case COMPRESS_ZSTD: {
-			mode = Compression::MODE_ZSTD;
-		} break;
 		default: {
 			ERR_FAIL_V_MSG(0, vformat("Invalid ENet compression mode: %d", compressor->mode));
 		}
@@ -484,7 +503,7 @@ size_t ENetConnection::Compressor::enet_decompress(void *context, const enet_uin
 			ret = Compression::decompress(outData, outLimit, inData, inLimit, Compression::MODE_DEFLATE);
 		} break;
 		case COMPRESS_ZSTD: {
-			ret = Compression::decompress(outData, outLimit, inData, inLimit, Compression::MODE_ZSTD);
+			ret = compressor->zstd.decompress(outData, outLimit, inData, inLimit);
 		} break;
 		default: {
 		}
@@ -496,8 +515,9 @@ size_t ENetConnection::Compressor::enet_decompress(void *context, const enet_uin
 	}
 }
 
-void ENetConnection::Compressor::setup(ENetHost *p_host, CompressionMode p_mode) {
-	ERR_FAIL_NULL(p_host);
+Error ENetConnection::Compressor::setup(ENetHost *p_host, CompressionMode p_mode, const Hector<uint8_t> &p_dictionary) {
+	ERR_FAIL_NULL_V(p_host, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V_MSG(!p_dictionary.is_empty() && p_mode != COMPRESS_ZSTD, ERR_INVALID_PARAMETER, "Compression dictionaries are only supported with COMPRESS_ZSTD.");
 	switch (p_mode) {
 		case COMPRESS_NONE: {
 			enet_host_compress(p_host, nullptr);
@@ -509,9 +529,15 @@ void ENetConnection::Compressor::setup(ENetHost *p_host, CompressionMode p_mode)
 		case COMPRESS_ZLIB:
 		case COMPRESS_ZSTD: {
 			Compressor *compressor = memnew(Compressor(p_mode));
+			Error err = compressor->zstd.set_dictionary(p_dictionary);
+			if (err != OK) {
+				memdelete(compressor);
+				return err;
+			}
 			enet_host_compress(p_host, &(compressor->enet_compressor));
 		} break;
 	}
+	return OK;
 }
 
 ENetConnection::Compressor::Compressor(CompressionMode p_mode) {
@@ -34,6 +34,7 @@
 #include "enet_packet_peer.h"
 
 #include "core/crypto/crypto.h"
+#include "core/io/compression.h"
 #include "core/object/ref_counted.h"
 
 #include <enet/enet.h>
@@ -93,6 +94,7 @@ private:
 		CompressionMode mode = COMPRESS_NONE;
 		Hector<uint8_t> src_mem;
 		Hector<uint8_t> dst_mem;
+		Compression::ZstdContext zstd;
 		ENetCompressor enet_compressor;
 
 		Compressor(CompressionMode mode);
@@ -104,7 +106,7 @@ private:
 		}
 
 	public:
-		static void setup(ENetHost *p_host, CompressionMode p_mode);
+		static Error setup(ENetHost *p_host, CompressionMode p_mode, const Hector<uint8_t> &p_dictionary = Hector<uint8_t>());
 	};
 
 public:
@@ -121,6 +123,8 @@ public:
 	void channel_limit(int p_max_channels);
 	void bandwidth_throttle();
 	void compress(CompressionMode p_mode);
+	Error compress_with_dictionary(const PackedByteArray &p_dictionary);
+	static PackedByteArray build_compression_dictionary(const TypedArray<PackedByteArray> &p_samples, int p_max_size = 16384);
 	double pop_statistic(HostStatistic p_stat);
 	int get_max_channels() const;
 
@@ -131,7 +131,7 @@ Error ENetMultiplayerPeer::add_mesh_peer(int p_id, Ref<ENetConnection> p_host) {
 	return OK;
 }
 
-void ENetMultiplayerPeer::_store_packet(int32_t p_source, ENetConnection::Event &p_event) {
+ENetMultiplayerPeer::Packet ENetMultiplayerPeer::_make_packet(int32_t p_source, ENetConnection::Event &p_event) {
 	Packet packet;
 	packet.packet = p_event.packet;
 	packet.channel = p_event.channel_id;
@@ -144,7 +144,244 @@ void ENetMultiplayerPeer::_store_packet(int32_t p_source, ENetConnection::Event
 		packet.transfer_mode = TRANSFER_MODE_UNRELIABLE_ORDERED;
 	}
 	packet.packet->referenceCount++;
-	incoming_packets.push_back(packet);
+	return packet;
+}
+
+void ENetMultiplayerPeer::_store_packet(int32_t p_source, ENetConnection::Event &p_event) {
+	incoming_packets.push_back(_make_packet(p_source, p_event));
+}
+
+void ENetMultiplayerPeer::_start_network_thread() {
+	thread_host = hosts[0];
+	thread_peers = peers;
+	thread_refusing = is_refusing_new_connections();
+	network_thread_refuse.set_to(thread_refusing);
+	network_thread_exit.clear();
+	network_thread_done.clear();
+	thread_events = memnew(SPSCQueue<ThreadEvent>(THREAD_QUEUE_SIZE));
+	thread_commands = memnew(SPSCQueue<ThreadCommand>(THREAD_QUEUE_SIZE));
+	network_thread.start(_network_thread_func, this);
+}
+
+void ENetMultiplayerPeer::_stop_network_thread() {
+	network_thread_exit.set();
+	network_thread.wait_to_finish();
+
+	// Send what the network thread didn't get to.
+	do {
+		_flush_thread_commands_overflow();
+		_process_thread_commands();
+	} while (!thread_commands_overflow.is_empty());
+
+	// Drop the events the main thread didn't get to.
+	ThreadEvent event;
+	while (thread_events->pop(event)) {
+		if (event.type == ENetConnection::EVENT_RECEIVE) {
+			event.packet.packet->referenceCount--;
+			_destroy_unused(event.packet.packet);
+		}
+	}
+	for (ThreadEvent &E : thread_events_overflow) {
+		if (E.type == ENetConnection::EVENT_RECEIVE) {
+			E.packet.packet->referenceCount--;
+			_destroy_unused(E.packet.packet);
+		}
+	}
+	thread_events_overflow.clear();
+
+	// Peers that connected since the last poll still need to be disconnected when closing.
+	for (const KeyValue<int, Ref<ENetPacketPeer>> &E : thread_peers) {
+		if (!peers.has(E.key)) {
+			peers[E.key] = E.value;
+		}
+	}
+	thread_peers.clear();
+	thread_host.unref();
+	memdelete(thread_events);
+	memdelete(thread_commands);
+	thread_events = nullptr;
+	thread_commands = nullptr;
+}
+
+void ENetMultiplayerPeer::_network_thread_func(void *p_user) {
+	ENetMultiplayerPeer *peer = (ENetMultiplayerPeer *)p_user;
+	while (!peer->network_thread_exit.is_set()) {
+		if (!peer->_network_thread_poll()) {
+			break; // The main thread will close the peer when it gets the event.
+		}
+	}
+	peer->network_thread_done.set();
+}
+
+void ENetMultiplayerPeer::_push_thread_event(const ThreadEvent &p_event) {
+	// Never block: events that don't fit wait until the main thread catches up.
+	if (!thread_events_overflow.is_empty() || !thread_events->push(p_event)) {
+		thread_events_overflow.push_back(p_event);
+	}
+}
+
+bool ENetMultiplayerPeer::_pop_thread_event(ThreadEvent &r_event) {
+	if (thread_events->pop(r_event)) {
+		return true;
+	}
+	// The network thread stops after a disconnection or an error, so it no longer moves
+	// the events that didn't fit into the queue, the last of which is the one that stopped it.
+	if (network_thread_done.is_set() && !thread_events_overflow.is_empty()) {
+		r_event = thread_events_overflow.front()->get();
+		thread_events_overflow.pop_front();
+		return true;
+	}
+	return false;
+}
+
+void ENetMultiplayerPeer::_push_thread_command(const ThreadCommand &p_command) {
+	_flush_thread_commands_overflow();
+	if (!thread_commands_overflow.is_empty() || !thread_commands->push(p_command)) {
+		thread_commands_overflow.push_back(p_command);
+	}
+}
+
+void ENetMultiplayerPeer::_flush_thread_commands_overflow() {
+	while (!thread_commands_overflow.is_empty() && thread_commands->push(thread_commands_overflow.front()->get())) {
+		thread_commands_overflow.pop_front();
+	}
+}
+
+void ENetMultiplayerPeer::_process_thread_commands() {
+	ThreadCommand command;
+	bool sent = false;
+	while (thread_commands->pop(command)) {
+		sent = true;
+		if (!command.packet) {
+			Ref<ENetPacketPeer> *peer = thread_peers.getptr(command.target_peer);
+			if (peer && (*peer)->is_active()) {
+				(*peer)->peer_disconnect(0);
+			}
+		} else if (command.target_peer == 0) {
+			thread_host->broadcast(command.channel, command.packet);
+		} else if (command.target_peer < 0) {
+			// Send to all but one.
+			for (KeyValue<int, Ref<ENetPacketPeer>> &E : thread_peers) {
+				if (E.key != -command.target_peer) {
+					E.value->send(command.channel, command.packet);
+				}
+			}
+			_destroy_unused(command.packet);
+		} else {
+			Ref<ENetPacketPeer> *peer = thread_peers.getptr(command.target_peer);
+			if (peer) {
+				(*peer)->send(command.channel, command.packet);
+			}
+			_destroy_unused(command.packet);
+		}
+	}
+	if (sent) {
+		thread_host->flush();
+	}
+}
+
+bool ENetMultiplayerPeer::_network_thread_poll() {
+	// Keep the events in order.
+	while (!thread_events_overflow.is_empty() && thread_events->push(thread_events_overflow.front()->get())) {
+		thread_events_overflow.pop_front();
+	}
+
+	const bool refuse = network_thread_refuse.is_set();
+	if (refuse != thread_refusing) {
+		thread_refusing = refuse;
+#ifdef GODOT_ENET
+		thread_host->refuse_new_connections(refuse);
+#endif
+	}
+
+	_process_thread_commands();
+
+	// Waits for incoming traffic, but not too long so outgoing packets are sent promptly.
+	ENetConnection::Event event;
+	ENetConnection::EventType ret = thread_host->service(THREAD_SERVICE_TIMEOUT_MSEC, event);
+	do {
+		if (ret == ENetConnection::EVENT_NONE) {
+			continue;
+		}
+		ThreadEvent thread_event;
+		thread_event.type = ret;
+		if (ret == ENetConnection::EVENT_ERROR) {
+			_push_thread_event(thread_event);
+			return false;
+		}
+		if (active_mode == MODE_CLIENT) {
+			thread_event.peer_id = 1;
+			if (ret == ENetConnection::EVENT_CONNECT) {
+				thread_event.peer = event.peer;
+			} else if (ret == ENetConnection::EVENT_DISCONNECT) {
+				_push_thread_event(thread_event);
+				return false;
+			} else if (ret == ENetConnection::EVENT_RECEIVE) {
+				thread_event.packet = _make_packet(1, event);
+			}
+		} else {
+			if (ret == ENetConnection::EVENT_CONNECT) {
+				// Refused, or client joined with invalid ID, probably trying to exploit us.
+				if (thread_refusing || event.data < 2 || thread_peers.has((int)event.data)) {
+					event.peer->reset();
+					continue;
+				}
+				int id = event.data;
+				event.peer->set_meta(SNAME("_net_id"), id);
+				thread_peers[id] = event.peer;
+				thread_event.peer_id = id;
+				thread_event.peer = event.peer;
+			} else if (ret == ENetConnection::EVENT_DISCONNECT) {
+				int id = event.peer->get_meta(SNAME("_net_id"));
+				if (!thread_peers.has(id)) {
+					// Never fully connected.
+					continue;
+				}
+				thread_peers.erase(id);
+				thread_event.peer_id = id;
+			} else if (ret == ENetConnection::EVENT_RECEIVE) {
+				thread_event.peer_id = event.peer->get_meta(SNAME("_net_id"));
+				thread_event.packet = _make_packet(thread_event.peer_id, event);
+			}
+		}
+		_push_thread_event(thread_event);
+	} while (thread_host->check_events(ret, event) > 0);
+	return true;
+}
+
+void ENetMultiplayerPeer::_poll_thread_events() {
+	_flush_thread_commands_overflow();
+
+	ThreadEvent event;
+	while (_is_active() && _pop_thread_event(event)) {
+		switch (event.type) {
+			case ENetConnection::EVENT_CONNECT: {
+				if (active_mode == MODE_CLIENT) {
+					connection_status = CONNECTION_CONNECTED;
+				}
+				peers[event.peer_id] = event.peer;
+				emit_signal(SNAME("peer_connected"), event.peer_id);
+			} break;
+			case ENetConnection::EVENT_DISCONNECT: {
+				if (active_mode == MODE_CLIENT) {
+					if (connection_status == CONNECTION_CONNECTED) {
+						// Client just disconnected from server.
+						emit_signal(SNAME("peer_disconnected"), 1);
+					}
+					close();
+				} else if (peers.has(event.peer_id)) {
+					emit_signal(SNAME("peer_disconnected"), event.peer_id);
+					peers.erase(event.peer_id);
+				}
+			} break;
+			case ENetConnection::EVENT_RECEIVE: {
+				incoming_packets.push_back(event.packet);
+			} break;
+			default: {
+				close(); // Error.
+			} break;
+		}
+	}
 }
 
 void ENetMultiplayerPeer::_disconnect_inactive_peers() {
@@ -170,6 +407,16 @@ void ENetMultiplayerPeer::poll() {
 
 	_pop_current_packet();
 
+#ifdef THREADS_ENABLED
+	if (use_network_thread && !_is_threaded() && (active_mode == MODE_SERVER || active_mode == MODE_CLIENT)) {
+		_start_network_thread();
+	}
+#endif
+	if (_is_threaded()) {
+		_poll_thread_events();
+		return;
+	}
+
 	_disconnect_inactive_peers();
 
 	switch (active_mode) {
@@ -272,10 +519,15 @@ bool ENetMultiplayerPeer::is_server_relay_supported() const {
 
 void ENetMultiplayerPeer::disconnect_peer(int p_peer, bool p_force) {
 	ERR_FAIL_COND(!_is_active() || !peers.has(p_peer));
-	peers[p_peer]->peer_disconnect(0); // Will be removed during next poll.
-	if (active_mode == MODE_CLIENT || active_mode == MODE_SERVER) {
+	if (_is_threaded()) {
+		ThreadCommand command;
+		command.target_peer = p_peer;
+		_push_thread_command(command);
+	} else if (active_mode == MODE_CLIENT || active_mode == MODE_SERVER) {
+		peers[p_peer]->peer_disconnect(0); // Will be removed during next poll.
 		hosts[0]->flush();
 	} else {
+		peers[p_peer]->peer_disconnect(0); // Will be removed during next poll.
 		ERR_FAIL_COND(!hosts.has(p_peer));
 		hosts[p_peer]->flush();
 	}
@@ -298,6 +550,10 @@ void ENetMultiplayerPeer::close() {
 
 	_pop_current_packet();
 
+	if (_is_threaded()) {
+		_stop_network_thread();
+	}
+
 	for (KeyValue<int, Ref<ENetPacketPeer>> &E : peers) {
 		if (E.value.is_valid() && E.value->get_state() == ENetPacketPeer::STATE_CONNECTED) {
 			E.value->peer_disconnect_now(0);
@@ -370,6 +626,15 @@ Error ENetMultiplayerPeer::put_packet(const uint8_t *p_buffer, int p_buffer_size
 	ENetPacket *packet = enet_packet_create(nullptr, p_buffer_size, packet_flags);
 	memcpy(&packet->data[0], p_buffer, p_buffer_size);
 
+	if (_is_threaded()) {
+		ThreadCommand command;
+		command.packet = packet;
+		command.channel = channel;
+		command.target_peer = active_mode == MODE_CLIENT ? TARGET_PEER_SERVER : target_peer; // Clients send everything to the server.
+		_push_thread_command(command);
+		return OK;
+	}
+
 	if (is_server()) {
 		if (target_peer == 0) {
 			hosts[0]->broadcast(channel, packet);
@@ -441,19 +706,22 @@ int ENetMultiplayerPeer::get_unique_id() const {
 }
 
 void ENetMultiplayerPeer::set_refuse_new_connections(bool p_enabled) {
+	if (_is_threaded()) {
+		network_thread_refuse.set_to(p_enabled); // Applied to the host by the network thread.
+	} else if (_is_active()) {
 #ifdef GODOT_ENET
-	if (_is_active()) {
 		for (KeyValue<int, Ref<ENetConnection>> &E : hosts) {
 			E.value->refuse_new_connections(p_enabled);
 		}
-	}
 #endif
+	}
 	MultiplayerPeer::set_refuse_new_connections(p_enabled);
 }
 
 Ref<ENetConnection> ENetMultiplayerPeer::get_host() const {
 	ERR_FAIL_COND_V(!_is_active(), nullptr);
 	ERR_FAIL_COND_V(active_mode == MODE_MESH, nullptr);
+	ERR_FAIL_COND_V_MSG(_is_threaded(), nullptr, "The host can't be accessed while the network thread is running.");
 	return hosts[0];
 }
 
@@ -461,6 +729,7 @@ Ref<ENetPacketPeer> ENetMultiplayerPeer::get_peer(int p_id) const {
 	ERR_FAIL_COND_V(!_is_active(), nullptr);
 	ERR_FAIL_COND_V(!peers.has(p_id), nullptr);
 	ERR_FAIL_COND_V(active_mode == MODE_CLIENT && p_id != 1, nullptr);
+	ERR_FAIL_COND_V_MSG(_is_threaded(), nullptr, "The peers can't be accessed while the network thread is running.");
 	return peers[p_id];
 }
 
@@ -477,10 +746,23 @@ void ENetMultiplayerPeer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("add_mesh_peer", "peer_id", "host"), &ENetMultiplayerPeer::add_mesh_peer);
 	ClassDB::bind_method(D_METHOD("set_bind_ip", "ip"), &ENetMultiplayerPeer::set_bind_ip);
 
+	ClassDB::bind_method(D_METHOD("set_use_network_thread", "enabled"), &ENetMultiplayerPeer::set_use_network_thread);
+	ClassDB::bind_method(D_METHOD("is_using_network_thread"), &ENetMultiplayerPeer::is_using_network_thread);
+
 	ClassDB::bind_method(D_METHOD("get_host"), &ENetMultiplayerPeer::get_host);
 	ClassDB::bind_method(D_METHOD("get_peer", "id"), &ENetMultiplayerPeer::get_peer);
 
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "host", PROPERTY_HINT_RESOURCE_TYPE, "ENetConnection", PROPERTY_USAGE_NONE), "", "get_host");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_network_thread"), "set_use_network_thread", "is_using_network_thread");
+}
+
+void ENetMultiplayerPeer::set_use_network_thread(bool p_enabled) {
+	ERR_FAIL_COND_MSG(_is_active(), "The network thread can't be enabled or disabled while the multiplayer instance is active.");
+	use_network_thread = p_enabled;
+}
+
+bool ENetMultiplayerPeer::is_using_network_thread() const {
+	return use_network_thread;
 }
 
 ENetMultiplayerPeer::ENetMultiplayerPeer() {
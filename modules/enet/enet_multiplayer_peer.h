@@ -34,6 +34,9 @@
 #include "enet_connection.h"
 
 #include "core/crypto/crypto.h"
+#include "core/os/thread.h"
+#include "core/templates/safe_refcount.h"
+#include "core/templates/spsc_queue.h"
 #include "scene/main/multiplayer_peer.h"
 
 #include <enet/enet.h>
@@ -82,6 +85,53 @@ private:
 
 	Packet current_packet;
 
+	// Network thread mode (server and client only).
+	// The host is only accessed by the network thread while it runs, the main thread
+	// communicates with it through the two queues below.
+	enum {
+		THREAD_QUEUE_SIZE = 1024,
+		THREAD_SERVICE_TIMEOUT_MSEC = 1,
+	};
+
+	struct ThreadEvent {
+		ENetConnection::EventType type = ENetConnection::EVENT_NONE;
+		int peer_id = 0;
+		Ref<ENetPacketPeer> peer; // EVENT_CONNECT only.
+		Packet packet; // EVENT_RECEIVE only.
+	};
+
+	struct ThreadCommand {
+		ENetPacket *packet = nullptr; // nullptr to disconnect the target peer.
+		int target_peer = 0;
+		int channel = 0;
+	};
+
+	bool use_network_thread = false;
+	Thread network_thread;
+	SafeFlag network_thread_exit;
+	SafeFlag network_thread_refuse;
+	SafeFlag network_thread_done; // Set when the network thread stops polling, the main thread then owns the overflow.
+	SPSCQueue<ThreadEvent> *thread_events = nullptr; // Network thread to main thread.
+	SPSCQueue<ThreadCommand> *thread_commands = nullptr; // Main thread to network thread.
+	List<ThreadEvent> thread_events_overflow; // Network thread only, until network_thread_done is set.
+	List<ThreadCommand> thread_commands_overflow; // Main thread only.
+	Ref<ENetConnection> thread_host;
+	HashMap<int, Ref<ENetPacketPeer>> thread_peers; // Network thread only.
+	bool thread_refusing = false; // Network thread only.
+
+	static void _network_thread_func(void *p_user);
+	bool _network_thread_poll();
+	void _push_thread_event(const ThreadEvent &p_event);
+	bool _pop_thread_event(ThreadEvent &r_event);
+	void _push_thread_command(const ThreadCommand &p_command);
+	void _flush_thread_commands_overflow();
+	void _process_thread_commands();
+	void _poll_thread_events();
+	void _start_network_thread();
+	void _stop_network_thread();
+	_FORCE_INLINE_ bool _is_threaded() const { return network_thread.is_started(); }
+
+	static Packet _make_packet(int32_t p_source, ENetConnection::Event &p_event);
 	void _store_packet(int32_t p_source, ENetConnection::Event &p_event);
 	void _pop_current_packet();
 	void _disconnect_inactive_peers();
@@ -126,6 +176,9 @@ public:
 
 	void set_bind_ip(const IPAddress &p_ip);
 
+	void set_use_network_thread(bool p_enabled);
+	bool is_using_network_thread() const;
+
 	Ref<ENetConnection> get_host() const;
 	Ref<ENetPacketPeer> get_peer(int p_id) const;
 
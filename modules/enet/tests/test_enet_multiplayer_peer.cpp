@@ -0,0 +1,119 @@
+/**************************************************************************/
+/*  test_enet_multiplayer_peer.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifdef THREADS_ENABLED
+
+#include "test_enet_multiplayer_peer.h"
+
+#include "../enet_multiplayer_peer.h"
+
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+
+namespace TestENetMultiplayerPeer {
+
+static ENetMultiplayerPeer *watched_client = nullptr;
+static int packets_at_disconnect = -1;
+static int server_connections = 0;
+static int server_disconnections = 0;
+
+static void _client_disconnected(int p_id) {
+	packets_at_disconnect = watched_client->get_available_packet_count();
+}
+
+static void _server_connected(int p_id) {
+	server_connections++;
+}
+
+static void _server_disconnected(int p_id) {
+	server_disconnections++;
+}
+
+void thread_event_overflow_test() {
+	const int port = 24187;
+	// More than the queue between the network thread and the main thread holds.
+	const int packet_count = 3000;
+
+	Ref<ENetMultiplayerPeer> server;
+	server.instantiate();
+	REQUIRE(server->create_server(port, 1) == OK);
+	server->connect(SNAME("peer_connected"), callable_mp_static(_server_connected));
+	server->connect(SNAME("peer_disconnected"), callable_mp_static(_server_disconnected));
+
+	Ref<ENetMultiplayerPeer> client;
+	client.instantiate();
+	client->set_use_network_thread(true);
+	REQUIRE(client->create_client("127.0.0.1", port) == OK);
+	watched_client = client.ptr();
+	packets_at_disconnect = -1;
+	server_connections = 0;
+	server_disconnections = 0;
+	client->connect(SNAME("peer_disconnected"), callable_mp_static(_client_disconnected));
+
+	for (int i = 0; i < 5000 && (server_connections == 0 || client->get_connection_status() != MultiplayerPeer::CONNECTION_CONNECTED); i++) {
+		server->poll();
+		client->poll();
+		OS::get_singleton()->delay_usec(1000);
+	}
+	REQUIRE(server_connections == 1);
+	REQUIRE(client->get_connection_status() == MultiplayerPeer::CONNECTION_CONNECTED);
+
+	// The client doesn't poll, so its network thread has to keep what doesn't fit in the queue.
+	const int client_id = client->get_unique_id();
+	const uint8_t data[4] = { 1, 2, 3, 4 };
+	server->set_target_peer(client_id);
+	server->set_transfer_mode(MultiplayerPeer::TRANSFER_MODE_RELIABLE);
+	for (int i = 0; i < packet_count; i++) {
+		server->put_packet(data, sizeof(data));
+	}
+	server->get_peer(client_id)->peer_disconnect_later();
+	for (int i = 0; i < 10000 && server_disconnections == 0; i++) {
+		server->poll();
+		OS::get_singleton()->delay_usec(1000);
+	}
+	REQUIRE_MESSAGE(server_disconnections == 1, "The client must receive every packet before the disconnection.");
+
+	// The network thread stopped after the disconnection, the main thread still gets everything it queued.
+	for (int i = 0; i < 1000 && client->get_connection_status() != MultiplayerPeer::CONNECTION_DISCONNECTED; i++) {
+		client->poll();
+		OS::get_singleton()->delay_usec(1000);
+	}
+	CHECK(client->get_connection_status() == MultiplayerPeer::CONNECTION_DISCONNECTED);
+	CHECK_MESSAGE(packets_at_disconnect == packet_count, "Packets received before the disconnection must be delivered.");
+
+	watched_client = nullptr;
+	client->close();
+	server->close();
+}
+
+} // namespace TestENetMultiplayerPeer
+
+#endif // THREADS_ENABLED
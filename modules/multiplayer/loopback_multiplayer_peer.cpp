@@ -0,0 +1,338 @@
+/**************************************************************************/
+/*  loopback_multiplayer_peer.cpp                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "loopback_multiplayer_peer.h"
+
+#include "core/os/os.h"
+
+LoopbackMultiplayerPeer *LoopbackMultiplayerPeer::_get_remote(int p_peer) const {
+	const ObjectID *id = remotes.getptr(p_peer);
+	return id ? Object::cast_to<LoopbackMultiplayerPeer>(ObjectDB::get_instance(*id)) : nullptr;
+}
+
+Error LoopbackMultiplayerPeer::create_server() {
+	ERR_FAIL_COND_V_MSG(connection_status != CONNECTION_DISCONNECTED, ERR_ALREADY_IN_USE, "The multiplayer instance is already active.");
+	unique_id = TARGET_PEER_SERVER;
+	last_client_id = TARGET_PEER_SERVER;
+	connection_status = CONNECTION_CONNECTED;
+	return OK;
+}
+
+Error LoopbackMultiplayerPeer::create_client(const Ref<LoopbackMultiplayerPeer> &p_server) {
+	ERR_FAIL_COND_V_MSG(connection_status != CONNECTION_DISCONNECTED, ERR_ALREADY_IN_USE, "The multiplayer instance is already active.");
+	ERR_FAIL_COND_V(p_server.is_null() || p_server.ptr() == this, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V_MSG(!p_server->is_server() || p_server->get_connection_status() != CONNECTION_CONNECTED, ERR_INVALID_PARAMETER, "The given peer is not an active server.");
+	if (p_server->is_refusing_new_connections()) {
+		return ERR_CANT_CONNECT;
+	}
+	// Sequential IDs keep benchmarks reproducible.
+	unique_id = ++p_server->last_client_id;
+	connection_status = CONNECTION_CONNECTING;
+	remotes[TARGET_PEER_SERVER] = p_server->get_instance_id();
+	pending_connected.push_back(TARGET_PEER_SERVER);
+	p_server->_remote_connected(unique_id);
+	p_server->remotes[unique_id] = get_instance_id();
+	return OK;
+}
+
+void LoopbackMultiplayerPeer::_remote_connected(int p_peer) {
+	pending_connected.push_back(p_peer);
+}
+
+void LoopbackMultiplayerPeer::_remote_disconnected(int p_peer) {
+	if (!remotes.has(p_peer)) {
+		return;
+	}
+	remotes.erase(p_peer);
+	pending_connected.erase(p_peer);
+	for (List<Packet>::Element *E = in_flight.front(); E;) {
+		List<Packet>::Element *next = E->next();
+		if (E->get().from == p_peer) {
+			in_flight.erase(E);
+		}
+		E = next;
+	}
+	for (List<Packet>::Element *E = incoming.front(); E;) {
+		List<Packet>::Element *next = E->next();
+		if (E->get().from == p_peer) {
+			incoming.erase(E);
+		}
+		E = next;
+	}
+	if (is_server()) {
+		pending_disconnected.push_back(p_peer);
+	} else {
+		// Lost the server.
+		close();
+	}
+}
+
+void LoopbackMultiplayerPeer::_send_to(int p_peer, const uint8_t *p_buffer, int p_buffer_size) {
+	LoopbackMultiplayerPeer *remote = _get_remote(p_peer);
+	ERR_FAIL_NULL(remote);
+	Stats &pstats = peer_stats[p_peer];
+	if (get_transfer_mode() != TRANSFER_MODE_RELIABLE && packet_loss > 0 && rng.randf() < packet_loss) {
+		stats.packets_lost++;
+		pstats.packets_lost++;
+		return;
+	}
+	stats.packets_sent++;
+	stats.bytes_sent += p_buffer_size;
+	pstats.packets_sent++;
+	pstats.bytes_sent += p_buffer_size;
+	remote->_receive(unique_id, get_transfer_channel(), get_transfer_mode(), uint64_t(latency * 1000000.0), p_buffer, p_buffer_size);
+}
+
+void LoopbackMultiplayerPeer::_receive(int p_from, int p_channel, TransferMode p_mode, uint64_t p_delay_usec, const uint8_t *p_buffer, int p_buffer_size) {
+	Packet packet;
+	packet.from = p_from;
+	packet.channel = p_channel;
+	packet.transfer_mode = p_mode;
+	packet.deliver_usec = OS::get_singleton()->get_ticks_usec() + p_delay_usec;
+	packet.data.resize(p_buffer_size);
+	memcpy(packet.data.ptrw(), p_buffer, p_buffer_size);
+
+	// Keep the list sorted by delivery time, packets with the same delay stay in order.
+	List<Packet>::Element *E = in_flight.back();
+	while (E && E->get().deliver_usec > packet.deliver_usec) {
+		E = E->prev();
+	}
+	if (E) {
+		in_flight.insert_after(E, packet);
+	} else {
+		in_flight.push_front(packet);
+	}
+}
+
+void LoopbackMultiplayerPeer::set_latency(double p_latency) {
+	ERR_FAIL_COND_MSG(p_latency < 0, "Latency must be greater or equal to 0.");
+	latency = p_latency;
+}
+
+double LoopbackMultiplayerPeer::get_latency() const {
+	return latency;
+}
+
+void LoopbackMultiplayerPeer::set_packet_loss(double p_loss) {
+	ERR_FAIL_COND_MSG(p_loss < 0 || p_loss > 1, "Packet loss must be between 0 and 1.");
+	packet_loss = p_loss;
+}
+
+double LoopbackMultiplayerPeer::get_packet_loss() const {
+	return packet_loss;
+}
+
+void LoopbackMultiplayerPeer::set_seed(uint64_t p_seed) {
+	rng.seed(p_seed);
+}
+
+static Dictionary _stats_to_dict(uint64_t p_packets_sent, uint64_t p_bytes_sent, uint64_t p_packets_received, uint64_t p_bytes_received, uint64_t p_packets_lost) {
+	Dictionary ret;
+	ret["packets_sent"] = p_packets_sent;
+	ret["bytes_sent"] = p_bytes_sent;
+	ret["packets_received"] = p_packets_received;
+	ret["bytes_received"] = p_bytes_received;
+	ret["packets_lost"] = p_packets_lost;
+	return ret;
+}
+
+Dictionary LoopbackMultiplayerPeer::get_statistics() const {
+	return _stats_to_dict(stats.packets_sent, stats.bytes_sent, stats.packets_received, stats.bytes_received, stats.packets_lost);
+}
+
+Dictionary LoopbackMultiplayerPeer::get_peer_statistics(int p_peer) const {
+	const Stats *s = peer_stats.getptr(p_peer);
+	if (!s) {
+		return _stats_to_dict(0, 0, 0, 0, 0);
+	}
+	return _stats_to_dict(s->packets_sent, s->bytes_sent, s->packets_received, s->bytes_received, s->packets_lost);
+}
+
+void LoopbackMultiplayerPeer::reset_statistics() {
+	stats = Stats();
+	peer_stats.clear();
+}
+
+int LoopbackMultiplayerPeer::get_available_packet_count() const {
+	return incoming.size();
+}
+
+Error LoopbackMultiplayerPeer::get_packet(const uint8_t **r_buffer, int &r_buffer_size) {
+	ERR_FAIL_COND_V_MSG(incoming.is_empty(), ERR_UNAVAILABLE, "No incoming packets available.");
+	current_packet = incoming.front()->get();
+	incoming.pop_front();
+	*r_buffer = current_packet.data.ptr();
+	r_buffer_size = current_packet.data.size();
+	return OK;
+}
+
+Error LoopbackMultiplayerPeer::put_packet(const uint8_t *p_buffer, int p_buffer_size) {
+	ERR_FAIL_COND_V_MSG(connection_status != CONNECTION_CONNECTED, ERR_UNCONFIGURED, "The multiplayer instance isn't currently active.");
+	if (target_peer > 0) {
+		ERR_FAIL_COND_V_MSG(!remotes.has(target_peer), ERR_INVALID_PARAMETER, vformat("Invalid target peer: %d", target_peer));
+		_send_to(target_peer, p_buffer, p_buffer_size);
+		return OK;
+	}
+	for (const KeyValue<int, ObjectID> &E : remotes) {
+		if (target_peer < 0 && E.key == -target_peer) {
+			continue; // Excluded.
+		}
+		_send_to(E.key, p_buffer, p_buffer_size);
+	}
+	return OK;
+}
+
+int LoopbackMultiplayerPeer::get_max_packet_size() const {
+	return 1 << 24;
+}
+
+void LoopbackMultiplayerPeer::set_target_peer(int p_peer_id) {
+	target_peer = p_peer_id;
+}
+
+int LoopbackMultiplayerPeer::get_packet_peer() const {
+	ERR_FAIL_COND_V_MSG(incoming.is_empty(), 0, "No incoming packets available.");
+	return incoming.front()->get().from;
+}
+
+MultiplayerPeer::TransferMode LoopbackMultiplayerPeer::get_packet_mode() const {
+	ERR_FAIL_COND_V_MSG(incoming.is_empty(), TRANSFER_MODE_RELIABLE, "No incoming packets available.");
+	return incoming.front()->get().transfer_mode;
+}
+
+int LoopbackMultiplayerPeer::get_packet_channel() const {
+	ERR_FAIL_COND_V_MSG(incoming.is_empty(), 0, "No incoming packets available.");
+	return incoming.front()->get().channel;
+}
+
+void LoopbackMultiplayerPeer::disconnect_peer(int p_peer, bool p_force) {
+	ERR_FAIL_COND(!remotes.has(p_peer));
+	if (!is_server()) {
+		close();
+		return;
+	}
+	LoopbackMultiplayerPeer *remote = _get_remote(p_peer);
+	remotes.erase(p_peer);
+	if (remote) {
+		remote->_remote_disconnected(unique_id);
+	}
+	if (p_force) {
+		emit_signal(SNAME("peer_disconnected"), p_peer);
+	} else {
+		pending_disconnected.push_back(p_peer);
+	}
+}
+
+bool LoopbackMultiplayerPeer::is_server() const {
+	return unique_id == TARGET_PEER_SERVER;
+}
+
+void LoopbackMultiplayerPeer::poll() {
+	if (connection_status == CONNECTION_DISCONNECTED) {
+		return;
+	}
+	if (connection_status == CONNECTION_CONNECTING) {
+		connection_status = CONNECTION_CONNECTED;
+	}
+	while (!pending_connected.is_empty()) {
+		int peer = pending_connected.front()->get();
+		pending_connected.pop_front();
+		emit_signal(SNAME("peer_connected"), peer);
+	}
+	while (!pending_disconnected.is_empty()) {
+		int peer = pending_disconnected.front()->get();
+		pending_disconnected.pop_front();
+		emit_signal(SNAME("peer_disconnected"), peer);
+	}
+	const uint64_t now = OS::get_singleton()->get_ticks_usec();
+	while (!in_flight.is_empty() && in_flight.front()->get().deliver_usec <= now) {
+		const Packet &packet = in_flight.front()->get();
+		stats.packets_received++;
+		stats.bytes_received += packet.data.size();
+		Stats &pstats = peer_stats[packet.from];
+		pstats.packets_received++;
+		pstats.bytes_received += packet.data.size();
+		incoming.push_back(packet);
+		in_flight.pop_front();
+	}
+}
+
+void LoopbackMultiplayerPeer::close() {
+	if (connection_status == CONNECTION_DISCONNECTED) {
+		return;
+	}
+	connection_status = CONNECTION_DISCONNECTED;
+	const int id = unique_id;
+	HashMap<int, ObjectID> to_notify = remotes;
+	remotes.clear();
+	for (const KeyValue<int, ObjectID> &E : to_notify) {
+		LoopbackMultiplayerPeer *remote = Object::cast_to<LoopbackMultiplayerPeer>(ObjectDB::get_instance(E.value));
+		if (remote) {
+			remote->_remote_disconnected(id);
+		}
+	}
+	in_flight.clear();
+	incoming.clear();
+	pending_connected.clear();
+	pending_disconnected.clear();
+	unique_id = 0;
+	target_peer = 0;
+}
+
+int LoopbackMultiplayerPeer::get_unique_id() const {
+	ERR_FAIL_COND_V_MSG(connection_status == CONNECTION_DISCONNECTED, 0, "The multiplayer instance isn't currently active.");
+	return unique_id;
+}
+
+MultiplayerPeer::ConnectionStatus LoopbackMultiplayerPeer::get_connection_status() const {
+	return connection_status;
+}
+
+void LoopbackMultiplayerPeer::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("create_server"), &LoopbackMultiplayerPeer::create_server);
+	ClassDB::bind_method(D_METHOD("create_client", "server"), &LoopbackMultiplayerPeer::create_client);
+
+	ClassDB::bind_method(D_METHOD("set_latency", "latency"), &LoopbackMultiplayerPeer::set_latency);
+	ClassDB::bind_method(D_METHOD("get_latency"), &LoopbackMultiplayerPeer::get_latency);
+	ClassDB::bind_method(D_METHOD("set_packet_loss", "loss"), &LoopbackMultiplayerPeer::set_packet_loss);
+	ClassDB::bind_method(D_METHOD("get_packet_loss"), &LoopbackMultiplayerPeer::get_packet_loss);
+	ClassDB::bind_method(D_METHOD("set_seed", "seed"), &LoopbackMultiplayerPeer::set_seed);
+
+	ClassDB::bind_method(D_METHOD("get_statistics"), &LoopbackMultiplayerPeer::get_statistics);
+	ClassDB::bind_method(D_METHOD("get_peer_statistics", "peer"), &LoopbackMultiplayerPeer::get_peer_statistics);
+	ClassDB::bind_method(D_METHOD("reset_statistics"), &LoopbackMultiplayerPeer::reset_statistics);
+
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "latency", PROPERTY_HINT_RANGE, "0,1,0.001,or_greater,suffix:s"), "set_latency", "get_latency");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "packet_loss", PROPERTY_HINT_RANGE, "0,1,0.001"), "set_packet_loss", "get_packet_loss");
+}
+
+LoopbackMultiplayerPeer::~LoopbackMultiplayerPeer() {
+	close();
+}
@@ -0,0 +1,125 @@
+/**************************************************************************/
+/*  loopback_multiplayer_peer.h                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef LOOPBACK_MULTIPLAYER_PEER_H
+#define LOOPBACK_MULTIPLAYER_PEER_H
+
+#include "core/math/random_pcg.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/list.h"
+#include "scene/main/multiplayer_peer.h"
+
+// In-process peer, used to test and benchmark the multiplayer API without sockets.
+// Clients are connected to a server peer in the same process, with simulated latency and packet loss.
+class LoopbackMultiplayerPeer : public MultiplayerPeer {
+	GDCLASS(LoopbackMultiplayerPeer, MultiplayerPeer);
+
+private:
+	struct Packet {
+		int from = 0;
+		int channel = 0;
+		TransferMode transfer_mode = TRANSFER_MODE_RELIABLE;
+		uint64_t deliver_usec = 0;
+		Hector<uint8_t> data;
+	};
+
+	struct Stats {
+		uint64_t packets_sent = 0;
+		uint64_t bytes_sent = 0;
+		uint64_t packets_received = 0;
+		uint64_t bytes_received = 0;
+		uint64_t packets_lost = 0;
+	};
+
+	ConnectionStatus connection_status = CONNECTION_DISCONNECTED;
+	int unique_id = 0;
+	int target_peer = 0;
+	int last_client_id = 1;
+
+	// Server: connected clients. Client: the server, as ID 1.
+	HashMap<int, ObjectID> remotes;
+	List<int> pending_connected;
+	List<int> pending_disconnected;
+
+	List<Packet> in_flight; // Sorted by delivery time.
+	List<Packet> incoming;
+	Packet current_packet;
+
+	double latency = 0;
+	double packet_loss = 0;
+	RandomPCG rng;
+	Stats stats;
+	HashMap<int, Stats> peer_stats;
+
+	LoopbackMultiplayerPeer *_get_remote(int p_peer) const;
+	void _send_to(int p_peer, const uint8_t *p_buffer, int p_buffer_size);
+	void _receive(int p_from, int p_channel, TransferMode p_mode, uint64_t p_delay_usec, const uint8_t *p_buffer, int p_buffer_size);
+	void _remote_connected(int p_peer);
+	void _remote_disconnected(int p_peer);
+
+protected:
+	static void _bind_methods();
+
+public:
+	Error create_server();
+	Error create_client(const Ref<LoopbackMultiplayerPeer> &p_server);
+
+	void set_latency(double p_latency);
+	double get_latency() const;
+	void set_packet_loss(double p_loss);
+	double get_packet_loss() const;
+	void set_seed(uint64_t p_seed);
+
+	Dictionary get_statistics() const;
+	Dictionary get_peer_statistics(int p_peer) const;
+	void reset_statistics();
+
+	virtual int get_available_packet_count() const override;
+	virtual Error get_packet(const uint8_t **r_buffer, int &r_buffer_size) override;
+	virtual Error put_packet(const uint8_t *p_buffer, int p_buffer_size) override;
+	virtual int get_max_packet_size() const override;
+
+	virtual bool is_server_relay_supported() const override { return true; }
+	virtual void set_target_peer(int p_peer_id) override;
+	virtual int get_packet_peer() const override;
+	virtual TransferMode get_packet_mode() const override;
+	virtual int get_packet_channel() const override;
+	virtual void disconnect_peer(int p_peer, bool p_force = false) override;
+	virtual bool is_server() const override;
+	virtual void poll() override;
+	virtual void close() override;
+	virtual int get_unique_id() const override;
+	virtual ConnectionStatus get_connection_status() const override;
+
+	LoopbackMultiplayerPeer() {}
+	~LoopbackMultiplayerPeer();
+};
+
+#endif // LOOPBACK_MULTIPLAYER_PEER_H
@@ -0,0 +1,97 @@
+/**************************************************************************/
+/*  multiplayer_interest_grid.cpp                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "multiplayer_interest_grid.h"
+
+void MultiplayerInterestGrid::set_cell_size(real_t p_size) {
+	ERR_FAIL_COND_MSG(p_size <= 0, "Cell size must be greater than 0.");
+	if (p_size == cell_size) {
+		return;
+	}
+	cell_size = p_size;
+	// Rebuild cells.
+	cells.clear();
+	for (KeyValue<ObjectID, Entry> &E : objects) {
+		E.value.cell = _get_cell(E.value.position);
+		cells[E.value.cell].insert(E.key);
+	}
+}
+
+void MultiplayerInterestGrid::update_object(const ObjectID &p_id, const Hector3 &p_position) {
+	const Hector3i cell = _get_cell(p_position);
+	Entry *entry = objects.getptr(p_id);
+	if (!entry) {
+		objects.insert(p_id, { cell, p_position });
+		cells[cell].insert(p_id);
+		return;
+	}
+	entry->position = p_position;
+	if (entry->cell == cell) {
+		return; // Most updates stay in the same cell.
+	}
+	HashMap<Hector3i, HashSet<ObjectID>>::Iterator old_cell = cells.find(entry->cell);
+	if (old_cell) {
+		old_cell->value.erase(p_id);
+		if (old_cell->value.is_empty()) {
+			cells.remove(old_cell);
+		}
+	}
+	entry->cell = cell;
+	cells[cell].insert(p_id);
+}
+
+void MultiplayerInterestGrid::remove_object(const ObjectID &p_id) {
+	HashMap<ObjectID, Entry>::Iterator entry = objects.find(p_id);
+	if (!entry) {
+		return;
+	}
+	HashMap<Hector3i, HashSet<ObjectID>>::Iterator cell = cells.find(entry->value.cell);
+	if (cell) {
+		cell->value.erase(p_id);
+		if (cell->value.is_empty()) {
+			cells.remove(cell);
+		}
+	}
+	objects.remove(entry);
+}
+
+bool MultiplayerInterestGrid::get_position(const ObjectID &p_id, Hector3 &r_position) const {
+	const Entry *entry = objects.getptr(p_id);
+	if (!entry) {
+		return false;
+	}
+	r_position = entry->position;
+	return true;
+}
+
+void MultiplayerInterestGrid::clear() {
+	cells.clear();
+	objects.clear();
+}
@@ -0,0 +1,104 @@
+/**************************************************************************/
+/*  multiplayer_interest_grid.h                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef MULTIPLAYER_INTEREST_GRID_H
+#define MULTIPLAYER_INTEREST_GRID_H
+
+#include "core/math/Hector3.h"
+#include "core/math/Hector3i.h"
+#include "core/object/object_id.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+
+// Uniform grid of object positions, used to find the synchronizers near each peer without testing all of them.
+class MultiplayerInterestGrid {
+	struct Entry {
+		Hector3i cell;
+		Hector3 position;
+	};
+
+	real_t cell_size = 64;
+	HashMap<Hector3i, HashSet<ObjectID>> cells;
+	HashMap<ObjectID, Entry> objects;
+
+	_FORCE_INLINE_ Hector3i _get_cell(const Hector3 &p_position) const {
+		return Hector3i((p_position / cell_size).floor());
+	}
+
+public:
+	void set_cell_size(real_t p_size);
+	real_t get_cell_size() const { return cell_size; }
+
+	void update_object(const ObjectID &p_id, const Hector3 &p_position);
+	void remove_object(const ObjectID &p_id);
+	bool has_object(const ObjectID &p_id) const { return objects.has(p_id); }
+	bool get_position(const ObjectID &p_id, Hector3 &r_position) const;
+	int get_object_count() const { return objects.size(); }
+	void clear();
+
+	// Calls p_callback(id, distance) for each object within p_radius of p_center.
+	template <typename F>
+	void query(const Hector3 &p_center, real_t p_radius, F p_callback) const {
+		const Hector3i from = _get_cell(p_center - Hector3(p_radius, p_radius, p_radius));
+		const Hector3i to = _get_cell(p_center + Hector3(p_radius, p_radius, p_radius));
+		const int64_t range = int64_t(to.x - from.x + 1) * (to.y - from.y + 1) * (to.z - from.z + 1);
+		const real_t radius_squared = p_radius * p_radius;
+		auto check_cell = [&](const HashSet<ObjectID> &p_cell) {
+			for (const ObjectID &id : p_cell) {
+				const real_t distance_squared = objects[id].position.distance_squared_to(p_center);
+				if (distance_squared <= radius_squared) {
+					p_callback(id, Math::sqrt(distance_squared));
+				}
+			}
+		};
+		if (range > int64_t(cells.size())) {
+			// Sparse world, cheaper to walk the occupied cells.
+			for (const KeyValue<Hector3i, HashSet<ObjectID>> &E : cells) {
+				const Hector3i &c = E.key;
+				if (c.x >= from.x && c.x <= to.x && c.y >= from.y && c.y <= to.y && c.z >= from.z && c.z <= to.z) {
+					check_cell(E.value);
+				}
+			}
+			return;
+		}
+		for (int x = from.x; x <= to.x; x++) {
+			for (int y = from.y; y <= to.y; y++) {
+				for (int z = from.z; z <= to.z; z++) {
+					const HashSet<ObjectID> *cell = cells.getptr(Hector3i(x, y, z));
+					if (cell) {
+						check_cell(*cell);
+					}
+				}
+			}
+		}
+	}
+};
+
+#endif // MULTIPLAYER_INTEREST_GRID_H
@@ -242,6 +242,27 @@ MultiplayerSynchronizer::VisibilityUpdateMode MultiplayerSynchronizer::get_visib
 	return visibility_update_mode;
 }
 
+void MultiplayerSynchronizer::set_spatial_interest(bool p_enabled) {
+	if (spatial_interest == p_enabled) {
+		return;
+	}
+	spatial_interest = p_enabled;
+	update_visibility(0);
+}
+
+bool MultiplayerSynchronizer::is_spatial_interest() const {
+	return spatial_interest;
+}
+
+void MultiplayerSynchronizer::set_sync_priority(real_t p_priority) {
+	ERR_FAIL_COND_MSG(p_priority < 0, "Priority must be greater or equal to 0.");
+	sync_priority = p_priority;
+}
+
+real_t MultiplayerSynchronizer::get_sync_priority() const {
+	return sync_priority;
+}
+
 void MultiplayerSynchronizer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_root_path", "path"), &MultiplayerSynchronizer::set_root_path);
 	ClassDB::bind_method(D_METHOD("get_root_path"), &MultiplayerSynchronizer::get_root_path);
@@ -267,12 +288,19 @@ void MultiplayerSynchronizer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_visibility_for", "peer", "visible"), &MultiplayerSynchronizer::set_visibility_for);
 	ClassDB::bind_method(D_METHOD("get_visibility_for", "peer"), &MultiplayerSynchronizer::get_visibility_for);
 
+	ClassDB::bind_method(D_METHOD("set_spatial_interest", "enabled"), &MultiplayerSynchronizer::set_spatial_interest);
+	ClassDB::bind_method(D_METHOD("is_spatial_interest"), &MultiplayerSynchronizer::is_spatial_interest);
+	ClassDB::bind_method(D_METHOD("set_sync_priority", "priority"), &MultiplayerSynchronizer::set_sync_priority);
+	ClassDB::bind_method(D_METHOD("get_sync_priority"), &MultiplayerSynchronizer::get_sync_priority);
+
 	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "root_path"), "set_root_path", "get_root_path");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "replication_interval", PROPERTY_HINT_RANGE, "0,5,0.001,suffix:s"), "set_replication_interval", "get_replication_interval");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "delta_interval", PROPERTY_HINT_RANGE, "0,5,0.001,suffix:s"), "set_delta_interval", "get_delta_interval");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "replication_config", PROPERTY_HINT_RESOURCE_TYPE, "SceneReplicationConfig", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_EDITOR_INSTANTIATE_OBJECT), "set_replication_config", "get_replication_config");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "visibility_update_mode", PROPERTY_HINT_ENUM, "Idle,Physics,None"), "set_visibility_update_mode", "get_visibility_update_mode");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "public_visibility"), "set_visibility_public", "is_visibility_public");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "spatial_interest"), "set_spatial_interest", "is_spatial_interest");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "sync_priority", PROPERTY_HINT_RANGE, "0,16,0.01,or_greater"), "set_sync_priority", "get_sync_priority");
 
 	BIND_ENUM_CONSTANT(VISIBILITY_PROCESS_IDLE);
 	BIND_ENUM_CONSTANT(VISIBILITY_PROCESS_PHYSICS);
@@ -30,6 +30,7 @@
 
 #include "register_types.h"
 
+#include "loopback_multiplayer_peer.h"
 #include "multiplayer_debugger.h"
 #include "multiplayer_spawner.h"
 #include "multiplayer_synchronizer.h"
@@ -47,6 +48,7 @@ void initialize_multiplayer_module(ModuleInitializationLevel p_level) {
 		GDREGISTER_CLASS(MultiplayerSpawner);
 		GDREGISTER_CLASS(MultiplayerSynchronizer);
 		GDREGISTER_CLASS(OfflineMultiplayerPeer);
+		GDREGISTER_CLASS(LoopbackMultiplayerPeer);
 		GDREGISTER_CLASS(SceneMultiplayer);
 		MultiplayerAPI::set_default_interface("SceneMultiplayer");
 		MultiplayerDebugger::initialize();
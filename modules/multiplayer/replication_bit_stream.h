@@ -0,0 +1,166 @@
+/**************************************************************************/
+/*  replication_bit_stream.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef REPLICATION_BIT_STREAM_H
+#define REPLICATION_BIT_STREAM_H
+
+#include "core/templates/local_Hector.h"
+#include "core/typedefs.h"
+
+// Minimal LSB-first bit packing used by the replication schemas.
+class ReplicationBitWriter {
+	LocalHector<uint8_t> data;
+	LocalHector<uint8_t> staging; // Reused between fields, see get_staging_buffer().
+	uint64_t scratch = 0;
+	int scratch_bits = 0;
+
+public:
+	// At least p_size bytes to encode a value into before passing it to put_bytes().
+	// Only valid until the next call.
+	uint8_t *get_staging_buffer(int p_size) {
+		if ((int)staging.size() < p_size) {
+			staging.resize(p_size);
+		}
+		return staging.ptr();
+	}
+
+	_FORCE_INLINE_ void put_bits(uint32_t p_value, int p_count) {
+		DEV_ASSERT(p_count >= 0 && p_count <= 32);
+		if (p_count < 32) {
+			p_value &= (1u << p_count) - 1;
+		}
+		scratch |= uint64_t(p_value) << scratch_bits;
+		scratch_bits += p_count;
+		while (scratch_bits >= 8) {
+			data.push_back(scratch & 0xFF);
+			scratch >>= 8;
+			scratch_bits -= 8;
+		}
+	}
+
+	_FORCE_INLINE_ void put_bool(bool p_value) { put_bits(p_value ? 1 : 0, 1); }
+
+	void put_uvarint(uint64_t p_value) {
+		// 7 bits per group, the 8th bit tells whether more groups follow.
+		while (p_value >= 0x80) {
+			put_bits((p_value & 0x7F) | 0x80, 8);
+			p_value >>= 7;
+		}
+		put_bits(p_value, 8);
+	}
+
+	_FORCE_INLINE_ void put_varint(int64_t p_value) { put_uvarint((uint64_t(p_value) << 1) ^ uint64_t(p_value >> 63)); }
+
+	void put_bytes(const uint8_t *p_data, int p_size) {
+		for (int i = 0; i < p_size; i++) {
+			put_bits(p_data[i], 8);
+		}
+	}
+
+	// Pads the last byte with zeros.
+	void flush() {
+		if (scratch_bits > 0) {
+			put_bits(0, 8 - scratch_bits);
+		}
+	}
+
+	void clear() {
+		data.clear();
+		scratch = 0;
+		scratch_bits = 0;
+	}
+
+	int get_bit_count() const { return data.size() * 8 + scratch_bits; }
+	const uint8_t *get_data() const { return data.ptr(); }
+	int get_size() const { return data.size(); } // Only whole bytes, call flush() first.
+};
+
+class ReplicationBitReader {
+	const uint8_t *data = nullptr;
+	int size = 0;
+	int pos = 0;
+	uint64_t scratch = 0;
+	int scratch_bits = 0;
+	bool overflow = false;
+
+public:
+	_FORCE_INLINE_ uint32_t get_bits(int p_count) {
+		DEV_ASSERT(p_count >= 0 && p_count <= 32);
+		while (scratch_bits < p_count) {
+			if (likely(pos < size)) {
+				scratch |= uint64_t(data[pos++]) << scratch_bits;
+			} else {
+				overflow = true;
+			}
+			scratch_bits += 8;
+		}
+		uint32_t value = p_count < 32 ? uint32_t(scratch & ((1u << p_count) - 1)) : uint32_t(scratch);
+		scratch >>= p_count;
+		scratch_bits -= p_count;
+		return value;
+	}
+
+	_FORCE_INLINE_ bool get_bool() { return get_bits(1) != 0; }
+
+	uint64_t get_uvarint() {
+		uint64_t value = 0;
+		for (int shift = 0; shift < 64; shift += 7) {
+			uint32_t group = get_bits(8);
+			value |= uint64_t(group & 0x7F) << shift;
+			if (!(group & 0x80)) {
+				return value;
+			}
+		}
+		overflow = true; // Malformed, longer than 64 bits.
+		return value;
+	}
+
+	_FORCE_INLINE_ int64_t get_varint() {
+		uint64_t value = get_uvarint();
+		return int64_t(value >> 1) ^ -int64_t(value & 1);
+	}
+
+	void get_bytes(uint8_t *r_data, int p_size) {
+		for (int i = 0; i < p_size; i++) {
+			r_data[i] = get_bits(8);
+		}
+	}
+
+	// True if more bits were read than available, the read values are then invalid.
+	bool has_overflowed() const { return overflow; }
+	int get_bits_left() const { return (size - pos) * 8 + scratch_bits; }
+
+	ReplicationBitReader(const uint8_t *p_data, int p_size) {
+		data = p_data;
+		size = p_size;
+	}
+};
+
+#endif // REPLICATION_BIT_STREAM_H
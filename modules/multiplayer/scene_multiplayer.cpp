@@ -72,6 +72,9 @@ Error SceneMultiplayer::poll() {
 		return OK;
 	}
 
+	// RPCs batched since the last poll, sent before servicing the peer.
+	rpc->flush_rpcs();
+
 	multiplayer_peer->poll();
 
 	_update_status();
@@ -173,6 +176,7 @@ void SceneMultiplayer::clear() {
 	pending_peers.clear();
 	connected_peers.clear();
 	packet_cache.clear();
+	rpc->clear_rpcs();
 	replicator->on_reset();
 	cache->clear();
 	relay_buffer->clear();
@@ -260,6 +264,10 @@ _FORCE_INLINE_ Error SceneMultiplayer::_send(const uint8_t *p_packet, int p_pack
 #endif
 
 Error SceneMultiplayer::send_command(int p_to, const uint8_t *p_packet, int p_packet_len) {
+	if (rpc->has_pending_rpcs()) {
+		// Keep the order in which packets were sent.
+		rpc->flush_rpcs();
+	}
 	if (server_relay && get_unique_id() != 1 && p_to != 1 && multiplayer_peer->is_server_relay_supported()) {
 		// Send relay packet.
 		relay_buffer->seek(0);
@@ -637,6 +645,46 @@ int SceneMultiplayer::get_max_delta_packet_size() const {
 	return replicator->get_max_delta_packet_size();
 }
 
+void SceneMultiplayer::set_rpc_batching_enabled(bool p_enabled) {
+	rpc->set_batching_enabled(p_enabled);
+}
+
+bool SceneMultiplayer::is_rpc_batching_enabled() const {
+	return rpc->is_batching_enabled();
+}
+
+void SceneMultiplayer::set_max_sync_bandwidth(int p_bytes_per_second) {
+	replicator->set_max_sync_bandwidth(p_bytes_per_second);
+}
+
+int SceneMultiplayer::get_max_sync_bandwidth() const {
+	return replicator->get_max_sync_bandwidth();
+}
+
+void SceneMultiplayer::set_interest_cell_size(real_t p_size) {
+	replicator->set_interest_cell_size(p_size);
+}
+
+real_t SceneMultiplayer::get_interest_cell_size() const {
+	return replicator->get_interest_cell_size();
+}
+
+void SceneMultiplayer::set_interest_radius(real_t p_radius) {
+	replicator->set_interest_radius(p_radius);
+}
+
+real_t SceneMultiplayer::get_interest_radius() const {
+	return replicator->get_interest_radius();
+}
+
+void SceneMultiplayer::set_interest_observer(int p_peer, Node *p_observer) {
+	replicator->set_interest_observer(p_peer, p_observer);
+}
+
+Node *SceneMultiplayer::get_interest_observer(int p_peer) const {
+	return replicator->get_interest_observer(p_peer);
+}
+
 void SceneMultiplayer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_root_path", "path"), &SceneMultiplayer::set_root_path);
 	ClassDB::bind_method(D_METHOD("get_root_path"), &SceneMultiplayer::get_root_path);
@@ -665,6 +713,18 @@ void SceneMultiplayer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_max_sync_packet_size", "size"), &SceneMultiplayer::set_max_sync_packet_size);
 	ClassDB::bind_method(D_METHOD("get_max_delta_packet_size"), &SceneMultiplayer::get_max_delta_packet_size);
 	ClassDB::bind_method(D_METHOD("set_max_delta_packet_size", "size"), &SceneMultiplayer::set_max_delta_packet_size);
+	ClassDB::bind_method(D_METHOD("set_rpc_batching_enabled", "enabled"), &SceneMultiplayer::set_rpc_batching_enabled);
+	ClassDB::bind_method(D_METHOD("is_rpc_batching_enabled"), &SceneMultiplayer::is_rpc_batching_enabled);
+
+	ClassDB::bind_method(D_METHOD("get_max_sync_bandwidth"), &SceneMultiplayer::get_max_sync_bandwidth);
+	ClassDB::bind_method(D_METHOD("set_max_sync_bandwidth", "bytes_per_second"), &SceneMultiplayer::set_max_sync_bandwidth);
+
+	ClassDB::bind_method(D_METHOD("get_interest_cell_size"), &SceneMultiplayer::get_interest_cell_size);
+	ClassDB::bind_method(D_METHOD("set_interest_cell_size", "size"), &SceneMultiplayer::set_interest_cell_size);
+	ClassDB::bind_method(D_METHOD("get_interest_radius"), &SceneMultiplayer::get_interest_radius);
+	ClassDB::bind_method(D_METHOD("set_interest_radius", "radius"), &SceneMultiplayer::set_interest_radius);
+	ClassDB::bind_method(D_METHOD("set_interest_observer", "peer", "observer"), &SceneMultiplayer::set_interest_observer);
+	ClassDB::bind_method(D_METHOD("get_interest_observer", "peer"), &SceneMultiplayer::get_interest_observer);
 
 	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "root_path"), "set_root_path", "get_root_path");
 	ADD_PROPERTY(PropertyInfo(Variant::CALLABLE, "auth_callback"), "set_auth_callback", "get_auth_callback");
@@ -672,8 +732,12 @@ void SceneMultiplayer::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "allow_object_decoding"), "set_allow_object_decoding", "is_object_decoding_allowed");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "refuse_new_connections"), "set_refuse_new_connections", "is_refusing_new_connections");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "server_relay"), "set_server_relay_enabled", "is_server_relay_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "rpc_batching"), "set_rpc_batching_enabled", "is_rpc_batching_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_sync_packet_size"), "set_max_sync_packet_size", "get_max_sync_packet_size");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_delta_packet_size"), "set_max_delta_packet_size", "get_max_delta_packet_size");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_sync_bandwidth", PROPERTY_HINT_RANGE, "0,1000000,1,or_greater,suffix:B/s"), "set_max_sync_bandwidth", "get_max_sync_bandwidth");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "interest_cell_size", PROPERTY_HINT_RANGE, "0.01,1024,0.01,or_greater"), "set_interest_cell_size", "get_interest_cell_size");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "interest_radius", PROPERTY_HINT_RANGE, "0.01,4096,0.01,or_greater"), "set_interest_radius", "get_interest_radius");
 
 	ADD_PROPERTY_DEFAULT("refuse_new_connections", false);
 
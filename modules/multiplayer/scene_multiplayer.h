@@ -183,7 +183,7 @@ public:
 	Error send_bytes(Hector<uint8_t> p_data, int p_to = MultiplayerPeer::TARGET_PEER_BROADCAST, MultiplayerPeer::TransferMode p_mode = MultiplayerPeer::TRANSFER_MODE_RELIABLE, int p_channel = 0);
 	String get_rpc_md5(const Object *p_obj);
 
-	const HashSet<int> get_connected_peers() const { return connected_peers; }
+	const HashSet<int> &get_connected_peers() const { return connected_peers; }
 
 	void set_remote_sender_override(int p_id) { remote_sender_override = p_id; }
 	void set_refuse_new_connections(bool p_refuse);
@@ -201,6 +201,21 @@ public:
 	void set_max_delta_packet_size(int p_size);
 	int get_max_delta_packet_size() const;
 
+	void set_rpc_batching_enabled(bool p_enabled);
+	bool is_rpc_batching_enabled() const;
+
+	void set_max_sync_bandwidth(int p_bytes_per_second);
+	int get_max_sync_bandwidth() const;
+
+	void set_interest_cell_size(real_t p_size);
+	real_t get_interest_cell_size() const;
+
+	void set_interest_radius(real_t p_radius);
+	real_t get_interest_radius() const;
+
+	void set_interest_observer(int p_peer, Node *p_observer);
+	Node *get_interest_observer(int p_peer) const;
+
 	SceneMultiplayer();
 	~SceneMultiplayer();
 };
@@ -55,6 +55,16 @@ bool SceneReplicationConfig::_set(const StringName &p_name, const Variant &p_val
 			ERR_FAIL_COND_V(mode < REPLICATION_MODE_NEVER || mode > REPLICATION_MODE_ON_CHANGE, false);
 			property_set_replication_mode(prop.name, mode);
 			return true;
+		} else if (what == "encoding") {
+			ERR_FAIL_COND_V(p_value.get_type() != Variant::INT, false);
+			PropertyEncoding encoding = (PropertyEncoding)p_value.operator int();
+			ERR_FAIL_COND_V(encoding < PROPERTY_ENCODING_VARIANT || encoding > PROPERTY_ENCODING_QUATERNION, false);
+			property_set_encoding(prop.name, encoding);
+			return true;
+		} else if (what == "precision") {
+			ERR_FAIL_COND_V(p_value.get_type() != Variant::FLOAT, false);
+			property_set_precision(prop.name, p_value);
+			return true;
 		}
 		ERR_FAIL_COND_V(p_value.get_type() != Variant::BOOL, false);
 		if (what == "spawn") {
@@ -90,6 +100,12 @@ bool SceneReplicationConfig::_get(const StringName &p_name, Variant &r_ret) cons
 		} else if (what == "replication_mode") {
 			r_ret = prop.mode;
 			return true;
+		} else if (what == "encoding") {
+			r_ret = prop.encoding;
+			return true;
+		} else if (what == "precision") {
+			r_ret = prop.precision;
+			return true;
 		}
 	}
 	return false;
@@ -100,6 +116,8 @@ void SceneReplicationConfig::_get_property_list(List<PropertyInfo> *p_list) cons
 		p_list->push_back(PropertyInfo(Variant::STRING, "properties/" + itos(i) + "/path", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL));
 		p_list->push_back(PropertyInfo(Variant::STRING, "properties/" + itos(i) + "/spawn", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL));
 		p_list->push_back(PropertyInfo(Variant::INT, "properties/" + itos(i) + "/replication_mode", PROPERTY_HINT_ENUM, "Never,Always,On Change", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL));
+		p_list->push_back(PropertyInfo(Variant::INT, "properties/" + itos(i) + "/encoding", PROPERTY_HINT_ENUM, "Variant,Bool,Varint,Float,Hector2,Hector3,Quaternion", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL));
+		p_list->push_back(PropertyInfo(Variant::FLOAT, "properties/" + itos(i) + "/precision", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL));
 	}
 }
 
@@ -225,6 +243,39 @@ void SceneReplicationConfig::property_set_replication_mode(const NodePath &p_pat
 	dirty = true;
 }
 
+SceneReplicationConfig::PropertyEncoding SceneReplicationConfig::property_get_encoding(const NodePath &p_path) {
+	List<ReplicationProperty>::Element *E = properties.find(p_path);
+	ERR_FAIL_COND_V(!E, PROPERTY_ENCODING_VARIANT);
+	return E->get().encoding;
+}
+
+void SceneReplicationConfig::property_set_encoding(const NodePath &p_path, PropertyEncoding p_encoding) {
+	List<ReplicationProperty>::Element *E = properties.find(p_path);
+	ERR_FAIL_COND(!E);
+	if (E->get().encoding == p_encoding) {
+		return;
+	}
+	E->get().encoding = p_encoding;
+	dirty = true;
+}
+
+real_t SceneReplicationConfig::property_get_precision(const NodePath &p_path) {
+	List<ReplicationProperty>::Element *E = properties.find(p_path);
+	ERR_FAIL_COND_V(!E, 0.001);
+	return E->get().precision;
+}
+
+void SceneReplicationConfig::property_set_precision(const NodePath &p_path, real_t p_precision) {
+	ERR_FAIL_COND_MSG(!(p_precision > 0), "Precision must be greater than zero."); // Also rejects NaN.
+	List<ReplicationProperty>::Element *E = properties.find(p_path);
+	ERR_FAIL_COND(!E);
+	if (E->get().precision == p_precision) {
+		return;
+	}
+	E->get().precision = p_precision;
+	dirty = true;
+}
+
 void SceneReplicationConfig::_update() {
 	if (!dirty) {
 		return;
@@ -233,16 +284,25 @@ void SceneReplicationConfig::_update() {
 	sync_props.clear();
 	spawn_props.clear();
 	watch_props.clear();
+	sync_schema.fields.clear();
+	watch_schema.fields.clear();
 	for (const ReplicationProperty &prop : properties) {
 		if (prop.spawn) {
 			spawn_props.push_back(prop.name);
 		}
+		Schema::Field field;
+		field.encoding = prop.encoding;
+		field.precision = prop.precision;
+		// Smallest-three components are within [-1/sqrt(2), 1/sqrt(2)].
+		field.quaternion_bits = CLAMP((int)Math::ceil(Math::log2(Math_SQRT2 / prop.precision + 1.0)), 2, 30);
 		switch (prop.mode) {
 			case REPLICATION_MODE_ALWAYS:
 				sync_props.push_back(prop.name);
+				sync_schema.fields.push_back(field);
 				break;
 			case REPLICATION_MODE_ON_CHANGE:
 				watch_props.push_back(prop.name);
+				watch_schema.fields.push_back(field);
 				break;
 			default:
 				break;
@@ -271,6 +331,257 @@ const List<NodePath> &SceneReplicationConfig::get_watch_properties() {
 	return watch_props;
 }
 
+const SceneReplicationConfig::Schema &SceneReplicationConfig::get_sync_schema() {
+	if (dirty) {
+		_update();
+	}
+	return sync_schema;
+}
+
+const SceneReplicationConfig::Schema &SceneReplicationConfig::get_watch_schema() {
+	if (dirty) {
+		_update();
+	}
+	return watch_schema;
+}
+
+/* Schema */
+
+static _FORCE_INLINE_ int64_t _quantize(real_t p_value, real_t p_precision) {
+	ERR_FAIL_COND_V_MSG(!(p_precision > 0), 0, "Precision must be greater than zero.");
+	const double steps = Math::round((double)p_value / (double)p_precision);
+	// Casting NaN or a value outside of the int64_t range is undefined, send NaN as zero and clamp the others.
+	if (unlikely(!Math::is_finite(steps) || steps >= 9223372036854775808.0 || steps < -9223372036854775808.0)) {
+		if (Math::is_nan(steps)) {
+			return 0;
+		}
+		return steps > 0 ? INT64_MAX : INT64_MIN;
+	}
+	return (int64_t)steps;
+}
+
+static void _quantize_quaternion(const Quaternion &p_value, int p_bits, uint32_t &r_largest, uint32_t r_components[3]) {
+	Quaternion q = p_value.normalized();
+	r_largest = 0;
+	for (int i = 1; i < 4; i++) {
+		if (Math::abs(q.components[i]) > Math::abs(q.components[r_largest])) {
+			r_largest = i;
+		}
+	}
+	// q and -q are the same rotation, make the dropped component positive so it can be rebuilt.
+	real_t sign = q.components[r_largest] < 0 ? -1.0 : 1.0;
+	const real_t max_value = (1 << p_bits) - 1;
+	int c = 0;
+	for (int i = 0; i < 4; i++) {
+		if (i == (int)r_largest) {
+			continue;
+		}
+		real_t normalized = (q.components[i] * sign + Math_SQRT12) / Math_SQRT2;
+		r_components[c++] = (uint32_t)CLAMP(Math::round(normalized * max_value), 0.0, max_value);
+	}
+}
+
+// Largest encoding of the types below, a Projection of doubles plus the header.
+static constexpr int MAX_FIXED_VARIANT_SIZE = 256;
+
+static _FORCE_INLINE_ bool _has_fixed_encoded_size(Variant::Type p_type) {
+	switch (p_type) {
+		case Variant::NIL:
+		case Variant::BOOL:
+		case Variant::INT:
+		case Variant::FLOAT:
+		case Variant::HECTOR2:
+		case Variant::HECTOR2I:
+		case Variant::RECT2:
+		case Variant::RECT2I:
+		case Variant::HECTOR3:
+		case Variant::HECTOR3I:
+		case Variant::TRANSFORM2D:
+		case Variant::HECTOR4:
+		case Variant::HECTOR4I:
+		case Variant::PLANE:
+		case Variant::QUATERNION:
+		case Variant::AABB:
+		case Variant::BASIS:
+		case Variant::TRANSFORM3D:
+		case Variant::PROJECTION:
+		case Variant::COLOR:
+		case Variant::RID:
+			return true;
+		default:
+			return false;
+	}
+}
+
+void SceneReplicationConfig::Schema::encode_field(int p_field, const Variant &p_value, ReplicationBitWriter &r_writer) const {
+	const Field &field = fields[p_field];
+	switch (field.encoding) {
+		case PROPERTY_ENCODING_BOOL: {
+			r_writer.put_bool(p_value.booleanize());
+		} break;
+		case PROPERTY_ENCODING_VARINT: {
+			r_writer.put_varint(p_value.operator int64_t());
+		} break;
+		case PROPERTY_ENCODING_FLOAT: {
+			r_writer.put_varint(_quantize(p_value.operator real_t(), field.precision));
+		} break;
+		case PROPERTY_ENCODING_HECTOR2: {
+			Hector2 v = p_value;
+			r_writer.put_varint(_quantize(v.x, field.precision));
+			r_writer.put_varint(_quantize(v.y, field.precision));
+		} break;
+		case PROPERTY_ENCODING_HECTOR3: {
+			Hector3 v = p_value;
+			r_writer.put_varint(_quantize(v.x, field.precision));
+			r_writer.put_varint(_quantize(v.y, field.precision));
+			r_writer.put_varint(_quantize(v.z, field.precision));
+		} break;
+		case PROPERTY_ENCODING_QUATERNION: {
+			uint32_t largest;
+			uint32_t components[3];
+			_quantize_quaternion(p_value, field.quaternion_bits, largest, components);
+			r_writer.put_bits(largest, 2);
+			for (int i = 0; i < 3; i++) {
+				r_writer.put_bits(components[i], field.quaternion_bits);
+			}
+		} break;
+		case PROPERTY_ENCODING_VARIANT: {
+			// Only values which can grow need to be measured before being encoded.
+			int len = 0;
+			if (!_has_fixed_encoded_size(p_value.get_type())) {
+				Error err = MultiplayerAPI::encode_and_compress_variant(p_value, nullptr, len, false);
+				ERR_FAIL_COND_MSG(err != OK, "Unable to encode replicated property.");
+			}
+			uint8_t *buffer = r_writer.get_staging_buffer(MAX(len, MAX_FIXED_VARIANT_SIZE));
+			Error err = MultiplayerAPI::encode_and_compress_variant(p_value, buffer, len, false);
+			ERR_FAIL_COND_MSG(err != OK, "Unable to encode replicated property.");
+			r_writer.put_uvarint(len);
+			r_writer.put_bytes(buffer, len);
+		} break;
+	}
+}
+
+Error SceneReplicationConfig::Schema::decode_field(int p_field, ReplicationBitReader &r_reader, Variant &r_value) const {
+	const Field &field = fields[p_field];
+	switch (field.encoding) {
+		case PROPERTY_ENCODING_BOOL: {
+			r_value = r_reader.get_bool();
+		} break;
+		case PROPERTY_ENCODING_VARINT: {
+			r_value = r_reader.get_varint();
+		} break;
+		case PROPERTY_ENCODING_FLOAT: {
+			r_value = r_reader.get_varint() * field.precision;
+		} break;
+		case PROPERTY_ENCODING_HECTOR2: {
+			Hector2 v;
+			v.x = r_reader.get_varint() * field.precision;
+			v.y = r_reader.get_varint() * field.precision;
+			r_value = v;
+		} break;
+		case PROPERTY_ENCODING_HECTOR3: {
+			Hector3 v;
+			v.x = r_reader.get_varint() * field.precision;
+			v.y = r_reader.get_varint() * field.precision;
+			v.z = r_reader.get_varint() * field.precision;
+			r_value = v;
+		} break;
+		case PROPERTY_ENCODING_QUATERNION: {
+			uint32_t largest = r_reader.get_bits(2);
+			const real_t max_value = (1 << field.quaternion_bits) - 1;
+			Quaternion q;
+			real_t sum = 0;
+			for (int i = 0; i < 4; i++) {
+				if (i == (int)largest) {
+					continue;
+				}
+				q.components[i] = r_reader.get_bits(field.quaternion_bits) / max_value * Math_SQRT2 - Math_SQRT12;
+				sum += q.components[i] * q.components[i];
+			}
+			q.components[largest] = Math::sqrt(MAX(0.0, 1.0 - sum));
+			r_value = q.normalized();
+		} break;
+		case PROPERTY_ENCODING_VARIANT: {
+			uint64_t len = r_reader.get_uvarint();
+			ERR_FAIL_COND_V(r_reader.has_overflowed() || len * 8 > (uint64_t)r_reader.get_bits_left(), ERR_INVALID_DATA);
+			LocalHector<uint8_t> buffer;
+			buffer.resize(len);
+			r_reader.get_bytes(buffer.ptr(), len);
+			int consumed = 0;
+			Error err = MultiplayerAPI::decode_and_decompress_variant(r_value, buffer.ptr(), len, &consumed, false);
+			ERR_FAIL_COND_V(err != OK, err);
+			ERR_FAIL_COND_V(uint64_t(consumed) != len, ERR_INVALID_DATA);
+		} break;
+	}
+	return r_reader.has_overflowed() ? ERR_INVALID_DATA : OK;
+}
+
+bool SceneReplicationConfig::Schema::is_field_equal(int p_field, const Variant &p_a, const Variant &p_b) const {
+	const Field &field = fields[p_field];
+	switch (field.encoding) {
+		case PROPERTY_ENCODING_BOOL: {
+			return p_a.booleanize() == p_b.booleanize();
+		}
+		case PROPERTY_ENCODING_VARINT: {
+			return p_a.operator int64_t() == p_b.operator int64_t();
+		}
+		case PROPERTY_ENCODING_FLOAT: {
+			return _quantize(p_a, field.precision) == _quantize(p_b, field.precision);
+		}
+		case PROPERTY_ENCODING_HECTOR2: {
+			Hector2 a = p_a;
+			Hector2 b = p_b;
+			return _quantize(a.x, field.precision) == _quantize(b.x, field.precision) && _quantize(a.y, field.precision) == _quantize(b.y, field.precision);
+		}
+		case PROPERTY_ENCODING_HECTOR3: {
+			Hector3 a = p_a;
+			Hector3 b = p_b;
+			for (int i = 0; i < 3; i++) {
+				if (_quantize(a[i], field.precision) != _quantize(b[i], field.precision)) {
+					return false;
+				}
+			}
+			return true;
+		}
+		case PROPERTY_ENCODING_QUATERNION: {
+			uint32_t largest_a, largest_b;
+			uint32_t a[3], b[3];
+			_quantize_quaternion(p_a, field.quaternion_bits, largest_a, a);
+			_quantize_quaternion(p_b, field.quaternion_bits, largest_b, b);
+			return largest_a == largest_b && a[0] == b[0] && a[1] == b[1] && a[2] == b[2];
+		}
+		case PROPERTY_ENCODING_VARIANT: {
+			return p_a.get_type() == p_b.get_type() && p_a.hash_compare(p_b);
+		}
+	}
+	return false;
+}
+
+void SceneReplicationConfig::Schema::encode_state(const Variant *p_state, const Variant *p_baseline, ReplicationBitWriter &r_writer) const {
+	for (int i = 0; i < fields.size(); i++) {
+		if (p_baseline) {
+			bool changed = !is_field_equal(i, p_state[i], p_baseline[i]);
+			r_writer.put_bool(changed);
+			if (!changed) {
+				continue;
+			}
+		}
+		encode_field(i, p_state[i], r_writer);
+	}
+}
+
+Error SceneReplicationConfig::Schema::decode_state(ReplicationBitReader &r_reader, const Variant *p_baseline, Variant *r_state) const {
+	for (int i = 0; i < fields.size(); i++) {
+		if (p_baseline && !r_reader.get_bool()) {
+			r_state[i] = p_baseline[i];
+			continue;
+		}
+		Error err = decode_field(i, r_reader, r_state[i]);
+		ERR_FAIL_COND_V(err != OK, err);
+	}
+	return r_reader.has_overflowed() ? ERR_INVALID_DATA : OK;
+}
+
 void SceneReplicationConfig::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_properties"), &SceneReplicationConfig::get_properties);
 	ClassDB::bind_method(D_METHOD("add_property", "path", "index"), &SceneReplicationConfig::add_property, DEFVAL(-1));
@@ -281,11 +592,23 @@ void SceneReplicationConfig::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("property_set_spawn", "path", "enabled"), &SceneReplicationConfig::property_set_spawn);
 	ClassDB::bind_method(D_METHOD("property_get_replication_mode", "path"), &SceneReplicationConfig::property_get_replication_mode);
 	ClassDB::bind_method(D_METHOD("property_set_replication_mode", "path", "mode"), &SceneReplicationConfig::property_set_replication_mode);
+	ClassDB::bind_method(D_METHOD("property_get_encoding", "path"), &SceneReplicationConfig::property_get_encoding);
+	ClassDB::bind_method(D_METHOD("property_set_encoding", "path", "encoding"), &SceneReplicationConfig::property_set_encoding);
+	ClassDB::bind_method(D_METHOD("property_get_precision", "path"), &SceneReplicationConfig::property_get_precision);
+	ClassDB::bind_method(D_METHOD("property_set_precision", "path", "precision"), &SceneReplicationConfig::property_set_precision);
 
 	BIND_ENUM_CONSTANT(REPLICATION_MODE_NEVER);
 	BIND_ENUM_CONSTANT(REPLICATION_MODE_ALWAYS);
 	BIND_ENUM_CONSTANT(REPLICATION_MODE_ON_CHANGE);
 
+	BIND_ENUM_CONSTANT(PROPERTY_ENCODING_VARIANT);
+	BIND_ENUM_CONSTANT(PROPERTY_ENCODING_BOOL);
+	BIND_ENUM_CONSTANT(PROPERTY_ENCODING_VARINT);
+	BIND_ENUM_CONSTANT(PROPERTY_ENCODING_FLOAT);
+	BIND_ENUM_CONSTANT(PROPERTY_ENCODING_HECTOR2);
+	BIND_ENUM_CONSTANT(PROPERTY_ENCODING_HECTOR3);
+	BIND_ENUM_CONSTANT(PROPERTY_ENCODING_QUATERNION);
+
 	// Deprecated.
 	ClassDB::bind_method(D_METHOD("property_get_sync", "path"), &SceneReplicationConfig::property_get_sync);
 	ClassDB::bind_method(D_METHOD("property_set_sync", "path", "enabled"), &SceneReplicationConfig::property_set_sync);
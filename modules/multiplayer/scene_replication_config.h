@@ -31,6 +31,8 @@
 #ifndef SCENE_REPLICATION_CONFIG_H
 #define SCENE_REPLICATION_CONFIG_H
 
+#include "replication_bit_stream.h"
+
 #include "core/io/resource.h"
 #include "core/variant/typed_array.h"
 
@@ -46,11 +48,43 @@ public:
 		REPLICATION_MODE_ON_CHANGE,
 	};
 
+	enum PropertyEncoding {
+		PROPERTY_ENCODING_VARIANT,
+		PROPERTY_ENCODING_BOOL,
+		PROPERTY_ENCODING_VARINT,
+		PROPERTY_ENCODING_FLOAT,
+		PROPERTY_ENCODING_HECTOR2,
+		PROPERTY_ENCODING_HECTOR3,
+		PROPERTY_ENCODING_QUATERNION,
+	};
+
+	// Compiled from the properties of one replication mode, so states can be written without type headers.
+	struct Schema {
+		struct Field {
+			PropertyEncoding encoding = PROPERTY_ENCODING_VARIANT;
+			real_t precision = 0.001; // Quantization step of FLOAT, HECTOR2, HECTOR3 and QUATERNION components.
+			int quaternion_bits = 0; // Bits per smallest-three component, derived from precision.
+		};
+		Hector<Field> fields;
+
+		void encode_field(int p_field, const Variant &p_value, ReplicationBitWriter &r_writer) const;
+		Error decode_field(int p_field, ReplicationBitReader &r_reader, Variant &r_value) const;
+		bool is_field_equal(int p_field, const Variant &p_a, const Variant &p_b) const; // Equal once quantized.
+
+		// If p_baseline is set, a bit per field tells whether it changed, and unchanged fields are taken from it when decoding.
+		void encode_state(const Variant *p_state, const Variant *p_baseline, ReplicationBitWriter &r_writer) const;
+		Error decode_state(ReplicationBitReader &r_reader, const Variant *p_baseline, Variant *r_state) const;
+
+		int size() const { return fields.size(); }
+	};
+
 private:
 	struct ReplicationProperty {
 		NodePath name;
 		bool spawn = true;
 		ReplicationMode mode = REPLICATION_MODE_ALWAYS;
+		PropertyEncoding encoding = PROPERTY_ENCODING_VARIANT;
+		real_t precision = 0.001;
 
 		bool operator==(const ReplicationProperty &p_to) {
 			return name == p_to.name;
@@ -67,6 +101,8 @@ private:
 	List<NodePath> spawn_props;
 	List<NodePath> sync_props;
 	List<NodePath> watch_props;
+	Schema sync_schema;
+	Schema watch_schema;
 	bool dirty = false;
 
 	void _update();
@@ -100,13 +136,22 @@ public:
 	ReplicationMode property_get_replication_mode(const NodePath &p_path);
 	void property_set_replication_mode(const NodePath &p_path, ReplicationMode p_mode);
 
+	PropertyEncoding property_get_encoding(const NodePath &p_path);
+	void property_set_encoding(const NodePath &p_path, PropertyEncoding p_encoding);
+
+	real_t property_get_precision(const NodePath &p_path);
+	void property_set_precision(const NodePath &p_path, real_t p_precision);
+
 	const List<NodePath> &get_spawn_properties();
 	const List<NodePath> &get_sync_properties();
 	const List<NodePath> &get_watch_properties();
+	const Schema &get_sync_schema();
+	const Schema &get_watch_schema();
 
 	SceneReplicationConfig() {}
 };
 
 VARIANT_ENUM_CAST(SceneReplicationConfig::ReplicationMode);
+VARIANT_ENUM_CAST(SceneReplicationConfig::PropertyEncoding);
 
 #endif // SCENE_REPLICATION_CONFIG_H
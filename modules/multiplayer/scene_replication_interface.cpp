@@ -34,12 +34,44 @@
 
 #include "core/debugger/engine_debugger.h"
 #include "core/io/marshalls.h"
+#include "scene/2d/node_2d.h"
 #include "scene/main/node.h"
 
+#ifndef _3D_DISABLED
+#include "scene/3d/node_3d.h"
+#endif // _3D_DISABLED
+
 #define MAKE_ROOM(m_amount)             \
 	if (packet_cache.size() < m_amount) \
 		packet_cache.resize(m_amount);
 
+// Sizes and masks in sync packets are mostly small, so they are sent as LEB128 varints.
+static int _encode_uvarint(uint64_t p_value, uint8_t *p_buffer) {
+	int len = 0;
+	while (p_value >= 0x80) {
+		p_buffer[len++] = (p_value & 0x7F) | 0x80;
+		p_value >>= 7;
+	}
+	p_buffer[len++] = p_value;
+	return len;
+}
+
+static bool _decode_uvarint(const uint8_t *p_buffer, int p_len, uint64_t &r_value, int &r_len) {
+	r_value = 0;
+	for (r_len = 0; r_len < p_len && r_len < 10; r_len++) {
+		r_value |= uint64_t(p_buffer[r_len] & 0x7F) << (7 * r_len);
+		if (!(p_buffer[r_len] & 0x80)) {
+			r_len++;
+			return true;
+		}
+	}
+	return false;
+}
+
+static _FORCE_INLINE_ bool _is_sync_time_newer(uint16_t p_time, uint16_t p_than) {
+	return int16_t(p_time - p_than) > 0;
+}
+
 #ifdef DEBUG_ENABLED
 _FORCE_INLINE_ void SceneReplicationInterface::_profile_node_data(const String &p_what, ObjectID p_id, int p_size) {
 	if (EngineDebugger::is_profiling("multiplayer:replication")) {
@@ -124,6 +156,7 @@ void SceneReplicationInterface::on_reset() {
 		ERR_CONTINUE(!sync);
 		sync->reset();
 	}
+	interest_grid.clear();
 	last_net_id = 0;
 }
 
@@ -141,16 +174,75 @@ void SceneReplicationInterface::on_network_process() {
 		spawn_queue.clear();
 	}
 
+	_update_interest();
+
 	// Process syncs.
 	uint64_t usec = OS::get_singleton()->get_ticks_usec();
+	LocalHector<ObjectID> scheduled;
 	for (KeyValue<int, PeerInfo> &E : peers_info) {
-		const HashSet<ObjectID> to_sync = E.value.sync_nodes;
+		PeerInfo &info = E.value;
+		if (info.recv_sync_ack_pending) {
+			_send_sync_ack(E.key, info);
+		}
+		const HashSet<ObjectID> to_sync = info.sync_nodes;
 		if (to_sync.is_empty()) {
 			continue; // Nothing to sync
 		}
-		uint16_t sync_net_time = ++E.value.last_sent_sync;
-		_send_sync(E.key, to_sync, sync_net_time, usec);
-		_send_delta(E.key, to_sync, usec, E.value.last_watch_usecs);
+		int budget = -1;
+		if (max_sync_bandwidth > 0) {
+			// Token bucket, allowing bursts of up to a tenth of a second (or a full packet).
+			const double burst = MAX(max_sync_bandwidth / 10, sync_mtu);
+			if (info.sync_budget_usec == 0) {
+				info.sync_budget = burst;
+			} else {
+				info.sync_budget = MIN(info.sync_budget + max_sync_bandwidth * double(usec - info.sync_budget_usec) / 1000000.0, burst);
+			}
+			info.sync_budget_usec = usec;
+			budget = MAX(0, int(info.sync_budget));
+		}
+		_schedule_syncs(info, usec, scheduled);
+		if (scheduled.size() && budget != 0) {
+			uint16_t sync_net_time = ++info.last_sent_sync;
+			int sent = 0;
+			int count = _send_sync(E.key, scheduled, sync_net_time, budget, sent);
+			for (int i = 0; i < count; i++) {
+				info.sync_priorities.erase(scheduled[i]);
+			}
+			info.sync_budget -= sent;
+		}
+		_send_delta(E.key, to_sync, usec, info.last_watch_usecs);
+	}
+}
+
+void SceneReplicationInterface::_schedule_syncs(PeerInfo &p_info, uint64_t p_usec, LocalHector<ObjectID> &r_synchronizers) {
+	r_synchronizers.clear();
+	LocalHector<SyncCandidate> candidates;
+	for (const ObjectID &sid : p_info.sync_nodes) {
+		MultiplayerSynchronizer *sync = get_id_as<MultiplayerSynchronizer>(sid);
+		ERR_CONTINUE(!sync);
+		real_t *accumulated = p_info.sync_priorities.getptr(sid);
+		if (sync->update_outbound_sync_time(p_usec)) {
+			// Due, raise its priority. Closer synchronizers rise faster.
+			real_t priority = sync->get_sync_priority();
+			Hector3 position;
+			if (p_info.has_interest_origin && interest_grid.get_position(sid, position)) {
+				priority /= 1 + position.distance_to(p_info.interest_origin) / interest_radius;
+			}
+			if (!accumulated) {
+				accumulated = &p_info.sync_priorities.insert(sid, 0)->value;
+			}
+			*accumulated += priority;
+		} else if (!accumulated) {
+			continue; // Nothing to sync.
+		}
+		candidates.push_back({ sid, *accumulated });
+	}
+	if (max_sync_bandwidth > 0) {
+		candidates.sort();
+	}
+	r_synchronizers.resize(candidates.size());
+	for (uint32_t i = 0; i < candidates.size(); i++) {
+		r_synchronizers[i] = candidates[i].id;
 	}
 }
 
@@ -280,9 +372,14 @@ Error SceneReplicationInterface::on_replication_stop(Object *p_obj, Variant p_co
 	TrackedNode &tobj = _track(oid);
 	tobj.synchronizers.erase(sid);
 	sync_nodes.erase(sid);
+	interest_grid.remove_object(sid);
 	for (KeyValue<int, PeerInfo> &E : peers_info) {
 		E.value.sync_nodes.erase(sid);
 		E.value.last_watch_usecs.erase(sid);
+		E.value.sent_syncs.erase(sid);
+		E.value.recv_syncs.erase(sid);
+		E.value.sync_priorities.erase(sid);
+		E.value.interest_syncs.erase(sid);
 		if (sync->get_net_id()) {
 			E.value.recv_sync_ids.erase(sync->get_net_id());
 		}
@@ -333,7 +430,7 @@ bool SceneReplicationInterface::is_rpc_visible(const ObjectID &p_oid, int p_peer
 			// RPC visibility is composed using OR when multiple synchronizers are present.
 			// Note that we don't really care about authority here which may lead to unexpected
 			// results when using multiple synchronizers to control the same node.
-			if (sync->is_visible_to(p_peer)) {
+			if (_is_sync_visible_to(sync, p_peer)) {
 				return true;
 			}
 		}
@@ -348,11 +445,11 @@ Error SceneReplicationInterface::_update_sync_visibility(int p_peer, Multiplayer
 	}
 
 	const ObjectID &sid = p_sync->get_instance_id();
-	bool is_visible = p_sync->is_visible_to(p_peer);
+	bool is_visible = _is_sync_visible_to(p_sync, p_peer);
 	if (p_peer == 0) {
 		for (KeyValue<int, PeerInfo> &E : peers_info) {
 			// Might be visible to this specific peer.
-			bool is_visible_to_peer = is_visible || p_sync->is_visible_to(E.key);
+			bool is_visible_to_peer = is_visible || _is_sync_visible_to(p_sync, E.key);
 			if (is_visible_to_peer == E.value.sync_nodes.has(sid)) {
 				continue;
 			}
@@ -361,6 +458,8 @@ Error SceneReplicationInterface::_update_sync_visibility(int p_peer, Multiplayer
 			} else {
 				E.value.sync_nodes.erase(sid);
 				E.value.last_watch_usecs.erase(sid);
+				E.value.sent_syncs.erase(sid);
+				E.value.sync_priorities.erase(sid);
 			}
 		}
 		return OK;
@@ -374,11 +473,92 @@ Error SceneReplicationInterface::_update_sync_visibility(int p_peer, Multiplayer
 		} else {
 			peers_info[p_peer].sync_nodes.erase(sid);
 			peers_info[p_peer].last_watch_usecs.erase(sid);
+			peers_info[p_peer].sent_syncs.erase(sid);
+			peers_info[p_peer].sync_priorities.erase(sid);
 		}
 		return OK;
 	}
 }
 
+bool SceneReplicationInterface::_is_sync_visible_to(MultiplayerSynchronizer *p_sync, int p_peer) const {
+	if (!p_sync->is_spatial_interest() || p_sync->get_multiplayer_authority() != multiplayer->get_unique_id()) {
+		return p_sync->is_visible_to(p_peer);
+	}
+	// Spatial synchronizers are only visible to the peers observing them, never to everyone.
+	const PeerInfo *info = p_peer ? peers_info.getptr(p_peer) : nullptr;
+	return info && info->interest_syncs.has(p_sync->get_instance_id()) && p_sync->is_visible_to(p_peer);
+}
+
+bool SceneReplicationInterface::_get_interest_position(Node *p_node, Hector3 &r_position) {
+#ifndef _3D_DISABLED
+	Node3D *node_3d = Object::cast_to<Node3D>(p_node);
+	if (node_3d) {
+		r_position = node_3d->is_inside_tree() ? node_3d->get_global_position() : node_3d->get_position();
+		return true;
+	}
+#endif // _3D_DISABLED
+	Node2D *node_2d = Object::cast_to<Node2D>(p_node);
+	if (node_2d) {
+		const Hector2 position = node_2d->is_inside_tree() ? node_2d->get_global_position() : node_2d->get_position();
+		r_position = Hector3(position.x, position.y, 0);
+		return true;
+	}
+	return false;
+}
+
+void SceneReplicationInterface::_update_interest() {
+	// Move the spatial synchronizers we have authority over in the grid.
+	for (const ObjectID &sid : sync_nodes) {
+		MultiplayerSynchronizer *sync = get_id_as<MultiplayerSynchronizer>(sid);
+		ERR_CONTINUE(!sync);
+		Hector3 position;
+		if (sync->is_spatial_interest() && _has_authority(sync) && _get_interest_position(sync->get_root_node(), position)) {
+			interest_grid.update_object(sid, position);
+		} else if (interest_grid.has_object(sid)) {
+			interest_grid.remove_object(sid);
+		}
+	}
+
+	// Only the synchronizers entering or leaving each peer relevant set need a visibility update.
+	// Leaving uses a slightly larger radius, so objects on the edge don't spawn and despawn repeatedly.
+	const real_t leave_radius = interest_radius * 1.1;
+	HashSet<ObjectID> relevant;
+	LocalHector<ObjectID> changed;
+	for (KeyValue<int, PeerInfo> &E : peers_info) {
+		PeerInfo &info = E.value;
+		info.has_interest_origin = _get_interest_position(get_id_as<Node>(info.interest_observer), info.interest_origin);
+		if (!info.has_interest_origin && info.interest_syncs.is_empty()) {
+			continue;
+		}
+		relevant.clear();
+		if (info.has_interest_origin) {
+			interest_grid.query(info.interest_origin, leave_radius, [&](const ObjectID &p_id, real_t p_distance) {
+				if (p_distance <= interest_radius || info.interest_syncs.has(p_id)) {
+					relevant.insert(p_id);
+				}
+			});
+		}
+		changed.clear();
+		for (const ObjectID &sid : info.interest_syncs) {
+			if (!relevant.has(sid)) {
+				changed.push_back(sid);
+			}
+		}
+		for (const ObjectID &sid : relevant) {
+			if (!info.interest_syncs.has(sid)) {
+				changed.push_back(sid);
+			}
+		}
+		if (changed.is_empty()) {
+			continue;
+		}
+		info.interest_syncs = relevant;
+		for (const ObjectID &sid : changed) {
+			_visibility_changed(E.key, sid);
+		}
+	}
+}
+
 Error SceneReplicationInterface::_update_spawn_visibility(int p_peer, const ObjectID &p_oid) {
 	const TrackedNode *tnode = tracked_nodes.getptr(p_oid);
 	ERR_FAIL_NULL_V(tnode, ERR_BUG);
@@ -397,7 +577,7 @@ Error SceneReplicationInterface::_update_spawn_visibility(int p_peer, const Obje
 			continue;
 		}
 		// Spawn visibility is composed using OR when multiple synchronizers are present.
-		if (sync->is_visible_to(p_peer)) {
+		if (_is_sync_visible_to(sync, p_peer)) {
 			is_visible = true;
 			break;
 		}
@@ -709,7 +889,7 @@ MultiplayerSynchronizer *SceneReplicationInterface::_find_synchronizer(int p_pee
 }
 
 void SceneReplicationInterface::_send_delta(int p_peer, const HashSet<ObjectID> &p_synchronizers, uint64_t p_usec, const HashMap<ObjectID, uint64_t> &p_last_watch_usecs) {
-	MAKE_ROOM(/* header */ 1 + /* element */ 4 + 8 + 4 + delta_mtu);
+	MAKE_ROOM(/* header */ 1 + /* element */ 4 + 10 + 5 + delta_mtu);
 	uint8_t *ptr = packet_cache.ptrw();
 	ptr[0] = SceneMultiplayer::NETWORK_COMMAND_SYNC | (1 << SceneMultiplayer::CMD_FLAG_0_SHIFT);
 	int ofs = 1;
@@ -728,30 +908,31 @@ void SceneReplicationInterface::_send_delta(int p_peer, const HashSet<ObjectID>
 			continue; // Nothing to update.
 		}
 
-		Hector<const Variant *> varp;
-		varp.resize(delta.size());
-		const Variant **vptr = varp.ptrw();
-		int i = 0;
-		for (const Variant &v : delta) {
-			vptr[i] = &v;
-			i++;
+		// Only the changed fields are written, in the order of the watch schema.
+		const SceneReplicationConfig::Schema &schema = sync->get_replication_config_ptr()->get_watch_schema();
+		state_writer.clear();
+		List<Variant>::ConstIterator value = delta.begin();
+		for (int i = 0; i < schema.size() && value != delta.end(); i++) {
+			if (indexes & (1ULL << i)) {
+				schema.encode_field(i, *value, state_writer);
+				++value;
+			}
 		}
-		int size;
-		Error err = MultiplayerAPI::encode_and_compress_variants(vptr, varp.size(), nullptr, size);
-		ERR_CONTINUE_MSG(err != OK, "Unable to encode delta state.");
+		state_writer.flush();
+		int size = state_writer.get_size();
 
 		ERR_CONTINUE_MSG(size > delta_mtu, vformat("Synchronizer delta bigger than MTU will not be sent (%d > %d): %s", size, delta_mtu, sync->get_path()));
 
-		if (ofs + 4 + 8 + 4 + size > delta_mtu) {
+		if (ofs + 4 + 10 + 5 + size > delta_mtu) {
 			// Send what we got, and reset write.
 			_send_raw(packet_cache.ptr(), ofs, p_peer, true);
 			ofs = 1;
 		}
 		if (size) {
 			ofs += encode_uint32(sync->get_net_id(), &ptr[ofs]);
-			ofs += encode_uint64(indexes, &ptr[ofs]);
-			ofs += encode_uint32(size, &ptr[ofs]);
-			MultiplayerAPI::encode_and_compress_variants(vptr, varp.size(), &ptr[ofs], size);
+			ofs += _encode_uvarint(indexes, &ptr[ofs]);
+			ofs += _encode_uvarint(size, &ptr[ofs]);
+			memcpy(&ptr[ofs], state_writer.get_data(), size);
 			ofs += size;
 		}
 #ifdef DEBUG_ENABLED
@@ -767,14 +948,17 @@ void SceneReplicationInterface::_send_delta(int p_peer, const HashSet<ObjectID>
 
 Error SceneReplicationInterface::on_delta_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len) {
 	int ofs = 1;
-	while (ofs + 4 + 8 + 4 < p_buffer_len) {
+	while (ofs + 4 + 1 + 1 < p_buffer_len) {
 		uint32_t net_id = decode_uint32(&p_buffer[ofs]);
 		ofs += 4;
-		uint64_t indexes = decode_uint64(&p_buffer[ofs]);
-		ofs += 8;
-		uint32_t size = decode_uint32(&p_buffer[ofs]);
-		ofs += 4;
-		ERR_FAIL_COND_V(size > uint32_t(p_buffer_len - ofs), ERR_INVALID_DATA);
+		uint64_t indexes;
+		uint64_t size;
+		int len;
+		ERR_FAIL_COND_V(!_decode_uvarint(&p_buffer[ofs], p_buffer_len - ofs, indexes, len), ERR_INVALID_DATA);
+		ofs += len;
+		ERR_FAIL_COND_V(!_decode_uvarint(&p_buffer[ofs], p_buffer_len - ofs, size, len), ERR_INVALID_DATA);
+		ofs += len;
+		ERR_FAIL_COND_V(size > uint64_t(p_buffer_len - ofs), ERR_INVALID_DATA);
 		MultiplayerSynchronizer *sync = _find_synchronizer(p_from, net_id);
 		Node *node = sync ? sync->get_root_node() : nullptr;
 		if (!sync || sync->get_multiplayer_authority() != p_from || !node) {
@@ -783,13 +967,19 @@ Error SceneReplicationInterface::on_delta_receive(int p_from, const uint8_t *p_b
 		}
 		List<NodePath> props = sync->get_delta_properties(indexes);
 		ERR_FAIL_COND_V(props.is_empty(), ERR_INVALID_DATA);
+		const SceneReplicationConfig::Schema &schema = sync->get_replication_config_ptr()->get_watch_schema();
 		Hector<Variant> vars;
 		vars.resize(props.size());
-		int consumed = 0;
-		Error err = MultiplayerAPI::decode_and_decompress_variants(vars, p_buffer + ofs, size, consumed);
-		ERR_FAIL_COND_V(err != OK, err);
-		ERR_FAIL_COND_V(uint32_t(consumed) != size, ERR_INVALID_DATA);
-		err = MultiplayerSynchronizer::set_state(props, node, vars);
+		ReplicationBitReader reader(&p_buffer[ofs], size);
+		int idx = 0;
+		for (int i = 0; i < schema.size() && idx < vars.size(); i++) {
+			if (indexes & (1ULL << i)) {
+				Error err = schema.decode_field(i, reader, vars.write[idx++]);
+				ERR_FAIL_COND_V(err != OK, err);
+			}
+		}
+		ERR_FAIL_COND_V(idx != vars.size(), ERR_INVALID_DATA);
+		Error err = MultiplayerSynchronizer::set_state(props, node, vars);
 		ERR_FAIL_COND_V(err != OK, err);
 		ofs += size;
 		sync->emit_signal(SNAME("delta_synchronized"));
@@ -800,20 +990,26 @@ Error SceneReplicationInterface::on_delta_receive(int p_from, const uint8_t *p_b
 	return OK;
 }
 
-void SceneReplicationInterface::_send_sync(int p_peer, const HashSet<ObjectID> &p_synchronizers, uint16_t p_sync_net_time, uint64_t p_usec) {
-	MAKE_ROOM(/* header */ 3 + /* element */ 4 + 4 + sync_mtu);
+int SceneReplicationInterface::_send_sync(int p_peer, const LocalHector<ObjectID> &p_synchronizers, uint16_t p_sync_net_time, int p_budget, int &r_sent) {
+	MAKE_ROOM(/* header */ 4 + /* element */ 4 + 1 + 5 + sync_mtu);
 	uint8_t *ptr = packet_cache.ptrw();
 	ptr[0] = SceneMultiplayer::NETWORK_COMMAND_SYNC;
 	int ofs = 1;
 	ofs += encode_uint16(p_sync_net_time, &ptr[1]);
+	uint8_t part = 0;
+	ptr[ofs++] = part;
+	PeerInfo &peer = peers_info[p_peer];
+	r_sent = 0;
 	// Can only send updates for already notified nodes.
 	// This is a lazy implementation, we could optimize much more here with by grouping by replication config.
-	for (const ObjectID &oid : p_synchronizers) {
+	int count = 0;
+	for (; count < int(p_synchronizers.size()); count++) {
+		if (p_budget >= 0 && r_sent + ofs >= p_budget) {
+			break; // Out of bandwidth, the rest waits for the next network process.
+		}
+		const ObjectID &oid = p_synchronizers[count];
 		MultiplayerSynchronizer *sync = get_id_as<MultiplayerSynchronizer>(oid);
 		ERR_CONTINUE(!sync || !sync->get_replication_config_ptr() || !_has_authority(sync));
-		if (!sync->update_outbound_sync_time(p_usec)) {
-			continue; // nothing to sync.
-		}
 
 		Node *node = sync->get_root_node();
 		ERR_CONTINUE(!node);
@@ -822,54 +1018,112 @@ void SceneReplicationInterface::_send_sync(int p_peer, const HashSet<ObjectID> &
 			// The path based sync is not yet confirmed, skipping.
 			continue;
 		}
-		int size;
 		Hector<Variant> vars;
 		Hector<const Variant *> varp;
 		const List<NodePath> props = sync->get_replication_config_ptr()->get_sync_properties();
+		const SceneReplicationConfig::Schema &schema = sync->get_replication_config_ptr()->get_sync_schema();
 		Error err = MultiplayerSynchronizer::get_state(props, node, vars, varp);
 		ERR_CONTINUE_MSG(err != OK, "Unable to retrieve sync state.");
-		err = MultiplayerAPI::encode_and_compress_variants(varp.ptrw(), varp.size(), nullptr, size);
-		ERR_CONTINUE_MSG(err != OK, "Unable to encode sync state.");
+		ERR_CONTINUE(schema.size() != vars.size());
+
+		// Encode against the last state the peer acknowledged, if still known.
+		SyncHistory &history = peer.sent_syncs[oid];
+		const SyncSnapshot *baseline = nullptr;
+		uint16_t baseline_age = p_sync_net_time - history.acked_time;
+		if (history.acked && baseline_age > 0 && baseline_age < SYNC_HISTORY_SIZE) {
+			baseline = history.get_snapshot(history.acked_time);
+		} else {
+			history.acked = false; // Too old, the snapshot might have been overwritten.
+		}
+		if (!baseline || baseline->state.size() != vars.size()) {
+			baseline = nullptr;
+			baseline_age = 0;
+		}
+		state_writer.clear();
+		schema.encode_state(vars.ptr(), baseline ? baseline->state.ptr() : nullptr, state_writer);
+		state_writer.flush();
+		int size = state_writer.get_size();
+
 		// TODO Handle single state above MTU.
 		ERR_CONTINUE_MSG(size > sync_mtu, vformat("Node states bigger than MTU will not be sent (%d > %d): %s", size, sync_mtu, node->get_path()));
-		if (ofs + 4 + 4 + size > sync_mtu) {
+		if (ofs + 4 + 1 + 5 + size > sync_mtu) {
 			// Send what we got, and reset write.
 			_send_raw(packet_cache.ptr(), ofs, p_peer, false);
-			ofs = 3;
+			r_sent += ofs;
+			ofs = 4;
+			part = MIN(part + 1, 255);
+			ptr[3] = part;
 		}
 		if (size) {
 			ofs += encode_uint32(sync->get_net_id(), &ptr[ofs]);
-			ofs += encode_uint32(size, &ptr[ofs]);
-			MultiplayerAPI::encode_and_compress_variants(varp.ptrw(), varp.size(), &ptr[ofs], size);
+			ptr[ofs++] = baseline_age;
+			ofs += _encode_uvarint(size, &ptr[ofs]);
+			memcpy(&ptr[ofs], state_writer.get_data(), size);
 			ofs += size;
+
+			SyncSnapshot &snap = history.snapshots[p_sync_net_time % SYNC_HISTORY_SIZE];
+			snap.time = p_sync_net_time;
+			snap.part = part;
+			snap.valid = true;
+			snap.state = vars;
 		}
 #ifdef DEBUG_ENABLED
 		_profile_node_data("sync_out", oid, size);
 #endif
 	}
-	if (ofs > 3) {
+	if (ofs > 4) {
 		// Got some left over to send.
 		_send_raw(packet_cache.ptr(), ofs, p_peer, false);
+		r_sent += ofs;
 	}
+	return count;
 }
 
 Error SceneReplicationInterface::on_sync_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len) {
-	ERR_FAIL_COND_V_MSG(p_buffer_len < 11, ERR_INVALID_DATA, "Invalid sync packet received");
 	bool is_delta = (p_buffer[0] & (1 << SceneMultiplayer::CMD_FLAG_0_SHIFT)) != 0;
 	if (is_delta) {
 		return on_delta_receive(p_from, p_buffer, p_buffer_len);
 	}
+	bool is_ack = (p_buffer[0] & (1 << SceneMultiplayer::CMD_FLAG_1_SHIFT)) != 0;
+	if (is_ack) {
+		return on_sync_ack_receive(p_from, p_buffer, p_buffer_len);
+	}
+	ERR_FAIL_COND_V_MSG(p_buffer_len < 10, ERR_INVALID_DATA, "Invalid sync packet received");
+	ERR_FAIL_COND_V(!peers_info.has(p_from), ERR_UNAVAILABLE);
+	PeerInfo &peer = peers_info[p_from];
 	uint16_t time = decode_uint16(&p_buffer[1]);
-	int ofs = 3;
-	while (ofs + 8 < p_buffer_len) {
+	uint8_t part = p_buffer[3];
+	int ofs = 4;
+
+	// Only the newest network time is acknowledged, with the packets received for it.
+	bool acknowledge = false;
+	if (!peer.recv_sync_started || _is_sync_time_newer(time, peer.recv_sync_time)) {
+		peer.recv_sync_started = true;
+		peer.recv_sync_time = time;
+		peer.recv_sync_parts = 0;
+		peer.recv_sync_resets.clear();
+	}
+	if (time == peer.recv_sync_time && part < SYNC_MAX_PARTS) {
+		peer.recv_sync_parts |= 1u << part;
+		peer.recv_sync_ack_pending = true;
+		acknowledge = true;
+	}
+
+	while (ofs + 4 + 1 + 1 <= p_buffer_len) {
 		uint32_t net_id = decode_uint32(&p_buffer[ofs]);
 		ofs += 4;
-		uint32_t size = decode_uint32(&p_buffer[ofs]);
-		ofs += 4;
-		ERR_FAIL_COND_V(size > uint32_t(p_buffer_len - ofs), ERR_INVALID_DATA);
+		uint16_t baseline_age = p_buffer[ofs++];
+		uint64_t size;
+		int len;
+		ERR_FAIL_COND_V(!_decode_uvarint(&p_buffer[ofs], p_buffer_len - ofs, size, len), ERR_INVALID_DATA);
+		ofs += len;
+		ERR_FAIL_COND_V(size > uint64_t(p_buffer_len - ofs), ERR_INVALID_DATA);
 		MultiplayerSynchronizer *sync = _find_synchronizer(p_from, net_id);
 		if (!sync) {
 			// Not received yet.
+			if (acknowledge) {
+				peer.recv_sync_resets.push_back(net_id);
+			}
 			ofs += size;
 			continue;
 		}
@@ -885,14 +1139,34 @@ Error SceneReplicationInterface::on_sync_receive(int p_from, const uint8_t *p_bu
 			continue;
 		}
 		const List<NodePath> props = sync->get_replication_config_ptr()->get_sync_properties();
+		const SceneReplicationConfig::Schema &schema = sync->get_replication_config_ptr()->get_sync_schema();
+		SyncHistory &history = peer.recv_syncs[sync->get_instance_id()];
+		const SyncSnapshot *baseline = nullptr;
+		if (baseline_age) {
+			baseline = history.get_snapshot(time - baseline_age);
+			if (!baseline || baseline->state.size() != props.size()) {
+				// Lost track of it, ask for a full state.
+				if (acknowledge) {
+					peer.recv_sync_resets.push_back(net_id);
+				}
+				ofs += size;
+				continue;
+			}
+		}
 		Hector<Variant> vars;
 		vars.resize(props.size());
-		int consumed;
-		Error err = MultiplayerAPI::decode_and_decompress_variants(vars, &p_buffer[ofs], size, consumed);
+		ReplicationBitReader reader(&p_buffer[ofs], size);
+		Error err = schema.decode_state(reader, baseline ? baseline->state.ptr() : nullptr, vars.ptrw());
 		ERR_FAIL_COND_V(err, err);
 		err = MultiplayerSynchronizer::set_state(props, node, vars);
 		ERR_FAIL_COND_V(err, err);
 		ofs += size;
+
+		SyncSnapshot &snap = history.snapshots[time % SYNC_HISTORY_SIZE];
+		snap.time = time;
+		snap.valid = true;
+		snap.state = vars;
+
 		sync->emit_signal(SNAME("synchronized"));
 #ifdef DEBUG_ENABLED
 		_profile_node_data("sync_in", sync->get_instance_id(), size);
@@ -901,6 +1175,51 @@ Error SceneReplicationInterface::on_sync_receive(int p_from, const uint8_t *p_bu
 	return OK;
 }
 
+void SceneReplicationInterface::_send_sync_ack(int p_peer, PeerInfo &p_info) {
+	int size = 1 + 2 + 4 + 4 * p_info.recv_sync_resets.size();
+	MAKE_ROOM(size);
+	uint8_t *ptr = packet_cache.ptrw();
+	ptr[0] = SceneMultiplayer::NETWORK_COMMAND_SYNC | (1 << SceneMultiplayer::CMD_FLAG_1_SHIFT);
+	int ofs = 1;
+	ofs += encode_uint16(p_info.recv_sync_time, &ptr[ofs]);
+	ofs += encode_uint32(p_info.recv_sync_parts, &ptr[ofs]);
+	for (uint32_t net_id : p_info.recv_sync_resets) {
+		ofs += encode_uint32(net_id, &ptr[ofs]);
+	}
+	_send_raw(packet_cache.ptr(), ofs, p_peer, false);
+	p_info.recv_sync_ack_pending = false;
+}
+
+Error SceneReplicationInterface::on_sync_ack_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len) {
+	ERR_FAIL_COND_V_MSG(p_buffer_len < 7 || (p_buffer_len - 7) % 4, ERR_INVALID_DATA, "Invalid sync acknowledgement received");
+	ERR_FAIL_COND_V(!peers_info.has(p_from), ERR_UNAVAILABLE);
+	PeerInfo &peer = peers_info[p_from];
+	uint16_t time = decode_uint16(&p_buffer[1]);
+	uint32_t parts = decode_uint32(&p_buffer[3]);
+	for (KeyValue<ObjectID, SyncHistory> &E : peer.sent_syncs) {
+		SyncHistory &history = E.value;
+		const SyncSnapshot *snap = history.get_snapshot(time);
+		if (!snap || snap->part >= SYNC_MAX_PARTS || !(parts & (1u << snap->part))) {
+			continue;
+		}
+		if (!history.acked || _is_sync_time_newer(time, history.acked_time)) {
+			history.acked = true;
+			history.acked_time = time;
+		}
+	}
+	// The peer could not decode these, start over from full states.
+	for (int ofs = 7; ofs < p_buffer_len; ofs += 4) {
+		uint32_t net_id = decode_uint32(&p_buffer[ofs]);
+		for (KeyValue<ObjectID, SyncHistory> &E : peer.sent_syncs) {
+			MultiplayerSynchronizer *sync = get_id_as<MultiplayerSynchronizer>(E.key);
+			if (sync && sync->get_net_id() == net_id) {
+				E.value.acked = false;
+			}
+		}
+	}
+	return OK;
+}
+
 void SceneReplicationInterface::set_max_sync_packet_size(int p_size) {
 	ERR_FAIL_COND_MSG(p_size < 128, "Sync maximum packet size must be at least 128 bytes.");
 	sync_mtu = p_size;
@@ -918,3 +1237,40 @@ void SceneReplicationInterface::set_max_delta_packet_size(int p_size) {
 int SceneReplicationInterface::get_max_delta_packet_size() const {
 	return delta_mtu;
 }
+
+void SceneReplicationInterface::set_max_sync_bandwidth(int p_bytes_per_second) {
+	ERR_FAIL_COND_MSG(p_bytes_per_second < 0, "Sync bandwidth must be greater or equal to 0 (where 0 means unlimited).");
+	max_sync_bandwidth = p_bytes_per_second;
+}
+
+int SceneReplicationInterface::get_max_sync_bandwidth() const {
+	return max_sync_bandwidth;
+}
+
+void SceneReplicationInterface::set_interest_cell_size(real_t p_size) {
+	ERR_FAIL_COND_MSG(p_size <= 0, "Interest cell size must be greater than 0.");
+	interest_grid.set_cell_size(p_size);
+}
+
+real_t SceneReplicationInterface::get_interest_cell_size() const {
+	return interest_grid.get_cell_size();
+}
+
+void SceneReplicationInterface::set_interest_radius(real_t p_radius) {
+	ERR_FAIL_COND_MSG(p_radius <= 0, "Interest radius must be greater than 0.");
+	interest_radius = p_radius;
+}
+
+real_t SceneReplicationInterface::get_interest_radius() const {
+	return interest_radius;
+}
+
+void SceneReplicationInterface::set_interest_observer(int p_peer, Node *p_observer) {
+	ERR_FAIL_COND_MSG(!peers_info.has(p_peer), vformat("Unknown peer %d.", p_peer));
+	peers_info[p_peer].interest_observer = p_observer ? p_observer->get_instance_id() : ObjectID();
+}
+
+Node *SceneReplicationInterface::get_interest_observer(int p_peer) const {
+	ERR_FAIL_COND_V_MSG(!peers_info.has(p_peer), nullptr, vformat("Unknown peer %d.", p_peer));
+	return get_id_as<Node>(peers_info[p_peer].interest_observer);
+}
@@ -31,6 +31,7 @@
 #ifndef SCENE_REPLICATION_INTERFACE_H
 #define SCENE_REPLICATION_INTERFACE_H
 
+#include "multiplayer_interest_grid.h"
 #include "multiplayer_spawner.h"
 #include "multiplayer_synchronizer.h"
 
@@ -60,6 +61,29 @@ private:
 		}
 	};
 
+	enum {
+		SYNC_HISTORY_SIZE = 32, // Snapshots kept per synchronizer, older acknowledgements fall back to full states.
+		SYNC_MAX_PARTS = 32, // Sync packets of a single network time that can be acknowledged.
+	};
+
+	struct SyncSnapshot {
+		uint16_t time = 0;
+		uint8_t part = 0; // Index of the sync packet it was sent in, for the same network time.
+		bool valid = false;
+		Hector<Variant> state;
+	};
+
+	struct SyncHistory {
+		SyncSnapshot snapshots[SYNC_HISTORY_SIZE]; // Indexed by network time.
+		uint16_t acked_time = 0;
+		bool acked = false;
+
+		const SyncSnapshot *get_snapshot(uint16_t p_time) const {
+			const SyncSnapshot &snap = snapshots[p_time % SYNC_HISTORY_SIZE];
+			return snap.valid && snap.time == p_time ? &snap : nullptr;
+		}
+	};
+
 	struct PeerInfo {
 		HashSet<ObjectID> sync_nodes;
 		HashSet<ObjectID> spawn_nodes;
@@ -67,6 +91,35 @@ private:
 		HashMap<uint32_t, ObjectID> recv_sync_ids;
 		HashMap<uint32_t, ObjectID> recv_nodes;
 		uint16_t last_sent_sync = 0;
+
+		// Sync states sent to this peer, deltas are encoded against the last acknowledged one.
+		HashMap<ObjectID, SyncHistory> sent_syncs;
+		// Sync states received from this peer, to decode its deltas.
+		HashMap<ObjectID, SyncHistory> recv_syncs;
+		// Acknowledgement of the newest received sync time, sent back once per network process.
+		uint16_t recv_sync_time = 0;
+		uint32_t recv_sync_parts = 0;
+		LocalHector<uint32_t> recv_sync_resets; // Synchronizers that could not be decoded and need a full state.
+		bool recv_sync_started = false;
+		bool recv_sync_ack_pending = false;
+
+		// Spatial interest, synchronizers near the observer.
+		ObjectID interest_observer;
+		Hector3 interest_origin;
+		bool has_interest_origin = false;
+		HashSet<ObjectID> interest_syncs;
+
+		// Accumulated priority of the synchronizers waiting to be sent, and the bandwidth left.
+		HashMap<ObjectID, real_t> sync_priorities;
+		double sync_budget = 0;
+		uint64_t sync_budget_usec = 0;
+	};
+
+	struct SyncCandidate {
+		ObjectID id;
+		real_t priority = 0;
+
+		bool operator<(const SyncCandidate &p_other) const { return priority > p_other.priority; } // Highest first.
 	};
 
 	// Replication state.
@@ -90,8 +143,14 @@ private:
 	SceneMultiplayer *multiplayer = nullptr;
 	SceneCacheInterface *multiplayer_cache = nullptr;
 	PackedByteArray packet_cache;
+	ReplicationBitWriter state_writer;
 	int sync_mtu = 1350; // Highly dependent on underlying protocol.
 	int delta_mtu = 65535;
+	int max_sync_bandwidth = 0; // Bytes per second per peer, 0 is unlimited.
+
+	// Spatial interest management.
+	MultiplayerInterestGrid interest_grid;
+	real_t interest_radius = 256;
 
 	TrackedNode &_track(const ObjectID &p_id);
 	void _untrack(const ObjectID &p_id);
@@ -101,8 +160,10 @@ private:
 	bool _verify_synchronizer(int p_peer, MultiplayerSynchronizer *p_sync, uint32_t &r_net_id);
 	MultiplayerSynchronizer *_find_synchronizer(int p_peer, uint32_t p_net_ida);
 
-	void _send_sync(int p_peer, const HashSet<ObjectID> &p_synchronizers, uint16_t p_sync_net_time, uint64_t p_usec);
+	void _schedule_syncs(PeerInfo &p_info, uint64_t p_usec, LocalHector<ObjectID> &r_synchronizers);
+	int _send_sync(int p_peer, const LocalHector<ObjectID> &p_synchronizers, uint16_t p_sync_net_time, int p_budget, int &r_sent);
 	void _send_delta(int p_peer, const HashSet<ObjectID> &p_synchronizers, uint64_t p_usec, const HashMap<ObjectID, uint64_t> &p_last_watch_usecs);
+	void _send_sync_ack(int p_peer, PeerInfo &p_info);
 	Error _make_spawn_packet(Node *p_node, MultiplayerSpawner *p_spawner, int &r_len);
 	Error _make_despawn_packet(Node *p_node, int &r_len);
 	Error _send_raw(const uint8_t *p_buffer, int p_size, int p_peer, bool p_reliable);
@@ -110,6 +171,9 @@ private:
 	void _visibility_changed(int p_peer, ObjectID p_oid);
 	Error _update_sync_visibility(int p_peer, MultiplayerSynchronizer *p_sync);
 	Error _update_spawn_visibility(int p_peer, const ObjectID &p_oid);
+	bool _is_sync_visible_to(MultiplayerSynchronizer *p_sync, int p_peer) const;
+	void _update_interest();
+	static bool _get_interest_position(Node *p_node, Hector3 &r_position);
 	void _free_remotes(const PeerInfo &p_info);
 
 	template <typename T>
@@ -137,6 +201,7 @@ public:
 	Error on_despawn_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len);
 	Error on_sync_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len);
 	Error on_delta_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len);
+	Error on_sync_ack_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len);
 
 	bool is_rpc_visible(const ObjectID &p_oid, int p_peer) const;
 
@@ -146,6 +211,18 @@ public:
 	void set_max_delta_packet_size(int p_size);
 	int get_max_delta_packet_size() const;
 
+	void set_max_sync_bandwidth(int p_bytes_per_second);
+	int get_max_sync_bandwidth() const;
+
+	void set_interest_cell_size(real_t p_size);
+	real_t get_interest_cell_size() const;
+
+	void set_interest_radius(real_t p_radius);
+	real_t get_interest_radius() const;
+
+	void set_interest_observer(int p_peer, Node *p_observer);
+	Node *get_interest_observer(int p_peer) const;
+
 	SceneReplicationInterface(SceneMultiplayer *p_multiplayer, SceneCacheInterface *p_cache) {
 		multiplayer = p_multiplayer;
 		multiplayer_cache = p_cache;
@@ -174,6 +174,29 @@ void SceneRPCInterface::process_rpc(int p_from, const uint8_t *p_packet, int p_p
 	int node_id_compression = (p_packet[0] & NODE_ID_COMPRESSION_FLAG) >> NODE_ID_COMPRESSION_SHIFT;
 	int name_id_compression = (p_packet[0] & NAME_ID_COMPRESSION_FLAG) >> NAME_ID_COMPRESSION_SHIFT;
 
+	if (node_id_compression == NETWORK_NODE_ID_COMPRESSION_BATCH) {
+		// Each RPC is prefixed by its size.
+		int ofs = 1;
+		while (ofs < p_packet_len) {
+			uint32_t size = 0;
+			int shift = 0;
+			while (true) {
+				ERR_FAIL_COND_MSG(ofs >= p_packet_len || shift > 28, "Invalid RPC batch received.");
+				const uint8_t byte = p_packet[ofs++];
+				size |= uint32_t(byte & 0x7F) << shift;
+				shift += 7;
+				if (!(byte & 0x80)) {
+					break;
+				}
+			}
+			ERR_FAIL_COND_MSG(size == 0 || size > uint32_t(p_packet_len - ofs), "Invalid RPC batch received. Size too small.");
+			ERR_FAIL_COND_MSG(((p_packet[ofs] & NODE_ID_COMPRESSION_FLAG) >> NODE_ID_COMPRESSION_SHIFT) == NETWORK_NODE_ID_COMPRESSION_BATCH, "Invalid RPC batch received. Batches can't be nested.");
+			process_rpc(p_from, &p_packet[ofs], size);
+			ofs += size;
+		}
+		return;
+	}
+
 	switch (node_id_compression) {
 		case NETWORK_NODE_ID_COMPRESSION_8:
 			packet_min_size += 1;
@@ -318,13 +341,14 @@ void SceneRPCInterface::_send_rpc(Node *p_node, int p_to, uint16_t p_rpc_id, con
 	}
 
 	// See if all peers have cached path (if so, call can be fast) while building the RPC target list.
-	HashSet<int> targets;
+	LocalHector<int> &targets = target_cache;
+	targets.clear();
 	int psc_id = -1;
 	bool has_all_peers = true;
 	const ObjectID oid = p_node->get_instance_id();
 	if (p_to > 0) {
 		ERR_FAIL_COND_MSG(!multiplayer_replicator->is_rpc_visible(oid, p_to), "Attempt to call an RPC to a peer that cannot see this node. Peer ID: " + itos(p_to));
-		targets.insert(p_to);
+		targets.push_back(p_to);
 		has_all_peers = multiplayer_cache->send_object_cache(p_node, p_to, psc_id);
 	} else {
 		bool restricted = !multiplayer_replicator->is_rpc_visible(oid, 0);
@@ -335,7 +359,7 @@ void SceneRPCInterface::_send_rpc(Node *p_node, int p_to, uint16_t p_rpc_id, con
 			if (restricted && !multiplayer_replicator->is_rpc_visible(oid, P)) {
 				continue; // Not visible to this peer.
 			}
-			targets.insert(P);
+			targets.push_back(P);
 			bool has_peer = multiplayer_cache->send_object_cache(p_node, P, psc_id);
 			has_all_peers = has_all_peers && has_peer;
 		}
@@ -423,7 +447,7 @@ void SceneRPCInterface::_send_rpc(Node *p_node, int p_to, uint16_t p_rpc_id, con
 	}
 
 	ERR_FAIL_COND(command_type > 7);
-	ERR_FAIL_COND(node_id_compression > 3);
+	ERR_FAIL_COND(node_id_compression > 2);
 	ERR_FAIL_COND(name_id_compression > 1);
 
 #ifdef DEBUG_ENABLED
@@ -439,7 +463,11 @@ void SceneRPCInterface::_send_rpc(Node *p_node, int p_to, uint16_t p_rpc_id, con
 
 	if (has_all_peers) {
 		for (const int P : targets) {
-			multiplayer->send_command(P, packet_cache.ptr(), ofs);
+			if (batching) {
+				_queue_rpc(P, p_config, packet_cache.ptr(), ofs);
+			} else {
+				multiplayer->send_command(P, packet_cache.ptr(), ofs);
+			}
 		}
 	} else {
 		// Unreachable because the node ID is never compressed if the peers doesn't know it.
@@ -459,16 +487,134 @@ void SceneRPCInterface::_send_rpc(Node *p_node, int p_to, uint16_t p_rpc_id, con
 			if (confirmed) {
 				// This one confirmed path, so use id.
 				encode_uint32(psc_id, &(packet_cache.write[1]));
-				multiplayer->send_command(P, packet_cache.ptr(), ofs);
+				if (batching) {
+					_queue_rpc(P, p_config, packet_cache.ptr(), ofs);
+				} else {
+					multiplayer->send_command(P, packet_cache.ptr(), ofs);
+				}
 			} else {
 				// This one did not confirm path yet, so use entire path (sorry!).
 				encode_uint32(0x80000000 | ofs, &(packet_cache.write[1])); // Offset to path and flag.
-				multiplayer->send_command(P, packet_cache.ptr(), ofs + path_len);
+				if (batching) {
+					_queue_rpc(P, p_config, packet_cache.ptr(), ofs + path_len);
+				} else {
+					multiplayer->send_command(P, packet_cache.ptr(), ofs + path_len);
+				}
 			}
 		}
 	}
 }
 
+void SceneRPCInterface::_queue_rpc(int p_to, const RPCConfig &p_config, const uint8_t *p_packet, int p_packet_len) {
+	LocalHector<RPCBatch> &peer_batches = batches[p_to];
+	RPCBatch *batch = nullptr;
+	for (RPCBatch &B : peer_batches) {
+		if (B.channel == p_config.channel && B.transfer_mode == p_config.transfer_mode) {
+			batch = &B;
+			break;
+		}
+	}
+	if (!batch) {
+		peer_batches.push_back(RPCBatch());
+		batch = &peer_batches[peer_batches.size() - 1];
+		batch->channel = p_config.channel;
+		batch->transfer_mode = p_config.transfer_mode;
+	}
+
+	// Unreliable batches must fit in a single packet, reliable ones can be fragmented by the peer.
+	const int max_size = p_config.transfer_mode == MultiplayerPeer::TRANSFER_MODE_RELIABLE ? multiplayer->get_max_delta_packet_size() : multiplayer->get_max_sync_packet_size();
+	if (batch->count && int(batch->data.size()) + 5 + p_packet_len > max_size) {
+		// Sending goes through send_command(), which must not flush (and send) this batch again.
+		flushing = true;
+		_send_batch(p_to, *batch);
+		flushing = false;
+	}
+	if (batch->data.is_empty()) {
+		batch->data.push_back(SceneMultiplayer::NETWORK_COMMAND_REMOTE_CALL | (NETWORK_NODE_ID_COMPRESSION_BATCH << NODE_ID_COMPRESSION_SHIFT));
+	}
+	uint32_t size = p_packet_len;
+	while (size >= 0x80) {
+		batch->data.push_back((size & 0x7F) | 0x80);
+		size >>= 7;
+	}
+	batch->data.push_back(size);
+	const uint32_t ofs = batch->data.size();
+	batch->data.resize(ofs + p_packet_len);
+	memcpy(&batch->data[ofs], p_packet, p_packet_len);
+	if (batch->count == 0) {
+		batch->first_size = p_packet_len;
+	}
+	batch->count++;
+	batch_pending = true;
+}
+
+void SceneRPCInterface::_send_batch(int p_to, RPCBatch &p_batch) {
+	Ref<MultiplayerPeer> peer = multiplayer->get_multiplayer_peer();
+	peer->set_transfer_channel(p_batch.channel);
+	peer->set_transfer_mode(p_batch.transfer_mode);
+	if (p_batch.count == 1) {
+		// A single RPC is sent as is.
+		multiplayer->send_command(p_to, p_batch.data.ptr() + p_batch.data.size() - p_batch.first_size, p_batch.first_size);
+	} else {
+		multiplayer->send_command(p_to, p_batch.data.ptr(), p_batch.data.size());
+	}
+	p_batch.data.clear();
+	p_batch.count = 0;
+}
+
+void SceneRPCInterface::flush_rpcs() {
+	if (!batch_pending || flushing) {
+		return;
+	}
+	Ref<MultiplayerPeer> peer = multiplayer->get_multiplayer_peer();
+	if (peer.is_null()) {
+		clear_rpcs();
+		return;
+	}
+	flushing = true;
+	// Sending from here must not change the mode chosen by whoever is sending next.
+	const int channel = peer->get_transfer_channel();
+	const MultiplayerPeer::TransferMode mode = peer->get_transfer_mode();
+	const HashSet<int> &connected = multiplayer->get_connected_peers();
+	for (HashMap<int, LocalHector<RPCBatch>>::Iterator E = batches.begin(); E;) {
+		HashMap<int, LocalHector<RPCBatch>>::Iterator next = E;
+		++next;
+		if (!connected.has(E->key)) {
+			batches.remove(E); // Disconnected.
+		} else {
+			for (RPCBatch &B : E->value) {
+				if (B.count) {
+					_send_batch(E->key, B);
+				}
+			}
+		}
+		E = next;
+	}
+	peer->set_transfer_channel(channel);
+	peer->set_transfer_mode(mode);
+	batch_pending = false;
+	flushing = false;
+}
+
+void SceneRPCInterface::clear_rpcs() {
+	batches.clear();
+	batch_pending = false;
+}
+
+void SceneRPCInterface::set_batching_enabled(bool p_enabled) {
+	if (batching == p_enabled) {
+		return;
+	}
+	batching = p_enabled;
+	if (!batching) {
+		flush_rpcs();
+	}
+}
+
+bool SceneRPCInterface::is_batching_enabled() const {
+	return batching;
+}
+
 Error SceneRPCInterface::rpcp(Object *p_obj, int p_peer_id, const StringName &p_method, const Variant **p_arg, int p_argcount) {
 	Ref<MultiplayerPeer> peer = multiplayer->get_multiplayer_peer();
 	ERR_FAIL_COND_V_MSG(!peer.is_valid(), ERR_UNCONFIGURED, "Trying to call an RPC while no multiplayer peer is active.");
@@ -71,6 +71,16 @@ private:
 		NETWORK_NODE_ID_COMPRESSION_8 = 0,
 		NETWORK_NODE_ID_COMPRESSION_16,
 		NETWORK_NODE_ID_COMPRESSION_32,
+		NETWORK_NODE_ID_COMPRESSION_BATCH, // Not a node ID, the packet contains multiple RPCs.
+	};
+
+	// RPCs waiting to be sent to a peer on a given channel and transfer mode.
+	struct RPCBatch {
+		int channel = 0;
+		MultiplayerPeer::TransferMode transfer_mode = MultiplayerPeer::TRANSFER_MODE_RELIABLE;
+		LocalHector<uint8_t> data; // Batch meta, then each RPC prefixed by its size.
+		int count = 0;
+		int first_size = 0;
 	};
 
 	enum NetworkNameIdCompression {
@@ -83,6 +93,12 @@ private:
 	SceneReplicationInterface *multiplayer_replicator = nullptr;
 
 	Hector<uint8_t> packet_cache;
+	LocalHector<int> target_cache;
+
+	bool batching = false;
+	bool batch_pending = false;
+	bool flushing = false;
+	HashMap<int, LocalHector<RPCBatch>> batches;
 
 	HashMap<ObjectID, RPCConfigCache> rpc_cache;
 
@@ -95,6 +111,8 @@ protected:
 
 	void _process_rpc(Node *p_node, const uint16_t p_rpc_method_id, int p_from, const uint8_t *p_packet, int p_packet_len, int p_offset);
 
+	void _queue_rpc(int p_to, const RPCConfig &p_config, const uint8_t *p_packet, int p_packet_len);
+	void _send_batch(int p_to, RPCBatch &p_batch);
 	void _send_rpc(Node *p_from, int p_to, uint16_t p_rpc_id, const RPCConfig &p_config, const StringName &p_name, const Variant **p_arg, int p_argcount);
 	Node *_process_get_node(int p_from, const uint8_t *p_packet, uint32_t p_node_target, int p_packet_len);
 
@@ -106,6 +124,12 @@ public:
 	void process_rpc(int p_from, const uint8_t *p_packet, int p_packet_len);
 	String get_rpc_md5(const Object *p_obj);
 
+	void set_batching_enabled(bool p_enabled);
+	bool is_batching_enabled() const;
+	bool has_pending_rpcs() const { return batch_pending && !flushing; }
+	void flush_rpcs();
+	void clear_rpcs();
+
 	SceneRPCInterface(SceneMultiplayer *p_multiplayer, SceneCacheInterface *p_cache, SceneReplicationInterface *p_replicator) {
 		multiplayer = p_multiplayer;
 		multiplayer_cache = p_cache;
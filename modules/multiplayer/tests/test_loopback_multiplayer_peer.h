@@ -0,0 +1,521 @@
+/**************************************************************************/
+/*  test_loopback_multiplayer_peer.h                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_LOOPBACK_MULTIPLAYER_PEER_H
+#define TEST_LOOPBACK_MULTIPLAYER_PEER_H
+
+#include "tests/test_macros.h"
+
+#include "../loopback_multiplayer_peer.h"
+#include "../multiplayer_synchronizer.h"
+#include "../scene_multiplayer.h"
+
+#include "core/os/os.h"
+#include "scene/2d/node_2d.h"
+#include "scene/main/window.h"
+
+namespace TestLoopbackMultiplayerPeer {
+
+static inline Array build_array() {
+	return Array();
+}
+template <typename... Targs>
+static inline Array build_array(Variant item, Targs... Fargs) {
+	Array a = build_array(Fargs...);
+	a.push_front(item);
+	return a;
+}
+
+static Hector<uint8_t> _make_packet(uint8_t p_value, int p_size = 4) {
+	Hector<uint8_t> data;
+	data.resize(p_size);
+	data.fill(p_value);
+	return data;
+}
+
+static Hector<uint8_t> _read_packet(const Ref<LoopbackMultiplayerPeer> &p_peer) {
+	const uint8_t *buffer = nullptr;
+	int size = 0;
+	Hector<uint8_t> data;
+	if (p_peer->get_packet(&buffer, size) == OK) {
+		data.resize(size);
+		memcpy(data.ptrw(), buffer, size);
+	}
+	return data;
+}
+
+TEST_CASE("[Multiplayer][LoopbackMultiplayerPeer] Connection") {
+	Ref<LoopbackMultiplayerPeer> server;
+	server.instantiate();
+	Ref<LoopbackMultiplayerPeer> client;
+	client.instantiate();
+
+	CHECK_EQ(server->get_connection_status(), MultiplayerPeer::CONNECTION_DISCONNECTED);
+	REQUIRE_EQ(server->create_server(), OK);
+	CHECK(server->is_server());
+	CHECK_EQ(server->get_unique_id(), MultiplayerPeer::TARGET_PEER_SERVER);
+	CHECK_EQ(server->get_connection_status(), MultiplayerPeer::CONNECTION_CONNECTED);
+
+	REQUIRE_EQ(client->create_client(server), OK);
+	CHECK_FALSE(client->is_server());
+	CHECK_EQ(client->get_unique_id(), 2);
+	CHECK_EQ(client->get_connection_status(), MultiplayerPeer::CONNECTION_CONNECTING);
+
+	SIGNAL_WATCH(server.ptr(), "peer_connected");
+	SIGNAL_WATCH(client.ptr(), "peer_connected");
+	server->poll();
+	SIGNAL_CHECK("peer_connected", build_array(build_array(2)));
+	client->poll();
+	SIGNAL_CHECK("peer_connected", build_array(build_array(1)));
+	CHECK_EQ(client->get_connection_status(), MultiplayerPeer::CONNECTION_CONNECTED);
+	SIGNAL_UNWATCH(server.ptr(), "peer_connected");
+	SIGNAL_UNWATCH(client.ptr(), "peer_connected");
+
+	SUBCASE("Clients get sequential IDs") {
+		Ref<LoopbackMultiplayerPeer> other;
+		other.instantiate();
+		REQUIRE_EQ(other->create_client(server), OK);
+		CHECK_EQ(other->get_unique_id(), 3);
+	}
+
+	SUBCASE("Refuses new connections") {
+		server->set_refuse_new_connections(true);
+		Ref<LoopbackMultiplayerPeer> other;
+		other.instantiate();
+		CHECK_EQ(other->create_client(server), ERR_CANT_CONNECT);
+		CHECK_EQ(other->get_connection_status(), MultiplayerPeer::CONNECTION_DISCONNECTED);
+	}
+
+	SUBCASE("Server disconnects a client") {
+		SIGNAL_WATCH(server.ptr(), "peer_disconnected");
+		server->disconnect_peer(2);
+		CHECK_EQ(client->get_connection_status(), MultiplayerPeer::CONNECTION_DISCONNECTED);
+		server->poll();
+		SIGNAL_CHECK("peer_disconnected", build_array(build_array(2)));
+		SIGNAL_UNWATCH(server.ptr(), "peer_disconnected");
+	}
+
+	SUBCASE("Client closes") {
+		SIGNAL_WATCH(server.ptr(), "peer_disconnected");
+		client->close();
+		server->poll();
+		SIGNAL_CHECK("peer_disconnected", build_array(build_array(2)));
+		SIGNAL_UNWATCH(server.ptr(), "peer_disconnected");
+	}
+
+	SUBCASE("Server closes") {
+		server->close();
+		CHECK_EQ(server->get_connection_status(), MultiplayerPeer::CONNECTION_DISCONNECTED);
+		CHECK_EQ(client->get_connection_status(), MultiplayerPeer::CONNECTION_DISCONNECTED);
+	}
+}
+
+TEST_CASE("[Multiplayer][LoopbackMultiplayerPeer] Packets") {
+	Ref<LoopbackMultiplayerPeer> server;
+	server.instantiate();
+	REQUIRE_EQ(server->create_server(), OK);
+	Ref<LoopbackMultiplayerPeer> client_a;
+	client_a.instantiate();
+	REQUIRE_EQ(client_a->create_client(server), OK);
+	Ref<LoopbackMultiplayerPeer> client_b;
+	client_b.instantiate();
+	REQUIRE_EQ(client_b->create_client(server), OK);
+	server->poll();
+	client_a->poll();
+	client_b->poll();
+
+	SUBCASE("Targeted") {
+		server->set_target_peer(3);
+		server->set_transfer_channel(2);
+		server->set_transfer_mode(MultiplayerPeer::TRANSFER_MODE_UNRELIABLE_ORDERED);
+		CHECK_EQ(server->put_packet(_make_packet(7).ptr(), 4), OK);
+		client_a->poll();
+		client_b->poll();
+		CHECK_EQ(client_a->get_available_packet_count(), 0);
+		REQUIRE_EQ(client_b->get_available_packet_count(), 1);
+		CHECK_EQ(client_b->get_packet_peer(), 1);
+		CHECK_EQ(client_b->get_packet_channel(), 2);
+		CHECK_EQ(client_b->get_packet_mode(), MultiplayerPeer::TRANSFER_MODE_UNRELIABLE_ORDERED);
+		CHECK_EQ(_read_packet(client_b), _make_packet(7));
+		CHECK_EQ(client_b->get_available_packet_count(), 0);
+	}
+
+	SUBCASE("Broadcast and exclude") {
+		server->set_target_peer(MultiplayerPeer::TARGET_PEER_BROADCAST);
+		CHECK_EQ(server->put_packet(_make_packet(1).ptr(), 4), OK);
+		server->set_target_peer(-2);
+		CHECK_EQ(server->put_packet(_make_packet(2).ptr(), 4), OK);
+		client_a->poll();
+		client_b->poll();
+		REQUIRE_EQ(client_a->get_available_packet_count(), 1);
+		CHECK_EQ(_read_packet(client_a), _make_packet(1));
+		REQUIRE_EQ(client_b->get_available_packet_count(), 2);
+		CHECK_EQ(_read_packet(client_b), _make_packet(1));
+		CHECK_EQ(_read_packet(client_b), _make_packet(2));
+	}
+
+	SUBCASE("Clients only reach the server") {
+		client_a->set_target_peer(MultiplayerPeer::TARGET_PEER_BROADCAST);
+		CHECK_EQ(client_a->put_packet(_make_packet(3).ptr(), 4), OK);
+		ERR_PRINT_OFF;
+		CHECK_EQ(client_a->put_packet(_make_packet(3).ptr(), 4), OK);
+		client_a->set_target_peer(3);
+		CHECK_EQ(client_a->put_packet(_make_packet(3).ptr(), 4), ERR_INVALID_PARAMETER);
+		ERR_PRINT_ON;
+		server->poll();
+		client_b->poll();
+		CHECK_EQ(server->get_available_packet_count(), 2);
+		CHECK_EQ(server->get_packet_peer(), 2);
+		CHECK_EQ(client_b->get_available_packet_count(), 0);
+	}
+
+	SUBCASE("Latency") {
+		server->set_latency(0.05);
+		server->set_target_peer(2);
+		const uint64_t sent = OS::get_singleton()->get_ticks_usec();
+		CHECK_EQ(server->put_packet(_make_packet(4).ptr(), 4), OK);
+		client_a->poll();
+		if (OS::get_singleton()->get_ticks_usec() - sent < 50000) {
+			CHECK_EQ(client_a->get_available_packet_count(), 0);
+		}
+		OS::get_singleton()->delay_usec(60000);
+		client_a->poll();
+		CHECK_EQ(client_a->get_available_packet_count(), 1);
+	}
+
+	SUBCASE("Packet loss only affects unreliable packets") {
+		server->set_packet_loss(1.0);
+		server->set_target_peer(2);
+		server->set_transfer_mode(MultiplayerPeer::TRANSFER_MODE_UNRELIABLE);
+		for (int i = 0; i < 5; i++) {
+			CHECK_EQ(server->put_packet(_make_packet(5).ptr(), 4), OK);
+		}
+		server->set_transfer_mode(MultiplayerPeer::TRANSFER_MODE_RELIABLE);
+		CHECK_EQ(server->put_packet(_make_packet(6).ptr(), 4), OK);
+		client_a->poll();
+		REQUIRE_EQ(client_a->get_available_packet_count(), 1);
+		CHECK_EQ(_read_packet(client_a), _make_packet(6));
+		Dictionary stats = server->get_statistics();
+		CHECK_EQ(int(stats["packets_lost"]), 5);
+		CHECK_EQ(int(stats["packets_sent"]), 1);
+	}
+
+	SUBCASE("Statistics") {
+		server->set_target_peer(MultiplayerPeer::TARGET_PEER_BROADCAST);
+		CHECK_EQ(server->put_packet(_make_packet(8, 10).ptr(), 10), OK);
+		client_a->set_target_peer(1);
+		CHECK_EQ(client_a->put_packet(_make_packet(9, 3).ptr(), 3), OK);
+		server->poll();
+		client_a->poll();
+
+		Dictionary stats = server->get_statistics();
+		CHECK_EQ(int(stats["packets_sent"]), 2);
+		CHECK_EQ(int(stats["bytes_sent"]), 20);
+		CHECK_EQ(int(stats["packets_received"]), 1);
+		CHECK_EQ(int(stats["bytes_received"]), 3);
+		stats = server->get_peer_statistics(2);
+		CHECK_EQ(int(stats["bytes_sent"]), 10);
+		CHECK_EQ(int(stats["bytes_received"]), 3);
+		stats = client_a->get_statistics();
+		CHECK_EQ(int(stats["bytes_sent"]), 3);
+		CHECK_EQ(int(stats["bytes_received"]), 10);
+
+		server->reset_statistics();
+		CHECK_EQ(int(server->get_statistics()["packets_sent"]), 0);
+		CHECK_EQ(int(server->get_peer_statistics(2)["bytes_sent"]), 0);
+	}
+}
+
+// Connects a server and clients through SceneMultiplayer instances, each on its own branch of the scene tree.
+struct LoopbackSession {
+	Hector<Ref<LoopbackMultiplayerPeer>> peers;
+	Hector<Ref<SceneMultiplayer>> multiplayers;
+	Hector<Node *> roots;
+
+	void add(const String &p_name, const Ref<LoopbackMultiplayerPeer> &p_server, Node *p_root) {
+		Ref<LoopbackMultiplayerPeer> peer;
+		peer.instantiate();
+		if (p_server.is_null()) {
+			peer->create_server();
+		} else {
+			peer->create_client(p_server);
+		}
+		p_root->set_name(p_name);
+		SceneTree::get_singleton()->get_root()->add_child(p_root);
+		Ref<SceneMultiplayer> mp;
+		mp.instantiate();
+		mp->set_multiplayer_peer(peer);
+		SceneTree::get_singleton()->set_multiplayer(mp, p_root->get_path());
+		peers.push_back(peer);
+		multiplayers.push_back(mp);
+		roots.push_back(p_root);
+	}
+
+	void poll() {
+		for (Ref<SceneMultiplayer> &mp : multiplayers) {
+			mp->poll();
+		}
+	}
+
+	~LoopbackSession() {
+		for (Node *root : roots) {
+			SceneTree::get_singleton()->set_multiplayer(Ref<MultiplayerAPI>(), root->get_path());
+			memdelete(root);
+		}
+		for (Ref<SceneMultiplayer> &mp : multiplayers) {
+			mp->set_multiplayer_peer(Ref<MultiplayerPeer>());
+		}
+	}
+};
+
+TEST_CASE("[Multiplayer][LoopbackMultiplayerPeer][SceneTree] SceneMultiplayer over loopback") {
+	LoopbackSession session;
+	session.add("Server", Ref<LoopbackMultiplayerPeer>(), memnew(Node));
+	session.add("Client", session.peers[0], memnew(Node));
+	Ref<SceneMultiplayer> server_mp = session.multiplayers[0];
+	Ref<SceneMultiplayer> client_mp = session.multiplayers[1];
+
+	SIGNAL_WATCH(client_mp.ptr(), "connected_to_server");
+	session.poll();
+	SIGNAL_CHECK("connected_to_server", build_array(build_array()));
+	SIGNAL_UNWATCH(client_mp.ptr(), "connected_to_server");
+	CHECK_EQ(server_mp->get_peer_ids(), Hector<int>({ 2 }));
+	CHECK_EQ(client_mp->get_unique_id(), 2);
+
+	SUBCASE("Raw bytes") {
+		SIGNAL_WATCH(server_mp.ptr(), "peer_packet");
+		CHECK_EQ(client_mp->send_bytes(_make_packet(42), 1), OK);
+		session.poll();
+		SIGNAL_CHECK("peer_packet", build_array(build_array(2, _make_packet(42))));
+		SIGNAL_UNWATCH(server_mp.ptr(), "peer_packet");
+	}
+
+	SUBCASE("RPC batching") {
+		// Same path under each branch, so the RPC resolves on the server.
+		Dictionary config;
+		config["rpc_mode"] = MultiplayerAPI::RPC_MODE_ANY_PEER;
+		Node *server_node = memnew(Node);
+		server_node->set_name("Target");
+		server_node->rpc_config("set_editor_description", config);
+		session.roots[0]->add_child(server_node);
+		Node *client_node = memnew(Node);
+		client_node->set_name("Target");
+		client_node->rpc_config("set_editor_description", config);
+		session.roots[1]->add_child(client_node);
+
+		const int rpc_count = 10;
+		int sent[2] = {};
+		for (int batching = 0; batching < 2; batching++) {
+			client_mp->set_rpc_batching_enabled(batching);
+			session.peers[1]->reset_statistics();
+			for (int i = 0; i < rpc_count; i++) {
+				CHECK_EQ(client_node->rpc_id(1, "set_editor_description", itos(batching * rpc_count + i)), OK);
+			}
+			session.poll();
+			session.poll();
+			CHECK_EQ(server_node->get_editor_description(), itos(batching * rpc_count + rpc_count - 1));
+			sent[batching] = session.peers[1]->get_statistics()["packets_sent"];
+		}
+		// Without batching, one packet per RPC, plus the path simplification the first time.
+		CHECK_EQ(sent[0], rpc_count + 1);
+		CHECK_EQ(sent[1], 1);
+	}
+
+	SUBCASE("RPC batch overflow") {
+		Dictionary config;
+		config["rpc_mode"] = MultiplayerAPI::RPC_MODE_ANY_PEER;
+		config["transfer_mode"] = MultiplayerPeer::TRANSFER_MODE_RELIABLE;
+		Node2D *server_node = memnew(Node2D);
+		server_node->set_name("Target");
+		server_node->rpc_config("translate", config);
+		session.roots[0]->add_child(server_node);
+		Node2D *client_node = memnew(Node2D);
+		client_node->set_name("Target");
+		client_node->rpc_config("translate", config);
+		session.roots[1]->add_child(client_node);
+
+		// Enough RPCs to fill several batches of the smallest allowed size.
+		const int rpc_count = 40;
+		client_mp->set_max_delta_packet_size(128);
+		client_mp->set_rpc_batching_enabled(true);
+		session.peers[1]->reset_statistics();
+		for (int i = 0; i < rpc_count; i++) {
+			CHECK_EQ(client_node->rpc_id(1, "translate", Hector2(1, 0)), OK);
+		}
+		session.poll();
+		session.poll();
+		CHECK_MESSAGE(int(session.peers[1]->get_statistics()["packets_sent"]) > 2, "The RPCs must not fit in one batch.");
+		CHECK_MESSAGE(server_node->get_position() == Hector2(rpc_count, 0), "Every RPC must arrive exactly once.");
+	}
+}
+
+// Entities whose position already matches the one set on the server.
+static int _count_synced_entities(Node *p_root, int p_from, int p_to) {
+	int count = 0;
+	for (int i = p_from; i < p_to; i++) {
+		if (Object::cast_to<Node2D>(p_root->get_child(i))->get_position() == Hector2(i + 1, 1)) {
+			count++;
+		}
+	}
+	return count;
+}
+
+TEST_CASE("[Multiplayer][LoopbackMultiplayerPeer][SceneTree] Spatial interest and sync bandwidth") {
+	LoopbackSession session;
+	session.add("Server", Ref<LoopbackMultiplayerPeer>(), memnew(Node));
+	session.add("Near", session.peers[0], memnew(Node));
+	session.add("Far", session.peers[0], memnew(Node));
+	session.poll();
+	Ref<SceneMultiplayer> server_mp = session.multiplayers[0];
+	REQUIRE_EQ(server_mp->get_peer_ids().size(), 2);
+
+	// Added once each branch has its multiplayer, so the synchronizers register with it.
+	const int entity_count = 16;
+	const int important_count = 4;
+	Ref<SceneReplicationConfig> config;
+	config.instantiate();
+	config->add_property(NodePath(".:position"));
+	for (int r = 0; r < session.roots.size(); r++) {
+		for (int i = 0; i < entity_count; i++) {
+			Node2D *entity = memnew(Node2D);
+			entity->set_name(vformat("Entity%d", i));
+			if (r == 0) {
+				entity->set_position(Hector2(i + 1, 1));
+			}
+			MultiplayerSynchronizer *sync = memnew(MultiplayerSynchronizer);
+			sync->set_replication_config(config);
+			sync->set_spatial_interest(true);
+			sync->set_sync_priority(i < important_count ? 10 : 1);
+			entity->add_child(sync);
+			session.roots[r]->add_child(entity);
+		}
+	}
+
+	// Only the first client observes the entities.
+	Node2D *near_observer = memnew(Node2D);
+	session.roots[0]->add_child(near_observer);
+	Node2D *far_observer = memnew(Node2D);
+	far_observer->set_position(Hector2(100000, 100000));
+	session.roots[0]->add_child(far_observer);
+	server_mp->set_interest_observer(2, near_observer);
+	server_mp->set_interest_observer(3, far_observer);
+
+	// Room for a single small packet of syncs per peer, refilled in a tenth of a second.
+	server_mp->set_max_sync_packet_size(128);
+	server_mp->set_max_sync_bandwidth(1280);
+
+	// The synchronizer paths are confirmed first, then the syncs start.
+	for (int tick = 0; tick < 10 && _count_synced_entities(session.roots[1], 0, entity_count) == 0; tick++) {
+		session.poll();
+	}
+	CHECK_MESSAGE(_count_synced_entities(session.roots[1], 0, important_count) == important_count, "Higher priorities must be sent first.");
+	CHECK_MESSAGE(_count_synced_entities(session.roots[1], important_count, entity_count) < entity_count - important_count, "The bandwidth limit must defer the lower priorities.");
+
+	for (int tick = 0; tick < 40 && _count_synced_entities(session.roots[1], 0, entity_count) < entity_count; tick++) {
+		OS::get_singleton()->delay_usec(50000);
+		session.poll();
+	}
+	CHECK_MESSAGE(_count_synced_entities(session.roots[1], 0, entity_count) == entity_count, "Deferred synchronizers must be sent in later ticks.");
+	CHECK_MESSAGE(_count_synced_entities(session.roots[2], 0, entity_count) == 0, "Peers observing elsewhere must not receive syncs.");
+}
+
+static void _move_entities(Node *p_root, int p_tick) {
+	for (int i = 0; i < p_root->get_child_count(); i++) {
+		Node2D *entity = Object::cast_to<Node2D>(p_root->get_child(i));
+		entity->set_position(Hector2(Math::sin(p_tick * 0.1 + i), Math::cos(p_tick * 0.1 + i)) * 100.0 + Hector2(i * 32, 0));
+	}
+}
+
+static Node *_create_world(int p_entities) {
+	Ref<SceneReplicationConfig> config;
+	config.instantiate();
+	config->add_property(NodePath(".:position"));
+	Node *world = memnew(Node);
+	for (int i = 0; i < p_entities; i++) {
+		Node2D *entity = memnew(Node2D);
+		entity->set_name(vformat("Entity%d", i));
+		MultiplayerSynchronizer *sync = memnew(MultiplayerSynchronizer);
+		sync->set_replication_config(config);
+		entity->add_child(sync);
+		world->add_child(entity);
+	}
+	return world;
+}
+
+// Run with `--test --test-case="*Benchmark*" --no-skip`.
+TEST_CASE("[Multiplayer][LoopbackMultiplayerPeer][SceneTree][Benchmark] Dedicated server load" * doctest::skip()) {
+	const int client_count = 32;
+	const int entity_count = 64;
+	const int tick_count = 300;
+
+	LoopbackSession session;
+	session.add("Server", Ref<LoopbackMultiplayerPeer>(), _create_world(entity_count));
+	for (int i = 0; i < client_count; i++) {
+		session.add(vformat("Client%d", i), session.peers[0], _create_world(entity_count));
+	}
+	Dictionary config;
+	config["rpc_mode"] = MultiplayerAPI::RPC_MODE_ANY_PEER;
+	config["transfer_mode"] = MultiplayerPeer::TRANSFER_MODE_UNRELIABLE;
+	for (Node *root : session.roots) {
+		root->rpc_config("set_editor_description", config);
+	}
+	session.poll();
+	session.poll();
+	REQUIRE_EQ(session.multiplayers[0]->get_peer_ids().size(), client_count);
+	session.peers[0]->reset_statistics();
+
+	uint64_t server_usec = 0;
+	uint64_t server_allocs = 0;
+	for (int tick = 0; tick < tick_count; tick++) {
+		_move_entities(session.roots[0], tick);
+		for (int i = 1; i < session.roots.size(); i++) {
+			session.roots[i]->rpc_id(1, "set_editor_description", itos(tick));
+		}
+		for (int i = 1; i < session.multiplayers.size(); i++) {
+			session.multiplayers[i]->poll();
+		}
+		const uint64_t allocs = Memory::get_alloc_total();
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		session.multiplayers[0]->poll();
+		server_usec += OS::get_singleton()->get_ticks_usec() - begin;
+		server_allocs += Memory::get_alloc_total() - allocs;
+	}
+
+	const Dictionary stats = session.peers[0]->get_statistics();
+	print_line(vformat("Dedicated server load: %d clients, %d entities, %d ticks.", client_count, entity_count, tick_count));
+	print_line(vformat("\tServer poll: %.1f usec/tick, %.1f allocations/tick.", double(server_usec) / tick_count, double(server_allocs) / tick_count));
+	print_line(vformat("\tServer traffic: %.1f bytes/tick/peer sent, %.1f bytes/tick/peer received.",
+			double(uint64_t(stats["bytes_sent"])) / tick_count / client_count,
+			double(uint64_t(stats["bytes_received"])) / tick_count / client_count));
+}
+
+} // namespace TestLoopbackMultiplayerPeer
+
+#endif // TEST_LOOPBACK_MULTIPLAYER_PEER_H
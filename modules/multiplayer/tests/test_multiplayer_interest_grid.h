@@ -0,0 +1,120 @@
+/**************************************************************************/
+/*  test_multiplayer_interest_grid.h                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_MULTIPLAYER_INTEREST_GRID_H
+#define TEST_MULTIPLAYER_INTEREST_GRID_H
+
+#include "tests/test_macros.h"
+
+#include "../multiplayer_interest_grid.h"
+
+namespace TestMultiplayerInterestGrid {
+
+static HashSet<ObjectID> query_ids(const MultiplayerInterestGrid &p_grid, const Hector3 &p_center, real_t p_radius) {
+	HashSet<ObjectID> ids;
+	p_grid.query(p_center, p_radius, [&](const ObjectID &p_id, real_t p_distance) {
+		CHECK(p_distance <= p_radius);
+		ids.insert(p_id);
+	});
+	return ids;
+}
+
+TEST_CASE("[Multiplayer][MultiplayerInterestGrid] Query") {
+	MultiplayerInterestGrid grid;
+	grid.set_cell_size(10);
+	const ObjectID a = ObjectID(uint64_t(1));
+	const ObjectID b = ObjectID(uint64_t(2));
+	const ObjectID c = ObjectID(uint64_t(3));
+	grid.update_object(a, Hector3(0, 0, 0));
+	grid.update_object(b, Hector3(15, 0, 0));
+	grid.update_object(c, Hector3(-100, 50, 0));
+	CHECK(grid.get_object_count() == 3);
+
+	HashSet<ObjectID> ids = query_ids(grid, Hector3(), 20);
+	CHECK(ids.size() == 2);
+	CHECK(ids.has(a));
+	CHECK(ids.has(b));
+
+	ids = query_ids(grid, Hector3(-95, 45, 0), 10);
+	CHECK(ids.size() == 1);
+	CHECK(ids.has(c));
+
+	SUBCASE("Move between cells") {
+		grid.update_object(c, Hector3(5, 5, 0));
+		CHECK(query_ids(grid, Hector3(), 20).size() == 3);
+		CHECK(query_ids(grid, Hector3(-95, 45, 0), 10).is_empty());
+
+		Hector3 position;
+		CHECK(grid.get_position(c, position));
+		CHECK(position == Hector3(5, 5, 0));
+	}
+
+	SUBCASE("Remove") {
+		grid.remove_object(a);
+		CHECK_FALSE(grid.has_object(a));
+		ids = query_ids(grid, Hector3(), 20);
+		CHECK(ids.size() == 1);
+		CHECK(ids.has(b));
+	}
+
+	SUBCASE("Cell size change keeps objects") {
+		grid.set_cell_size(1);
+		CHECK(query_ids(grid, Hector3(), 20).size() == 2);
+		grid.set_cell_size(1000);
+		CHECK(query_ids(grid, Hector3(), 20).size() == 2);
+		CHECK(query_ids(grid, Hector3(), 1000).size() == 3);
+	}
+}
+
+TEST_CASE("[Multiplayer][MultiplayerInterestGrid] Dense and sparse queries match") {
+	MultiplayerInterestGrid grid;
+	grid.set_cell_size(4);
+	for (int i = 0; i < 200; i++) {
+		grid.update_object(ObjectID(uint64_t(i + 1)), Hector3((i * 37) % 101 - 50, (i * 53) % 97 - 48, (i * 11) % 13 - 6));
+	}
+	// A small radius walks the cells around the center, a large one walks the occupied cells.
+	for (const real_t radius : { 3.0, 7.0, 12.0, 500.0 }) {
+		for (const Hector3 &center : { Hector3(), Hector3(10, -20, 3) }) {
+			int brute_force = 0;
+			for (int i = 0; i < 200; i++) {
+				Hector3 position;
+				grid.get_position(ObjectID(uint64_t(i + 1)), position);
+				if (position.distance_to(center) <= radius) {
+					brute_force++;
+				}
+			}
+			CHECK(int(query_ids(grid, center, radius).size()) == brute_force);
+		}
+	}
+}
+
+} // namespace TestMultiplayerInterestGrid
+
+#endif // TEST_MULTIPLAYER_INTEREST_GRID_H
@@ -64,8 +64,12 @@ TEST_CASE("[Multiplayer][SceneMultiplayer] Defaults") {
 	CHECK_FALSE(scene_multiplayer->is_refusing_new_connections());
 	CHECK_FALSE(scene_multiplayer->is_object_decoding_allowed());
 	CHECK(scene_multiplayer->is_server_relay_enabled());
+	CHECK_FALSE(scene_multiplayer->is_rpc_batching_enabled());
 	CHECK_EQ(scene_multiplayer->get_max_sync_packet_size(), 1350);
 	CHECK_EQ(scene_multiplayer->get_max_delta_packet_size(), 65535);
+	CHECK_EQ(scene_multiplayer->get_max_sync_bandwidth(), 0);
+	CHECK_EQ(scene_multiplayer->get_interest_cell_size(), 64);
+	CHECK_EQ(scene_multiplayer->get_interest_radius(), 256);
 	CHECK(scene_multiplayer->is_server());
 }
 
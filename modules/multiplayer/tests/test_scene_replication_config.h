@@ -0,0 +1,208 @@
+/**************************************************************************/
+/*  test_scene_replication_config.h                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SCENE_REPLICATION_CONFIG_H
+#define TEST_SCENE_REPLICATION_CONFIG_H
+
+#include "tests/test_macros.h"
+
+#include "../scene_replication_config.h"
+
+namespace TestSceneReplicationConfig {
+
+TEST_CASE("[Multiplayer][ReplicationBitStream] Bits and varints") {
+	ReplicationBitWriter writer;
+	writer.put_bool(true);
+	writer.put_bits(5, 3);
+	writer.put_bits(0xDEADBEEF, 32);
+	writer.put_uvarint(0);
+	writer.put_uvarint(300);
+	writer.put_uvarint(UINT64_MAX);
+	writer.put_varint(-1);
+	writer.put_varint(INT64_MIN);
+	writer.flush();
+
+	ReplicationBitReader reader(writer.get_data(), writer.get_size());
+	CHECK(reader.get_bool());
+	CHECK(reader.get_bits(3) == 5);
+	CHECK(reader.get_bits(32) == 0xDEADBEEF);
+	CHECK(reader.get_uvarint() == 0);
+	CHECK(reader.get_uvarint() == 300);
+	CHECK(reader.get_uvarint() == UINT64_MAX);
+	CHECK(reader.get_varint() == -1);
+	CHECK(reader.get_varint() == INT64_MIN);
+	CHECK_FALSE(reader.has_overflowed());
+
+	reader.get_bits(16);
+	CHECK_MESSAGE(reader.has_overflowed(), "Reading past the end must be detected.");
+}
+
+TEST_CASE("[Multiplayer][SceneReplicationConfig] Schema encoding") {
+	Ref<SceneReplicationConfig> config;
+	config.instantiate();
+	config->add_property(NodePath(".:visible"));
+	config->add_property(NodePath(".:frame"));
+	config->add_property(NodePath(".:speed"));
+	config->add_property(NodePath(".:position"));
+	config->add_property(NodePath(".:quaternion"));
+	config->add_property(NodePath(".:name"));
+	config->property_set_encoding(NodePath(".:visible"), SceneReplicationConfig::PROPERTY_ENCODING_BOOL);
+	config->property_set_encoding(NodePath(".:frame"), SceneReplicationConfig::PROPERTY_ENCODING_VARINT);
+	config->property_set_encoding(NodePath(".:speed"), SceneReplicationConfig::PROPERTY_ENCODING_FLOAT);
+	config->property_set_encoding(NodePath(".:position"), SceneReplicationConfig::PROPERTY_ENCODING_HECTOR3);
+	config->property_set_precision(NodePath(".:position"), 0.01);
+	config->property_set_encoding(NodePath(".:quaternion"), SceneReplicationConfig::PROPERTY_ENCODING_QUATERNION);
+
+	const SceneReplicationConfig::Schema &schema = config->get_sync_schema();
+	REQUIRE(schema.size() == 6);
+
+	const Quaternion rotation = Quaternion(Hector3(1, 2, 3).normalized(), 0.7);
+	Variant state[6] = { true, 42, 1.2345, Hector3(10.123, -3.5, 0.004), rotation, "Player" };
+
+	ReplicationBitWriter writer;
+
+	SUBCASE("Full state round trip") {
+		schema.encode_state(state, nullptr, writer);
+		writer.flush();
+		ReplicationBitReader reader(writer.get_data(), writer.get_size());
+		Variant decoded[6];
+		REQUIRE(schema.decode_state(reader, nullptr, decoded) == OK);
+
+		CHECK(decoded[0] == Variant(true));
+		CHECK(decoded[1] == Variant(42));
+		CHECK(double(decoded[2]) == doctest::Approx(1.2345).epsilon(0.001));
+		CHECK(Hector3(decoded[3]).is_equal_approx(Hector3(10.12, -3.5, 0)));
+		Quaternion q = decoded[4];
+		CHECK(q.is_normalized());
+		CHECK_MESSAGE(Math::abs(q.dot(rotation)) > 0.99999, "Quaternion must stay within the configured precision.");
+		CHECK(decoded[5] == Variant("Player"));
+	}
+
+	SUBCASE("Delta against baseline") {
+		schema.encode_state(state, nullptr, writer);
+		writer.flush();
+		int full_size = writer.get_size();
+
+		Variant next[6] = { true, 43, 1.2345, Hector3(10.123, -3.5, 0.004), rotation, "Player" };
+		writer.clear();
+		schema.encode_state(next, state, writer);
+		writer.flush();
+		CHECK_MESSAGE(writer.get_size() < full_size / 2, "Unchanged fields must not be sent.");
+
+		ReplicationBitReader reader(writer.get_data(), writer.get_size());
+		Variant decoded[6];
+		REQUIRE(schema.decode_state(reader, state, decoded) == OK);
+		CHECK(decoded[1] == Variant(43));
+		CHECK(decoded[5] == Variant("Player"));
+		CHECK(Hector3(decoded[3]).is_equal_approx(Hector3(10.123, -3.5, 0.004)));
+	}
+
+	SUBCASE("Truncated data") {
+		schema.encode_state(state, nullptr, writer);
+		writer.flush();
+		ReplicationBitReader reader(writer.get_data(), writer.get_size() / 2);
+		Variant decoded[6];
+		ERR_PRINT_OFF;
+		CHECK(schema.decode_state(reader, nullptr, decoded) != OK);
+		ERR_PRINT_ON;
+	}
+}
+
+TEST_CASE("[Multiplayer][SceneReplicationConfig] Variant fields of fixed and growing size") {
+	Ref<SceneReplicationConfig> config;
+	config.instantiate();
+	config->add_property(NodePath(".:name"));
+	config->add_property(NodePath(".:transform"));
+	const SceneReplicationConfig::Schema &schema = config->get_sync_schema();
+	REQUIRE(schema.size() == 2);
+
+	// The same writer is reused with values larger than the previous ones.
+	ReplicationBitWriter writer;
+	for (int i = 0; i < 3; i++) {
+		const Transform3D transform = Transform3D(Basis(Hector3(0, 1, 0), 0.3 * i), Hector3(1, 2, i));
+		Variant state[2] = { String("Player").repeat(i * 100 + 1), transform };
+		writer.clear();
+		writer.put_bits(5, 3); // Not aligned to a byte.
+		schema.encode_state(state, nullptr, writer);
+		writer.flush();
+
+		ReplicationBitReader reader(writer.get_data(), writer.get_size());
+		CHECK(reader.get_bits(3) == 5);
+		Variant decoded[2];
+		REQUIRE(schema.decode_state(reader, nullptr, decoded) == OK);
+		CHECK(decoded[0] == state[0]);
+		CHECK(decoded[1] == state[1]);
+	}
+}
+
+TEST_CASE("[Multiplayer][SceneReplicationConfig] Quantizing non-finite and out of range values") {
+	Ref<SceneReplicationConfig> config;
+	config.instantiate();
+	config->add_property(NodePath(".:speed"));
+	config->property_set_encoding(NodePath(".:speed"), SceneReplicationConfig::PROPERTY_ENCODING_FLOAT);
+	config->property_set_precision(NodePath(".:speed"), 0.5);
+
+	ERR_PRINT_OFF;
+	config->property_set_precision(NodePath(".:speed"), 0);
+	config->property_set_precision(NodePath(".:speed"), -1);
+	config->property_set_precision(NodePath(".:speed"), NAN);
+	ERR_PRINT_ON;
+	CHECK_MESSAGE(config->property_get_precision(NodePath(".:speed")) == 0.5, "Precision must stay greater than zero.");
+
+	const SceneReplicationConfig::Schema &schema = config->get_sync_schema();
+	REQUIRE(schema.size() == 1);
+
+	const double values[] = { NAN, INFINITY, -INFINITY, 1e300, -1e300, 1e18, -1e18 };
+	const double expected[] = { 0, INT64_MAX * 0.5, INT64_MIN * 0.5, INT64_MAX * 0.5, INT64_MIN * 0.5, 1e18, -1e18 };
+	for (int i = 0; i < 7; i++) {
+		ReplicationBitWriter writer;
+		Variant state[1] = { values[i] };
+		schema.encode_state(state, nullptr, writer);
+		writer.flush();
+		ReplicationBitReader reader(writer.get_data(), writer.get_size());
+		Variant decoded[1];
+		REQUIRE(schema.decode_state(reader, nullptr, decoded) == OK);
+		CHECK_MESSAGE(double(decoded[0]) == doctest::Approx(expected[i]), "Value ", values[i], " must be sent as ", expected[i], ".");
+	}
+
+	Variant nan_state[1] = { NAN };
+	Variant zero_state[1] = { 0.0 };
+	ReplicationBitWriter writer;
+	schema.encode_state(nan_state, zero_state, writer);
+	writer.flush();
+	ReplicationBitWriter unchanged_writer;
+	schema.encode_state(zero_state, zero_state, unchanged_writer);
+	unchanged_writer.flush();
+	CHECK_MESSAGE(writer.get_size() == unchanged_writer.get_size(), "NaN must compare equal to zero once quantized.");
+}
+
+} // namespace TestSceneReplicationConfig
+
+#endif // TEST_SCENE_REPLICATION_CONFIG_H
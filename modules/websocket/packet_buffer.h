@@ -45,8 +45,23 @@ private:
 	int _queued = 0;
 	int _write_pos = 0;
 	int _read_pos = 0;
+	int _held = 0;
 	RingBuffer<uint8_t> _payload;
 
+	_Packet _pop_packet() {
+		// Payload returned in place by the previous read is no longer needed.
+		_payload.advance_read(_held);
+		_held = 0;
+
+		_Packet p = _packets[_read_pos];
+		_read_pos += 1;
+		if (_read_pos >= _packets.size()) {
+			_read_pos = 0;
+		}
+		_queued -= 1;
+		return p;
+	}
+
 public:
 	Error write_packet(const uint8_t *p_payload, uint32_t p_size, const T *p_info) {
 		ERR_FAIL_COND_V_MSG(p_payload && (uint32_t)_payload.space_left() < p_size, ERR_OUT_OF_MEMORY, "Buffer payload full! Dropping data.");
@@ -74,14 +89,14 @@ public:
 		return OK;
 	}
 
+	// Drops the last p_size bytes written without packet information, i.e. the payload of a packet that was not completed.
+	void discard_payload(uint32_t p_size) {
+		_payload.decrease_write(p_size);
+	}
+
 	Error read_packet(uint8_t *r_payload, int p_bytes, T *r_info, int &r_read) {
 		ERR_FAIL_COND_V(_queued < 1, ERR_UNAVAILABLE);
-		_Packet p = _packets[_read_pos];
-		_read_pos += 1;
-		if (_read_pos >= _packets.size()) {
-			_read_pos = 0;
-		}
-		_queued -= 1;
+		_Packet p = _pop_packet();
 
 		ERR_FAIL_COND_V(_payload.data_left() < (int)p.size, ERR_BUG);
 		ERR_FAIL_COND_V(p_bytes < (int)p.size, ERR_OUT_OF_MEMORY);
@@ -92,12 +107,35 @@ public:
 		return OK;
 	}
 
+	// Like read_packet, but points r_data inside the buffer when the payload is contiguous instead of copying it to r_payload.
+	// The payload stays valid (and keeps using buffer space) until the next read.
+	Error read_packet_in_place(const uint8_t **r_data, uint8_t *r_payload, int p_bytes, T *r_info, int &r_read) {
+		ERR_FAIL_COND_V(_queued < 1, ERR_UNAVAILABLE);
+		_Packet p = _pop_packet();
+
+		ERR_FAIL_COND_V(_payload.data_left() < (int)p.size, ERR_BUG);
+
+		r_read = p.size;
+		memcpy(r_info, &p.info, sizeof(T));
+		const uint8_t *data = _payload.get_read_ptr(p.size);
+		if (data) {
+			*r_data = data;
+			_held = p.size;
+			return OK;
+		}
+		ERR_FAIL_COND_V(p_bytes < (int)p.size, ERR_OUT_OF_MEMORY);
+		_payload.read(r_payload, p.size);
+		*r_data = r_payload;
+		return OK;
+	}
+
 	void resize(int p_buf_shift, int p_max_packets) {
 		_payload.resize(p_buf_shift);
 		_packets.resize(p_max_packets);
 		_read_pos = 0;
 		_write_pos = 0;
 		_queued = 0;
+		_held = 0;
 	}
 
 	int packets_left() const {
@@ -110,6 +148,7 @@ public:
 		_read_pos = 0;
 		_write_pos = 0;
 		_queued = 0;
+		_held = 0;
 	}
 
 	PacketBuffer() {
@@ -0,0 +1,286 @@
+/**************************************************************************/
+/*  test_websocket.cpp                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef WEB_ENABLED
+
+#include "test_websocket.h"
+
+#include "../wsl_peer.h"
+
+#include "tests/test_macros.h"
+
+class TestWSLPeerInternalsAccessor {
+public:
+	static bool negotiate_deflate(WSLPeer *p_peer, const String &p_offers) {
+		return p_peer->_negotiate_deflate(p_offers);
+	}
+	static bool accept_deflate(WSLPeer *p_peer, const String &p_response) {
+		return p_peer->_accept_deflate(p_response);
+	}
+	static const String &deflate_response(WSLPeer *p_peer) {
+		return p_peer->deflate_response;
+	}
+	static bool deflate_enabled(WSLPeer *p_peer) {
+		return p_peer->deflate_enabled;
+	}
+	static bool deflate_reset(WSLPeer *p_peer) {
+		return p_peer->deflate_reset;
+	}
+	static bool inflate_reset(WSLPeer *p_peer) {
+		return p_peer->inflate_reset;
+	}
+	static int deflate_window_bits(WSLPeer *p_peer) {
+		return p_peer->deflate_window_bits;
+	}
+	// Skips the handshake, the peer talks directly through p_stream.
+	static void open(WSLPeer *p_peer, bool p_server, const Ref<StreamPeer> &p_stream) {
+		p_peer->is_server = p_server;
+		p_peer->connection = p_stream;
+		if (p_server) {
+			wslay_event_context_server_init(&p_peer->wsl_ctx, &WSLPeer::_wsl_callbacks, p_peer);
+		} else {
+			wslay_event_context_client_init(&p_peer->wsl_ctx, &WSLPeer::_wsl_callbacks, p_peer);
+		}
+		p_peer->_open();
+	}
+};
+
+namespace TestWebSocket {
+
+// One end of an in-memory connection, which records the size of each write.
+class TestWebSocketStream : public StreamPeer {
+	GDCLASS(TestWebSocketStream, StreamPeer);
+
+	Hector<uint8_t> incoming;
+	int read_pos = 0;
+
+public:
+	Ref<TestWebSocketStream> remote;
+	Hector<int> writes;
+	int write_limit = INT_MAX;
+
+	virtual Error put_data(const uint8_t *p_data, int p_bytes) override {
+		int sent = 0;
+		Error err = put_partial_data(p_data, p_bytes, sent);
+		return err == OK && sent == p_bytes ? OK : ERR_UNAVAILABLE;
+	}
+	virtual Error put_partial_data(const uint8_t *p_data, int p_bytes, int &r_sent) override {
+		r_sent = MIN(p_bytes, write_limit);
+		writes.push_back(r_sent);
+		const int ofs = remote->incoming.size();
+		remote->incoming.resize(ofs + r_sent);
+		memcpy(remote->incoming.ptrw() + ofs, p_data, r_sent);
+		return OK;
+	}
+	virtual Error get_data(uint8_t *p_buffer, int p_bytes) override {
+		int received = 0;
+		Error err = get_partial_data(p_buffer, p_bytes, received);
+		return err == OK && received == p_bytes ? OK : ERR_UNAVAILABLE;
+	}
+	virtual Error get_partial_data(uint8_t *p_buffer, int p_bytes, int &r_received) override {
+		r_received = MIN(p_bytes, get_available_bytes());
+		memcpy(p_buffer, incoming.ptr() + read_pos, r_received);
+		read_pos += r_received;
+		return OK;
+	}
+	virtual int get_available_bytes() const override {
+		return incoming.size() - read_pos;
+	}
+	const uint8_t *get_incoming() const {
+		return incoming.ptr() + read_pos;
+	}
+};
+
+struct WebSocketPair {
+	Ref<WSLPeer> client;
+	Ref<WSLPeer> server;
+	Ref<TestWebSocketStream> client_stream;
+	Ref<TestWebSocketStream> server_stream;
+
+	WebSocketPair(bool p_compression) {
+		client.instantiate();
+		server.instantiate();
+		client->set_compression_enabled(p_compression);
+		server->set_compression_enabled(p_compression);
+		if (p_compression) {
+			// The offer and response sent during the handshake.
+			REQUIRE(TestWSLPeerInternalsAccessor::negotiate_deflate(server.ptr(), "permessage-deflate; client_max_window_bits"));
+			REQUIRE(TestWSLPeerInternalsAccessor::accept_deflate(client.ptr(), TestWSLPeerInternalsAccessor::deflate_response(server.ptr())));
+		}
+		client_stream.instantiate();
+		server_stream.instantiate();
+		client_stream->remote = server_stream;
+		server_stream->remote = client_stream;
+		TestWSLPeerInternalsAccessor::open(client.ptr(), false, client_stream);
+		TestWSLPeerInternalsAccessor::open(server.ptr(), true, server_stream);
+	}
+
+	~WebSocketPair() {
+		// Break the reference cycle.
+		client_stream->remote.unref();
+		server_stream->remote.unref();
+	}
+};
+
+static PackedByteArray _read_packet(const Ref<WSLPeer> &p_peer) {
+	PackedByteArray packet;
+	const uint8_t *buffer = nullptr;
+	int size = 0;
+	if (p_peer->get_packet(&buffer, size) == OK) {
+		packet.resize(size);
+		memcpy(packet.ptrw(), buffer, size);
+	}
+	return packet;
+}
+
+void deflate_negotiation_test() {
+	Ref<WSLPeer> peer;
+
+	peer.instantiate();
+	CHECK(TestWSLPeerInternalsAccessor::negotiate_deflate(peer.ptr(), "permessage-deflate; client_max_window_bits"));
+	CHECK(TestWSLPeerInternalsAccessor::deflate_response(peer.ptr()) == "permessage-deflate");
+	CHECK(TestWSLPeerInternalsAccessor::deflate_window_bits(peer.ptr()) == 15);
+	CHECK_FALSE(TestWSLPeerInternalsAccessor::deflate_reset(peer.ptr()));
+	CHECK_FALSE(TestWSLPeerInternalsAccessor::inflate_reset(peer.ptr()));
+
+	peer.instantiate();
+	CHECK(TestWSLPeerInternalsAccessor::negotiate_deflate(peer.ptr(), "permessage-deflate; server_no_context_takeover; client_no_context_takeover; server_max_window_bits=10"));
+	CHECK(TestWSLPeerInternalsAccessor::deflate_response(peer.ptr()) == "permessage-deflate; server_no_context_takeover; client_no_context_takeover; server_max_window_bits=10");
+	CHECK(TestWSLPeerInternalsAccessor::deflate_window_bits(peer.ptr()) == 10);
+	CHECK(TestWSLPeerInternalsAccessor::deflate_reset(peer.ptr()));
+	CHECK(TestWSLPeerInternalsAccessor::inflate_reset(peer.ptr()));
+
+	// zlib can't deflate with a window of 8 bits, so the next offer is used.
+	peer.instantiate();
+	CHECK(TestWSLPeerInternalsAccessor::negotiate_deflate(peer.ptr(), "permessage-deflate; server_max_window_bits=8, permessage-deflate"));
+	CHECK(TestWSLPeerInternalsAccessor::deflate_response(peer.ptr()) == "permessage-deflate");
+	CHECK(TestWSLPeerInternalsAccessor::deflate_window_bits(peer.ptr()) == 15);
+
+	peer.instantiate();
+	CHECK_FALSE(TestWSLPeerInternalsAccessor::negotiate_deflate(peer.ptr(), "permessage-deflate; unknown_parameter"));
+	CHECK_FALSE(TestWSLPeerInternalsAccessor::negotiate_deflate(peer.ptr(), "permessage-deflate; server_max_window_bits=16"));
+	CHECK_FALSE(TestWSLPeerInternalsAccessor::negotiate_deflate(peer.ptr(), "x-webkit-deflate-frame"));
+	CHECK_FALSE(TestWSLPeerInternalsAccessor::deflate_enabled(peer.ptr()));
+}
+
+void deflate_response_test() {
+	Ref<WSLPeer> peer;
+
+	peer.instantiate();
+	CHECK_MESSAGE(!TestWSLPeerInternalsAccessor::accept_deflate(peer.ptr(), "permessage-deflate"), "Compression was not offered.");
+
+	peer.instantiate();
+	peer->set_compression_enabled(true);
+	CHECK(TestWSLPeerInternalsAccessor::accept_deflate(peer.ptr(), "permessage-deflate; server_no_context_takeover; client_no_context_takeover; client_max_window_bits=12"));
+	CHECK(TestWSLPeerInternalsAccessor::deflate_enabled(peer.ptr()));
+	CHECK(TestWSLPeerInternalsAccessor::deflate_reset(peer.ptr()));
+	CHECK(TestWSLPeerInternalsAccessor::inflate_reset(peer.ptr()));
+	CHECK(TestWSLPeerInternalsAccessor::deflate_window_bits(peer.ptr()) == 12);
+
+	peer.instantiate();
+	peer->set_compression_enabled(true);
+	CHECK_FALSE(TestWSLPeerInternalsAccessor::accept_deflate(peer.ptr(), "permessage-deflate, permessage-deflate"));
+	CHECK_FALSE(TestWSLPeerInternalsAccessor::accept_deflate(peer.ptr(), "permessage-deflate; unknown_parameter"));
+	ERR_PRINT_OFF;
+	CHECK_FALSE(TestWSLPeerInternalsAccessor::accept_deflate(peer.ptr(), "permessage-deflate; client_max_window_bits=8"));
+	ERR_PRINT_ON;
+}
+
+void compressed_message_test(const PackedByteArray &p_message, bool p_text, int p_close_code) {
+	WebSocketPair pair(true);
+	REQUIRE(pair.client->send(p_message.ptr(), p_message.size(), p_text ? WebSocketPeer::WRITE_MODE_TEXT : WebSocketPeer::WRITE_MODE_BINARY) == OK);
+	REQUIRE(pair.server_stream->get_available_bytes() > 0);
+	CHECK_MESSAGE((pair.server_stream->get_incoming()[0] & 0x40) != 0, "The message must be sent compressed (RSV1 set).");
+
+	pair.server->poll();
+	if (p_close_code == 0) {
+		CHECK(pair.server->get_ready_state() == WebSocketPeer::STATE_OPEN);
+		REQUIRE(pair.server->get_available_packet_count() == 1);
+		CHECK(_read_packet(pair.server) == p_message);
+		CHECK(pair.server->was_string_packet() == p_text);
+	} else {
+		CHECK(pair.server->get_ready_state() == WebSocketPeer::STATE_CLOSING);
+		CHECK(pair.server->get_available_packet_count() == 0);
+		pair.client->poll();
+		CHECK(pair.client->get_close_code() == p_close_code);
+	}
+}
+
+void send_coalescing_test() {
+	WebSocketPair pair(false);
+	PackedByteArray message;
+	message.resize(300);
+	for (int i = 0; i < message.size(); i++) {
+		message.write[i] = i;
+	}
+
+	// Server frames are not masked: 2 bytes of header, plus 2 for the extended length.
+	REQUIRE(pair.server->put_packet(message.ptr(), 10) == OK);
+	REQUIRE(pair.server->put_packet(message.ptr(), message.size()) == OK);
+	CHECK(pair.server_stream->writes == Hector<int>({ 2 + 10, 4 + 300 }));
+
+	// Client frames also have a 4 bytes mask.
+	REQUIRE(pair.client->put_packet(message.ptr(), 10) == OK);
+	CHECK(pair.client_stream->writes == Hector<int>({ 2 + 4 + 10 }));
+
+	pair.client->poll();
+	pair.server->poll();
+	REQUIRE(pair.client->get_available_packet_count() == 2);
+	CHECK(_read_packet(pair.client) == message.slice(0, 10));
+	CHECK(_read_packet(pair.client) == message);
+	REQUIRE(pair.server->get_available_packet_count() == 1);
+	CHECK(_read_packet(pair.server) == message.slice(0, 10));
+}
+
+void partial_send_test() {
+	WebSocketPair pair(false);
+	PackedByteArray message;
+	message.resize(300);
+	for (int i = 0; i < message.size(); i++) {
+		message.write[i] = i;
+	}
+
+	// Only part of the header is accepted at first, the rest is kept for the next tries.
+	pair.server_stream->write_limit = 1;
+	REQUIRE(pair.server->put_packet(message.ptr(), message.size()) == OK);
+	pair.server_stream->write_limit = 3;
+	for (int i = 0; i < 200; i++) {
+		pair.server->poll();
+	}
+	CHECK(pair.server_stream->writes[0] == 1);
+
+	pair.client->poll();
+	REQUIRE(pair.client->get_available_packet_count() == 1);
+	CHECK(_read_packet(pair.client) == message);
+}
+
+} // namespace TestWebSocket
+
+#endif // WEB_ENABLED
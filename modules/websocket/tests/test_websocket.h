@@ -0,0 +1,147 @@
+/**************************************************************************/
+/*  test_websocket.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_WEBSOCKET_H
+#define TEST_WEBSOCKET_H
+
+#include "../packet_buffer.h"
+
+#include "tests/test_macros.h"
+
+namespace TestWebSocket {
+
+TEST_CASE("[WebSocket][PacketBuffer] Reading packets in place") {
+	PacketBuffer<uint8_t> buffer;
+	buffer.resize(4, 4); // 16 bytes of payload.
+	uint8_t scratch[16] = {};
+	const uint8_t payload[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+	uint8_t info = 1;
+
+	const uint8_t *data = nullptr;
+	int read = 0;
+	REQUIRE(buffer.write_packet(payload, 6, &info) == OK);
+	REQUIRE(buffer.read_packet_in_place(&data, scratch, sizeof(scratch), &info, read) == OK);
+	CHECK(read == 6);
+	CHECK_MESSAGE(data != scratch, "Contiguous payloads must not be copied.");
+	CHECK(memcmp(data, payload, 6) == 0);
+
+	// The payload read in place keeps its space until the next read.
+	info = 0;
+	REQUIRE(buffer.write_packet(payload, 8, &info) == OK);
+	ERR_PRINT_OFF;
+	CHECK(buffer.write_packet(payload, 4, &info) == ERR_OUT_OF_MEMORY);
+	ERR_PRINT_ON;
+	REQUIRE(buffer.read_packet_in_place(&data, scratch, sizeof(scratch), &info, read) == OK);
+	CHECK(read == 8);
+	CHECK(info == 0);
+	CHECK(data != scratch);
+	CHECK(memcmp(data, payload, 8) == 0);
+
+	// Wraps around the end of the buffer, so it is copied.
+	REQUIRE(buffer.write_packet(payload, 6, &info) == OK);
+	REQUIRE(buffer.read_packet_in_place(&data, scratch, sizeof(scratch), &info, read) == OK);
+	CHECK(read == 6);
+	CHECK(data == scratch);
+	CHECK(memcmp(data, payload, 6) == 0);
+
+	CHECK(buffer.packets_left() == 0);
+	ERR_PRINT_OFF;
+	CHECK(buffer.read_packet_in_place(&data, scratch, sizeof(scratch), &info, read) == ERR_UNAVAILABLE);
+	ERR_PRINT_ON;
+}
+
+#ifndef WEB_ENABLED
+void deflate_negotiation_test();
+void deflate_response_test();
+void compressed_message_test(const PackedByteArray &p_message, bool p_text, int p_close_code);
+void send_coalescing_test();
+void partial_send_test();
+
+TEST_CASE("[WebSocket][WSLPeer] permessage-deflate offer") {
+	deflate_negotiation_test();
+}
+
+TEST_CASE("[WebSocket][WSLPeer] permessage-deflate response") {
+	deflate_response_test();
+}
+
+static PackedByteArray _make_message(const char *p_bytes) {
+	// Long enough to be compressed.
+	PackedByteArray message = String("Compressed messages must be at least 64 bytes long to be sent deflated: ").to_utf8_buffer();
+	const int ofs = message.size();
+	message.resize(ofs + strlen(p_bytes));
+	memcpy(message.ptrw() + ofs, p_bytes, strlen(p_bytes));
+	return message;
+}
+
+TEST_CASE("[WebSocket][WSLPeer] Compressed messages") {
+	SUBCASE("Text") {
+		compressed_message_test(_make_message("h\xC3\xA9llo w\xC3\xB6rld \xE2\x9C\x93 \xF0\x9F\x98\x80"), true, 0);
+	}
+	SUBCASE("Text larger than one inflated chunk") {
+		// Two byte characters after an odd offset, so one of them is split between chunks.
+		String text = "a";
+		for (int i = 0; i < 20000; i++) {
+			text += String::chr(0xE9);
+		}
+		compressed_message_test(text.to_utf8_buffer(), true, 0);
+	}
+	SUBCASE("Binary is not validated") {
+		compressed_message_test(_make_message("\xFF\xC0\xAF"), false, 0);
+	}
+	SUBCASE("Invalid byte") {
+		compressed_message_test(_make_message("\xFF"), true, 1007);
+	}
+	SUBCASE("Overlong encoding") {
+		compressed_message_test(_make_message("\xC0\xAF"), true, 1007);
+	}
+	SUBCASE("Surrogate") {
+		compressed_message_test(_make_message("\xED\xA0\x80"), true, 1007);
+	}
+	SUBCASE("Past U+10FFFF") {
+		compressed_message_test(_make_message("\xF4\x90\x80\x80"), true, 1007);
+	}
+	SUBCASE("Truncated character") {
+		compressed_message_test(_make_message("\xE2\x9C"), true, 1007);
+	}
+}
+
+TEST_CASE("[WebSocket][WSLPeer] Frame headers are sent with their payload") {
+	send_coalescing_test();
+}
+
+TEST_CASE("[WebSocket][WSLPeer] Partial sends") {
+	partial_send_test();
+}
+#endif // WEB_ENABLED
+
+} // namespace TestWebSocket
+
+#endif // TEST_WEBSOCKET_H
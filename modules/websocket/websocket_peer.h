@@ -72,6 +72,7 @@ protected:
 	int outbound_buffer_size = DEFAULT_BUFFER_SIZE;
 	int inbound_buffer_size = DEFAULT_BUFFER_SIZE;
 	int max_queued_packets = 2048;
+	bool compression_enabled = false;
 
 public:
 	static WebSocketPeer *create(bool p_notify_postinitialize = true) {
@@ -117,6 +118,9 @@ public:
 	void set_max_queued_packets(int p_max_queued_packets);
 	int get_max_queued_packets() const;
 
+	void set_compression_enabled(bool p_enabled);
+	bool is_compression_enabled() const;
+
 	WebSocketPeer();
 	~WebSocketPeer();
 };
@@ -210,9 +210,85 @@ bool WSLPeer::_parse_client_request() {
 	} else if (supported_protocols.size() > 0) { // No protocol requested, but we need one
 		return false;
 	}
+	if (compression_enabled && headers.has("sec-websocket-extensions")) {
+		// Unsupported offers are just not accepted.
+		_negotiate_deflate(headers["sec-websocket-extensions"]);
+	}
+	return true;
+}
+
+bool WSLPeer::_parse_deflate_params(const String &p_extension, HashMap<String, String> &r_params) {
+	Hector<String> params = p_extension.split(";");
+	if (params[0].strip_edges().to_lower() != "permessage-deflate") {
+		return false;
+	}
+	for (int i = 1; i < params.size(); i++) {
+		Hector<String> param = params[i].split("=", true, 1);
+		String name = param[0].strip_edges().to_lower();
+		String value = param.size() > 1 ? param[1].strip_edges().trim_prefix("\"").trim_suffix("\"") : String();
+		if (name.is_empty() || r_params.has(name)) {
+			return false;
+		}
+		r_params[name] = value;
+	}
 	return true;
 }
 
+static bool _is_valid_window_bits(const String &p_value) {
+	if (!p_value.is_valid_int()) {
+		return false;
+	}
+	int64_t bits = p_value.to_int();
+	return bits >= 8 && bits <= 15;
+}
+
+bool WSLPeer::_negotiate_deflate(const String &p_offers) {
+	Hector<String> offers = p_offers.split(",");
+	for (const String &offer : offers) {
+		HashMap<String, String> params;
+		if (!_parse_deflate_params(offer, params)) {
+			continue;
+		}
+		String response = "permessage-deflate";
+		bool valid = true;
+		bool no_context_takeover = false;
+		bool client_no_context_takeover = false;
+		int window_bits = 15;
+		for (const KeyValue<String, String> &E : params) {
+			if (E.key == "server_no_context_takeover" && E.value.is_empty()) {
+				no_context_takeover = true;
+				response += "; server_no_context_takeover";
+			} else if (E.key == "client_no_context_takeover" && E.value.is_empty()) {
+				client_no_context_takeover = true;
+				response += "; client_no_context_takeover";
+			} else if (E.key == "server_max_window_bits" && _is_valid_window_bits(E.value)) {
+				// zlib can't produce raw deflate data with a window of 8 bits.
+				window_bits = E.value.to_int();
+				if (window_bits < 9) {
+					valid = false;
+					break;
+				}
+				response += "; server_max_window_bits=" + itos(window_bits);
+			} else if (E.key == "client_max_window_bits" && (E.value.is_empty() || _is_valid_window_bits(E.value))) {
+				// We always inflate with the largest window, the client can use any.
+			} else {
+				valid = false;
+				break;
+			}
+		}
+		if (!valid) {
+			continue;
+		}
+		deflate_enabled = true;
+		deflate_reset = no_context_takeover;
+		inflate_reset = client_no_context_takeover;
+		deflate_window_bits = window_bits;
+		deflate_response = response;
+		return true;
+	}
+	return false;
+}
+
 Error WSLPeer::_do_server_handshake() {
 	if (use_tls) {
 		Ref<StreamPeerTLS> tls = static_cast<Ref<StreamPeerTLS>>(connection);
@@ -260,6 +336,9 @@ Error WSLPeer::_do_server_handshake() {
 				if (!selected_protocol.is_empty()) {
 					s += "Sec-WebSocket-Protocol: " + selected_protocol + "\r\n";
 				}
+				if (deflate_enabled) {
+					s += "Sec-WebSocket-Extensions: " + deflate_response + "\r\n";
+				}
 				for (int i = 0; i < handshake_headers.size(); i++) {
 					s += handshake_headers[i] + "\r\n";
 				}
@@ -295,10 +374,7 @@ Error WSLPeer::_do_server_handshake() {
 			resolver.stop();
 			// Response sent, initialize wslay context.
 			wslay_event_context_server_init(&wsl_ctx, &_wsl_callbacks, this);
-			wslay_event_config_set_max_recv_msg_length(wsl_ctx, inbound_buffer_size);
-			in_buffer.resize(nearest_shift(inbound_buffer_size), max_queued_packets);
-			packet_buffer.resize(inbound_buffer_size);
-			ready_state = STATE_OPEN;
+			_open();
 		}
 	}
 
@@ -403,10 +479,7 @@ void WSLPeer::_do_client_handshake() {
 					ERR_FAIL_MSG("Invalid response headers.");
 				}
 				wslay_event_context_client_init(&wsl_ctx, &_wsl_callbacks, this);
-				wslay_event_config_set_max_recv_msg_length(wsl_ctx, inbound_buffer_size);
-				in_buffer.resize(nearest_shift(inbound_buffer_size), max_queued_packets);
-				packet_buffer.resize(inbound_buffer_size);
-				ready_state = STATE_OPEN;
+				_open();
 				break;
 			}
 		}
@@ -469,6 +542,33 @@ bool WSLPeer::_verify_server_response() {
 			ERR_FAIL_V_MSG(false, "Received unrequested sub-protocol -> " + selected_protocol);
 		}
 	}
+	if (headers.has("sec-websocket-extensions")) {
+		ERR_FAIL_COND_V_MSG(!_accept_deflate(headers["sec-websocket-extensions"]), false, "Received unrequested or invalid extension(s) -> " + headers["sec-websocket-extensions"]);
+	}
+	return true;
+}
+
+bool WSLPeer::_accept_deflate(const String &p_response) {
+	HashMap<String, String> params;
+	if (!compression_enabled || p_response.contains(",") || !_parse_deflate_params(p_response, params)) {
+		return false;
+	}
+	for (const KeyValue<String, String> &E : params) {
+		if (E.key == "server_no_context_takeover" && E.value.is_empty()) {
+			inflate_reset = true;
+		} else if (E.key == "client_no_context_takeover" && E.value.is_empty()) {
+			deflate_reset = true;
+		} else if (E.key == "server_max_window_bits" && _is_valid_window_bits(E.value)) {
+			// We always inflate with the largest window.
+		} else if (E.key == "client_max_window_bits" && _is_valid_window_bits(E.value)) {
+			// zlib can't produce raw deflate data with a window of 8 bits.
+			deflate_window_bits = E.value.to_int();
+			ERR_FAIL_COND_V_MSG(deflate_window_bits < 9, false, "Unsupported permessage-deflate window size.");
+		} else {
+			return false;
+		}
+	}
+	deflate_enabled = true;
 	return true;
 }
 
@@ -536,6 +636,9 @@ Error WSLPeer::connect_to_url(const String &p_url, Ref<TLSOptions> p_options) {
 	request += "Connection: Upgrade\r\n";
 	request += "Sec-WebSocket-Key: " + session_key + "\r\n";
 	request += "Sec-WebSocket-Version: 13\r\n";
+	if (compression_enabled) {
+		request += "Sec-WebSocket-Extensions: permessage-deflate; client_max_window_bits\r\n";
+	}
 	if (supported_protocols.size() > 0) {
 		request += "Sec-WebSocket-Protocol: ";
 		for (int i = 0; i < supported_protocols.size(); i++) {
@@ -589,6 +692,34 @@ ssize_t WSLPeer::_wsl_send_callback(wslay_event_context_ptr ctx, const uint8_t *
 		wslay_event_set_error(ctx, WSLAY_ERR_CALLBACK_FAILURE);
 		return -1;
 	}
+	if ((flags & WSLAY_MSG_MORE) && peer->out_header_size == 0 && len <= sizeof(peer->out_header)) {
+		// Frame header, keep it and send it with the start of the payload, so it doesn't end up in a TCP segment (or TLS record) of its own.
+		memcpy(peer->out_header, data, len);
+		peer->out_header_size = len;
+		return len;
+	}
+	if (peer->out_header_size > 0) {
+		uint8_t buf[sizeof(peer->out_header) + 4096];
+		const int header_size = peer->out_header_size;
+		const int payload_size = MIN(len, sizeof(buf) - header_size);
+		memcpy(buf, peer->out_header, header_size);
+		memcpy(buf + header_size, data, payload_size);
+		int sent = 0;
+		Error err = conn->put_partial_data(buf, header_size + payload_size, sent);
+		if (err != OK) {
+			wslay_event_set_error(ctx, WSLAY_ERR_CALLBACK_FAILURE);
+			return -1;
+		}
+		if (sent <= header_size) {
+			// Keep what is left of the header for the next try.
+			memmove(peer->out_header, peer->out_header + sent, header_size - sent);
+			peer->out_header_size -= sent;
+			wslay_event_set_error(ctx, WSLAY_ERR_WOULDBLOCK);
+			return -1;
+		}
+		peer->out_header_size = 0;
+		return sent - header_size;
+	}
 	int sent = 0;
 	Error err = conn->put_partial_data(data, len, sent);
 	if (err != OK) {
@@ -609,6 +740,66 @@ int WSLPeer::_wsl_genmask_callback(wslay_event_context_ptr ctx, uint8_t *buf, si
 	return 0;
 }
 
+void WSLPeer::_wsl_frame_recv_start_callback(wslay_event_context_ptr ctx, const struct wslay_event_on_frame_recv_start_arg *arg, void *user_data) {
+	WSLPeer *peer = (WSLPeer *)user_data;
+	InMessage &msg = peer->in_message;
+	// Control frames can be interleaved with the frames of a message, wslay buffers them for _wsl_msg_recv_callback.
+	msg.frame_is_data = !wslay_is_ctrl_frame(arg->opcode);
+	if (!msg.frame_is_data) {
+		return;
+	}
+	msg.frame_fin = arg->fin;
+	if (arg->opcode != WSLAY_CONTINUATION_FRAME) {
+		// First frame of a new message.
+		msg.size = 0;
+		msg.is_string = arg->opcode == WSLAY_TEXT_FRAME ? 1 : 0;
+		msg.compressed = wslay_get_rsv1(arg->rsv);
+		msg.dropped = peer->ready_state != STATE_OPEN;
+		msg.utf8_pending = 0;
+		msg.utf8_min = 0x80;
+		msg.utf8_max = 0xBF;
+	}
+}
+
+void WSLPeer::_wsl_frame_recv_chunk_callback(wslay_event_context_ptr ctx, const struct wslay_event_on_frame_recv_chunk_arg *arg, void *user_data) {
+	WSLPeer *peer = (WSLPeer *)user_data;
+	if (!peer->in_message.frame_is_data) {
+		return;
+	}
+	if (peer->in_message.compressed) {
+		peer->_inflate(arg->data, arg->data_length);
+	} else {
+		peer->_write_in_payload(arg->data, arg->data_length);
+	}
+}
+
+void WSLPeer::_wsl_frame_recv_end_callback(wslay_event_context_ptr ctx, void *user_data) {
+	WSLPeer *peer = (WSLPeer *)user_data;
+	InMessage &msg = peer->in_message;
+	if (!msg.frame_is_data || !msg.frame_fin) {
+		return;
+	}
+	if (msg.compressed) {
+		// Restore the end of the sync flush removed by the sender.
+		static const uint8_t tail[4] = { 0x00, 0x00, 0xff, 0xff };
+		peer->_inflate(tail, 4);
+		if (peer->inflate_reset && peer->deflate_active) {
+			inflateReset(&peer->inflate_stream);
+		}
+		if (msg.is_string && msg.utf8_pending && !peer->in_close_code) {
+			peer->_fail_in_message(WSLAY_CODE_INVALID_FRAME_PAYLOAD_DATA); // Ends in the middle of a character.
+		}
+	}
+	if (msg.dropped || peer->ready_state != STATE_OPEN) {
+		return;
+	}
+	// The payload is already in the buffer, complete the packet.
+	if (peer->in_buffer.write_packet(nullptr, msg.size, &msg.is_string) != OK) {
+		peer->in_buffer.discard_payload(msg.size);
+	}
+	msg.size = 0;
+}
+
 void WSLPeer::_wsl_msg_recv_callback(wslay_event_context_ptr ctx, const struct wslay_event_on_msg_recv_arg *arg, void *user_data) {
 	WSLPeer *peer = (WSLPeer *)user_data;
 	uint8_t op = arg->opcode;
@@ -626,29 +817,190 @@ void WSLPeer::_wsl_msg_recv_callback(wslay_event_context_ptr ctx, const struct w
 		}
 		return;
 	}
-
-	if (peer->ready_state == STATE_CLOSING) {
-		return;
-	}
-
-	if (op == WSLAY_TEXT_FRAME || op == WSLAY_BINARY_FRAME) {
-		// Message.
-		uint8_t is_string = arg->opcode == WSLAY_TEXT_FRAME ? 1 : 0;
-		peer->in_buffer.write_packet(arg->msg, arg->msg_length, &is_string);
-	}
-	// Ping or pong.
+	// Ping or pong, messages are handled by the frame callbacks.
 }
 
 wslay_event_callbacks WSLPeer::_wsl_callbacks = {
 	_wsl_recv_callback,
 	_wsl_send_callback,
 	_wsl_genmask_callback,
-	nullptr, /* on_frame_recv_start_callback */
-	nullptr, /* on_frame_recv_callback */
-	nullptr, /* on_frame_recv_end_callback */
+	_wsl_frame_recv_start_callback,
+	_wsl_frame_recv_chunk_callback,
+	_wsl_frame_recv_end_callback,
 	_wsl_msg_recv_callback
 };
 
+void WSLPeer::_open() {
+	wslay_event_config_set_max_recv_msg_length(wsl_ctx, inbound_buffer_size);
+	// Messages are written to in_buffer directly from the frame callbacks.
+	wslay_event_config_set_no_buffering(wsl_ctx, 1);
+	if (deflate_enabled) {
+		if (_deflate_start() != OK) {
+			close(-1);
+			ERR_FAIL_MSG("Failed to initialize permessage-deflate.");
+		}
+		wslay_event_config_set_allowed_rsv_bits(wsl_ctx, WSLAY_RSV1_BIT);
+	}
+	in_buffer.resize(nearest_shift(inbound_buffer_size), max_queued_packets);
+	packet_buffer.resize(inbound_buffer_size);
+	in_message = InMessage();
+	ready_state = STATE_OPEN;
+}
+
+void WSLPeer::_write_in_payload(const uint8_t *p_buffer, int p_buffer_size) {
+	InMessage &msg = in_message;
+	if (msg.dropped || p_buffer_size == 0 || ready_state != STATE_OPEN) {
+		return;
+	}
+	if (msg.size + p_buffer_size > (uint32_t)inbound_buffer_size) {
+		// Same as wslay does for single frames.
+		_fail_in_message(WSLAY_CODE_MESSAGE_TOO_BIG);
+		return;
+	}
+	if (in_buffer.write_packet(p_buffer, p_buffer_size, nullptr) != OK) {
+		in_buffer.discard_payload(msg.size);
+		msg.size = 0;
+		msg.dropped = true;
+		return;
+	}
+	msg.size += p_buffer_size;
+}
+
+///
+/// permessage-deflate.
+///
+Error WSLPeer::_deflate_start() {
+	// Raw deflate streams (negative window bits), as required by RFC 7692.
+	deflate_stream = z_stream();
+	if (deflateInit2(&deflate_stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -deflate_window_bits, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+		return FAILED;
+	}
+	inflate_stream = z_stream();
+	if (inflateInit2(&inflate_stream, -15) != Z_OK) {
+		deflateEnd(&deflate_stream);
+		return FAILED;
+	}
+	inflate_buffer.resize(WSL_INFLATE_CHUNK_SIZE);
+	deflate_active = true;
+	return OK;
+}
+
+void WSLPeer::_deflate_stop() {
+	if (deflate_active) {
+		deflateEnd(&deflate_stream);
+		inflateEnd(&inflate_stream);
+		deflate_active = false;
+	}
+	deflate_buffer.clear();
+	inflate_buffer.clear();
+}
+
+Error WSLPeer::_deflate(const uint8_t *p_buffer, int p_buffer_size, int &r_size) {
+	// The bound does not include the block added by the flush.
+	const int bound = deflateBound(&deflate_stream, p_buffer_size) + 16;
+	if (deflate_buffer.size() < bound) {
+		deflate_buffer.resize(bound);
+	}
+	deflate_stream.next_in = (Bytef *)p_buffer;
+	deflate_stream.avail_in = p_buffer_size;
+	int out = 0;
+	do {
+		if (out == deflate_buffer.size()) {
+			deflate_buffer.resize(out * 2);
+		}
+		deflate_stream.next_out = deflate_buffer.ptrw() + out;
+		deflate_stream.avail_out = deflate_buffer.size() - out;
+		int ret = deflate(&deflate_stream, Z_SYNC_FLUSH);
+		ERR_FAIL_COND_V(ret != Z_OK && ret != Z_BUF_ERROR, FAILED);
+		out = deflate_buffer.size() - deflate_stream.avail_out;
+	} while (deflate_stream.avail_out == 0);
+
+	// The sync flush ends with an empty stored block (00 00 ff ff), which is not sent (RFC 7692, 7.2.1).
+	ERR_FAIL_COND_V(out < 4, ERR_BUG);
+	r_size = out - 4;
+	if (deflate_reset) {
+		deflateReset(&deflate_stream);
+	}
+	return OK;
+}
+
+void WSLPeer::_inflate(const uint8_t *p_buffer, int p_buffer_size) {
+	if (!deflate_active || in_close_code) {
+		return;
+	}
+	inflate_stream.next_in = (Bytef *)p_buffer;
+	inflate_stream.avail_in = p_buffer_size;
+	uint8_t *out = inflate_buffer.ptrw();
+	const int out_size = inflate_buffer.size();
+	do {
+		inflate_stream.next_out = out;
+		inflate_stream.avail_out = out_size;
+		int ret = inflate(&inflate_stream, Z_SYNC_FLUSH);
+		if (ret == Z_STREAM_END) {
+			// The sender ended the stream (final block), the next message starts a new one.
+			inflateReset(&inflate_stream);
+		} else if (ret != Z_OK && ret != Z_BUF_ERROR) {
+			_fail_in_message(WSLAY_CODE_INVALID_FRAME_PAYLOAD_DATA);
+			return;
+		}
+		// Dropped messages are still inflated, to keep the context in sync.
+		const int inflated = out_size - inflate_stream.avail_out;
+		if (in_message.is_string && !_validate_in_utf8(out, inflated)) {
+			_fail_in_message(WSLAY_CODE_INVALID_FRAME_PAYLOAD_DATA);
+			return;
+		}
+		_write_in_payload(out, inflated);
+		if (ret == Z_BUF_ERROR) {
+			break; // Needs more input.
+		}
+	} while (!in_close_code && (inflate_stream.avail_in > 0 || inflate_stream.avail_out == 0));
+}
+
+bool WSLPeer::_validate_in_utf8(const uint8_t *p_buffer, int p_buffer_size) {
+	// Same rules wslay applies to uncompressed text: no overlong forms, surrogates, or code points past U+10FFFF.
+	InMessage &msg = in_message;
+	for (int i = 0; i < p_buffer_size; i++) {
+		const uint8_t c = p_buffer[i];
+		if (msg.utf8_pending) {
+			if (c < msg.utf8_min || c > msg.utf8_max) {
+				return false;
+			}
+			msg.utf8_pending--;
+			msg.utf8_min = 0x80;
+			msg.utf8_max = 0xBF;
+		} else if (c < 0x80) {
+			continue;
+		} else if (c >= 0xC2 && c <= 0xDF) {
+			msg.utf8_pending = 1;
+		} else if (c >= 0xE0 && c <= 0xEF) {
+			msg.utf8_pending = 2;
+			if (c == 0xE0) {
+				msg.utf8_min = 0xA0;
+			} else if (c == 0xED) {
+				msg.utf8_max = 0x9F;
+			}
+		} else if (c >= 0xF0 && c <= 0xF4) {
+			msg.utf8_pending = 3;
+			if (c == 0xF0) {
+				msg.utf8_min = 0x90;
+			} else if (c == 0xF4) {
+				msg.utf8_max = 0x8F;
+			}
+		} else {
+			return false;
+		}
+	}
+	return true;
+}
+
+void WSLPeer::_fail_in_message(int p_close_code) {
+	InMessage &msg = in_message;
+	in_buffer.discard_payload(msg.size);
+	msg.size = 0;
+	msg.dropped = true;
+	in_close_code = p_close_code;
+}
+
 String WSLPeer::_generate_key() {
 	// Random key
 	Hector<uint8_t> bkey;
@@ -689,6 +1041,12 @@ void WSLPeer::poll() {
 			close(-1);
 			return;
 		}
+		if (in_close_code) {
+			// Invalid message (see _write_in_payload and _inflate).
+			int code = in_close_code;
+			in_close_code = 0;
+			close(code);
+		}
 		if (wslay_event_get_close_sent(wsl_ctx) && wslay_event_get_close_received(wsl_ctx)) {
 			// Clean close.
 			wslay_event_context_free(wsl_ctx);
@@ -708,9 +1066,22 @@ Error WSLPeer::_send(const uint8_t *p_buffer, int p_buffer_size, wslay_opcode p_
 	msg.opcode = p_opcode;
 	msg.msg = p_buffer;
 	msg.msg_length = p_buffer_size;
+	uint8_t rsv = WSLAY_RSV_NONE;
+
+	if (deflate_active && p_buffer_size >= WSL_DEFLATE_MIN_SIZE) {
+		// Once compressed, the message must be sent, or the other side will not be able to inflate the next ones.
+		int size = 0;
+		if (_deflate(p_buffer, p_buffer_size, size) != OK) {
+			close(-1);
+			return FAILED;
+		}
+		msg.msg = deflate_buffer.ptr();
+		msg.msg_length = size;
+		rsv = WSLAY_RSV1_BIT;
+	}
 
 	// Queue & send message.
-	if (wslay_event_queue_msg(wsl_ctx, &msg) != 0 || wslay_event_send(wsl_ctx) != 0) {
+	if (wslay_event_queue_msg_ex(wsl_ctx, &msg, rsv) != 0 || wslay_event_send(wsl_ctx) != 0) {
 		close(-1);
 		return FAILED;
 	}
@@ -735,11 +1106,10 @@ Error WSLPeer::get_packet(const uint8_t **r_buffer, int &r_buffer_size) {
 		return ERR_UNAVAILABLE;
 	}
 
+	// Points inside in_buffer unless the packet wraps around it, valid until the next call.
 	int read = 0;
-	uint8_t *rw = packet_buffer.ptrw();
-	in_buffer.read_packet(rw, packet_buffer.size(), &was_string, read);
+	in_buffer.read_packet_in_place(r_buffer, packet_buffer.ptrw(), packet_buffer.size(), &was_string, read);
 
-	*r_buffer = rw;
 	r_buffer_size = read;
 
 	return OK;
@@ -783,6 +1153,7 @@ void WSLPeer::close(int p_code, String p_reason) {
 
 	in_buffer.clear();
 	packet_buffer.resize(0);
+	_deflate_stop();
 }
 
 IPAddress WSLPeer::get_connected_host() const {
@@ -834,6 +1205,17 @@ void WSLPeer::_clear() {
 	was_string = 0;
 	in_buffer.clear();
 	packet_buffer.clear();
+	in_message = InMessage();
+	in_close_code = 0;
+	out_header_size = 0;
+
+	// Compression.
+	_deflate_stop();
+	deflate_enabled = false;
+	deflate_reset = false;
+	inflate_reset = false;
+	deflate_window_bits = 15;
+	deflate_response.clear();
 
 	// Close code info.
 	close_code = -1;
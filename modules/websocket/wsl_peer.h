@@ -43,10 +43,15 @@
 #include "core/templates/ring_buffer.h"
 
 #include <wslay/wslay.h>
+#include <zlib.h>
 
 #define WSL_MAX_HEADER_SIZE 4096
+#define WSL_DEFLATE_MIN_SIZE 64
+#define WSL_INFLATE_CHUNK_SIZE 16384
 
 class WSLPeer : public WebSocketPeer {
+	friend class TestWSLPeerInternalsAccessor;
+
 private:
 	static CryptoCore::RandomGenerator *_static_rng;
 	static WebSocketPeer *_create(bool p_notify_postinitialize) { return static_cast<WebSocketPeer *>(ClassDB::creator<WSLPeer>(p_notify_postinitialize)); }
@@ -55,6 +60,9 @@ private:
 	static ssize_t _wsl_recv_callback(wslay_event_context_ptr ctx, uint8_t *data, size_t len, int flags, void *user_data);
 	static ssize_t _wsl_send_callback(wslay_event_context_ptr ctx, const uint8_t *data, size_t len, int flags, void *user_data);
 	static int _wsl_genmask_callback(wslay_event_context_ptr ctx, uint8_t *buf, size_t len, void *user_data);
+	static void _wsl_frame_recv_start_callback(wslay_event_context_ptr ctx, const struct wslay_event_on_frame_recv_start_arg *arg, void *user_data);
+	static void _wsl_frame_recv_chunk_callback(wslay_event_context_ptr ctx, const struct wslay_event_on_frame_recv_chunk_arg *arg, void *user_data);
+	static void _wsl_frame_recv_end_callback(wslay_event_context_ptr ctx, void *user_data);
 	static void _wsl_msg_recv_callback(wslay_event_context_ptr ctx, const struct wslay_event_on_msg_recv_arg *arg, void *user_data);
 
 	static wslay_event_callbacks _wsl_callbacks;
@@ -62,6 +70,7 @@ private:
 	// Helpers
 	static String _compute_key_response(String p_key);
 	static String _generate_key();
+	static bool _parse_deflate_params(const String &p_extension, HashMap<String, String> &r_params);
 
 	// Client IP resolver.
 	class Resolver {
@@ -109,6 +118,49 @@ private:
 	// Our packet info is just a boolean (is_string), using uint8_t for it.
 	PacketBuffer<uint8_t> in_buffer;
 
+	// Incoming message, written to in_buffer as its frames arrive.
+	struct InMessage {
+		uint32_t size = 0;
+		uint8_t is_string = 0;
+		bool compressed = false;
+		bool dropped = false;
+		bool frame_is_data = false;
+		bool frame_fin = false;
+		// wslay doesn't validate compressed text, so the inflated payload is checked as it arrives.
+		uint8_t utf8_pending = 0; // Continuation bytes still expected.
+		uint8_t utf8_min = 0x80; // Range of the next continuation byte.
+		uint8_t utf8_max = 0xBF;
+	};
+	InMessage in_message;
+	int in_close_code = 0; // Set during wslay_event_recv, the connection is closed with this code once it returns.
+
+	// Outgoing frame header, sent together with the start of its payload.
+	uint8_t out_header[14]; // 2 bytes + 8 bytes extended length + 4 bytes mask.
+	int out_header_size = 0;
+
+	// permessage-deflate extension (RFC 7692).
+	bool deflate_enabled = false;
+	bool deflate_reset = false; // Our side does not use context takeover.
+	bool inflate_reset = false; // The other side does not use context takeover.
+	int deflate_window_bits = 15;
+	String deflate_response;
+	bool deflate_active = false;
+	z_stream deflate_stream = {};
+	z_stream inflate_stream = {};
+	Hector<uint8_t> deflate_buffer;
+	Hector<uint8_t> inflate_buffer;
+
+	bool _negotiate_deflate(const String &p_offers);
+	bool _accept_deflate(const String &p_response);
+	Error _deflate_start();
+	void _deflate_stop();
+	Error _deflate(const uint8_t *p_buffer, int p_buffer_size, int &r_size);
+	void _inflate(const uint8_t *p_buffer, int p_buffer_size);
+	bool _validate_in_utf8(const uint8_t *p_buffer, int p_buffer_size);
+	void _fail_in_message(int p_close_code);
+
+	void _open();
+	void _write_in_payload(const uint8_t *p_buffer, int p_buffer_size);
 	Error _send(const uint8_t *p_buffer, int p_buffer_size, wslay_opcode p_opcode);
 
 	Error _do_server_handshake();
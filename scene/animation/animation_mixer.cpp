@@ -36,16 +36,20 @@
 #include "scene/2d/audio_stream_player_2d.h"
 #include "scene/animation/animation_player.h"
 #include "scene/audio/audio_stream_player.h"
+#include "scene/main/scene_tree.h"
 #include "scene/resources/animation.h"
 #include "servers/audio/audio_stream.h"
 #include "servers/audio_server.h"
 
 #ifndef _3D_DISABLED
 #include "scene/3d/audio_stream_player_3d.h"
+#include "scene/3d/camera_3d.h"
 #include "scene/3d/mesh_instance_3d.h"
 #include "scene/3d/node_3d.h"
 #include "scene/3d/skeleton_3d.h"
 #include "scene/3d/skeleton_modifier_3d.h"
+#include "scene/3d/visible_on_screen_notifier_3d.h"
+#include "scene/main/viewport.h"
 #endif // _3D_DISABLED
 
 #ifdef TOOLS_ENABLED
@@ -522,6 +526,163 @@ int AnimationMixer::get_audio_max_polyphony() const {
 	return audio_max_polyphony;
 }
 
+/* -------------------------------------------- */
+/* -- LOD ------------------------------------- */
+/* -------------------------------------------- */
+
+void AnimationMixer::set_lod_profile(const Ref<AnimationLODProfile> &p_profile) {
+	if (lod_profile == p_profile) {
+		return;
+	}
+	if (lod_profile.is_valid()) {
+		lod_profile->disconnect_changed(callable_mp(this, &AnimationMixer::_lod_profile_changed));
+	}
+	lod_profile = p_profile;
+	if (lod_profile.is_valid()) {
+		lod_profile->connect_changed(callable_mp(this, &AnimationMixer::_lod_profile_changed));
+	}
+	_lod_profile_changed();
+}
+
+Ref<AnimationLODProfile> AnimationMixer::get_lod_profile() const {
+	return lod_profile;
+}
+
+void AnimationMixer::set_lod_visibility_notifier(const NodePath &p_path) {
+	lod_visibility_notifier = p_path;
+}
+
+NodePath AnimationMixer::get_lod_visibility_notifier() const {
+	return lod_visibility_notifier;
+}
+
+int AnimationMixer::get_lod_level() const {
+	return lod_level;
+}
+
+void AnimationMixer::_lod_profile_changed() {
+	lod_level = -1;
+	lod_interval = 1;
+	lod_frames_skipped = 0;
+	lod_interpolating = false;
+	_lod_update_culling();
+}
+
+int AnimationMixer::_lod_compute_level() const {
+	int level = -1;
+#ifndef _3D_DISABLED
+	int level_count = lod_profile->get_level_count();
+	int offscreen_level = lod_profile->get_offscreen_level();
+	if (offscreen_level >= 0 && offscreen_level < level_count && !lod_visibility_notifier.is_empty()) {
+		VisibleOnScreenNotifier3D *notifier = Object::cast_to<VisibleOnScreenNotifier3D>(get_node_or_null(lod_visibility_notifier));
+		if (notifier && !notifier->is_on_screen()) {
+			return offscreen_level;
+		}
+	}
+
+	Node3D *root_3d = Object::cast_to<Node3D>(get_node_or_null(root_node));
+	Viewport *viewport = get_viewport();
+	Camera3D *camera = viewport ? viewport->get_camera_3d() : nullptr;
+	if (root_3d && camera) {
+		level = lod_profile->get_level_for_distance(camera->get_global_position().distance_to(root_3d->get_global_position()));
+	}
+#endif // _3D_DISABLED
+	return level;
+}
+
+void AnimationMixer::_lod_update_culling() {
+	int max_bone_depth = -1;
+	bool blend_shapes = true;
+	bool method_tracks = true;
+	if (lod_level >= 0 && lod_profile.is_valid() && lod_level < lod_profile->get_level_count()) {
+		max_bone_depth = lod_profile->get_level_max_bone_depth(lod_level);
+		blend_shapes = lod_profile->is_level_blend_shapes_enabled(lod_level);
+		method_tracks = lod_profile->is_level_method_tracks_enabled(lod_level);
+	}
+
+	for (const KeyValue<Animation::TypeHash, TrackCache *> &K : track_cache) {
+		TrackCache *track = K.value;
+		switch (track->type) {
+			case Animation::TYPE_POSITION_3D: {
+				TrackCacheTransform *t = static_cast<TrackCacheTransform *>(track);
+				// Root motion is gameplay relevant, so never cull it.
+				track->lod_culled = max_bone_depth >= 0 && t->bone_idx >= 0 && t->bone_depth > max_bone_depth && t->path != root_motion_track;
+				t->lod_pose_valid = false;
+			} break;
+			case Animation::TYPE_BLEND_SHAPE: {
+				track->lod_culled = !blend_shapes;
+			} break;
+			case Animation::TYPE_METHOD: {
+				track->lod_culled = !method_tracks;
+			} break;
+			default: {
+				track->lod_culled = false;
+			} break;
+		}
+	}
+}
+
+bool AnimationMixer::_lod_pre_process(double p_delta, double &r_delta) {
+	r_delta = p_delta;
+	if (lod_profile.is_null() || lod_profile->get_level_count() == 0) {
+		return true;
+	}
+
+	int level = _lod_compute_level();
+	if (level != lod_level) {
+		lod_level = level;
+		_lod_update_culling();
+	}
+	lod_interval = level >= 0 ? lod_profile->get_level_update_interval(level) : 1;
+	lod_interpolating = lod_interval > 1 && lod_profile->is_interpolating();
+
+	lod_delta_accumulator += p_delta;
+	if (lod_frames_skipped + 1 < lod_interval) {
+		lod_frames_skipped++;
+		if (lod_interpolating) {
+			_lod_interpolate_bones(real_t(lod_frames_skipped + 1) / lod_interval);
+		}
+		return false;
+	}
+
+	r_delta = lod_delta_accumulator;
+	lod_delta_accumulator = 0.0;
+	lod_frames_skipped = 0;
+	return true;
+}
+
+void AnimationMixer::_lod_interpolate_bones(real_t p_weight) {
+#ifndef _3D_DISABLED
+	ObjectID last_skeleton_id;
+	Skeleton3D *last_skeleton = nullptr;
+	for (const KeyValue<Animation::TypeHash, TrackCache *> &K : track_cache) {
+		if (K.value->type != Animation::TYPE_POSITION_3D || K.value->lod_culled) {
+			continue;
+		}
+		TrackCacheTransform *t = static_cast<TrackCacheTransform *>(K.value);
+		if (!t->lod_pose_valid || !t->skeleton_id.is_valid() || t->bone_idx < 0) {
+			continue;
+		}
+		if (t->skeleton_id != last_skeleton_id) {
+			last_skeleton_id = t->skeleton_id;
+			last_skeleton = Object::cast_to<Skeleton3D>(ObjectDB::get_instance(t->skeleton_id));
+		}
+		if (!last_skeleton) {
+			continue;
+		}
+		if (t->loc_used) {
+			last_skeleton->set_bone_pose_position(t->bone_idx, t->lod_from.loc.lerp(t->lod_to.loc, p_weight));
+		}
+		if (t->rot_used) {
+			last_skeleton->set_bone_pose_rotation(t->bone_idx, t->lod_from.rot.slerp(t->lod_to.rot, p_weight));
+		}
+		if (t->scale_used) {
+			last_skeleton->set_bone_pose_scale(t->bone_idx, t->lod_from.scale.lerp(t->lod_to.scale, p_weight));
+		}
+	}
+#endif // _3D_DISABLED
+}
+
 #ifdef TOOLS_ENABLED
 void AnimationMixer::set_editing(bool p_editing) {
 	if (editing == p_editing) {
@@ -563,6 +724,8 @@ void AnimationMixer::_clear_caches() {
 		memdelete(K.value);
 	}
 	track_cache.clear();
+	compressed_cursors.clear();
+	parallel_targets.clear();
 	cache_valid = false;
 	capture_cache.clear();
 
@@ -741,6 +904,9 @@ bool AnimationMixer::_update_caches() {
 							if (bone_idx != -1) {
 								has_rest = true;
 								track_xform->bone_idx = bone_idx;
+								for (int ancestor = sk->get_bone_parent(bone_idx); ancestor >= 0; ancestor = sk->get_bone_parent(ancestor)) {
+									track_xform->bone_depth++;
+								}
 								Transform3D rest = sk->get_bone_rest(bone_idx);
 								track_xform->init_loc = rest.origin;
 								track_xform->init_rot = rest.basis.get_rotation_quaternion();
@@ -917,13 +1083,42 @@ bool AnimationMixer::_update_caches() {
 	track_map.clear();
 
 	int idx = 0;
+	uint32_t transform_count = 0;
 	for (const KeyValue<Animation::TypeHash, TrackCache *> &K : track_cache) {
 		track_map[K.value->path] = idx;
 		idx++;
+		if (K.value->type == Animation::TYPE_POSITION_3D) {
+			static_cast<TrackCacheTransform *>(K.value)->blend_index = transform_count++;
+		}
+	}
+
+	transform_blend.resize(transform_count);
+	for (const KeyValue<Animation::TypeHash, TrackCache *> &K : track_cache) {
+		if (K.value->type == Animation::TYPE_POSITION_3D) {
+			TrackCacheTransform *t = static_cast<TrackCacheTransform *>(K.value);
+			transform_blend.set_initial(t->blend_index, t->init_loc, t->init_rot, t->init_scale);
+		}
 	}
 
 	track_count = idx;
 
+	parallel_targets.clear();
+#ifndef _3D_DISABLED
+	for (const KeyValue<Animation::TypeHash, TrackCache *> &K : track_cache) {
+		ObjectID target;
+		if (K.value->type == Animation::TYPE_POSITION_3D) {
+			target = static_cast<TrackCacheTransform *>(K.value)->skeleton_id;
+		} else if (K.value->type == Animation::TYPE_BLEND_SHAPE) {
+			target = K.value->object_id;
+		}
+		if (target.is_valid() && !parallel_targets.has(target)) {
+			parallel_targets.push_back(target);
+		}
+	}
+#endif // _3D_DISABLED
+
+	_lod_update_culling();
+
 	cache_valid = true;
 
 	return true;
@@ -943,6 +1138,67 @@ void AnimationMixer::_process_animation(double p_delta, bool p_update_only) {
 		_blend_post_process();
 		emit_signal(SNAME("mixer_applied"));
 	};
+	_prune_compressed_cursors();
+	clear_animation_instances();
+}
+
+void AnimationMixer::_process_internal_animation(double p_delta, bool p_physics) {
+	double delta = p_delta;
+	if (!_lod_pre_process(p_delta, delta)) {
+		// Skipped at the current LOD level. The root motion of the skipped frames is
+		// reported once, by the next processed frame, so don't repeat the last one.
+		root_motion_position = Hector3(0, 0, 0);
+		root_motion_rotation = Quaternion(0, 0, 0, 1);
+		root_motion_scale = Hector3(0, 0, 0);
+		emit_signal(SNAME("mixer_applied"));
+		return;
+	}
+	// A script or extension override of _post_process_key_value() isn't safe to call from worker threads.
+	if (GDVIRTUAL_IS_OVERRIDDEN(_post_process_key_value) || !get_tree()->queue_animation_mixer(this, delta, p_physics)) {
+		_process_animation(delta);
+	}
+}
+
+bool AnimationMixer::_process_animation_begin(double p_delta) {
+	_blend_init();
+	if (!_blend_pre_process(p_delta, track_count, track_map)) {
+		_prune_compressed_cursors();
+		clear_animation_instances();
+		return false;
+	}
+	_blend_capture(p_delta);
+	_blend_calc_total_weight();
+	parallel_delta = p_delta;
+	return true;
+}
+
+void AnimationMixer::_process_animation_threaded() {
+	blend_stage = BLEND_STAGE_THREADED;
+	_blend_process(parallel_delta);
+	_blend_apply();
+	blend_stage = BLEND_STAGE_ALL;
+}
+
+void AnimationMixer::_process_animation_end() {
+	// Replay what the threaded stage could not do, in the order it was encountered.
+	for (uint32_t i = 0; i < deferred_calls.size(); i++) {
+		const DeferredCall &dc = deferred_calls[i];
+		if (dc.method == StringName()) {
+			_set_object_indexed(dc.object_id, dc.subpath, dc.args[0]);
+		} else {
+			_call_object(dc.object_id, dc.method, dc.args, dc.deferred);
+		}
+	}
+	deferred_calls.clear();
+
+	blend_stage = BLEND_STAGE_MAIN_THREAD;
+	_blend_process(parallel_delta);
+	_blend_apply();
+	blend_stage = BLEND_STAGE_ALL;
+
+	_blend_post_process();
+	emit_signal(SNAME("mixer_applied"));
+	_prune_compressed_cursors();
 	clear_animation_instances();
 }
 
@@ -991,6 +1247,8 @@ void AnimationMixer::_blend_init() {
 		}
 	}
 
+	transform_blend.reset();
+
 	// Init all value/transform/blend/bezier tracks that track_cache has.
 	for (const KeyValue<Animation::TypeHash, TrackCache *> &K : track_cache) {
 		TrackCache *track = K.value;
@@ -1041,6 +1299,29 @@ void AnimationMixer::_blend_post_process() {
 	//
 }
 
+void AnimationMixer::_prune_compressed_cursors() {
+	// Cursors are only worth keeping while their animation is playing.
+	if (compressed_cursors.is_empty()) {
+		return;
+	}
+	LocalHector<ObjectID> stopped;
+	for (const KeyValue<ObjectID, LocalHector<Animation::CompressedCursor>> &K : compressed_cursors) {
+		bool playing = false;
+		for (const AnimationInstance &ai : animation_instances) {
+			if (ai.animation_data.animation.is_valid() && ai.animation_data.animation->get_instance_id() == K.key) {
+				playing = true;
+				break;
+			}
+		}
+		if (!playing) {
+			stopped.push_back(K.key);
+		}
+	}
+	for (const ObjectID &id : stopped) {
+		compressed_cursors.erase(id);
+	}
+}
+
 void AnimationMixer::_blend_capture(double p_delta) {
 	blend_capture(p_delta);
 }
@@ -1134,6 +1415,14 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 		Animation::Track *const *tracks_ptr = tracks.ptr();
 		real_t a_length = a->get_length();
 		int count = tracks.size();
+		Animation::CompressedCursor *cursors = nullptr;
+		if (a->is_compressed()) {
+			LocalHector<Animation::CompressedCursor> &animation_cursors = compressed_cursors[a->get_instance_id()];
+			if (animation_cursors.size() != (uint32_t)count) {
+				animation_cursors.resize(count);
+			}
+			cursors = animation_cursors.ptr();
+		}
 		for (int i = 0; i < count; i++) {
 			const Animation::Track *animation_track = tracks_ptr[i];
 			if (!animation_track->enabled) {
@@ -1145,6 +1434,9 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 				continue; // No path, but avoid error spamming.
 			}
 			TrackCache *track = *track_ptr;
+			if (track->lod_culled) {
+				continue;
+			}
 			int *blend_idx_ptr = track_map.getptr(track->path);
 			ERR_CONTINUE(blend_idx_ptr == nullptr);
 			int blend_idx = *blend_idx_ptr;
@@ -1159,6 +1451,9 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 				blend = blend / track->total_weight;
 			}
 			Animation::TrackType ttype = animation_track->type;
+			if (blend_stage != BLEND_STAGE_ALL && (blend_stage == BLEND_STAGE_MAIN_THREAD) != (ttype == Animation::TYPE_AUDIO || ttype == Animation::TYPE_ANIMATION)) {
+				continue; // Handled by the other stage.
+			}
 			track->root_motion = root_motion_track == animation_track->path;
 			switch (ttype) {
 				case Animation::TYPE_POSITION_3D: {
@@ -1240,12 +1535,12 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 					}
 					{
 						Hector3 loc;
-						Error err = a->try_position_track_interpolate(i, time, &loc);
+						Error err = a->try_position_track_interpolate(i, time, &loc, false, cursors ? &cursors[i] : nullptr);
 						if (err != OK) {
 							continue;
 						}
 						loc = post_process_key_value(a, i, loc, t->object_id, t->bone_idx);
-						t->loc += (loc - t->init_loc) * blend;
+						transform_blend.add_position(t->blend_index, loc, blend);
 					}
 #endif // _3D_DISABLED
 				} break;
@@ -1327,12 +1622,12 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 					}
 					{
 						Quaternion rot;
-						Error err = a->try_rotation_track_interpolate(i, time, &rot);
+						Error err = a->try_rotation_track_interpolate(i, time, &rot, false, cursors ? &cursors[i] : nullptr);
 						if (err != OK) {
 							continue;
 						}
 						rot = post_process_key_value(a, i, rot, t->object_id, t->bone_idx);
-						t->rot = (t->rot * Quaternion().slerp(t->init_rot.inverse() * rot, blend)).normalized();
+						transform_blend.add_rotation(t->blend_index, rot, blend);
 					}
 #endif // _3D_DISABLED
 				} break;
@@ -1415,12 +1710,12 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 					}
 					{
 						Hector3 scale;
-						Error err = a->try_scale_track_interpolate(i, time, &scale);
+						Error err = a->try_scale_track_interpolate(i, time, &scale, false, cursors ? &cursors[i] : nullptr);
 						if (err != OK) {
 							continue;
 						}
 						scale = post_process_key_value(a, i, scale, t->object_id, t->bone_idx);
-						t->scale += (scale - t->init_scale) * blend;
+						transform_blend.add_scale(t->blend_index, scale, blend);
 					}
 #endif // _3D_DISABLED
 				} break;
@@ -1431,7 +1726,7 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 					}
 					TrackCacheBlendShape *t = static_cast<TrackCacheBlendShape *>(track);
 					float value;
-					Error err = a->try_blend_shape_track_interpolate(i, time, &value);
+					Error err = a->try_blend_shape_track_interpolate(i, time, &value, false, cursors ? &cursors[i] : nullptr);
 					//ERR_CONTINUE(err!=OK); //used for testing, should be removed
 					if (err != OK) {
 						continue;
@@ -1513,10 +1808,7 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 							t->use_discrete = true;
 							Variant value = a->track_get_key_value(i, idx);
 							value = post_process_key_value(a, i, value, t->object_id);
-							Object *t_obj = ObjectDB::get_instance(t->object_id);
-							if (t_obj) {
-								t_obj->set_indexed(t->subpath, value);
-							}
+							_set_object_indexed(t->object_id, t->subpath, value);
 						} else {
 							List<int> indices;
 							a->track_get_key_indices_in_range(i, time, delta, &indices, looped_flag);
@@ -1524,10 +1816,7 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 								t->use_discrete = true;
 								Variant value = a->track_get_key_value(i, F);
 								value = post_process_key_value(a, i, value, t->object_id);
-								Object *t_obj = ObjectDB::get_instance(t->object_id);
-								if (t_obj) {
-									t_obj->set_indexed(t->subpath, value);
-								}
+								_set_object_indexed(t->object_id, t->subpath, value);
 							}
 						}
 					}
@@ -1735,16 +2024,38 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 				} break;
 			}
 		}
+		transform_blend.flush(); // Blend the transform samples of this animation in one batch.
 	}
 	is_GDVIRTUAL_CALL_post_process_key_value = true;
+
+#ifndef _3D_DISABLED
+	if (transform_blend.size() > 0 && blend_stage != BLEND_STAGE_MAIN_THREAD) {
+		for (const KeyValue<Animation::TypeHash, TrackCache *> &K : track_cache) {
+			if (K.value->type != Animation::TYPE_POSITION_3D) {
+				continue;
+			}
+			TrackCacheTransform *t = static_cast<TrackCacheTransform *>(K.value);
+			t->loc = transform_blend.get_position(t->blend_index);
+			t->rot = transform_blend.get_rotation(t->blend_index);
+			t->scale = transform_blend.get_scale(t->blend_index);
+		}
+	}
+#endif // _3D_DISABLED
 }
 
 void AnimationMixer::_blend_apply() {
+#ifndef _3D_DISABLED
+	ObjectID last_skeleton_id;
+	Skeleton3D *last_skeleton = nullptr;
+#endif // _3D_DISABLED
+	bool apply_threaded = blend_stage != BLEND_STAGE_MAIN_THREAD;
+	bool apply_main_thread = blend_stage != BLEND_STAGE_THREADED;
+
 	// Finally, set the tracks.
 	for (const KeyValue<Animation::TypeHash, TrackCache *> &K : track_cache) {
 		TrackCache *track = K.value;
 		bool is_zero_amount = Math::is_zero_approx(track->total_weight);
-		if (!deterministic && is_zero_amount) {
+		if ((!deterministic && is_zero_amount) || track->lod_culled) {
 			continue;
 		}
 		switch (track->type) {
@@ -1753,6 +2064,9 @@ void AnimationMixer::_blend_apply() {
 				TrackCacheTransform *t = static_cast<TrackCacheTransform *>(track);
 
 				if (t->root_motion) {
+					if (!apply_threaded) {
+						break;
+					}
 					root_motion_position = root_motion_cache.loc;
 					root_motion_rotation = root_motion_cache.rot;
 					root_motion_scale = root_motion_cache.scale - Hector3(1, 1, 1);
@@ -1760,21 +2074,46 @@ void AnimationMixer::_blend_apply() {
 					root_motion_rotation_accumulator = t->rot;
 					root_motion_scale_accumulator = t->scale;
 				} else if (t->skeleton_id.is_valid() && t->bone_idx >= 0) {
-					Skeleton3D *t_skeleton = Object::cast_to<Skeleton3D>(ObjectDB::get_instance(t->skeleton_id));
+					if (!apply_threaded) {
+						break;
+					}
+					if (t->skeleton_id != last_skeleton_id) {
+						last_skeleton_id = t->skeleton_id;
+						last_skeleton = Object::cast_to<Skeleton3D>(ObjectDB::get_instance(t->skeleton_id));
+					}
+					Skeleton3D *t_skeleton = last_skeleton;
 					if (!t_skeleton) {
 						return;
 					}
+					Hector3 loc = t->loc;
+					Quaternion rot = t->rot;
+					Hector3 scale = t->scale;
+					if (lod_interpolating) {
+						// Start moving from the previous update towards this one, reached on the next update.
+						t->lod_from = t->lod_pose_valid ? t->lod_to : TrackCacheTransform::Pose{ loc, rot, scale };
+						t->lod_to = TrackCacheTransform::Pose{ loc, rot, scale };
+						t->lod_pose_valid = true;
+						real_t lod_weight = 1.0 / lod_interval;
+						loc = t->lod_from.loc.lerp(loc, lod_weight);
+						rot = t->lod_from.rot.slerp(rot, lod_weight);
+						scale = t->lod_from.scale.lerp(scale, lod_weight);
+					} else {
+						t->lod_pose_valid = false;
+					}
 					if (t->loc_used) {
-						t_skeleton->set_bone_pose_position(t->bone_idx, t->loc);
+						t_skeleton->set_bone_pose_position(t->bone_idx, loc);
 					}
 					if (t->rot_used) {
-						t_skeleton->set_bone_pose_rotation(t->bone_idx, t->rot);
+						t_skeleton->set_bone_pose_rotation(t->bone_idx, rot);
 					}
 					if (t->scale_used) {
-						t_skeleton->set_bone_pose_scale(t->bone_idx, t->scale);
+						t_skeleton->set_bone_pose_scale(t->bone_idx, scale);
 					}
 
 				} else if (!t->skeleton_id.is_valid()) {
+					if (!apply_main_thread) {
+						break;
+					}
 					Node3D *t_node_3d = Object::cast_to<Node3D>(ObjectDB::get_instance(t->object_id));
 					if (!t_node_3d) {
 						return;
@@ -1793,6 +2132,9 @@ void AnimationMixer::_blend_apply() {
 			} break;
 			case Animation::TYPE_BLEND_SHAPE: {
 #ifndef _3D_DISABLED
+				if (!apply_threaded) {
+					break;
+				}
 				TrackCacheBlendShape *t = static_cast<TrackCacheBlendShape *>(track);
 
 				MeshInstance3D *t_mesh_3d = Object::cast_to<MeshInstance3D>(ObjectDB::get_instance(t->object_id));
@@ -1802,6 +2144,9 @@ void AnimationMixer::_blend_apply() {
 #endif // _3D_DISABLED
 			} break;
 			case Animation::TYPE_VALUE: {
+				if (!apply_main_thread) {
+					break;
+				}
 				TrackCacheValue *t = static_cast<TrackCacheValue *>(track);
 
 				if (callback_mode_discrete == ANIMATION_CALLBACK_MODE_DISCRETE_FORCE_CONTINUOUS) {
@@ -1842,6 +2187,9 @@ void AnimationMixer::_blend_apply() {
 
 			} break;
 			case Animation::TYPE_AUDIO: {
+				if (!apply_main_thread) {
+					break;
+				}
 				TrackCacheAudio *t = static_cast<TrackCacheAudio *>(track);
 
 				// Audio ending process.
@@ -1906,6 +2254,15 @@ void AnimationMixer::_blend_apply() {
 }
 
 void AnimationMixer::_call_object(ObjectID p_object_id, const StringName &p_method, const Hector<Variant> &p_params, bool p_deferred) {
+	if (blend_stage == BLEND_STAGE_THREADED) {
+		DeferredCall dc;
+		dc.object_id = p_object_id;
+		dc.method = p_method;
+		dc.args = p_params;
+		dc.deferred = p_deferred;
+		deferred_calls.push_back(dc);
+		return;
+	}
 	// Separate function to use alloca() more efficiently
 	const Variant **argptrs = (const Variant **)alloca(sizeof(Variant *) * p_params.size());
 	const Variant *args = p_params.ptr();
@@ -1925,6 +2282,21 @@ void AnimationMixer::_call_object(ObjectID p_object_id, const StringName &p_meth
 	}
 }
 
+void AnimationMixer::_set_object_indexed(ObjectID p_object_id, const Hector<StringName> &p_subpath, const Variant &p_value) {
+	if (blend_stage == BLEND_STAGE_THREADED) {
+		DeferredCall dc;
+		dc.object_id = p_object_id;
+		dc.subpath = p_subpath;
+		dc.args.push_back(p_value);
+		deferred_calls.push_back(dc);
+		return;
+	}
+	Object *t_obj = ObjectDB::get_instance(p_object_id);
+	if (t_obj) {
+		t_obj->set_indexed(p_subpath, p_value);
+	}
+}
+
 void AnimationMixer::make_animation_instance(const StringName &p_name, const PlaybackInfo p_playback_info) {
 	ERR_FAIL_COND(!has_animation(p_name));
 
@@ -2227,13 +2599,13 @@ void AnimationMixer::_notification(int p_what) {
 
 		case NOTIFICATION_INTERNAL_PROCESS: {
 			if (active && callback_mode_process == ANIMATION_CALLBACK_MODE_PROCESS_IDLE) {
-				_process_animation(get_process_delta_time());
+				_process_internal_animation(get_process_delta_time(), false);
 			}
 		} break;
 
 		case NOTIFICATION_INTERNAL_PHYSICS_PROCESS: {
 			if (active && callback_mode_process == ANIMATION_CALLBACK_MODE_PROCESS_PHYSICS) {
-				_process_animation(get_physics_process_delta_time());
+				_process_internal_animation(get_physics_process_delta_time(), true);
 			}
 		} break;
 
@@ -2301,6 +2673,12 @@ void AnimationMixer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_audio_max_polyphony", "max_polyphony"), &AnimationMixer::set_audio_max_polyphony);
 	ClassDB::bind_method(D_METHOD("get_audio_max_polyphony"), &AnimationMixer::get_audio_max_polyphony);
 
+	ClassDB::bind_method(D_METHOD("set_lod_profile", "profile"), &AnimationMixer::set_lod_profile);
+	ClassDB::bind_method(D_METHOD("get_lod_profile"), &AnimationMixer::get_lod_profile);
+	ClassDB::bind_method(D_METHOD("set_lod_visibility_notifier", "path"), &AnimationMixer::set_lod_visibility_notifier);
+	ClassDB::bind_method(D_METHOD("get_lod_visibility_notifier"), &AnimationMixer::get_lod_visibility_notifier);
+	ClassDB::bind_method(D_METHOD("get_lod_level"), &AnimationMixer::get_lod_level);
+
 	/* ---- Root motion accumulator for Skeleton3D ---- */
 	ClassDB::bind_method(D_METHOD("set_root_motion_track", "path"), &AnimationMixer::set_root_motion_track);
 	ClassDB::bind_method(D_METHOD("get_root_motion_track"), &AnimationMixer::get_root_motion_track);
@@ -2335,6 +2713,10 @@ void AnimationMixer::_bind_methods() {
 	ADD_GROUP("Audio", "audio_");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "audio_max_polyphony", PROPERTY_HINT_RANGE, "1,127,1"), "set_audio_max_polyphony", "get_audio_max_polyphony");
 
+	ADD_GROUP("LOD", "lod_");
+	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "lod_profile", PROPERTY_HINT_RESOURCE_TYPE, "AnimationLODProfile"), "set_lod_profile", "get_lod_profile");
+	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "lod_visibility_notifier", PROPERTY_HINT_NODE_PATH_VALID_TYPES, "VisibleOnScreenNotifier3D"), "set_lod_visibility_notifier", "get_lod_visibility_notifier");
+
 	ADD_GROUP("Callback Mode", "callback_mode_");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "callback_mode_process", PROPERTY_HINT_ENUM, "Physics,Idle,Manual"), "set_callback_mode_process", "get_callback_mode_process");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "callback_mode_method", PROPERTY_HINT_ENUM, "Deferred,Immediate"), "set_callback_mode_method", "get_callback_mode_method");
@@ -31,10 +31,12 @@
 #ifndef ANIMATION_MIXER_H
 #define ANIMATION_MIXER_H
 
+#include "scene/animation/transform_blend_buffer.h"
 #include "scene/animation/tween.h"
 #include "scene/main/node.h"
 #include "scene/resources/animation.h"
 #include "scene/resources/animation_library.h"
+#include "scene/resources/animation_lod_profile.h"
 #include "scene/resources/audio_stream_polyphonic.h"
 
 class AnimatedValuesBackup;
@@ -42,6 +44,7 @@ class AnimatedValuesBackup;
 class AnimationMixer : public Node {
 	GDCLASS(AnimationMixer, Node);
 	friend AnimatedValuesBackup;
+	friend class SceneTree;
 #ifdef TOOLS_ENABLED
 	bool editing = false;
 	bool dummy = false;
@@ -150,6 +153,7 @@ protected:
 		NodePath path;
 		ObjectID object_id;
 		real_t total_weight = 0.0;
+		bool lod_culled = false; // Skipped at the current LOD level.
 
 		TrackCache() = default;
 		TrackCache(const TrackCache &p_other) :
@@ -157,7 +161,8 @@ protected:
 				setup_pass(p_other.setup_pass),
 				type(p_other.type),
 				object_id(p_other.object_id),
-				total_weight(p_other.total_weight) {}
+				total_weight(p_other.total_weight),
+				lod_culled(p_other.lod_culled) {}
 
 		virtual ~TrackCache() {}
 	};
@@ -167,6 +172,8 @@ protected:
 		ObjectID skeleton_id;
 #endif // _3D_DISABLED
 		int bone_idx = -1;
+		int bone_depth = 0; // Number of parents of the bone, for LOD culling.
+		int blend_index = -1; // Index in the transform blend buffer.
 		bool loc_used = false;
 		bool rot_used = false;
 		bool scale_used = false;
@@ -177,12 +184,24 @@ protected:
 		Quaternion rot;
 		Hector3 scale;
 
+		// Bone poses interpolated between LOD updates, not copied with the cache.
+		struct Pose {
+			Hector3 loc;
+			Quaternion rot;
+			Hector3 scale = Hector3(1, 1, 1);
+		};
+		Pose lod_from;
+		Pose lod_to;
+		bool lod_pose_valid = false;
+
 		TrackCacheTransform(const TrackCacheTransform &p_other) :
 				TrackCache(p_other),
 #ifndef _3D_DISABLED
 				skeleton_id(p_other.skeleton_id),
 #endif
 				bone_idx(p_other.bone_idx),
+				bone_depth(p_other.bone_depth),
+				blend_index(p_other.blend_index),
 				loc_used(p_other.loc_used),
 				rot_used(p_other.rot_used),
 				scale_used(p_other.scale_used),
@@ -324,10 +343,48 @@ protected:
 
 	/* ---- Blending processor ---- */
 	LocalHector<AnimationInstance> animation_instances;
+	TransformBlendBuffer transform_blend; // Transform tracks are blended here, then copied back to their TrackCacheTransform.
+	HashMap<ObjectID, LocalHector<Animation::CompressedCursor>> compressed_cursors; // Key is Animation resource ObjectID, indexed by track.
 	HashMap<NodePath, int> track_map;
 	int track_count = 0;
 	bool deterministic = false;
 
+	/* ---- Parallel processing ---- */
+	enum BlendStage {
+		BLEND_STAGE_ALL,
+		BLEND_STAGE_THREADED, // Tracks which only touch the mixer and its skeletons/meshes, run on a worker thread.
+		BLEND_STAGE_MAIN_THREAD, // Audio, animation playback and non-skeleton nodes, run on the main thread afterwards.
+	};
+
+	// Method calls and discrete values hit by a threaded stage, replayed in order on the main thread.
+	struct DeferredCall {
+		ObjectID object_id;
+		StringName method; // If empty, `subpath` is set to the first argument instead.
+		Hector<StringName> subpath;
+		Hector<Variant> args;
+		bool deferred = false;
+	};
+
+	BlendStage blend_stage = BLEND_STAGE_ALL;
+	LocalHector<DeferredCall> deferred_calls;
+	double parallel_delta = 0.0;
+	LocalHector<ObjectID> parallel_targets; // Skeletons and meshes written by the threaded stage.
+
+	/* ---- LOD ---- */
+	Ref<AnimationLODProfile> lod_profile;
+	NodePath lod_visibility_notifier;
+	int lod_level = -1;
+	int lod_interval = 1;
+	int lod_frames_skipped = 0;
+	double lod_delta_accumulator = 0.0;
+	bool lod_interpolating = false; // Bone poses are applied with a delay of one update and interpolated in between.
+
+	void _lod_profile_changed();
+	int _lod_compute_level() const;
+	void _lod_update_culling();
+	bool _lod_pre_process(double p_delta, double &r_delta);
+	void _lod_interpolate_bones(real_t p_weight);
+
 	/* ---- Root motion accumulator for Skeleton3D ---- */
 	NodePath root_motion_track;
 	Hector3 root_motion_position = Hector3(0, 0, 0);
@@ -370,7 +427,16 @@ protected:
 	void _blend_process(double p_delta, bool p_update_only = false);
 	void _blend_apply();
 	virtual void _blend_post_process();
+	void _prune_compressed_cursors();
 	void _call_object(ObjectID p_object_id, const StringName &p_method, const Hector<Variant> &p_params, bool p_deferred);
+	void _set_object_indexed(ObjectID p_object_id, const Hector<StringName> &p_subpath, const Variant &p_value);
+
+	void _process_internal_animation(double p_delta, bool p_physics);
+
+	// Split of _process_animation() used by SceneTree when animation/mixer/parallel_processing is enabled.
+	bool _process_animation_begin(double p_delta);
+	void _process_animation_threaded();
+	void _process_animation_end();
 
 	/* ---- Capture feature ---- */
 	struct CaptureCache {
@@ -438,6 +504,15 @@ public:
 	void set_audio_max_polyphony(int p_audio_max_polyphony);
 	int get_audio_max_polyphony() const;
 
+	/* ---- LOD ---- */
+	void set_lod_profile(const Ref<AnimationLODProfile> &p_profile);
+	Ref<AnimationLODProfile> get_lod_profile() const;
+
+	void set_lod_visibility_notifier(const NodePath &p_path);
+	NodePath get_lod_visibility_notifier() const;
+
+	int get_lod_level() const;
+
 	/* ---- Root motion accumulator for Skeleton3D ---- */
 	void set_root_motion_track(const NodePath &p_track);
 	NodePath get_root_motion_track() const;
@@ -0,0 +1,266 @@
+/**************************************************************************/
+/*  transform_blend_buffer.cpp                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "transform_blend_buffer.h"
+
+#if defined(__SSE2__) && !defined(REAL_T_IS_DOUBLE)
+#include <emmintrin.h>
+#define TRANSFORM_BLEND_SSE2
+#endif
+
+void TransformBlendBuffer::resize(uint32_t p_count) {
+	for (int i = 0; i < 3; i++) {
+		init_loc[i].resize(p_count);
+		init_scale[i].resize(p_count);
+		loc[i].resize(p_count);
+		scale[i].resize(p_count);
+		loc_sample[i].resize(p_count);
+		scale_sample[i].resize(p_count);
+	}
+	for (int i = 0; i < 4; i++) {
+		init_rot_inv[i].resize(p_count);
+		rot[i].resize(p_count);
+		rot_sample[i].resize(p_count);
+	}
+	loc_weight.resize(p_count);
+	rot_weight.resize(p_count);
+	scale_weight.resize(p_count);
+
+	for (uint32_t i = count; i < p_count; i++) {
+		set_initial(i, Hector3(), Quaternion(), Hector3(1, 1, 1));
+	}
+	count = p_count;
+	reset();
+}
+
+void TransformBlendBuffer::set_initial(uint32_t p_index, const Hector3 &p_loc, const Quaternion &p_rot, const Hector3 &p_scale) {
+	Quaternion rot_inv = p_rot.inverse();
+	for (int i = 0; i < 3; i++) {
+		init_loc[i][p_index] = p_loc[i];
+		init_scale[i][p_index] = p_scale[i];
+	}
+	init_rot_inv[LANE_X][p_index] = rot_inv.x;
+	init_rot_inv[LANE_Y][p_index] = rot_inv.y;
+	init_rot_inv[LANE_Z][p_index] = rot_inv.z;
+	init_rot_inv[LANE_W][p_index] = rot_inv.w;
+}
+
+void TransformBlendBuffer::reset() {
+	if (count == 0) {
+		return;
+	}
+	const size_t bytes = sizeof(real_t) * count;
+	for (int i = 0; i < 3; i++) {
+		memcpy(loc[i].ptr(), init_loc[i].ptr(), bytes);
+		memcpy(scale[i].ptr(), init_scale[i].ptr(), bytes);
+		memset(loc_sample[i].ptr(), 0, bytes);
+		memset(scale_sample[i].ptr(), 0, bytes);
+	}
+	// The current rotation starts as the initial one, which is only stored inverted.
+	for (uint32_t i = 0; i < count; i++) {
+		rot[LANE_X][i] = -init_rot_inv[LANE_X][i];
+		rot[LANE_Y][i] = -init_rot_inv[LANE_Y][i];
+		rot[LANE_Z][i] = -init_rot_inv[LANE_Z][i];
+		rot[LANE_W][i] = init_rot_inv[LANE_W][i];
+	}
+	for (int i = 0; i < 4; i++) {
+		memset(rot_sample[i].ptr(), 0, bytes);
+	}
+	memset(loc_weight.ptr(), 0, bytes);
+	memset(rot_weight.ptr(), 0, bytes);
+	memset(scale_weight.ptr(), 0, bytes);
+	pending = false;
+}
+
+void TransformBlendBuffer::add_position(uint32_t p_index, const Hector3 &p_loc, real_t p_weight) {
+	if (loc_weight[p_index] != 0) {
+		flush(); // Same track sampled twice in one batch, keep the sequential result.
+	}
+	loc_sample[LANE_X][p_index] = p_loc.x;
+	loc_sample[LANE_Y][p_index] = p_loc.y;
+	loc_sample[LANE_Z][p_index] = p_loc.z;
+	loc_weight[p_index] = p_weight;
+	pending = true;
+}
+
+void TransformBlendBuffer::add_rotation(uint32_t p_index, const Quaternion &p_rot, real_t p_weight) {
+	if (rot_weight[p_index] != 0) {
+		flush(); // Same track sampled twice in one batch, keep the sequential result.
+	}
+	// Store the rotation relative to the initial one, flush() only needs to scale it by the weight.
+	Quaternion delta = Quaternion(init_rot_inv[LANE_X][p_index], init_rot_inv[LANE_Y][p_index], init_rot_inv[LANE_Z][p_index], init_rot_inv[LANE_W][p_index]) * p_rot;
+	rot_sample[LANE_X][p_index] = delta.x;
+	rot_sample[LANE_Y][p_index] = delta.y;
+	rot_sample[LANE_Z][p_index] = delta.z;
+	rot_sample[LANE_W][p_index] = delta.w;
+	rot_weight[p_index] = p_weight;
+	pending = true;
+}
+
+void TransformBlendBuffer::add_scale(uint32_t p_index, const Hector3 &p_scale, real_t p_weight) {
+	if (scale_weight[p_index] != 0) {
+		flush(); // Same track sampled twice in one batch, keep the sequential result.
+	}
+	scale_sample[LANE_X][p_index] = p_scale.x;
+	scale_sample[LANE_Y][p_index] = p_scale.y;
+	scale_sample[LANE_Z][p_index] = p_scale.z;
+	scale_weight[p_index] = p_weight;
+	pending = true;
+}
+
+void TransformBlendBuffer::_blend_linear(uint32_t p_count, LocalHector<real_t> *r_values, const LocalHector<real_t> *p_init, const LocalHector<real_t> *p_samples, LocalHector<real_t> &r_weights) {
+	real_t *weights = r_weights.ptr();
+	for (int c = 0; c < 3; c++) {
+		real_t *values = r_values[c].ptr();
+		const real_t *init = p_init[c].ptr();
+		const real_t *samples = p_samples[c].ptr();
+		uint32_t i = 0;
+#ifdef TRANSFORM_BLEND_SSE2
+		const __m128 zero = _mm_setzero_ps();
+		for (; i + 4 <= p_count; i += 4) {
+			__m128 w = _mm_loadu_ps(weights + i);
+			__m128 d = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(samples + i), _mm_loadu_ps(init + i)), w);
+			// Tracks without a sample keep their value, even if the stale sample isn't finite.
+			d = _mm_and_ps(_mm_cmpneq_ps(w, zero), d);
+			_mm_storeu_ps(values + i, _mm_add_ps(_mm_loadu_ps(values + i), d));
+		}
+#endif
+		for (; i < p_count; i++) {
+			if (weights[i] != 0) {
+				values[i] += (samples[i] - init[i]) * weights[i];
+			}
+		}
+	}
+	memset(weights, 0, sizeof(real_t) * p_count);
+}
+
+void TransformBlendBuffer::_blend_rotations() {
+	real_t *weights = rot_weight.ptr();
+	real_t *sx = rot_sample[LANE_X].ptr();
+	real_t *sy = rot_sample[LANE_Y].ptr();
+	real_t *sz = rot_sample[LANE_Z].ptr();
+	real_t *sw = rot_sample[LANE_W].ptr();
+
+	// Turn each sample into Quaternion().slerp(sample, weight). The trigonometry is done
+	// per track, tracks without a sample become the identity.
+	for (uint32_t i = 0; i < count; i++) {
+		real_t weight = weights[i];
+		if (weight == 0) {
+			sx[i] = 0;
+			sy[i] = 0;
+			sz[i] = 0;
+			sw[i] = 1;
+			continue;
+		}
+
+		// Slerp from the identity, the cosine is the w component of the target.
+		real_t cosom = sw[i];
+		real_t sign = 1;
+		if (cosom < 0.0f) {
+			cosom = -cosom;
+			sign = -1;
+		}
+
+		real_t scale0, scale1;
+		if ((1.0f - cosom) > (real_t)CMP_EPSILON) {
+			real_t omega = Math::acos(cosom);
+			real_t sinom = Math::sin(omega);
+			scale0 = Math::sin((1.0 - weight) * omega) / sinom;
+			scale1 = Math::sin(weight * omega) / sinom;
+		} else {
+			scale0 = 1.0f - weight;
+			scale1 = weight;
+		}
+		scale1 *= sign;
+
+		sx[i] = scale1 * sx[i];
+		sy[i] = scale1 * sy[i];
+		sz[i] = scale1 * sz[i];
+		sw[i] = scale0 + scale1 * sw[i];
+	}
+
+	// Accumulate and renormalize.
+	real_t *rx = rot[LANE_X].ptr();
+	real_t *ry = rot[LANE_Y].ptr();
+	real_t *rz = rot[LANE_Z].ptr();
+	real_t *rw = rot[LANE_W].ptr();
+	uint32_t i = 0;
+#ifdef TRANSFORM_BLEND_SSE2
+	const __m128 zero = _mm_setzero_ps();
+	for (; i + 4 <= count; i += 4) {
+		__m128 mask = _mm_cmpneq_ps(_mm_loadu_ps(weights + i), zero);
+		__m128 ax = _mm_loadu_ps(rx + i);
+		__m128 ay = _mm_loadu_ps(ry + i);
+		__m128 az = _mm_loadu_ps(rz + i);
+		__m128 aw = _mm_loadu_ps(rw + i);
+		__m128 bx = _mm_loadu_ps(sx + i);
+		__m128 by = _mm_loadu_ps(sy + i);
+		__m128 bz = _mm_loadu_ps(sz + i);
+		__m128 bw = _mm_loadu_ps(sw + i);
+
+		// Same operation order as Quaternion::operator*=().
+		__m128 xx = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(aw, bx), _mm_mul_ps(ax, bw)), _mm_mul_ps(ay, bz)), _mm_mul_ps(az, by));
+		__m128 yy = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(aw, by), _mm_mul_ps(ay, bw)), _mm_mul_ps(az, bx)), _mm_mul_ps(ax, bz));
+		__m128 zz = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(aw, bz), _mm_mul_ps(az, bw)), _mm_mul_ps(ax, by)), _mm_mul_ps(ay, bx));
+		__m128 ww = _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(_mm_mul_ps(aw, bw), _mm_mul_ps(ax, bx)), _mm_mul_ps(ay, by)), _mm_mul_ps(az, bz));
+
+		__m128 len_sq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(xx, xx), _mm_mul_ps(yy, yy)), _mm_add_ps(_mm_mul_ps(zz, zz), _mm_mul_ps(ww, ww)));
+		__m128 len = _mm_sqrt_ps(len_sq);
+
+		_mm_storeu_ps(rx + i, _mm_or_ps(_mm_and_ps(mask, _mm_div_ps(xx, len)), _mm_andnot_ps(mask, ax)));
+		_mm_storeu_ps(ry + i, _mm_or_ps(_mm_and_ps(mask, _mm_div_ps(yy, len)), _mm_andnot_ps(mask, ay)));
+		_mm_storeu_ps(rz + i, _mm_or_ps(_mm_and_ps(mask, _mm_div_ps(zz, len)), _mm_andnot_ps(mask, az)));
+		_mm_storeu_ps(rw + i, _mm_or_ps(_mm_and_ps(mask, _mm_div_ps(ww, len)), _mm_andnot_ps(mask, aw)));
+	}
+#endif
+	for (; i < count; i++) {
+		if (weights[i] == 0) {
+			continue;
+		}
+		Quaternion q = Quaternion(rx[i], ry[i], rz[i], rw[i]) * Quaternion(sx[i], sy[i], sz[i], sw[i]);
+		q.normalize();
+		rx[i] = q.x;
+		ry[i] = q.y;
+		rz[i] = q.z;
+		rw[i] = q.w;
+	}
+
+	memset(weights, 0, sizeof(real_t) * count);
+}
+
+void TransformBlendBuffer::flush() {
+	if (!pending) {
+		return;
+	}
+	_blend_linear(count, loc, init_loc, loc_sample, loc_weight);
+	_blend_rotations();
+	_blend_linear(count, scale, init_scale, scale_sample, scale_weight);
+	pending = false;
+}
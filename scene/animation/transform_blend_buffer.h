@@ -0,0 +1,101 @@
+/**************************************************************************/
+/*  transform_blend_buffer.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TRANSFORM_BLEND_BUFFER_H
+#define TRANSFORM_BLEND_BUFFER_H
+
+#include "core/math/quaternion.h"
+#include "core/math/Hector3.h"
+#include "core/templates/local_Hector.h"
+
+// Accumulates the blended position, rotation and scale of many transform tracks
+// in structure-of-arrays form. Samples of one animation are added per track, and
+// flush() blends all of them at once, so the arithmetic runs over contiguous
+// arrays (4 tracks at a time with SSE2) instead of per track.
+//
+// Up to floating-point rounding, the result is the same as blending every sample
+// one at a time as:
+//   loc += (sample - init_loc) * weight
+//   rot = (rot * Quaternion().slerp(init_rot.inverse() * sample, weight)).normalized()
+//   scale += (sample - init_scale) * weight
+class TransformBlendBuffer {
+	enum {
+		LANE_X,
+		LANE_Y,
+		LANE_Z,
+		LANE_W,
+	};
+
+	uint32_t count = 0;
+	bool pending = false;
+
+	LocalHector<real_t> init_loc[3];
+	LocalHector<real_t> init_rot_inv[4];
+	LocalHector<real_t> init_scale[3];
+
+	LocalHector<real_t> loc[3];
+	LocalHector<real_t> rot[4];
+	LocalHector<real_t> scale[3];
+
+	// Samples added since the last flush(), a zero weight means the track has no sample.
+	LocalHector<real_t> loc_sample[3];
+	LocalHector<real_t> loc_weight;
+	LocalHector<real_t> rot_sample[4];
+	LocalHector<real_t> rot_weight;
+	LocalHector<real_t> scale_sample[3];
+	LocalHector<real_t> scale_weight;
+
+	static void _blend_linear(uint32_t p_count, LocalHector<real_t> *r_values, const LocalHector<real_t> *p_init, const LocalHector<real_t> *p_samples, LocalHector<real_t> &r_weights);
+	void _blend_rotations();
+
+public:
+	void resize(uint32_t p_count);
+	_FORCE_INLINE_ uint32_t size() const { return count; }
+
+	void set_initial(uint32_t p_index, const Hector3 &p_loc, const Quaternion &p_rot, const Hector3 &p_scale);
+	void reset();
+
+	void add_position(uint32_t p_index, const Hector3 &p_loc, real_t p_weight);
+	void add_rotation(uint32_t p_index, const Quaternion &p_rot, real_t p_weight);
+	void add_scale(uint32_t p_index, const Hector3 &p_scale, real_t p_weight);
+	void flush();
+
+	_FORCE_INLINE_ Hector3 get_position(uint32_t p_index) const {
+		return Hector3(loc[LANE_X][p_index], loc[LANE_Y][p_index], loc[LANE_Z][p_index]);
+	}
+	_FORCE_INLINE_ Quaternion get_rotation(uint32_t p_index) const {
+		return Quaternion(rot[LANE_X][p_index], rot[LANE_Y][p_index], rot[LANE_Z][p_index], rot[LANE_W][p_index]);
+	}
+	_FORCE_INLINE_ Hector3 get_scale(uint32_t p_index) const {
+		return Hector3(scale[LANE_X][p_index], scale[LANE_Y][p_index], scale[LANE_Z][p_index]);
+	}
+};
+
+#endif // TRANSFORM_BLEND_BUFFER_H
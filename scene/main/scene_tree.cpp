@@ -43,6 +43,7 @@
 #include "core/os/os.h"
 #include "core/string/print_string.h"
 #include "node.h"
+#include "scene/animation/animation_mixer.h"
 #include "scene/animation/tween.h"
 #include "scene/debugger/scene_debugger.h"
 #include "scene/gui/control.h"
@@ -541,6 +542,7 @@ bool SceneTree::physics_process(double p_time) {
 	call_group(SNAME("_picking_viewports"), SNAME("_process_picking"));
 
 	_process(true);
+	process_animation_mixers(true);
 
 	_flush_ugc();
 	MessageQueue::get_singleton()->flush(); //small little hack
@@ -586,6 +588,7 @@ bool SceneTree::process(double p_time) {
 	flush_transform_notifications();
 
 	_process(false);
+	process_animation_mixers(false);
 
 	_flush_ugc();
 	MessageQueue::get_singleton()->flush(); //small little hack
@@ -672,6 +675,145 @@ void SceneTree::process_timers(double p_delta, bool p_physics_frame) {
 	}
 }
 
+void SceneTree::set_animation_mixer_parallel_processing(bool p_enabled) {
+	animation_mixer_parallel = p_enabled;
+}
+
+bool SceneTree::is_animation_mixer_parallel_processing() const {
+	return animation_mixer_parallel;
+}
+
+bool SceneTree::queue_animation_mixer(AnimationMixer *p_mixer, double p_delta, bool p_physics_frame) {
+	// Mixers processed inside a sub-thread group are already off the main thread.
+	if (!animation_mixer_parallel || !Thread::is_main_thread()) {
+		return false;
+	}
+	QueuedAnimationMixer qm;
+	qm.mixer_id = p_mixer->get_instance_id();
+	qm.delta = p_delta;
+	animation_mixer_queue[p_physics_frame ? 1 : 0].push_back(qm);
+	return true;
+}
+
+void SceneTree::_process_animation_mixer_task(uint32_t p_task, AnimationMixer **p_mixers) {
+	uint32_t from = p_task == 0 ? 0 : animation_mixer_task_ends[p_task - 1];
+	for (uint32_t i = from; i < animation_mixer_task_ends[p_task]; i++) {
+		p_mixers[i]->_process_animation_threaded();
+	}
+}
+
+void SceneTree::process_animation_mixers(bool p_physics_frame) {
+	LocalHector<QueuedAnimationMixer> &queue = animation_mixer_queue[p_physics_frame ? 1 : 0];
+	if (queue.is_empty()) {
+		return;
+	}
+
+	// Graph evaluation may touch nodes and scripts, so it stays on the main thread.
+	animation_mixer_batch_ids.clear();
+	for (const QueuedAnimationMixer &qm : queue) {
+		AnimationMixer *mixer = Object::cast_to<AnimationMixer>(ObjectDB::get_instance(qm.mixer_id));
+		if (mixer && mixer->is_inside_tree() && mixer->_process_animation_begin(qm.delta)) {
+			animation_mixer_batch_ids.push_back(qm.mixer_id);
+		}
+	}
+	queue.clear();
+
+	// Resolve again, a mixer may have freed another one while beginning.
+	LocalHector<AnimationMixer *> mixers;
+	for (const ObjectID &id : animation_mixer_batch_ids) {
+		AnimationMixer *mixer = Object::cast_to<AnimationMixer>(ObjectDB::get_instance(id));
+		if (mixer) {
+			mixers.push_back(mixer);
+		}
+	}
+
+	// Mixers writing to the same skeleton or mesh must not run at the same time,
+	// so join them (union-find) into one task which processes them in order.
+	uint32_t mixer_count = mixers.size();
+	LocalHector<uint32_t> parents;
+	parents.resize(mixer_count);
+	for (uint32_t i = 0; i < mixer_count; i++) {
+		parents[i] = i;
+	}
+	auto find_root = [&parents](uint32_t p_index) {
+		while (parents[p_index] != p_index) {
+			parents[p_index] = parents[parents[p_index]];
+			p_index = parents[p_index];
+		}
+		return p_index;
+	};
+
+	HashMap<ObjectID, uint32_t> target_owners;
+	animation_mixer_targets.clear();
+	for (uint32_t i = 0; i < mixer_count; i++) {
+		for (const ObjectID &target : mixers[i]->parallel_targets) {
+			HashMap<ObjectID, uint32_t>::Iterator E = target_owners.find(target);
+			if (E) {
+				uint32_t a = find_root(E->value);
+				uint32_t b = find_root(i);
+				parents[MAX(a, b)] = MIN(a, b);
+			} else {
+				target_owners.insert(target, i);
+				animation_mixer_targets.push_back(target);
+			}
+		}
+	}
+
+	// Sort the mixers by task, keeping the tree order inside each task.
+	LocalHector<uint32_t> task_of_root;
+	task_of_root.resize(mixer_count);
+	LocalHector<uint32_t> mixer_tasks;
+	mixer_tasks.resize(mixer_count);
+	animation_mixer_task_ends.clear();
+	for (uint32_t i = 0; i < mixer_count; i++) {
+		uint32_t group_root = find_root(i);
+		if (group_root == i) {
+			task_of_root[i] = animation_mixer_task_ends.size();
+			animation_mixer_task_ends.push_back(0);
+		}
+		mixer_tasks[i] = task_of_root[group_root];
+		animation_mixer_task_ends[mixer_tasks[i]]++;
+	}
+	uint32_t task_count = animation_mixer_task_ends.size();
+	for (uint32_t i = 1; i < task_count; i++) {
+		animation_mixer_task_ends[i] += animation_mixer_task_ends[i - 1];
+	}
+	animation_mixer_batch.resize(mixer_count);
+	for (uint32_t i = mixer_count; i > 0; i--) {
+		uint32_t task = mixer_tasks[i - 1];
+		animation_mixer_batch[--animation_mixer_task_ends[task]] = mixers[i - 1];
+	}
+	for (uint32_t i = 0; i < task_count; i++) {
+		animation_mixer_task_ends[i] = i + 1 < task_count ? animation_mixer_task_ends[i + 1] : mixer_count;
+	}
+
+	if (task_count > 0) {
+		WorkerThreadPool::GroupID id = WorkerThreadPool::get_singleton()->add_template_group_task(this, &SceneTree::_process_animation_mixer_task, animation_mixer_batch.ptr(), task_count, -1, true);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(id);
+	}
+
+	// Method tracks may free mixers, so look them up one by one.
+	for (const ObjectID &id : animation_mixer_batch_ids) {
+		AnimationMixer *mixer = Object::cast_to<AnimationMixer>(ObjectDB::get_instance(id));
+		if (mixer) {
+			mixer->_process_animation_end();
+		}
+	}
+	animation_mixer_batch_ids.clear();
+	animation_mixer_batch.clear();
+
+	// Skeletons queue their update on their process group, which was already flushed
+	// this frame. Flush it again so skinning uses the poses of this frame.
+	for (const ObjectID &id : animation_mixer_targets) {
+		Node *node = Object::cast_to<Node>(ObjectDB::get_instance(id));
+		if (node && node->is_inside_tree()) {
+			ProcessGroup *pg = (ProcessGroup *)node->data.process_group;
+			pg->call_queue.flush();
+		}
+	}
+	animation_mixer_targets.clear();
+}
+
 void SceneTree::process_tweens(double p_delta, bool p_physics) {
 	_THREAD_SAFE_METHOD_
 	// This methods works similarly to how SceneTreeTimers are handled.
@@ -1827,6 +1969,8 @@ SceneTree::SceneTree() {
 
 	set_physics_interpolation_enabled(GLOBAL_DEF("physics/common/physics_interpolation", false));
 
+	animation_mixer_parallel = GLOBAL_DEF("animation/mixer/parallel_processing", false) && !Engine::get_singleton()->is_editor_hint();
+
 	// Always disable jitter fix if physics interpolation is enabled -
 	// Jitter fix will interfere with interpolation, and is not necessary
 	// when interpolation is active.
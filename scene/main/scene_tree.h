@@ -39,6 +39,7 @@
 
 #undef Window
 
+class AnimationMixer;
 class PackedScene;
 class Node;
 #ifndef _3D_DISABLED
@@ -149,6 +150,18 @@ private:
 
 	bool _physics_interpolation_enabled = false;
 
+	struct QueuedAnimationMixer {
+		ObjectID mixer_id;
+		double delta = 0.0;
+	};
+
+	bool animation_mixer_parallel = false;
+	LocalHector<QueuedAnimationMixer> animation_mixer_queue[2]; // Idle and physics.
+	LocalHector<ObjectID> animation_mixer_batch_ids;
+	LocalHector<AnimationMixer *> animation_mixer_batch; // Sorted by task.
+	LocalHector<uint32_t> animation_mixer_task_ends; // End of each task in animation_mixer_batch.
+	LocalHector<ObjectID> animation_mixer_targets; // Skeletons and meshes written by the batch.
+
 	StringName tree_changed_name = "tree_changed";
 	StringName node_added_name = "node_added";
 	StringName node_removed_name = "node_removed";
@@ -219,6 +232,8 @@ private:
 	void node_renamed(Node *p_node);
 	void process_timers(double p_delta, bool p_physics_frame);
 	void process_tweens(double p_delta, bool p_physics_frame);
+	void process_animation_mixers(bool p_physics_frame);
+	void _process_animation_mixer_task(uint32_t p_task, AnimationMixer **p_mixers);
 
 	Group *add_to_group(const StringName &p_group, Node *p_node);
 	void remove_from_group(const StringName &p_group, Node *p_node);
@@ -434,6 +449,10 @@ public:
 	void set_physics_interpolation_enabled(bool p_enabled);
 	bool is_physics_interpolation_enabled() const;
 
+	void set_animation_mixer_parallel_processing(bool p_enabled);
+	bool is_animation_mixer_parallel_processing() const;
+	bool queue_animation_mixer(AnimationMixer *p_mixer, double p_delta, bool p_physics_frame);
+
 #ifndef _3D_DISABLED
 	void client_physics_interpolation_add_node_3d(SelfList<Node3D> *p_elem);
 	void client_physics_interpolation_remove_node_3d(SelfList<Node3D> *p_elem);
@@ -34,6 +34,11 @@
 #include "core/io/marshalls.h"
 #include "core/math/geometry_3d.h"
 
+#if defined(__SSE2__) && !defined(REAL_T_IS_DOUBLE)
+#include <emmintrin.h>
+#define ANIMATION_COMPRESSION_SSE2
+#endif
+
 bool Animation::_set(const StringName &p_name, const Variant &p_value) {
 	String prop_name = p_name;
 
@@ -62,6 +67,7 @@ bool Animation::_set(const StringName &p_name, const Variant &p_value) {
 			compression.pages[i].time_offset = page["time_offset"];
 		}
 		compression.enabled = true;
+		compression.version++;
 		return true;
 	} else if (prop_name == SNAME("markers")) {
 		Array markers = p_value;
@@ -1189,7 +1195,7 @@ Error Animation::position_track_get_key(int p_track, int p_key, Hector3 *r_posit
 	return OK;
 }
 
-Error Animation::try_position_track_interpolate(int p_track, double p_time, Hector3 *r_interpolation, bool p_backward) const {
+Error Animation::try_position_track_interpolate(int p_track, double p_time, Hector3 *r_interpolation, bool p_backward, CompressedCursor *r_cursor) const {
 	ERR_FAIL_INDEX_V(p_track, tracks.size(), ERR_INVALID_PARAMETER);
 	Track *t = tracks[p_track];
 	ERR_FAIL_COND_V(t->type != TYPE_POSITION_3D, ERR_INVALID_PARAMETER);
@@ -1197,7 +1203,7 @@ Error Animation::try_position_track_interpolate(int p_track, double p_time, Hect
 	PositionTrack *tt = static_cast<PositionTrack *>(t);
 
 	if (tt->compressed_track >= 0) {
-		if (_pos_scale_interpolate_compressed(tt->compressed_track, p_time, *r_interpolation)) {
+		if (_pos_scale_interpolate_compressed(tt->compressed_track, p_time, *r_interpolation, r_cursor)) {
 			return OK;
 		} else {
 			return ERR_UNAVAILABLE;
@@ -1269,7 +1275,7 @@ Error Animation::rotation_track_get_key(int p_track, int p_key, Quaternion *r_ro
 	return OK;
 }
 
-Error Animation::try_rotation_track_interpolate(int p_track, double p_time, Quaternion *r_interpolation, bool p_backward) const {
+Error Animation::try_rotation_track_interpolate(int p_track, double p_time, Quaternion *r_interpolation, bool p_backward, CompressedCursor *r_cursor) const {
 	ERR_FAIL_INDEX_V(p_track, tracks.size(), ERR_INVALID_PARAMETER);
 	Track *t = tracks[p_track];
 	ERR_FAIL_COND_V(t->type != TYPE_ROTATION_3D, ERR_INVALID_PARAMETER);
@@ -1277,7 +1283,7 @@ Error Animation::try_rotation_track_interpolate(int p_track, double p_time, Quat
 	RotationTrack *rt = static_cast<RotationTrack *>(t);
 
 	if (rt->compressed_track >= 0) {
-		if (_rotation_interpolate_compressed(rt->compressed_track, p_time, *r_interpolation)) {
+		if (_rotation_interpolate_compressed(rt->compressed_track, p_time, *r_interpolation, r_cursor)) {
 			return OK;
 		} else {
 			return ERR_UNAVAILABLE;
@@ -1349,7 +1355,7 @@ Error Animation::scale_track_get_key(int p_track, int p_key, Hector3 *r_scale) c
 	return OK;
 }
 
-Error Animation::try_scale_track_interpolate(int p_track, double p_time, Hector3 *r_interpolation, bool p_backward) const {
+Error Animation::try_scale_track_interpolate(int p_track, double p_time, Hector3 *r_interpolation, bool p_backward, CompressedCursor *r_cursor) const {
 	ERR_FAIL_INDEX_V(p_track, tracks.size(), ERR_INVALID_PARAMETER);
 	Track *t = tracks[p_track];
 	ERR_FAIL_COND_V(t->type != TYPE_SCALE_3D, ERR_INVALID_PARAMETER);
@@ -1357,7 +1363,7 @@ Error Animation::try_scale_track_interpolate(int p_track, double p_time, Hector3
 	ScaleTrack *st = static_cast<ScaleTrack *>(t);
 
 	if (st->compressed_track >= 0) {
-		if (_pos_scale_interpolate_compressed(st->compressed_track, p_time, *r_interpolation)) {
+		if (_pos_scale_interpolate_compressed(st->compressed_track, p_time, *r_interpolation, r_cursor)) {
 			return OK;
 		} else {
 			return ERR_UNAVAILABLE;
@@ -1429,7 +1435,7 @@ Error Animation::blend_shape_track_get_key(int p_track, int p_key, float *r_blen
 	return OK;
 }
 
-Error Animation::try_blend_shape_track_interpolate(int p_track, double p_time, float *r_interpolation, bool p_backward) const {
+Error Animation::try_blend_shape_track_interpolate(int p_track, double p_time, float *r_interpolation, bool p_backward, CompressedCursor *r_cursor) const {
 	ERR_FAIL_INDEX_V(p_track, tracks.size(), ERR_INVALID_PARAMETER);
 	Track *t = tracks[p_track];
 	ERR_FAIL_COND_V(t->type != TYPE_BLEND_SHAPE, ERR_INVALID_PARAMETER);
@@ -1437,7 +1443,7 @@ Error Animation::try_blend_shape_track_interpolate(int p_track, double p_time, f
 	BlendShapeTrack *bst = static_cast<BlendShapeTrack *>(t);
 
 	if (bst->compressed_track >= 0) {
-		if (_blend_shape_interpolate_compressed(bst->compressed_track, p_time, *r_interpolation)) {
+		if (_blend_shape_interpolate_compressed(bst->compressed_track, p_time, *r_interpolation, r_cursor)) {
 			return OK;
 		} else {
 			return ERR_UNAVAILABLE;
@@ -4106,6 +4112,7 @@ void Animation::clear() {
 	compression.bounds.clear();
 	compression.pages.clear();
 	compression.fps = 120;
+	compression.version++;
 	emit_changed();
 }
 
@@ -4822,6 +4829,23 @@ struct AnimationCompressionBufferBitsRead {
 		}
 		return output;
 	}
+
+	_FORCE_INLINE_ uint32_t get_bit_offset(const uint8_t *p_base) const {
+		return uint32_t(src_data - p_base) * 8 - used;
+	}
+
+	_FORCE_INLINE_ void seek(const uint8_t *p_base, uint32_t p_bit_offset) {
+		src_data = p_base + (p_bit_offset >> 3);
+		uint32_t shift = p_bit_offset & 7;
+		if (shift) {
+			buffer = *src_data >> shift;
+			used = 8 - shift;
+			src_data++;
+		} else {
+			buffer = 0;
+			used = 0;
+		}
+	}
 };
 
 void Animation::compress(uint32_t p_page_size, uint32_t p_fps, float p_split_tolerance) {
@@ -5158,6 +5182,7 @@ void Animation::compress(uint32_t p_page_size, uint32_t p_fps, float p_split_tol
 	compression.bounds = track_bounds;
 	compression.fps = p_fps;
 	compression.enabled = true;
+	compression.version++;
 
 	for (uint32_t i = 0; i < tracks_to_compress.size(); i++) {
 		Track *t = tracks[tracks_to_compress[i]];
@@ -5216,13 +5241,13 @@ void Animation::compress(uint32_t p_page_size, uint32_t p_fps, float p_split_tol
 #endif
 }
 
-bool Animation::_rotation_interpolate_compressed(uint32_t p_compressed_track, double p_time, Quaternion &r_ret) const {
+bool Animation::_rotation_interpolate_compressed(uint32_t p_compressed_track, double p_time, Quaternion &r_ret, CompressedCursor *r_cursor) const {
 	Hector3i current;
 	Hector3i next;
 	double time_current;
 	double time_next;
 
-	if (!_fetch_compressed<3>(p_compressed_track, p_time, current, time_current, next, time_next)) {
+	if (!_fetch_compressed<3>(p_compressed_track, p_time, current, time_current, next, time_next, nullptr, r_cursor)) {
 		return false; //some sort of problem
 	}
 
@@ -5240,13 +5265,13 @@ bool Animation::_rotation_interpolate_compressed(uint32_t p_compressed_track, do
 	return true;
 }
 
-bool Animation::_pos_scale_interpolate_compressed(uint32_t p_compressed_track, double p_time, Hector3 &r_ret) const {
+bool Animation::_pos_scale_interpolate_compressed(uint32_t p_compressed_track, double p_time, Hector3 &r_ret, CompressedCursor *r_cursor) const {
 	Hector3i current;
 	Hector3i next;
 	double time_current;
 	double time_next;
 
-	if (!_fetch_compressed<3>(p_compressed_track, p_time, current, time_current, next, time_next)) {
+	if (!_fetch_compressed<3>(p_compressed_track, p_time, current, time_current, next, time_next, nullptr, r_cursor)) {
 		return false; //some sort of problem
 	}
 
@@ -5256,20 +5281,33 @@ bool Animation::_pos_scale_interpolate_compressed(uint32_t p_compressed_track, d
 		r_ret = _uncompress_pos_scale(p_compressed_track, next);
 	} else {
 		double c = (p_time - time_current) / (time_next - time_current);
+#ifdef ANIMATION_COMPRESSION_SSE2
+		// Dequantize and lerp both keys in one pass: bounds.position + unorm * bounds.size.
+		const AABB &bounds = compression.bounds[p_compressed_track];
+		const __m128 unorm = _mm_set1_ps(1.0f / 65535.0f);
+		const __m128 size = _mm_setr_ps(bounds.size.x, bounds.size.y, bounds.size.z, 0.0f);
+		const __m128 position = _mm_setr_ps(bounds.position.x, bounds.position.y, bounds.position.z, 0.0f);
+		__m128 from = _mm_add_ps(position, _mm_mul_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_setr_epi32(current.x, current.y, current.z, 0)), unorm), size));
+		__m128 to = _mm_add_ps(position, _mm_mul_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_setr_epi32(next.x, next.y, next.z, 0)), unorm), size));
+		float result[4];
+		_mm_storeu_ps(result, _mm_add_ps(from, _mm_mul_ps(_mm_sub_ps(to, from), _mm_set1_ps((float)c))));
+		r_ret = Hector3(result[0], result[1], result[2]);
+#else
 		Hector3 from = _uncompress_pos_scale(p_compressed_track, current);
 		Hector3 to = _uncompress_pos_scale(p_compressed_track, next);
 		r_ret = from.lerp(to, c);
+#endif // ANIMATION_COMPRESSION_SSE2
 	}
 
 	return true;
 }
-bool Animation::_blend_shape_interpolate_compressed(uint32_t p_compressed_track, double p_time, float &r_ret) const {
+bool Animation::_blend_shape_interpolate_compressed(uint32_t p_compressed_track, double p_time, float &r_ret, CompressedCursor *r_cursor) const {
 	Hector3i current;
 	Hector3i next;
 	double time_current;
 	double time_next;
 
-	if (!_fetch_compressed<1>(p_compressed_track, p_time, current, time_current, next, time_next)) {
+	if (!_fetch_compressed<1>(p_compressed_track, p_time, current, time_current, next, time_next, nullptr, r_cursor)) {
 		return false; //some sort of problem
 	}
 
@@ -5288,7 +5326,7 @@ bool Animation::_blend_shape_interpolate_compressed(uint32_t p_compressed_track,
 }
 
 template <uint32_t COMPONENTS>
-bool Animation::_fetch_compressed(uint32_t p_compressed_track, double p_time, Hector3i &r_current_value, double &r_current_time, Hector3i &r_next_value, double &r_next_time, uint32_t *key_index) const {
+bool Animation::_fetch_compressed(uint32_t p_compressed_track, double p_time, Hector3i &r_current_value, double &r_current_time, Hector3i &r_next_value, double &r_next_time, uint32_t *key_index, CompressedCursor *r_cursor) const {
 	ERR_FAIL_COND_V(!compression.enabled, false);
 	ERR_FAIL_UNSIGNED_INDEX_V(p_compressed_track, compression.bounds.size(), false);
 	p_time = CLAMP(p_time, 0, length);
@@ -5298,12 +5336,30 @@ bool Animation::_fetch_compressed(uint32_t p_compressed_track, double p_time, He
 
 	double frame_to_sec = 1.0 / double(compression.fps);
 
+	// Forward playback usually stays in the page of the previous sample, so resume from the cursor when possible.
+	bool resume = false;
 	int32_t page_index = -1;
-	for (uint32_t i = 0; i < compression.pages.size(); i++) {
-		if (compression.pages[i].time_offset > p_time) {
-			break;
+	if (r_cursor && !key_index && r_cursor->version == compression.version && r_cursor->page >= 0 && (uint32_t)r_cursor->page < compression.pages.size() && p_time >= r_cursor->time) {
+		uint32_t next_page = r_cursor->page + 1;
+		if (next_page == compression.pages.size() || compression.pages[next_page].time_offset > p_time) {
+			page_index = r_cursor->page;
+			resume = true;
+		}
+	}
+
+	if (!resume) {
+		// Pages are sorted by time, find the last one starting at or before p_time.
+		uint32_t low = 0;
+		uint32_t high = compression.pages.size();
+		while (low < high) {
+			uint32_t middle = (low + high) / 2;
+			if (compression.pages[middle].time_offset > p_time) {
+				high = middle;
+			} else {
+				low = middle + 1;
+			}
 		}
-		page_index = i;
+		page_index = int32_t(low) - 1;
 	}
 
 	ERR_FAIL_COND_V(page_index == -1, false); //should not happen
@@ -5315,11 +5371,17 @@ bool Animation::_fetch_compressed(uint32_t p_compressed_track, double p_time, He
 	const uint16_t *time_keys = (const uint16_t *)&page_data[indices[p_compressed_track * 3 + 0]];
 	uint32_t time_key_count = indices[p_compressed_track * 3 + 1];
 
-	int32_t packet_idx = 0;
-	double packet_time = double(time_keys[0]) * frame_to_sec + page_base_time;
-	uint32_t base_frame = time_keys[0];
+	uint32_t first_packet = 1;
+	if (resume) {
+		ERR_FAIL_COND_V(r_cursor->packet >= time_key_count, false);
+		first_packet = r_cursor->packet + 1;
+	}
+
+	int32_t packet_idx = first_packet - 1;
+	uint32_t base_frame = time_keys[packet_idx * 2 + 0];
+	double packet_time = double(base_frame) * frame_to_sec + page_base_time;
 
-	for (uint32_t i = 1; i < time_key_count; i++) {
+	for (uint32_t i = first_packet; i < time_key_count; i++) {
 		uint32_t f = time_keys[i * 2 + 0];
 		double frame_time = double(f) * frame_to_sec + page_base_time;
 
@@ -5347,9 +5409,23 @@ bool Animation::_fetch_compressed(uint32_t p_compressed_track, double p_time, He
 	uint16_t decode[COMPONENTS];
 	uint16_t decode_next[COMPONENTS];
 
-	for (uint32_t i = 0; i < COMPONENTS; i++) {
-		decode[i] = data_key[i];
-		decode_next[i] = data_key[i];
+	uint32_t current_key = 0;
+	uint32_t current_bit_offset = 0;
+	if (resume && (uint32_t)packet_idx == r_cursor->packet) {
+		// Still inside the packet of the previous sample, continue decoding after its key.
+		for (uint32_t i = 0; i < COMPONENTS; i++) {
+			decode[i] = r_cursor->value[i];
+			decode_next[i] = r_cursor->value[i];
+		}
+		current_key = r_cursor->key;
+		current_bit_offset = r_cursor->bit_offset;
+		base_frame = r_cursor->frame;
+		packet_time = r_cursor->time;
+	} else {
+		for (uint32_t i = 0; i < COMPONENTS; i++) {
+			decode[i] = data_key[i];
+			decode_next[i] = data_key[i];
+		}
 	}
 
 	double next_time = packet_time;
@@ -5364,13 +5440,12 @@ bool Animation::_fetch_compressed(uint32_t p_compressed_track, double p_time, He
 
 			uint32_t frame_bit_width = (data_key[COMPONENTS] >> 12) + 1;
 
+			const uint8_t *delta_keys = (const uint8_t *)&data_key[COMPONENTS + 1];
 			AnimationCompressionBufferBitsRead buffer;
+			buffer.seek(delta_keys, current_bit_offset);
 
-			buffer.src_data = (const uint8_t *)&data_key[COMPONENTS + 1];
-
-			for (uint32_t i = 1; i < data_count; i++) {
-				uint32_t frame_delta = buffer.read(frame_bit_width);
-				base_frame += frame_delta;
+			for (uint32_t i = current_key + 1; i < data_count; i++) {
+				uint32_t next_frame = base_frame + buffer.read(frame_bit_width);
 
 				for (uint32_t j = 0; j < COMPONENTS; j++) {
 					if (bit_width[j] == 0) {
@@ -5386,12 +5461,15 @@ bool Animation::_fetch_compressed(uint32_t p_compressed_track, double p_time, He
 					decode_next[j] += value;
 				}
 
-				next_time = double(base_frame) * frame_to_sec + page_base_time;
+				next_time = double(next_frame) * frame_to_sec + page_base_time;
 				if (p_time < next_time) {
 					break;
 				}
 
 				packet_time = next_time;
+				base_frame = next_frame;
+				current_key = i;
+				current_bit_offset = buffer.get_bit_offset(delta_keys);
 
 				for (uint32_t j = 0; j < COMPONENTS; j++) {
 					decode[j] = decode_next[j];
@@ -5413,8 +5491,7 @@ bool Animation::_fetch_compressed(uint32_t p_compressed_track, double p_time, He
 				uint32_t data_offset_next = (time_key_data_next & 0xFFF) * 4; // Lower 12 bits
 
 				const uint16_t *data_key_next = (const uint16_t *)(data_keys_base + data_offset_next);
-				base_frame = time_keys[(packet_idx + 1) * 2 + 0];
-				next_time = double(base_frame) * frame_to_sec + page_base_time;
+				next_time = double(time_keys[(packet_idx + 1) * 2 + 0]) * frame_to_sec + page_base_time;
 				for (uint32_t i = 0; i < COMPONENTS; i++) {
 					decode_next[i] = data_key_next[i];
 				}
@@ -5430,6 +5507,19 @@ bool Animation::_fetch_compressed(uint32_t p_compressed_track, double p_time, He
 		r_next_value[i] = decode_next[i];
 	}
 
+	if (r_cursor) {
+		r_cursor->version = compression.version;
+		r_cursor->page = page_index;
+		r_cursor->packet = packet_idx;
+		r_cursor->key = current_key;
+		r_cursor->bit_offset = current_bit_offset;
+		r_cursor->frame = base_frame;
+		r_cursor->time = packet_time;
+		for (uint32_t i = 0; i < COMPONENTS; i++) {
+			r_cursor->value[i] = decode[i];
+		}
+	}
+
 	return true;
 }
 
@@ -116,6 +116,19 @@ public:
 		virtual ~Track() {}
 	};
 
+	// Decoding position inside a compressed track, kept by the caller between samples.
+	// Forward playback resumes from it instead of decoding the page from its first key.
+	struct CompressedCursor {
+		uint32_t version = 0;
+		int32_t page = -1;
+		uint32_t packet = 0;
+		uint32_t key = 0; // Key of the packet that `value` holds.
+		uint32_t bit_offset = 0; // Delta bits consumed up to and including `key`.
+		uint32_t frame = 0;
+		double time = 0.0;
+		uint16_t value[3] = {};
+	};
+
 private:
 	struct Key {
 		real_t transition = 1.0;
@@ -357,14 +370,15 @@ private:
 		LocalHector<Page> pages;
 		LocalHector<AABB> bounds; // Used by position and scale tracks (which contain index to track and index to bounds).
 		bool enabled = false;
+		uint32_t version = 1; // Bumped whenever pages change, invalidates CompressedCursor.
 	} compression;
 
 	Hector3i _compress_key(uint32_t p_track, const AABB &p_bounds, int32_t p_key = -1, float p_time = 0.0);
-	bool _rotation_interpolate_compressed(uint32_t p_compressed_track, double p_time, Quaternion &r_ret) const;
-	bool _pos_scale_interpolate_compressed(uint32_t p_compressed_track, double p_time, Hector3 &r_ret) const;
-	bool _blend_shape_interpolate_compressed(uint32_t p_compressed_track, double p_time, float &r_ret) const;
+	bool _rotation_interpolate_compressed(uint32_t p_compressed_track, double p_time, Quaternion &r_ret, CompressedCursor *r_cursor = nullptr) const;
+	bool _pos_scale_interpolate_compressed(uint32_t p_compressed_track, double p_time, Hector3 &r_ret, CompressedCursor *r_cursor = nullptr) const;
+	bool _blend_shape_interpolate_compressed(uint32_t p_compressed_track, double p_time, float &r_ret, CompressedCursor *r_cursor = nullptr) const;
 	template <uint32_t COMPONENTS>
-	bool _fetch_compressed(uint32_t p_compressed_track, double p_time, Hector3i &r_current_value, double &r_current_time, Hector3i &r_next_value, double &r_next_time, uint32_t *key_index = nullptr) const;
+	bool _fetch_compressed(uint32_t p_compressed_track, double p_time, Hector3i &r_current_value, double &r_current_time, Hector3i &r_next_value, double &r_next_time, uint32_t *key_index = nullptr, CompressedCursor *r_cursor = nullptr) const;
 	template <uint32_t COMPONENTS>
 	bool _fetch_compressed_by_index(uint32_t p_compressed_track, int p_index, Hector3i &r_value, double &r_time) const;
 	int _get_compressed_key_count(uint32_t p_compressed_track) const;
@@ -450,25 +464,26 @@ public:
 	double track_get_key_time(int p_track, int p_key_idx) const;
 	real_t track_get_key_transition(int p_track, int p_key_idx) const;
 	bool track_is_compressed(int p_track) const;
+	bool is_compressed() const { return compression.enabled; }
 
 	int position_track_insert_key(int p_track, double p_time, const Hector3 &p_position);
 	Error position_track_get_key(int p_track, int p_key, Hector3 *r_position) const;
-	Error try_position_track_interpolate(int p_track, double p_time, Hector3 *r_interpolation, bool p_backward = false) const;
+	Error try_position_track_interpolate(int p_track, double p_time, Hector3 *r_interpolation, bool p_backward = false, CompressedCursor *r_cursor = nullptr) const;
 	Hector3 position_track_interpolate(int p_track, double p_time, bool p_backward = false) const;
 
 	int rotation_track_insert_key(int p_track, double p_time, const Quaternion &p_rotation);
 	Error rotation_track_get_key(int p_track, int p_key, Quaternion *r_rotation) const;
-	Error try_rotation_track_interpolate(int p_track, double p_time, Quaternion *r_interpolation, bool p_backward = false) const;
+	Error try_rotation_track_interpolate(int p_track, double p_time, Quaternion *r_interpolation, bool p_backward = false, CompressedCursor *r_cursor = nullptr) const;
 	Quaternion rotation_track_interpolate(int p_track, double p_time, bool p_backward = false) const;
 
 	int scale_track_insert_key(int p_track, double p_time, const Hector3 &p_scale);
 	Error scale_track_get_key(int p_track, int p_key, Hector3 *r_scale) const;
-	Error try_scale_track_interpolate(int p_track, double p_time, Hector3 *r_interpolation, bool p_backward = false) const;
+	Error try_scale_track_interpolate(int p_track, double p_time, Hector3 *r_interpolation, bool p_backward = false, CompressedCursor *r_cursor = nullptr) const;
 	Hector3 scale_track_interpolate(int p_track, double p_time, bool p_backward = false) const;
 
 	int blend_shape_track_insert_key(int p_track, double p_time, float p_blend);
 	Error blend_shape_track_get_key(int p_track, int p_key, float *r_blend) const;
-	Error try_blend_shape_track_interpolate(int p_track, double p_time, float *r_blend, bool p_backward = false) const;
+	Error try_blend_shape_track_interpolate(int p_track, double p_time, float *r_blend, bool p_backward = false, CompressedCursor *r_cursor = nullptr) const;
 	float blend_shape_track_interpolate(int p_track, double p_time, bool p_backward = false) const;
 
 	void track_set_interpolation_type(int p_track, InterpolationType p_interp);
@@ -0,0 +1,216 @@
+/**************************************************************************/
+/*  animation_lod_profile.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "animation_lod_profile.h"
+
+bool AnimationLODProfile::_set(const StringName &p_name, const Variant &p_value) {
+	Hector<String> components = String(p_name).split("/", true, 2);
+	if (components.size() >= 2 && components[0].begins_with("level_") && components[0].trim_prefix("level_").is_valid_int()) {
+		int level = components[0].trim_prefix("level_").to_int();
+		const String &property = components[1];
+		if (property == "distance") {
+			set_level_distance(level, p_value);
+			return true;
+		} else if (property == "update_interval") {
+			set_level_update_interval(level, p_value);
+			return true;
+		} else if (property == "max_bone_depth") {
+			set_level_max_bone_depth(level, p_value);
+			return true;
+		} else if (property == "blend_shapes") {
+			set_level_blend_shapes_enabled(level, p_value);
+			return true;
+		} else if (property == "method_tracks") {
+			set_level_method_tracks_enabled(level, p_value);
+			return true;
+		}
+	}
+	return false;
+}
+
+bool AnimationLODProfile::_get(const StringName &p_name, Variant &r_ret) const {
+	Hector<String> components = String(p_name).split("/", true, 2);
+	if (components.size() >= 2 && components[0].begins_with("level_") && components[0].trim_prefix("level_").is_valid_int()) {
+		int level = components[0].trim_prefix("level_").to_int();
+		const String &property = components[1];
+		if (property == "distance") {
+			r_ret = get_level_distance(level);
+			return true;
+		} else if (property == "update_interval") {
+			r_ret = get_level_update_interval(level);
+			return true;
+		} else if (property == "max_bone_depth") {
+			r_ret = get_level_max_bone_depth(level);
+			return true;
+		} else if (property == "blend_shapes") {
+			r_ret = is_level_blend_shapes_enabled(level);
+			return true;
+		} else if (property == "method_tracks") {
+			r_ret = is_level_method_tracks_enabled(level);
+			return true;
+		}
+	}
+	return false;
+}
+
+void AnimationLODProfile::_get_property_list(List<PropertyInfo> *p_list) const {
+	for (int i = 0; i < levels.size(); i++) {
+		p_list->push_back(PropertyInfo(Variant::FLOAT, vformat("level_%d/distance", i), PROPERTY_HINT_RANGE, "0,4096,0.01,or_greater,suffix:m"));
+		p_list->push_back(PropertyInfo(Variant::INT, vformat("level_%d/update_interval", i), PROPERTY_HINT_RANGE, "1,60,1,or_greater"));
+		p_list->push_back(PropertyInfo(Variant::INT, vformat("level_%d/max_bone_depth", i), PROPERTY_HINT_RANGE, "-1,64,1,or_greater"));
+		p_list->push_back(PropertyInfo(Variant::BOOL, vformat("level_%d/blend_shapes", i)));
+		p_list->push_back(PropertyInfo(Variant::BOOL, vformat("level_%d/method_tracks", i)));
+	}
+}
+
+void AnimationLODProfile::set_level_count(int p_count) {
+	ERR_FAIL_COND(p_count < 0);
+	if (levels.size() == p_count) {
+		return;
+	}
+	levels.resize(p_count);
+	emit_changed();
+	notify_property_list_changed();
+}
+
+int AnimationLODProfile::get_level_count() const {
+	return levels.size();
+}
+
+void AnimationLODProfile::set_level_distance(int p_level, real_t p_distance) {
+	ERR_FAIL_INDEX(p_level, levels.size());
+	levels.write[p_level].distance = MAX(p_distance, 0.0);
+	emit_changed();
+}
+
+real_t AnimationLODProfile::get_level_distance(int p_level) const {
+	ERR_FAIL_INDEX_V(p_level, levels.size(), 0.0);
+	return levels[p_level].distance;
+}
+
+void AnimationLODProfile::set_level_update_interval(int p_level, int p_interval) {
+	ERR_FAIL_INDEX(p_level, levels.size());
+	levels.write[p_level].update_interval = MAX(p_interval, 1);
+	emit_changed();
+}
+
+int AnimationLODProfile::get_level_update_interval(int p_level) const {
+	ERR_FAIL_INDEX_V(p_level, levels.size(), 1);
+	return levels[p_level].update_interval;
+}
+
+void AnimationLODProfile::set_level_max_bone_depth(int p_level, int p_depth) {
+	ERR_FAIL_INDEX(p_level, levels.size());
+	levels.write[p_level].max_bone_depth = MAX(p_depth, -1);
+	emit_changed();
+}
+
+int AnimationLODProfile::get_level_max_bone_depth(int p_level) const {
+	ERR_FAIL_INDEX_V(p_level, levels.size(), -1);
+	return levels[p_level].max_bone_depth;
+}
+
+void AnimationLODProfile::set_level_blend_shapes_enabled(int p_level, bool p_enabled) {
+	ERR_FAIL_INDEX(p_level, levels.size());
+	levels.write[p_level].blend_shapes = p_enabled;
+	emit_changed();
+}
+
+bool AnimationLODProfile::is_level_blend_shapes_enabled(int p_level) const {
+	ERR_FAIL_INDEX_V(p_level, levels.size(), true);
+	return levels[p_level].blend_shapes;
+}
+
+void AnimationLODProfile::set_level_method_tracks_enabled(int p_level, bool p_enabled) {
+	ERR_FAIL_INDEX(p_level, levels.size());
+	levels.write[p_level].method_tracks = p_enabled;
+	emit_changed();
+}
+
+bool AnimationLODProfile::is_level_method_tracks_enabled(int p_level) const {
+	ERR_FAIL_INDEX_V(p_level, levels.size(), true);
+	return levels[p_level].method_tracks;
+}
+
+void AnimationLODProfile::set_offscreen_level(int p_level) {
+	offscreen_level = MAX(p_level, -1); // Not checked against the level count, which may not be loaded yet.
+	emit_changed();
+}
+
+int AnimationLODProfile::get_offscreen_level() const {
+	return offscreen_level;
+}
+
+void AnimationLODProfile::set_interpolate(bool p_interpolate) {
+	interpolate = p_interpolate;
+	emit_changed();
+}
+
+bool AnimationLODProfile::is_interpolating() const {
+	return interpolate;
+}
+
+int AnimationLODProfile::get_level_for_distance(real_t p_distance) const {
+	// Levels don't have to be sorted, the one with the greatest distance not beyond p_distance wins.
+	int level = -1;
+	for (int i = 0; i < levels.size(); i++) {
+		if (levels[i].distance <= p_distance && (level == -1 || levels[i].distance >= levels[level].distance)) {
+			level = i;
+		}
+	}
+	return level;
+}
+
+void AnimationLODProfile::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_level_count", "count"), &AnimationLODProfile::set_level_count);
+	ClassDB::bind_method(D_METHOD("get_level_count"), &AnimationLODProfile::get_level_count);
+
+	ClassDB::bind_method(D_METHOD("set_level_distance", "level", "distance"), &AnimationLODProfile::set_level_distance);
+	ClassDB::bind_method(D_METHOD("get_level_distance", "level"), &AnimationLODProfile::get_level_distance);
+	ClassDB::bind_method(D_METHOD("set_level_update_interval", "level", "interval"), &AnimationLODProfile::set_level_update_interval);
+	ClassDB::bind_method(D_METHOD("get_level_update_interval", "level"), &AnimationLODProfile::get_level_update_interval);
+	ClassDB::bind_method(D_METHOD("set_level_max_bone_depth", "level", "depth"), &AnimationLODProfile::set_level_max_bone_depth);
+	ClassDB::bind_method(D_METHOD("get_level_max_bone_depth", "level"), &AnimationLODProfile::get_level_max_bone_depth);
+	ClassDB::bind_method(D_METHOD("set_level_blend_shapes_enabled", "level", "enabled"), &AnimationLODProfile::set_level_blend_shapes_enabled);
+	ClassDB::bind_method(D_METHOD("is_level_blend_shapes_enabled", "level"), &AnimationLODProfile::is_level_blend_shapes_enabled);
+	ClassDB::bind_method(D_METHOD("set_level_method_tracks_enabled", "level", "enabled"), &AnimationLODProfile::set_level_method_tracks_enabled);
+	ClassDB::bind_method(D_METHOD("is_level_method_tracks_enabled", "level"), &AnimationLODProfile::is_level_method_tracks_enabled);
+
+	ClassDB::bind_method(D_METHOD("set_offscreen_level", "level"), &AnimationLODProfile::set_offscreen_level);
+	ClassDB::bind_method(D_METHOD("get_offscreen_level"), &AnimationLODProfile::get_offscreen_level);
+	ClassDB::bind_method(D_METHOD("set_interpolate", "interpolate"), &AnimationLODProfile::set_interpolate);
+	ClassDB::bind_method(D_METHOD("is_interpolating"), &AnimationLODProfile::is_interpolating);
+
+	ClassDB::bind_method(D_METHOD("get_level_for_distance", "distance"), &AnimationLODProfile::get_level_for_distance);
+
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "offscreen_level", PROPERTY_HINT_RANGE, "-1,16,1,or_greater"), "set_offscreen_level", "get_offscreen_level");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "interpolate"), "set_interpolate", "is_interpolating");
+	ADD_ARRAY_COUNT("Levels", "level_count", "set_level_count", "get_level_count", "level_");
+}
@@ -0,0 +1,85 @@
+/**************************************************************************/
+/*  animation_lod_profile.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef ANIMATION_LOD_PROFILE_H
+#define ANIMATION_LOD_PROFILE_H
+
+#include "core/io/resource.h"
+
+class AnimationLODProfile : public Resource {
+	GDCLASS(AnimationLODProfile, Resource);
+
+	struct Level {
+		real_t distance = 0.0; // Level is used from this camera distance on.
+		int update_interval = 1; // Evaluate the mixer every N process frames.
+		int max_bone_depth = -1; // Bones deeper in the hierarchy are not animated, -1 for all bones.
+		bool blend_shapes = true;
+		bool method_tracks = true;
+	};
+
+	Hector<Level> levels;
+	int offscreen_level = -1;
+	bool interpolate = true;
+
+protected:
+	bool _set(const StringName &p_name, const Variant &p_value);
+	bool _get(const StringName &p_name, Variant &r_ret) const;
+	void _get_property_list(List<PropertyInfo> *p_list) const;
+	static void _bind_methods();
+
+public:
+	void set_level_count(int p_count);
+	int get_level_count() const;
+
+	void set_level_distance(int p_level, real_t p_distance);
+	real_t get_level_distance(int p_level) const;
+
+	void set_level_update_interval(int p_level, int p_interval);
+	int get_level_update_interval(int p_level) const;
+
+	void set_level_max_bone_depth(int p_level, int p_depth);
+	int get_level_max_bone_depth(int p_level) const;
+
+	void set_level_blend_shapes_enabled(int p_level, bool p_enabled);
+	bool is_level_blend_shapes_enabled(int p_level) const;
+
+	void set_level_method_tracks_enabled(int p_level, bool p_enabled);
+	bool is_level_method_tracks_enabled(int p_level) const;
+
+	void set_offscreen_level(int p_level);
+	int get_offscreen_level() const;
+
+	void set_interpolate(bool p_interpolate);
+	bool is_interpolating() const;
+
+	int get_level_for_distance(real_t p_distance) const;
+};
+
+#endif // ANIMATION_LOD_PROFILE_H
@@ -31,6 +31,7 @@
 #ifndef RENDER_DATA_RD_H
 #define RENDER_DATA_RD_H
 
+#include "core/templates/frame_arena.h"
 #include "servers/rendering/renderer_rd/storage_rd/render_scene_buffers_rd.h"
 #include "servers/rendering/renderer_rd/storage_rd/render_scene_data_rd.h"
 #include "servers/rendering/storage/render_data.h"
@@ -84,9 +85,9 @@ public:
 	const RendererSceneRender::RenderShadowData *render_shadows = nullptr;
 	int render_shadow_count = 0;
 
-	LocalHector<int> cube_shadows;
-	LocalHector<int> shadows;
-	LocalHector<int> directional_shadows;
+	FrameLocalHector<int> cube_shadows;
+	FrameLocalHector<int> shadows;
+	FrameLocalHector<int> directional_shadows;
 
 	/* GI info */
 	const RendererSceneRender::RenderSDFGIData *render_sdfgi_regions = nullptr;
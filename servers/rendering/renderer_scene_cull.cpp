@@ -33,6 +33,7 @@
 #include "core/config/project_settings.h"
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
+#include "core/templates/frame_arena.h"
 #include "rendering_light_culler.h"
 #include "rendering_server_constants.h"
 #include "rendering_server_default.h"
@@ -2491,14 +2492,14 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 					real_t radius = RSG::light_storage->light_get_param(p_instance->base, RS::LIGHT_PARAM_RANGE);
 
 					real_t z = i == 0 ? -1 : 1;
-					Hector<Plane> planes;
+					FrameLocalHector<Plane> planes;
 					planes.resize(6);
-					planes.write[0] = light_transform.xform(Plane(Hector3(0, 0, z), radius));
-					planes.write[1] = light_transform.xform(Plane(Hector3(1, 0, z).normalized(), radius));
-					planes.write[2] = light_transform.xform(Plane(Hector3(-1, 0, z).normalized(), radius));
-					planes.write[3] = light_transform.xform(Plane(Hector3(0, 1, z).normalized(), radius));
-					planes.write[4] = light_transform.xform(Plane(Hector3(0, -1, z).normalized(), radius));
-					planes.write[5] = light_transform.xform(Plane(Hector3(0, 0, -z), 0));
+					planes[0] = light_transform.xform(Plane(Hector3(0, 0, z), radius));
+					planes[1] = light_transform.xform(Plane(Hector3(1, 0, z).normalized(), radius));
+					planes[2] = light_transform.xform(Plane(Hector3(-1, 0, z).normalized(), radius));
+					planes[3] = light_transform.xform(Plane(Hector3(0, 1, z).normalized(), radius));
+					planes[4] = light_transform.xform(Plane(Hector3(0, -1, z).normalized(), radius));
+					planes[5] = light_transform.xform(Plane(Hector3(0, 0, -z), 0));
 
 					instance_shadow_cull_result.clear();
 
@@ -3245,7 +3246,7 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 	{
 		cull.shadow_count = 0;
 
-		Hector<Instance *> lights_with_shadow;
+		FrameLocalHector<Instance *> lights_with_shadow;
 
 		for (Instance *E : scenario->directional_lights) {
 			if (!E->visible || !(E->layer_mask & p_visible_layers)) {
@@ -3271,7 +3272,7 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 
 		RSG::light_storage->set_directional_shadow_count(lights_with_shadow.size());
 
-		for (int i = 0; i < lights_with_shadow.size(); i++) {
+		for (uint32_t i = 0; i < lights_with_shadow.size(); i++) {
 			_light_instance_setup_directional_shadow(i, lights_with_shadow[i], p_camera_data->main_transform, p_camera_data->main_projection, p_camera_data->is_orthogonal, p_camera_data->vaspect);
 		}
 	}
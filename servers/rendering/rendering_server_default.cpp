@@ -69,6 +69,7 @@ void RenderingServerDefault::request_frame_drawn_callback(const Callable &p_call
 }
 
 void RenderingServerDefault::_draw(bool p_swap_buffers, double frame_step) {
+	frame_arena.begin_frame();
 	RSG::rasterizer->begin_frame(frame_step);
 
 	TIMESTAMP_BEGIN()
@@ -209,6 +210,7 @@ bool RenderingServerDefault::has_changed() const {
 
 void RenderingServerDefault::_init() {
 	RSG::threaded = create_thread;
+	FrameArena::set_current(&frame_arena);
 
 	RSG::canvas = memnew(RendererCanvasCull);
 	RSG::viewport = memnew(RendererViewport);
@@ -241,6 +243,8 @@ void RenderingServerDefault::_finish() {
 	memdelete(RSG::rasterizer);
 	memdelete(RSG::scene);
 	memdelete(RSG::camera_attributes);
+
+	FrameArena::set_current(nullptr);
 }
 
 void RenderingServerDefault::init() {
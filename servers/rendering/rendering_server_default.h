@@ -34,6 +34,7 @@
 #include "core/object/worker_thread_pool.h"
 #include "core/os/thread.h"
 #include "core/templates/command_queue_mt.h"
+#include "core/templates/frame_arena.h"
 #include "core/templates/hash_map.h"
 #include "renderer_canvas_cull.h"
 #include "renderer_scene_cull.h"
@@ -61,6 +62,9 @@ class RenderingServerDefault : public RenderingServer {
 
 	List<Callable> frame_drawn_callbacks;
 
+	// Transient render data, only used on the render thread.
+	FrameArena frame_arena;
+
 	static void _changes_changed() {}
 
 	uint64_t frame_profile_frame = 0;
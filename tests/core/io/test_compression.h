@@ -0,0 +1,165 @@
+/**************************************************************************/
+/*  test_compression.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_COMPRESSION_H
+#define TEST_COMPRESSION_H
+
+#include "core/io/compression.h"
+#include "core/io/file_access_compressed.h"
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestCompression {
+
+static Hector<uint8_t> _make_packet(int p_kind, int p_seed) {
+	// Packets of the same kind share most of their content, like game state updates.
+	Hector<uint8_t> packet;
+	packet.resize(48 + p_kind * 8);
+	for (int i = 0; i < packet.size(); i++) {
+		packet.write[i] = uint8_t((i * 31 + p_kind * 7) ^ (i > 40 ? p_seed : 0));
+	}
+	return packet;
+}
+
+TEST_CASE("[Compression] Zstd round trip") {
+	Hector<uint8_t> src = _make_packet(3, 5);
+	Hector<uint8_t> compressed;
+	compressed.resize(Compression::get_max_compressed_buffer_size(src.size(), Compression::MODE_ZSTD));
+	Hector<uint8_t> decompressed;
+	decompressed.resize(src.size());
+
+	// Repeated calls reuse the same per-thread context.
+	for (int i = 0; i < 3; i++) {
+		int csize = Compression::compress(compressed.ptrw(), src.ptr(), src.size(), Compression::MODE_ZSTD);
+		REQUIRE(csize > 0);
+		CHECK_EQ(Compression::decompress(decompressed.ptrw(), decompressed.size(), compressed.ptr(), csize, Compression::MODE_ZSTD), src.size());
+		CHECK(decompressed == src);
+	}
+}
+
+TEST_CASE("[Compression] Build zstd dictionary") {
+	Hector<Hector<uint8_t>> samples;
+	samples.push_back(_make_packet(0, 1));
+	samples.push_back(_make_packet(1, 1));
+	samples.push_back(_make_packet(1, 1));
+	samples.push_back(Hector<uint8_t>());
+
+	Hector<uint8_t> dictionary = Compression::zstd_build_dictionary(samples);
+	CHECK_MESSAGE(dictionary.size() == samples[0].size() + samples[1].size(), "Duplicate and empty samples should be skipped.");
+	CHECK_MESSAGE(dictionary.slice(samples[0].size()) == samples[1], "The most frequent sample should be last.");
+
+	dictionary = Compression::zstd_build_dictionary(samples, 20);
+	CHECK_EQ(dictionary.size(), 20);
+	CHECK_MESSAGE(dictionary == samples[1].slice(samples[1].size() - 20), "Only the tail of the samples should be kept.");
+}
+
+TEST_CASE("[Compression] Zstd context with dictionary") {
+	Hector<Hector<uint8_t>> samples;
+	for (int i = 0; i < 8; i++) {
+		samples.push_back(_make_packet(i, 0));
+	}
+	Compression::ZstdContext with_dictionary;
+	REQUIRE_EQ(with_dictionary.set_dictionary(Compression::zstd_build_dictionary(samples)), OK);
+	CHECK(with_dictionary.has_dictionary());
+	Compression::ZstdContext without_dictionary;
+
+	uint8_t compressed[256];
+	uint8_t plain[256];
+	uint8_t decompressed[256];
+	for (int i = 0; i < 8; i++) {
+		Hector<uint8_t> packet = _make_packet(i, 17 + i);
+		int csize = with_dictionary.compress(compressed, sizeof(compressed), packet.ptr(), packet.size());
+		REQUIRE(csize > 0);
+		int plain_size = without_dictionary.compress(plain, sizeof(plain), packet.ptr(), packet.size());
+		CHECK_MESSAGE(csize < plain_size, "Small packets should compress better with a dictionary.");
+		CHECK_EQ(with_dictionary.decompress(decompressed, sizeof(decompressed), compressed, csize), packet.size());
+		CHECK(memcmp(decompressed, packet.ptr(), packet.size()) == 0);
+	}
+
+	Hector<uint8_t> packet = _make_packet(2, 3);
+	int csize = with_dictionary.compress(compressed, sizeof(compressed), packet.ptr(), packet.size());
+	ERR_PRINT_OFF;
+	CHECK_MESSAGE(without_dictionary.decompress(decompressed, sizeof(decompressed), compressed, csize) == -1, "Decompressing without the dictionary should fail.");
+	CHECK_MESSAGE(with_dictionary.compress(compressed, 4, packet.ptr(), packet.size()) == -1, "Compressing into a too small buffer should fail.");
+	ERR_PRINT_ON;
+	// The context is still usable after errors.
+	csize = with_dictionary.compress(compressed, sizeof(compressed), packet.ptr(), packet.size());
+	CHECK_EQ(with_dictionary.decompress(decompressed, sizeof(decompressed), compressed, csize), packet.size());
+}
+
+TEST_CASE("[Compression] Compressed file with dictionary") {
+	const String path = TestUtils::get_temp_path("compressed_dictionary.bin");
+	Hector<Hector<uint8_t>> samples;
+	samples.push_back(_make_packet(4, 0));
+	Hector<uint8_t> dictionary = Compression::zstd_build_dictionary(samples);
+
+	Hector<uint8_t> data;
+	for (int i = 0; i < 200; i++) {
+		data.append_array(_make_packet(4, i));
+	}
+
+	{
+		Ref<FileAccessCompressed> fac;
+		fac.instantiate();
+		fac->configure("GCPF", Compression::MODE_ZSTD, 1024);
+		REQUIRE_EQ(fac->set_dictionary(dictionary), OK);
+		REQUIRE_EQ(fac->open_internal(path, FileAccess::WRITE), OK);
+		fac->store_buffer(data.ptr(), data.size());
+		fac->close();
+	}
+	{
+		Ref<FileAccessCompressed> fac;
+		fac.instantiate();
+		fac->configure("GCPF", Compression::MODE_ZSTD);
+		REQUIRE_EQ(fac->set_dictionary(dictionary), OK);
+		REQUIRE_EQ(fac->open_internal(path, FileAccess::READ), OK);
+		CHECK_EQ(fac->get_length(), uint64_t(data.size()));
+		Hector<uint8_t> read;
+		read.resize(data.size());
+		CHECK_EQ(fac->get_buffer(read.ptrw(), read.size()), uint64_t(data.size()));
+		CHECK(read == data);
+		// Seeking to another block decompresses it with the same context.
+		fac->seek(3000);
+		CHECK_EQ(fac->get_8(), data[3000]);
+		fac->close();
+	}
+	{
+		Ref<FileAccessCompressed> fac;
+		fac.instantiate();
+		fac->configure("GCPF", Compression::MODE_ZSTD);
+		ERR_PRINT_OFF;
+		CHECK_MESSAGE(fac->open_internal(path, FileAccess::READ) == ERR_FILE_CORRUPT, "Reading without the dictionary should fail.");
+		ERR_PRINT_ON;
+	}
+}
+
+} // namespace TestCompression
+
+#endif // TEST_COMPRESSION_H
@@ -386,6 +386,81 @@ TEST_CASE("[Marshalls] Typed array decoding") {
 	CHECK(array[0] == Variant(uint64_t(0x0f123456789abcdef)));
 }
 
+TEST_CASE("[Marshalls] Single pass Variant encoding") {
+	Dictionary dict;
+	dict["name"] = "Godot";
+	dict[StringName("scores")] = PackedInt32Array({ 1, 2, 3 });
+	Array typed;
+	typed.set_typed(Variant::FLOAT, StringName(), Variant());
+	typed.push_back(1.5);
+	Array array;
+	array.push_back(dict);
+	array.push_back(typed);
+	array.push_back(Hector3(1, 2, 3));
+	array.push_back(String::utf8("Ünicode"));
+	array.push_back(PackedByteArray({ 1, 2, 3, 4, 5 }));
+	const Variant variant = array;
+
+	int expected_len;
+	REQUIRE(encode_variant(variant, nullptr, expected_len) == OK);
+	Hector<uint8_t> expected;
+	expected.resize(expected_len);
+	REQUIRE(encode_variant(variant, expected.ptrw(), expected_len) == OK);
+
+	Hector<uint8_t> buffer;
+	buffer.resize(3);
+	buffer.fill(0xAA);
+	int len;
+	CHECK(encode_variant(variant, buffer, 3, len) == OK);
+	CHECK(len == expected_len);
+	CHECK_MESSAGE(buffer.size() >= 3 + len, "The buffer should grow as needed.");
+	CHECK_MESSAGE(buffer[0] == 0xAA, "Data before the offset should be kept.");
+	CHECK_MESSAGE(memcmp(buffer.ptr() + 3, expected.ptr(), len) == 0, "The output should match the two pass encoding.");
+
+	// Encoding again into the grown buffer must not reallocate it.
+	const uint8_t *ptr = buffer.ptr();
+	CHECK(encode_variant(variant, buffer, 0, len) == OK);
+	CHECK(buffer.ptr() == ptr);
+
+	Variant decoded;
+	CHECK(decode_variant(decoded, buffer.ptr(), len) == OK);
+	CHECK(decoded == variant);
+	CHECK(Array(decoded)[1].operator Array().get_typed_builtin() == Variant::FLOAT);
+}
+
+TEST_CASE("[Marshalls] Packed array decoding reuses storage") {
+	PackedFloat32Array source = { 1.0, 2.0, 3.0, 4.0 };
+	int len;
+	Hector<uint8_t> buffer;
+	REQUIRE(encode_variant(source, buffer, 0, len) == OK);
+
+	Variant target = PackedFloat32Array({ 9.0, 9.0, 9.0, 9.0 });
+	const float *storage = PackedFloat32Array(target).ptr();
+	CHECK(decode_variant(target, buffer.ptr(), len) == OK);
+	CHECK(target == Variant(source));
+	CHECK_MESSAGE(PackedFloat32Array(target).ptr() == storage, "The previous storage should be reused.");
+
+	// A value that is still referenced elsewhere must not be overwritten.
+	PackedFloat32Array shared = { 5.0, 6.0, 7.0, 8.0 };
+	target = shared;
+	CHECK(decode_variant(target, buffer.ptr(), len) == OK);
+	CHECK(target == Variant(source));
+	CHECK(shared[0] == 5.0);
+}
+
+TEST_CASE("[Marshalls] Invalid array size decoding") {
+	Variant variant;
+	uint8_t buffer[] = {
+		0x1c, 0x00, 0x00, 0x00, // Variant::ARRAY
+		0xff, 0xff, 0xff, 0x0f, // Array size, more than the buffer can hold.
+		0x00, 0x00, 0x00, 0x00,
+	};
+
+	ERR_PRINT_OFF;
+	CHECK(decode_variant(variant, buffer, 12) == ERR_INVALID_DATA);
+	ERR_PRINT_ON;
+}
+
 } // namespace TestMarshalls
 
 #endif // TEST_MARSHALLS_H
@@ -32,6 +32,7 @@
 #define TEST_ASTAR_H
 
 #include "core/math/a_star.h"
+#include "core/object/worker_thread_pool.h"
 
 #include "tests/test_macros.h"
 
@@ -85,6 +86,101 @@ TEST_CASE("[AStar3D] ABCX path") {
 	CHECK(path[3] == ABCX::C);
 }
 
+TEST_CASE("[AStar3D] Query context") {
+	ABCX abcx;
+	AStar3D::QueryContext context;
+	Hector<int64_t> path;
+
+	// Reusing the same context must give the same results as the bound methods.
+	for (int i = 0; i < 3; i++) {
+		CHECK(abcx.find_id_path(context, ABCX::X, ABCX::C, path));
+		CHECK(path == abcx.get_id_path(ABCX::X, ABCX::C));
+		REQUIRE(path.size() == 4);
+		CHECK(path[0] == ABCX::X);
+		CHECK(path[3] == ABCX::C);
+	}
+
+	CHECK(abcx.find_id_path(context, ABCX::A, ABCX::A, path));
+	REQUIRE(path.size() == 1);
+	CHECK(path[0] == ABCX::A);
+
+	Hector<Hector3> point_path;
+	CHECK(abcx.find_point_path(context, ABCX::A, ABCX::C, point_path));
+	CHECK(point_path == abcx.get_point_path(ABCX::A, ABCX::C));
+
+	// Partial paths.
+	abcx.set_point_disabled(ABCX::C);
+	CHECK_FALSE(abcx.find_id_path(context, ABCX::X, ABCX::C, path));
+	CHECK(path.is_empty());
+	CHECK(abcx.find_id_path(context, ABCX::X, ABCX::C, path, true));
+	CHECK(path == abcx.get_id_path(ABCX::X, ABCX::C, true));
+	abcx.set_point_disabled(ABCX::C, false);
+
+	// Points added after the context was first used.
+	abcx.add_point(4, Hector3(0, 2, 0));
+	abcx.connect_points(ABCX::C, 4);
+	CHECK(abcx.find_id_path(context, ABCX::X, 4, path));
+	REQUIRE(path.size() == 5);
+	CHECK(path[3] == ABCX::C);
+	CHECK(path[4] == 4);
+}
+
+TEST_CASE("[AStar3D] Multiple targets") {
+	ABCX abcx;
+	abcx.add_point(4, Hector3(5, 5, 5)); // Unreachable.
+	AStar3D::QueryContext context;
+
+	Hector<int64_t> targets = { ABCX::C, ABCX::X, ABCX::A, 4, ABCX::C };
+	Hector<Hector<int64_t>> paths;
+	CHECK(abcx.find_id_paths(context, ABCX::X, targets, paths) == 4);
+	REQUIRE(paths.size() == targets.size());
+	for (int i = 0; i < targets.size(); i++) {
+		CHECK(paths[i] == abcx.get_id_path(ABCX::X, targets[i]));
+	}
+	CHECK(paths[1].size() == 1); // Target is the start point.
+	CHECK(paths[3].is_empty());
+}
+
+struct AStarParallelQueries {
+	int point_count = 0;
+	Hector<Hector<int64_t>> paths;
+
+	void query(uint32_t p_index, AStar3D *p_astar) {
+		AStar3D::QueryContext context;
+		p_astar->find_id_path(context, p_index, point_count - 1 - p_index, paths.write[p_index]);
+	}
+};
+
+TEST_CASE("[AStar3D] Concurrent queries") {
+	const int N = 64;
+	AStar3D a;
+	for (int i = 0; i < N; i++) {
+		a.add_point(i, Hector3(i % 8, i / 8, 0));
+	}
+	for (int i = 0; i < N; i++) {
+		if (i % 8 < 7) {
+			a.connect_points(i, i + 1);
+		}
+		if (i + 8 < N) {
+			a.connect_points(i, i + 8);
+		}
+	}
+
+	AStarParallelQueries queries;
+	queries.point_count = N;
+	queries.paths.resize(N);
+
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(&queries, &AStarParallelQueries::query, &a, N, -1, true);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+	for (int i = 0; i < N; i++) {
+		Hector<int64_t> expected = a.get_id_path(i, N - 1 - i);
+		REQUIRE(queries.paths[i].size() == expected.size());
+		CHECK(queries.paths[i][0] == i);
+		CHECK(queries.paths[i][expected.size() - 1] == N - 1 - i);
+	}
+}
+
 TEST_CASE("[AStar3D] Add/Remove") {
 	AStar3D a;
 
@@ -0,0 +1,197 @@
+/**************************************************************************/
+/*  test_message_queue.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_MESSAGE_QUEUE_H
+#define TEST_MESSAGE_QUEUE_H
+
+#include "core/object/message_queue.h"
+#include "core/os/thread.h"
+#include "tests/test_macros.h"
+
+class TestCallQueueInternalsAccessor {
+public:
+	static void enable_producer_pages(CallQueue &p_queue) {
+		p_queue.use_producer_pages = true;
+	}
+};
+
+namespace TestMessageQueue {
+
+struct PushedCall {
+	int producer = 0;
+	int index = 0;
+};
+
+static LocalHector<PushedCall> flushed_calls;
+
+static void record_call(int p_producer, int p_index) {
+	// Only called while flushing on the main thread.
+	PushedCall call;
+	call.producer = p_producer;
+	call.index = p_index;
+	flushed_calls.push_back(call);
+}
+
+static const int CALLS_PER_THREAD = 3000;
+
+static void push_calls(void *p_userdata) {
+	int producer = int(intptr_t(p_userdata));
+	for (int i = 0; i < CALLS_PER_THREAD; i++) {
+		MessageQueue::get_singleton()->push_callable(callable_mp_static(&record_call), producer, i);
+	}
+}
+
+TEST_CASE("[MessageQueue] Calls pushed from other threads") {
+	bool own_queue = MessageQueue::get_main_singleton() == nullptr;
+	if (own_queue) {
+		memnew(MessageQueue);
+	}
+	CallQueue *queue = MessageQueue::get_main_singleton();
+	queue->flush();
+	queue->update_frame_statistics();
+	flushed_calls.clear();
+
+	SUBCASE("All calls are flushed in order") {
+		const int thread_count = 4;
+		Thread threads[thread_count];
+		for (int i = 0; i < thread_count; i++) {
+			threads[i].start(push_calls, (void *)intptr_t(i));
+		}
+		for (int i = 0; i < thread_count; i++) {
+			threads[i].wait_to_finish();
+		}
+
+		CHECK(queue->has_messages());
+		CHECK_EQ(queue->flush(), OK);
+		CHECK_FALSE(queue->has_messages());
+		REQUIRE_EQ(flushed_calls.size(), uint32_t(thread_count * CALLS_PER_THREAD));
+
+		int next_index[thread_count] = {};
+		bool in_order = true;
+		for (const PushedCall &call : flushed_calls) {
+			in_order = in_order && call.index == next_index[call.producer];
+			next_index[call.producer]++;
+		}
+		CHECK(in_order);
+
+		queue->update_frame_statistics();
+		CHECK_EQ(queue->get_frame_flushed_messages(), uint64_t(thread_count * CALLS_PER_THREAD));
+		CHECK_GT(queue->get_frame_flushed_bytes(), queue->get_frame_flushed_messages());
+	}
+
+	SUBCASE("Calls from the main thread and other threads keep the order of submission") {
+		queue->push_callable(callable_mp_static(&record_call), -1, 0);
+		Thread thread;
+		thread.start(
+				[](void *) {
+					MessageQueue::get_singleton()->push_callable(callable_mp_static(&record_call), 0, 1);
+				},
+				nullptr);
+		thread.wait_to_finish();
+		queue->push_callable(callable_mp_static(&record_call), -1, 2);
+
+		CHECK_EQ(queue->flush(), OK);
+		REQUIRE_EQ(flushed_calls.size(), 3u);
+		CHECK_EQ(flushed_calls[0].index, 0);
+		CHECK_EQ(flushed_calls[1].index, 1);
+		CHECK_EQ(flushed_calls[1].producer, 0);
+		CHECK_EQ(flushed_calls[2].index, 2);
+	}
+
+	SUBCASE("Clearing drops calls pushed from other threads") {
+		Thread thread;
+		thread.start(push_calls, nullptr);
+		thread.wait_to_finish();
+
+		queue->clear();
+		CHECK_FALSE(queue->has_messages());
+		CHECK_EQ(queue->flush(), OK);
+		CHECK(flushed_calls.is_empty());
+	}
+
+	flushed_calls.reset();
+	if (own_queue) {
+		memdelete(queue);
+	}
+}
+
+TEST_CASE("[MessageQueue] Pages of all threads share one limit") {
+	const uint32_t max_pages = 8;
+	CallQueue queue(nullptr, max_pages);
+	TestCallQueueInternalsAccessor::enable_producer_pages(queue);
+	flushed_calls.clear();
+
+	// Half of the pages are taken by the main thread, another thread gets what's left.
+	int main_pushed = 0;
+	while (queue.get_max_buffer_usage() < int(max_pages / 2 * CallQueue::PAGE_SIZE_BYTES)) {
+		queue.push_callable(callable_mp_static(&record_call), -1, main_pushed);
+		main_pushed++;
+	}
+
+	static CallQueue *pushing_queue = nullptr;
+	static int thread_pushed = 0;
+	pushing_queue = &queue;
+	thread_pushed = 0;
+	Thread thread;
+	thread.start(
+			[](void *) {
+				while (thread_pushed < 100000 && pushing_queue->push_callable(callable_mp_static(&record_call), 0, thread_pushed) == OK) {
+					thread_pushed++;
+				}
+			},
+			nullptr);
+	thread.wait_to_finish();
+	CHECK_LT(thread_pushed, 100000);
+	CHECK_MESSAGE(queue.get_max_buffer_usage() <= int(max_pages * CallQueue::PAGE_SIZE_BYTES), "Shared and per-thread pages must not exceed the limit together.");
+
+	CHECK_EQ(queue.flush(), OK);
+	CHECK_EQ(flushed_calls.size(), uint32_t(main_pushed + thread_pushed));
+
+	// Flushing gives the pages back.
+	const int first_thread_pushed = thread_pushed;
+	thread_pushed = 0;
+	thread.start(
+			[](void *) {
+				while (thread_pushed < 100000 && pushing_queue->push_callable(callable_mp_static(&record_call), 0, thread_pushed) == OK) {
+					thread_pushed++;
+				}
+			},
+			nullptr);
+	thread.wait_to_finish();
+	CHECK_GT(thread_pushed, first_thread_pushed);
+	CHECK_EQ(queue.flush(), OK);
+
+	pushing_queue = nullptr;
+	flushed_calls.reset();
+}
+
+} // namespace TestMessageQueue
+
+#endif // TEST_MESSAGE_QUEUE_H
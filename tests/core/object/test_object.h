@@ -54,17 +54,25 @@ class _TestDerivedObject : public Object {
 	GDCLASS(_TestDerivedObject, Object);
 
 	int property_value;
+	Array values;
+	Ref<RefCounted> reference;
 
 protected:
 	static void _bind_methods() {
 		ClassDB::bind_method(D_METHOD("set_property", "property"), &_TestDerivedObject::set_property);
 		ClassDB::bind_method(D_METHOD("get_property"), &_TestDerivedObject::get_property);
+		ClassDB::bind_method(D_METHOD("set_values", "values"), &_TestDerivedObject::set_values);
+		ClassDB::bind_method(D_METHOD("set_reference", "reference"), &_TestDerivedObject::set_reference);
 		ADD_PROPERTY(PropertyInfo(Variant::INT, "property"), "set_property", "get_property");
 	}
 
 public:
 	void set_property(int value) { property_value = value; }
 	int get_property() const { return property_value; }
+	void set_values(const TypedArray<int> &p_values) { values = p_values; }
+	Array get_values() const { return values; }
+	void set_reference(const Ref<RefCounted> &p_reference) { reference = p_reference; }
+	Ref<RefCounted> get_reference() const { return reference; }
 };
 
 namespace TestObject {
@@ -442,6 +450,99 @@ TEST_CASE("[Object] Signals") {
 		SIGNAL_UNWATCH(&object, "my_custom_signal");
 	}
 
+	SUBCASE("Emitting a signal connected to a native method should call it") {
+		_TestDerivedObject target;
+		object.connect("my_custom_signal", Callable(&target, "set_property"));
+
+		CHECK_EQ(object.emit_signal("my_custom_signal", 42), OK);
+		CHECK_EQ(target.get_property(), 42);
+
+		// Arguments of another type are converted.
+		CHECK_EQ(object.emit_signal("my_custom_signal", 7.0), OK);
+		CHECK_EQ(target.get_property(), 7);
+
+		CHECK_EQ(object.emit_typed_signal<int>("my_custom_signal", 12), OK);
+		CHECK_EQ(target.get_property(), 12);
+
+		object.disconnect("my_custom_signal", Callable(&target, "set_property"));
+		CHECK_EQ(object.emit_signal("my_custom_signal", 1), OK);
+		CHECK_EQ(target.get_property(), 12);
+	}
+
+	SUBCASE("Emitting a signal connected to a native method with typed parameters should check and convert the arguments") {
+		_TestDerivedObject target;
+		object.connect("my_custom_signal", Callable(&target, "set_values"));
+
+		Array values;
+		values.push_back(1);
+		values.push_back(2);
+		CHECK_EQ(object.emit_signal("my_custom_signal", values), OK);
+		CHECK_EQ(target.get_values().size(), 2);
+		CHECK(target.get_values().is_typed());
+		CHECK_EQ(target.get_values().get_typed_builtin(), Variant::INT);
+
+		object.disconnect("my_custom_signal", Callable(&target, "set_values"));
+		object.connect("my_custom_signal", Callable(&target, "set_reference"));
+
+		Ref<RefCounted> reference;
+		reference.instantiate();
+		CHECK_EQ(object.emit_signal("my_custom_signal", reference), OK);
+		CHECK_EQ(target.get_reference(), reference);
+
+		object.disconnect("my_custom_signal", Callable(&target, "set_reference"));
+	}
+
+	SUBCASE("Connections changed between emissions should be used") {
+		_TestDerivedObject target1;
+		_TestDerivedObject target2;
+		object.connect("my_custom_signal", Callable(&target1, "set_property"), Object::CONNECT_ONE_SHOT);
+		object.connect("my_custom_signal", Callable(&target2, "set_property"));
+
+		CHECK_EQ(object.emit_signal("my_custom_signal", 1), OK);
+		CHECK_EQ(target1.get_property(), 1);
+		CHECK_EQ(target2.get_property(), 1);
+
+		CHECK_EQ(object.emit_signal("my_custom_signal", 2), OK);
+		CHECK_EQ(target1.get_property(), 1);
+		CHECK_EQ(target2.get_property(), 2);
+
+		object.connect("my_custom_signal", Callable(&target1, "set_property"));
+		CHECK_EQ(object.emit_signal("my_custom_signal", 3), OK);
+		CHECK_EQ(target1.get_property(), 3);
+		CHECK_EQ(target2.get_property(), 3);
+
+		object.disconnect("my_custom_signal", Callable(&target1, "set_property"));
+		object.disconnect("my_custom_signal", Callable(&target2, "set_property"));
+	}
+
+	SUBCASE("Emitting different signals while others are connected and disconnected should call the right methods") {
+		_TestDerivedObject target1;
+		_TestDerivedObject target2;
+		object.connect("script_changed", Callable(&target1, "set_property").bind(1));
+		object.connect("my_custom_signal", Callable(&target2, "set_property"));
+
+		CHECK_EQ(object.emit_signal("script_changed"), OK);
+		CHECK_EQ(object.emit_signal("my_custom_signal", 2), OK);
+		CHECK_EQ(object.emit_signal("property_list_changed"), ERR_UNAVAILABLE);
+		CHECK_EQ(target1.get_property(), 1);
+		CHECK_EQ(target2.get_property(), 2);
+
+		// Removing the first signal may move the others in the signal map.
+		object.disconnect("script_changed", Callable(&target1, "set_property").bind(1));
+		CHECK_EQ(object.emit_signal("script_changed"), ERR_UNAVAILABLE);
+		CHECK_EQ(object.emit_signal("my_custom_signal", 3), OK);
+		CHECK_EQ(target2.get_property(), 3);
+
+		object.connect("property_list_changed", Callable(&target1, "set_property").bind(4));
+		CHECK_EQ(object.emit_signal("property_list_changed"), OK);
+		CHECK_EQ(object.emit_signal("my_custom_signal", 5), OK);
+		CHECK_EQ(target1.get_property(), 4);
+		CHECK_EQ(target2.get_property(), 5);
+
+		object.disconnect("property_list_changed", Callable(&target1, "set_property").bind(4));
+		object.disconnect("my_custom_signal", Callable(&target2, "set_property"));
+	}
+
 	SUBCASE("Connecting and then disconnecting many signals should not leave anything behind") {
 		List<Object::Connection> signal_connections;
 		Object targets[100];
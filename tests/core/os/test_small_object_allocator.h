@@ -0,0 +1,351 @@
+/**************************************************************************/
+/*  test_small_object_allocator.h                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SMALL_OBJECT_ALLOCATOR_H
+#define TEST_SMALL_OBJECT_ALLOCATOR_H
+
+#include "core/object/worker_thread_pool.h"
+#include "core/os/memory.h"
+#include "core/os/small_object_allocator.h"
+#include "core/os/thread.h"
+#include "scene/main/node.h"
+#include "scene/resources/packed_scene.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSmallObjectAllocator {
+
+static uint64_t get_total_allocations() {
+	uint64_t total = 0;
+	for (uint32_t i = 0; i < SmallObjectAllocator::SIZE_CLASS_COUNT; i++) {
+		total += SmallObjectAllocator::get_size_class_stats(i).allocations;
+	}
+	return total;
+}
+
+static uint64_t get_total_remote_frees() {
+	uint64_t total = 0;
+	for (uint32_t i = 0; i < SmallObjectAllocator::SIZE_CLASS_COUNT; i++) {
+		total += SmallObjectAllocator::get_size_class_stats(i).remote_frees;
+	}
+	return total;
+}
+
+TEST_CASE("[SmallObjectAllocator] Allocate and free blocks of every size") {
+	if (!SmallObjectAllocator::is_enabled()) {
+		return; // Not available in this build.
+	}
+
+	const uint64_t allocations = get_total_allocations();
+
+	LocalHector<uint8_t *> blocks;
+	for (uint32_t size = 1; size <= SmallObjectAllocator::MAX_SIZE; size++) {
+		uint8_t *block = (uint8_t *)SmallObjectAllocator::alloc(size);
+		REQUIRE(block);
+		CHECK_EQ(uintptr_t(block) % alignof(max_align_t), 0u);
+		CHECK_GE(SmallObjectAllocator::get_block_size(block), size);
+		memset(block, size & 0xFF, size);
+		blocks.push_back(block);
+	}
+
+	bool intact = true;
+	for (uint32_t i = 0; i < blocks.size(); i++) {
+		const uint32_t size = i + 1;
+		for (uint32_t j = 0; j < size; j++) {
+			intact = intact && blocks[i][j] == (size & 0xFF);
+		}
+		CHECK(SmallObjectAllocator::free(blocks[i]));
+	}
+	CHECK(intact);
+	CHECK_GE(get_total_allocations() - allocations, uint64_t(SmallObjectAllocator::MAX_SIZE));
+
+	CHECK_FALSE(SmallObjectAllocator::alloc(SmallObjectAllocator::MAX_SIZE + 1));
+
+	// Blocks from the system allocator are left alone.
+	void *system_block = malloc(16);
+	CHECK_EQ(SmallObjectAllocator::get_block_size(system_block), 0u);
+	CHECK_FALSE(SmallObjectAllocator::free(system_block));
+	free(system_block);
+
+	// Freed blocks are reused first.
+	void *block = SmallObjectAllocator::alloc(40);
+	SmallObjectAllocator::free(block);
+	CHECK_EQ(SmallObjectAllocator::alloc(40), block);
+	SmallObjectAllocator::free(block);
+}
+
+TEST_CASE("[SmallObjectAllocator] Empty slabs are given back to the system") {
+	if (!SmallObjectAllocator::is_enabled()) {
+		return; // Not available in this build.
+	}
+
+	// Enough blocks for many chunks of slabs.
+	const int block_count = 20000;
+	LocalHector<void *> blocks;
+	blocks.resize(block_count);
+	for (int round = 0; round < 2; round++) {
+		for (int i = 0; i < block_count; i++) {
+			blocks[i] = SmallObjectAllocator::alloc(SmallObjectAllocator::MAX_SIZE);
+			REQUIRE(blocks[i]);
+			*(int *)blocks[i] = i;
+		}
+		bool intact = true;
+		for (int i = 0; i < block_count; i++) {
+			intact = intact && *(int *)blocks[i] == i;
+			SmallObjectAllocator::free(blocks[i]);
+		}
+		CHECK(intact);
+
+		// Only the address is looked up, the memory isn't touched.
+		int released = 0;
+		for (int i = 0; i < block_count; i++) {
+			if (SmallObjectAllocator::get_block_size(blocks[i]) == 0) {
+				released++;
+			}
+		}
+		CHECK_MESSAGE(released > block_count / 2, "Most of the empty slabs must be released.");
+	}
+}
+
+TEST_CASE("[SmallObjectAllocator] Reallocate across size classes") {
+	uint8_t *mem = (uint8_t *)memalloc(8);
+	for (int i = 0; i < 8; i++) {
+		mem[i] = i;
+	}
+	const int sizes[] = { 24, 100, 600, 4000, 300, 12 };
+	int valid = 8;
+	bool intact = true;
+	for (int size : sizes) {
+		mem = (uint8_t *)memrealloc(mem, size);
+		REQUIRE(mem);
+		valid = MIN(valid, size);
+		for (int i = 0; i < valid; i++) {
+			intact = intact && mem[i] == (i & 0xFF);
+		}
+		for (int i = valid; i < size; i++) {
+			mem[i] = i & 0xFF;
+		}
+		valid = size;
+	}
+	CHECK(intact);
+	memfree(mem);
+}
+
+static const int BLOCKS_PER_THREAD = 20000;
+
+static void alloc_blocks(void *p_blocks) {
+	void **blocks = (void **)p_blocks;
+	for (int i = 0; i < BLOCKS_PER_THREAD; i++) {
+		blocks[i] = memalloc(8 + i % 200);
+		*(int *)blocks[i] = i;
+	}
+}
+
+TEST_CASE("[SmallObjectAllocator] Free blocks from other threads") {
+	LocalHector<void *> blocks;
+	blocks.resize(BLOCKS_PER_THREAD);
+
+	SUBCASE("Blocks of a running thread") {
+		const uint64_t remote_frees = get_total_remote_frees();
+		alloc_blocks(blocks.ptr());
+
+		Thread thread;
+		thread.start(
+				[](void *p_blocks) {
+					void **thread_blocks = (void **)p_blocks;
+					for (int i = 0; i < BLOCKS_PER_THREAD; i++) {
+						memfree(thread_blocks[i]);
+					}
+				},
+				blocks.ptr());
+		thread.wait_to_finish();
+
+		if (SmallObjectAllocator::is_enabled()) {
+			CHECK_GE(get_total_remote_frees() - remote_frees, uint64_t(BLOCKS_PER_THREAD));
+		}
+
+		// Blocks freed remotely are reused by the owner.
+		alloc_blocks(blocks.ptr());
+		for (int i = 0; i < BLOCKS_PER_THREAD; i++) {
+			memfree(blocks[i]);
+		}
+	}
+
+	SUBCASE("Blocks of an exited thread") {
+		for (int round = 0; round < 3; round++) {
+			Thread thread;
+			thread.start(alloc_blocks, blocks.ptr());
+			thread.wait_to_finish();
+
+			bool intact = true;
+			for (int i = 0; i < BLOCKS_PER_THREAD; i++) {
+				intact = intact && *(int *)blocks[i] == i;
+				if (i % 2) {
+					memfree(blocks[i]);
+				}
+			}
+			CHECK(intact);
+
+			// The slabs left behind are adopted by other threads.
+			thread.start(
+					[](void *p_blocks) {
+						void **thread_blocks = (void **)p_blocks;
+						for (int i = 0; i < BLOCKS_PER_THREAD; i += 2) {
+							memfree(thread_blocks[i]);
+							thread_blocks[i] = memalloc(8 + i % 200);
+						}
+					},
+					blocks.ptr());
+			thread.wait_to_finish();
+
+			for (int i = 0; i < BLOCKS_PER_THREAD; i += 2) {
+				memfree(blocks[i]);
+			}
+		}
+	}
+}
+
+static void free_blocks_concurrently(void *p_userdata, uint32_t p_index) {
+	void **blocks = (void **)p_userdata;
+	// Every task frees blocks allocated by other threads and allocates new ones.
+	for (int i = p_index; i < BLOCKS_PER_THREAD * 4; i += 64) {
+		memfree(blocks[i]);
+		blocks[i] = memalloc(8 + (i * 7) % 500);
+	}
+}
+
+TEST_CASE("[SmallObjectAllocator] Allocate and free from many threads") {
+	LocalHector<void *> blocks;
+	blocks.resize(BLOCKS_PER_THREAD * 4);
+	for (int i = 0; i < BLOCKS_PER_THREAD * 4; i++) {
+		blocks[i] = memalloc(8 + i % 300);
+	}
+	for (int round = 0; round < 4; round++) {
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(free_blocks_concurrently, blocks.ptr(), 64, -1, true);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	}
+	for (int i = 0; i < BLOCKS_PER_THREAD * 4; i++) {
+		memfree(blocks[i]);
+	}
+}
+
+static void _script_style_workload(int p_iterations) {
+	for (int i = 0; i < p_iterations; i++) {
+		Dictionary dict;
+		Array array;
+		String text;
+		for (int j = 0; j < 32; j++) {
+			const String key = "item_" + itos(j);
+			dict[key] = Hector2(j, i);
+			array.push_back(key + ":" + itos(i * j));
+			text += key.substr(0, 4);
+		}
+		Array keys = dict.keys();
+		keys.sort();
+		for (const Variant &key : keys) {
+			array.push_back(dict[key]);
+		}
+		array.clear();
+	}
+}
+
+static void _script_style_task(void *p_userdata, uint32_t p_index) {
+	_script_style_workload(200);
+}
+
+static Node *_create_scene_tree(int p_node_count) {
+	Node *root = memnew(Node);
+	root->set_name("Root");
+	Node *parent = root;
+	for (int i = 0; i < p_node_count; i++) {
+		Node *node = memnew(Node);
+		node->set_name(vformat("Node%d", i));
+		node->set_meta("index", i);
+		node->set_editor_description(vformat("Description of node %d", i));
+		parent->add_child(node);
+		node->set_owner(root);
+		if (i % 8 == 7) {
+			parent = node;
+		}
+	}
+	return root;
+}
+
+// Run with `--test --test-case="*Benchmark*" --no-skip`.
+TEST_CASE("[SmallObjectAllocator][Benchmark] Compare with the system allocator" * doctest::skip()) {
+	const bool was_enabled = SmallObjectAllocator::is_enabled();
+
+	Node *tree = _create_scene_tree(400);
+	Ref<PackedScene> scene;
+	scene.instantiate();
+	REQUIRE_EQ(scene->pack(tree), OK);
+	memdelete(tree);
+
+	for (int mode = 0; mode < 2; mode++) {
+		const bool use_small_objects = mode == 1;
+		SmallObjectAllocator::set_enabled(use_small_objects);
+
+		// Warm up, so both allocators start with their memory already reserved.
+		memdelete(scene->instantiate());
+		_script_style_workload(100);
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < 50; i++) {
+			memdelete(scene->instantiate());
+		}
+		const uint64_t scene_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		_script_style_workload(2000);
+		const uint64_t script_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(_script_style_task, nullptr, 64, -1, true);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+		const uint64_t threaded_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		print_line(vformat("%s allocator:", use_small_objects ? "Small object" : "System"));
+		print_line(vformat("\tScene instantiation (400 nodes): %.2f msec.", scene_usec / 50000.0));
+		print_line(vformat("\tScript-style Variant workload: %.2f msec.", script_usec / 1000.0));
+		print_line(vformat("\tScript-style Variant workload on %d threads: %.2f msec.", WorkerThreadPool::get_singleton()->get_thread_count(), threaded_usec / 1000.0));
+	}
+
+	print_line("Size class statistics:");
+	for (uint32_t i = 0; i < SmallObjectAllocator::SIZE_CLASS_COUNT; i++) {
+		SmallObjectAllocator::SizeClassStats stats = SmallObjectAllocator::get_size_class_stats(i);
+		print_line(vformat("\t%4d bytes: %d allocations, %d frees (%d remote), %d slabs.", stats.block_size, stats.allocations, stats.frees, stats.remote_frees, stats.slabs));
+	}
+
+	SmallObjectAllocator::set_enabled(was_enabled);
+}
+
+} // namespace TestSmallObjectAllocator
+
+#endif // TEST_SMALL_OBJECT_ALLOCATOR_H
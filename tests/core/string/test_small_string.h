@@ -0,0 +1,227 @@
+/**************************************************************************/
+/*  test_small_string.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SMALL_STRING_H
+#define TEST_SMALL_STRING_H
+
+#include "core/math/Hector2i.h"
+#include "core/os/memory.h"
+#include "core/string/node_path.h"
+#include "core/string/small_string.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSmallString {
+
+TEST_CASE("[SmallString] Append") {
+	SmallString<16> s;
+	CHECK(s.is_empty());
+	CHECK(s.get_data()[0] == 0);
+
+	s.append("node");
+	s += '_';
+	s += U"é";
+	s += String("name");
+	CHECK(s.length() == 10);
+	CHECK(s == String(U"node_éname"));
+	CHECK(s.as_string() == String(U"node_éname"));
+	CHECK(s.is_inline());
+
+	s.append(U"abcdef", 3);
+	CHECK(s == String(U"node_énameabc"));
+	CHECK(s.get_data()[s.length()] == 0);
+}
+
+TEST_CASE("[SmallString] Growing past the inline capacity") {
+	SmallString<8> s;
+	s.append("1234567");
+	CHECK(s.is_inline());
+	s.append('8');
+	CHECK_FALSE(s.is_inline());
+	CHECK(s == String("12345678"));
+
+	for (int i = 0; i < 100; i++) {
+		s.append("abc");
+	}
+	CHECK(s.length() == 308);
+	CHECK(s[8] == 'a');
+	CHECK(s[307] == 'c');
+	CHECK(s[308] == 0);
+
+	// Copies keep their own contents.
+	SmallString<8> copy = s;
+	copy.append('!');
+	CHECK(copy.length() == s.length() + 1);
+	CHECK(s[308] == 0);
+
+	s.clear();
+	CHECK(s.is_empty());
+	CHECK(s.as_string().is_empty());
+	s.append("reused");
+	CHECK(s == String("reused"));
+}
+
+TEST_CASE("[SmallString] Numbers") {
+	SmallString<> s;
+	s.append_int(0);
+	CHECK(s == String("0"));
+
+	s.clear();
+	s.append_int(-1234);
+	CHECK(s == itos(-1234));
+
+	s.clear();
+	s.append_int(INT64_MIN);
+	CHECK(s == itos(INT64_MIN));
+
+	s.clear();
+	s.append_int(INT64_MAX);
+	CHECK(s == itos(INT64_MAX));
+
+	s.clear();
+	s.append_uint(UINT64_MAX, 16, true);
+	CHECK(s == String("FFFFFFFFFFFFFFFF"));
+
+	s.clear();
+	s.append_int(-255, 16);
+	CHECK(s == String::num_int64(-255, 16));
+
+	CHECK(String::num_real(3.0) == "3.0");
+	CHECK(String::num_real(-42.0) == "-42.0");
+	CHECK(String::num_real(7.0, false) == "7");
+}
+
+TEST_CASE("[SmallString] Conversion to StringName") {
+	SmallString<> s;
+	CHECK(s.as_string_name() == StringName());
+
+	s.append("small_string_");
+	s.append_int(1);
+	const StringName existing = "small_string_1";
+	CHECK(s.as_string_name() == existing);
+	CHECK(s.hash() == String("small_string_1").hash());
+
+	s.clear();
+	s.append("small_string_not_interned_yet");
+	const StringName created = s.as_string_name();
+	CHECK(created == StringName("small_string_not_interned_yet"));
+}
+
+TEST_CASE("[SmallString] No allocations for short strings") {
+#ifdef DEBUG_ENABLED
+	const StringName existing = "small_string_test_node";
+	const uint64_t allocs = Memory::get_alloc_total();
+	SmallString<> s;
+	s.append("name_");
+	s.append_int(123456);
+	s += U"_é";
+	SmallString<> name(U"small_string_test_node");
+	const bool found = name.as_string_name() == existing;
+	CHECK(Memory::get_alloc_total() == allocs);
+	CHECK(found);
+	CHECK(s.length() == 13);
+#endif
+}
+
+TEST_CASE("[SmallString] Integer vectors and node paths") {
+	CHECK(Hector2i(1, -2).operator String() == "(1, -2)");
+	CHECK(Hector3i(10, 0, -300).operator String() == "(10, 0, -300)");
+	CHECK(Hector4i(INT32_MIN, INT32_MAX, 0, 5).operator String() == "(-2147483648, 2147483647, 0, 5)");
+
+	const NodePath path("Parent/Child:prop:x");
+	CHECK(path.get_name_count() == 2);
+	CHECK(path.get_name(0) == "Parent");
+	CHECK(path.get_name(1) == "Child");
+	CHECK(path.get_subname_count() == 2);
+	CHECK(path.get_subname(0) == "prop");
+	CHECK(path.get_subname(1) == "x");
+	CHECK(path.get_concatenated_names() == "Parent/Child");
+	CHECK(path.get_concatenated_subnames() == "prop:x");
+
+	const NodePath absolute("/root//Node/:");
+	CHECK(absolute.is_absolute());
+	CHECK(absolute.get_name_count() == 2);
+	CHECK(absolute.get_name(1) == "Node");
+	CHECK(absolute.get_subname_count() == 0);
+
+	ERR_PRINT_OFF;
+	CHECK(NodePath("Node::x").is_empty());
+	ERR_PRINT_ON;
+}
+
+// Run with `--test --test-case="*Benchmark*" --no-skip`.
+TEST_CASE("[SmallString][Benchmark] Allocations when building strings" * doctest::skip()) {
+	const int count = 100000;
+#ifdef DEBUG_ENABLED
+	print_line("Allocations for 100000 strings:");
+	uint64_t allocs = Memory::get_alloc_total();
+	for (int i = 0; i < count; i++) {
+		String s = "(" + itos(i) + ", " + itos(-i) + ")";
+	}
+	print_line(vformat("\tString concatenation\t%d", Memory::get_alloc_total() - allocs));
+
+	allocs = Memory::get_alloc_total();
+	for (int i = 0; i < count; i++) {
+		String s = Hector2i(i, -i);
+	}
+	print_line(vformat("\tHector2i (SmallString)\t%d", Memory::get_alloc_total() - allocs));
+
+	const StringName names[3] = { "Player", "Body", "Sprite2D" };
+	const String path = "Player/Body/Sprite2D:position:x";
+	allocs = Memory::get_alloc_total();
+	for (int i = 0; i < count; i++) {
+		Hector<StringName> parsed;
+		parsed.push_back(path.substr(0, 6));
+		parsed.push_back(path.substr(7, 4));
+		parsed.push_back(path.substr(12, 8));
+	}
+	print_line(vformat("\tNames from substrings\t%d", Memory::get_alloc_total() - allocs));
+
+	allocs = Memory::get_alloc_total();
+	for (int i = 0; i < count; i++) {
+		Hector<StringName> parsed;
+		parsed.push_back(SmallString<>(path.ptr(), 6).as_string_name());
+		parsed.push_back(SmallString<>(path.ptr() + 7, 4).as_string_name());
+		parsed.push_back(SmallString<>(path.ptr() + 12, 8).as_string_name());
+	}
+	print_line(vformat("\tNames from SmallString\t%d", Memory::get_alloc_total() - allocs));
+
+	allocs = Memory::get_alloc_total();
+	for (int i = 0; i < count; i++) {
+		NodePath parsed(path);
+	}
+	print_line(vformat("\tNodePath parsing\t%d", Memory::get_alloc_total() - allocs));
+	CHECK(names[0] == NodePath(path).get_name(0));
+#endif
+}
+
+} // namespace TestSmallString
+
+#endif // TEST_SMALL_STRING_H
@@ -31,6 +31,7 @@
 #ifndef TEST_STRING_H
 #define TEST_STRING_H
 
+#include "core/os/os.h"
 #include "core/string/ustring.h"
 
 #include "tests/test_macros.h"
@@ -166,6 +167,131 @@ TEST_CASE("[String] UTF8 with CR") {
 	CHECK(no_cr == base.replace("\r", ""));
 }
 
+TEST_CASE("[String] UTF8 with long ASCII runs") {
+	// Multi-byte characters at every position relative to the 16 character ASCII chunks.
+	for (int offset = 0; offset < 34; offset++) {
+		String s = String("a").repeat(offset) + U"é" + String("b").repeat(20) + U"🎤" + String("c").repeat(offset % 17);
+		const String expected_str = String("a").repeat(offset) + "\xC3\xA9" + String("b").repeat(20) + "\xF0\x9F\x8E\xA4" + String("c").repeat(offset % 17);
+		const CharString expected = expected_str.ascii(true);
+
+		CharString cs = s.utf8();
+		CHECK(cs == expected);
+		CHECK(s.utf8_byte_length() == expected.length());
+
+		String parsed;
+		CHECK(parsed.parse_utf8(cs.get_data(), cs.length()) == OK);
+		CHECK(parsed == s);
+		CHECK(parsed.parse_utf8(cs.get_data()) == OK);
+		CHECK(parsed == s);
+	}
+
+	// A known length stops in the middle of a chunk, a null character stops the whole parse.
+	const String ascii = "0123456789abcdefghijklmnopqrstuvwxyz";
+	String parsed;
+	CHECK(parsed.parse_utf8(ascii.utf8().get_data(), 20) == OK);
+	CHECK(parsed == "0123456789abcdefghij");
+	const char with_null[] = "0123456789abcdef0123\0_after_the_null_character";
+	CHECK(parsed.parse_utf8(with_null, sizeof(with_null) - 1) == OK);
+	CHECK(parsed == "0123456789abcdef0123");
+
+	// Carriage returns inside what would be an ASCII chunk.
+	const String with_cr = "0123456789\r\nabcdefghijklmnopqrstuvwxyz\r\n0123456789abcdefghij\r";
+	CHECK(parsed.parse_utf8(with_cr.utf8().get_data(), -1, true) == OK);
+	CHECK(parsed == with_cr.replace("\r", ""));
+
+	// Invalid bytes right after an ASCII chunk.
+	ERR_PRINT_OFF
+	const char invalid[] = "0123456789abcdef\xFF" "0123456789abcdef";
+	CHECK(parsed.parse_utf8(invalid) == ERR_INVALID_DATA);
+	CHECK(parsed == U"0123456789abcdef\uFFFD0123456789abcdef");
+	ERR_PRINT_ON
+}
+
+TEST_CASE("[String] UTF8 into a buffer") {
+	const String s = String("x").repeat(18) + U"é🎤";
+	CHECK(s.utf8_byte_length() == 24);
+	CHECK(String().utf8_byte_length() == 0);
+
+	char buffer[32];
+	memset(buffer, '#', sizeof(buffer));
+	CHECK(s.utf8_to_buffer(buffer, sizeof(buffer)) == 24);
+	CHECK(memcmp(buffer, s.utf8().get_data(), 24) == 0);
+	CHECK(buffer[24] == '#'); // No trailing zero.
+
+	// Only whole characters are written.
+	memset(buffer, '#', sizeof(buffer));
+	CHECK(s.utf8_to_buffer(buffer, 19) == 18);
+	CHECK(buffer[18] == '#');
+	CHECK(s.utf8_to_buffer(buffer, 23) == 20);
+	CHECK(s.utf8_to_buffer(buffer, 0) == 0);
+}
+
+// Run with `--test --test-case="*Benchmark*" --no-skip`.
+TEST_CASE("[String][Benchmark] UTF8 conversion" * doctest::skip()) {
+	const String ascii = String("{\"name\": \"Player\", \"position\": [12.5, 3.0], \"tags\": [\"a\", \"b\"]}\n").repeat(1000);
+	const String mixed = String(U"Grüße, 世界! Ünïcödé text with accents, mostly ASCII. ").repeat(1000);
+	for (const String &text : { ascii, mixed }) {
+		const CharString utf8 = text.utf8();
+		const int rounds = 200;
+		int64_t sum = 0;
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < rounds; i++) {
+			sum += text.utf8().length();
+		}
+		const uint64_t encode = OS::get_singleton()->get_ticks_usec() - begin;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < rounds; i++) {
+			String parsed;
+			parsed.parse_utf8(utf8.get_data(), utf8.length());
+			sum += parsed.length();
+		}
+		const uint64_t decode = OS::get_singleton()->get_ticks_usec() - begin;
+
+		const double megabytes = double(utf8.length()) * rounds / 1e6;
+		print_line(vformat("%d bytes: utf8() %d MB/s, parse_utf8() %d MB/s", utf8.length(), int(megabytes * 1e6 / MAX(encode, (uint64_t)1)), int(megabytes * 1e6 / MAX(decode, (uint64_t)1))));
+		CHECK(sum == int64_t(utf8.length() + text.length()) * rounds);
+	}
+}
+
+// Run with `--test --test-case="*Benchmark*" --no-skip`.
+TEST_CASE("[String][Benchmark] Search and case conversion" * doctest::skip()) {
+	const String text = String("Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor. ").repeat(1000) + "needle";
+	const int rounds = 200;
+	int64_t sum = 0;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < rounds; i++) {
+		sum += text.find("needle") + text.rfind("Lorem");
+	}
+	const uint64_t find = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < rounds; i++) {
+		sum += text.findn("NEEDLE");
+	}
+	const uint64_t findn = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < rounds; i++) {
+		sum += text.count("dolor");
+	}
+	const uint64_t count = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < rounds; i++) {
+		sum += text.to_upper().length() + text.to_lower().length();
+	}
+	const uint64_t change_case = OS::get_singleton()->get_ticks_usec() - begin;
+
+	const double characters = double(text.length()) * rounds / 1e6;
+	print_line(vformat("%d characters: find() + rfind() %d M/s, findn() %d M/s, count() %d M/s, to_upper() + to_lower() %d M/s", text.length(),
+			int(2 * characters * 1e6 / MAX(find, (uint64_t)1)), int(characters * 1e6 / MAX(findn, (uint64_t)1)),
+			int(characters * 1e6 / MAX(count, (uint64_t)1)), int(2 * characters * 1e6 / MAX(change_case, (uint64_t)1))));
+	CHECK(sum > 0);
+}
+
 TEST_CASE("[String] Invalid UTF8 (non-standard)") {
 	ERR_PRINT_OFF
 	static const uint8_t u8str[] = { 0x45, 0xE3, 0x81, 0x8A, 0xE3, 0x82, 0x88, 0xE3, 0x81, 0x86, 0xF0, 0x9F, 0x8E, 0xA4, 0xF0, 0x82, 0x82, 0xAC, 0xED, 0xA0, 0x81, 0 };
@@ -335,6 +461,19 @@ TEST_CASE("[String] Case function test") {
 	CHECK(a.to_lower() == "momonga");
 }
 
+TEST_CASE("[String] Case functions on long strings") {
+	// Long enough for the chunked conversion, with non-ASCII characters in some chunks.
+	const String a = String(U"The Quick Brown Fox Jumps Over The Lazy Dog. [@`{] ").repeat(3) + U"Ärger über Öl, ÇA VA? ÿ" + String("Zz").repeat(20);
+	const String upper = String(U"THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG. [@`{] ").repeat(3) + U"ÄRGER ÜBER ÖL, ÇA VA? Ÿ" + String("ZZ").repeat(20);
+	const String lower = String(U"the quick brown fox jumps over the lazy dog. [@`{] ").repeat(3) + U"ärger über öl, ça va? ÿ" + String("zz").repeat(20);
+
+	CHECK(a.to_upper() == upper);
+	CHECK(a.to_lower() == lower);
+	CHECK(a.to_upper().length() == a.length());
+	CHECK(a.nocasecmp_to(lower) == 0);
+	CHECK(upper.nocasecmp_to(lower) == 0);
+}
+
 TEST_CASE("[String] Case compare function test") {
 	String a = "MoMoNgA";
 
@@ -406,6 +545,39 @@ TEST_CASE("[String] Find case insensitive") {
 	MULTICHECK_STRING_INT_EQ(s, rfindn, "", 13, -1);
 }
 
+TEST_CASE("[String] Find in long strings") {
+	// Place the key at every offset around the 8 characters the search skips at a time.
+	for (int pos = 0; pos < 40; pos++) {
+		String s = String("a").repeat(pos) + "abcd" + String("a").repeat(40 - pos);
+		CHECK(s.find("abcd") == pos);
+		CHECK(s.find(String("abcd")) == pos);
+		CHECK(s.rfind("abcd") == pos);
+		CHECK(s.rfind(String("abcd")) == pos);
+		CHECK(s.findn("ABCD") == pos);
+		CHECK(s.find("abcd", pos + 1) == -1);
+		if (pos > 0) {
+			CHECK(s.rfind("abcd", pos - 1) == -1);
+		}
+		CHECK(s.find("abce") == -1);
+		CHECK(s.rfind("abce") == -1);
+		CHECK(s.find_char('b') == pos + 1);
+	}
+
+	const String s = String(U"Ünïcödé ").repeat(10) + U"needle Ünïcödé needle";
+	CHECK(s.find(U"needle") == 80);
+	CHECK(s.rfind(U"needle") == 95);
+	CHECK(s.findn(U"NEEDLE Ü") == 80);
+	CHECK(s.findn(U"ÜNÏCÖDÉ NEEDLE") == 72);
+	CHECK(s.count(U"needle") == 2);
+	CHECK(s.countn(U"NEEDLE") == 2);
+	CHECK(s.count(U"needle", 81) == 1);
+	CHECK(s.count(U"needle", 0, 86) == 1);
+	CHECK(s.count(U"needle", 0, 85) == 0);
+	CHECK(s.count(U"ö") == 11);
+	CHECK(String("aaaaaaaaaa").count("aa") == 5);
+	CHECK(String("aaaaaaaaaa").count("aa", 3, 100) == 3);
+}
+
 TEST_CASE("[String] Find MK") {
 	Hector<String> keys;
 	keys.push_back("sty");
@@ -0,0 +1,143 @@
+/**************************************************************************/
+/*  test_string_name.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_STRING_NAME_H
+#define TEST_STRING_NAME_H
+
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
+#include "core/string/string_name.h"
+
+#include "tests/test_macros.h"
+
+namespace TestStringName {
+
+TEST_CASE("[StringName] Construction and comparison") {
+	const StringName from_cstring("test_string_name");
+	const StringName from_string(String("test_string_name"));
+	const StringName from_static = _scs_create("test_string_name");
+
+	CHECK(from_cstring == from_string);
+	CHECK(from_cstring == from_static);
+	CHECK(from_cstring.data_unique_pointer() == from_string.data_unique_pointer());
+	CHECK(from_cstring == "test_string_name");
+	CHECK(String(from_string) == "test_string_name");
+	CHECK(StringName::search("test_string_name") == from_cstring);
+	CHECK(StringName() == StringName(""));
+}
+
+TEST_CASE("[StringName] Names are released with their last reference") {
+	const String name = "test_string_name_released";
+	{
+		StringName sname(name);
+		StringName copy = sname;
+		CHECK(StringName::search(name) == copy);
+	}
+	CHECK(StringName::search(name) == StringName());
+}
+
+static const int CONCURRENT_NAME_COUNT = 512;
+
+static void _intern_names(void *p_userdata, uint32_t p_index) {
+	// Every thread creates and releases the same names, racing to insert
+	// and remove the same entries.
+	for (int i = 0; i < CONCURRENT_NAME_COUNT; i++) {
+		const int n = (i + p_index * 7) % CONCURRENT_NAME_COUNT;
+		StringName a(vformat("test_concurrent_%d", n));
+		StringName b(String("test_concurrent_") + itos(n));
+		if (a != b || a.data_unique_pointer() != b.data_unique_pointer()) {
+			((SafeFlag *)p_userdata)->set();
+		}
+	}
+}
+
+TEST_CASE("[StringName] Concurrent interning") {
+	// Keep every other name alive, the rest are created and freed by the threads.
+	Hector<StringName> kept;
+	for (int i = 0; i < CONCURRENT_NAME_COUNT; i += 2) {
+		kept.push_back(StringName(vformat("test_concurrent_%d", i)));
+	}
+
+	SafeFlag mismatch;
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(_intern_names, &mismatch, 256, -1, true);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+	CHECK_FALSE(mismatch.is_set());
+
+	bool ok = true;
+	for (int i = 0; i < CONCURRENT_NAME_COUNT; i++) {
+		const StringName found = StringName::search(vformat("test_concurrent_%d", i));
+		ok = ok && ((i % 2 == 0) ? found == kept[i / 2] : found == StringName());
+	}
+	CHECK_MESSAGE(ok, "Only the names kept alive should remain interned.");
+}
+
+static void _intern_benchmark_names(void *p_userdata, uint32_t p_index) {
+	const Hector<String> &names = *(const Hector<String> *)p_userdata;
+	for (int i = 0; i < names.size(); i++) {
+		StringName sname(names[(i + p_index * 31) % names.size()]);
+	}
+}
+
+// Run with `--test --test-case="*Benchmark*" --no-skip`.
+TEST_CASE("[StringName][Benchmark] Concurrent interning" * doctest::skip()) {
+	Hector<String> names;
+	for (int i = 0; i < 4096; i++) {
+		names.push_back(vformat("benchmark_property_%d", i));
+	}
+	// Half of the names are interned already, like properties of existing
+	// classes, the rest are created and freed on every use.
+	Hector<StringName> kept;
+	for (int i = 0; i < names.size(); i += 2) {
+		kept.push_back(names[i]);
+	}
+
+	const int tasks = 256;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < tasks; i++) {
+		_intern_benchmark_names(&names, i);
+	}
+	const uint64_t serial_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(_intern_benchmark_names, &names, tasks, -1, true);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	const uint64_t threaded_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	const double count = double(tasks) * names.size();
+	print_line(vformat("Interning %d names:", count));
+	print_line(vformat("\tOn one thread: %.2f msec (%.1f ns per name).", serial_usec / 1000.0, serial_usec * 1000.0 / count));
+	print_line(vformat("\tOn %d threads: %.2f msec (%.1f ns per name).", WorkerThreadPool::get_singleton()->get_thread_count(), threaded_usec / 1000.0, threaded_usec * 1000.0 / count));
+}
+
+} // namespace TestStringName
+
+#endif // TEST_STRING_NAME_H
@@ -0,0 +1,165 @@
+/**************************************************************************/
+/*  test_a_hash_map.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_A_HASH_MAP_H
+#define TEST_A_HASH_MAP_H
+
+#include "core/templates/a_hash_map.h"
+
+#include "tests/test_macros.h"
+
+namespace TestAHashMap {
+
+TEST_CASE("[AHashMap] Insert element") {
+	AHashMap<int, int> map;
+	AHashMap<int, int>::Iterator e = map.insert(42, 84);
+
+	CHECK(e);
+	CHECK(e->key == 42);
+	CHECK(e->value == 84);
+	CHECK(map[42] == 84);
+	CHECK(map.has(42));
+	CHECK(map.find(42));
+}
+
+TEST_CASE("[AHashMap] Overwrite element") {
+	AHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(42, 1234);
+
+	CHECK(map[42] == 1234);
+	CHECK(map.size() == 1);
+}
+
+TEST_CASE("[AHashMap] Erase via element") {
+	AHashMap<int, int> map;
+	AHashMap<int, int>::Iterator e = map.insert(42, 84);
+	map.remove(e);
+	CHECK(!map.has(42));
+	CHECK(!map.find(42));
+	CHECK(map.is_empty());
+}
+
+TEST_CASE("[AHashMap] Erase keeps insertion order") {
+	AHashMap<int, int> map;
+	for (int i = 0; i < 100; i++) {
+		map.insert(i, i * 2);
+	}
+	for (int i = 0; i < 100; i += 3) {
+		CHECK(map.erase(i));
+	}
+	CHECK_FALSE(map.erase(3));
+
+	int expected = 1;
+	bool ok = true;
+	for (const KeyValue<int, int> &E : map) {
+		ok = ok && E.key == expected && E.value == expected * 2;
+		expected += (expected % 3 == 2) ? 2 : 1;
+	}
+	CHECK(ok);
+	CHECK(map.size() == 66);
+
+	// Filling the holes back appends at the end.
+	for (int i = 0; i < 100; i += 3) {
+		map.insert(i, -i);
+	}
+	CHECK(map.size() == 100);
+	CHECK(map.last()->key == 99);
+	CHECK(map.last()->value == -99);
+	CHECK(map[1] == 2);
+}
+
+TEST_CASE("[AHashMap] Erase during iteration") {
+	AHashMap<int, int> map;
+	for (int i = 0; i < 20; i++) {
+		map.insert(i, i);
+	}
+	int visited = 0;
+	for (AHashMap<int, int>::Iterator E = map.begin(); E; ++E) {
+		if (E->key % 2 == 0) {
+			map.erase(E->key);
+		}
+		visited++;
+	}
+	CHECK(visited == 20);
+	CHECK(map.size() == 10);
+	CHECK(map.begin()->key == 1);
+}
+
+TEST_CASE("[AHashMap] Many elements with colliding hashes") {
+	struct CollidingHasher {
+		static _FORCE_INLINE_ uint32_t hash(const int p_key) { return p_key % 7; }
+	};
+	AHashMap<int, String, CollidingHasher> map;
+	for (int i = 0; i < 1000; i++) {
+		map.insert(i, itos(i));
+	}
+	for (int i = 0; i < 1000; i += 2) {
+		map.erase(i);
+	}
+	bool ok = true;
+	for (int i = 0; i < 1000; i++) {
+		const String *value = map.getptr(i);
+		ok = ok && ((i % 2) ? (value && *value == itos(i)) : value == nullptr);
+	}
+	CHECK(ok);
+}
+
+TEST_CASE("[AHashMap] Const iteration and copy") {
+	AHashMap<String, int> map;
+	map.insert("a", 1);
+	map.insert("b", 2);
+	map.insert("c", 3);
+	map.erase("b");
+	map.insert("b", 4);
+
+	const AHashMap<String, int> const_map = map;
+
+	Hector<Pair<String, int>> expected;
+	expected.push_back(Pair<String, int>("a", 1));
+	expected.push_back(Pair<String, int>("c", 3));
+	expected.push_back(Pair<String, int>("b", 4));
+
+	int idx = 0;
+	for (const KeyValue<String, int> &E : const_map) {
+		CHECK(expected[idx] == Pair<String, int>(E.key, E.value));
+		++idx;
+	}
+	CHECK(idx == 3);
+
+	map.clear();
+	CHECK(map.is_empty());
+	CHECK(map.begin() == map.end());
+	CHECK(const_map.size() == 3);
+}
+
+} // namespace TestAHashMap
+
+#endif // TEST_A_HASH_MAP_H
@@ -0,0 +1,249 @@
+/**************************************************************************/
+/*  test_flat_hash_map.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_FLAT_HASH_MAP_H
+#define TEST_FLAT_HASH_MAP_H
+
+#include "core/os/os.h"
+#include "core/templates/a_hash_map.h"
+#include "core/templates/flat_hash_map.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/oa_hash_map.h"
+
+#include "tests/test_macros.h"
+
+namespace TestFlatHashMap {
+
+TEST_CASE("[FlatHashMap] Insert element") {
+	FlatHashMap<int, int> map;
+	FlatHashMap<int, int>::Iterator e = map.insert(42, 84);
+
+	CHECK(e);
+	CHECK(e->key == 42);
+	CHECK(e->value == 84);
+	CHECK(map[42] == 84);
+	CHECK(map.has(42));
+	CHECK(map.find(42));
+}
+
+TEST_CASE("[FlatHashMap] Overwrite element") {
+	FlatHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(42, 1234);
+
+	CHECK(map[42] == 1234);
+	CHECK(map.size() == 1);
+}
+
+TEST_CASE("[FlatHashMap] Erase") {
+	FlatHashMap<int, int> map;
+	FlatHashMap<int, int>::Iterator e = map.insert(42, 84);
+	map.remove(e);
+	CHECK(!map.has(42));
+	CHECK(!map.find(42));
+
+	map.insert(1, 1);
+	CHECK(map.erase(1));
+	CHECK_FALSE(map.erase(1));
+	CHECK(map.is_empty());
+}
+
+TEST_CASE("[FlatHashMap] Many elements") {
+	FlatHashMap<String, int> map;
+	for (int i = 0; i < 5000; i++) {
+		map[itos(i)] = i;
+	}
+	CHECK(map.size() == 5000);
+
+	for (int i = 0; i < 5000; i += 2) {
+		map.erase(itos(i));
+	}
+	CHECK(map.size() == 2500);
+
+	bool ok = true;
+	for (int i = 0; i < 5000; i++) {
+		const int *value = map.getptr(itos(i));
+		ok = ok && ((i % 2) ? (value && *value == i) : value == nullptr);
+	}
+	CHECK(ok);
+
+	int sum = 0;
+	int count = 0;
+	for (const KeyValue<String, int> &E : map) {
+		ok = ok && E.key.to_int() == E.value;
+		sum += E.value;
+		count++;
+	}
+	CHECK(ok);
+	CHECK(count == 2500);
+	CHECK(sum == 2500 * 2500);
+}
+
+TEST_CASE("[FlatHashMap] Reuses deleted slots") {
+	FlatHashMap<int, int> map;
+	map.reserve(100);
+	const uint32_t capacity = map.get_capacity();
+
+	// Churning through keys must not grow the table while the size stays the same.
+	for (int i = 0; i < 100000; i++) {
+		map.insert(i, i);
+		if (i >= 50) {
+			map.erase(i - 50);
+		}
+	}
+	CHECK(map.size() == 50);
+	CHECK(map.get_capacity() == capacity);
+	CHECK(map[99999] == 99999);
+}
+
+TEST_CASE("[FlatHashMap] Colliding hashes") {
+	struct CollidingHasher {
+		static _FORCE_INLINE_ uint32_t hash(const int p_key) { return p_key % 3; }
+	};
+	FlatHashMap<int, int, CollidingHasher> map;
+	for (int i = 0; i < 500; i++) {
+		map.insert(i, -i);
+	}
+	bool ok = true;
+	for (int i = 0; i < 500; i++) {
+		ok = ok && map.has(i) && map[i] == -i;
+	}
+	CHECK(ok);
+	CHECK_FALSE(map.has(500));
+}
+
+TEST_CASE("[FlatHashMap] Copy and clear") {
+	FlatHashMap<int, String> map;
+	for (int i = 0; i < 100; i++) {
+		map.insert(i, itos(i));
+	}
+	const FlatHashMap<int, String> copy = map;
+	map.clear();
+
+	CHECK(map.is_empty());
+	CHECK(map.begin() == map.end());
+	CHECK(copy.size() == 100);
+	CHECK(copy[55] == "55");
+}
+
+template <typename M>
+static uint64_t _benchmark_insert(M &r_map, const Hector<StringName> &p_keys) {
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < p_keys.size(); i++) {
+		r_map.insert(p_keys[i], i);
+	}
+	return OS::get_singleton()->get_ticks_usec() - begin;
+}
+
+template <typename M>
+static uint64_t _benchmark_lookup(const M &p_map, const Hector<StringName> &p_keys, int p_rounds, int &r_found) {
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int r = 0; r < p_rounds; r++) {
+		for (int i = 0; i < p_keys.size(); i++) {
+			r_found += p_map.has(p_keys[i]) ? 1 : 0;
+		}
+	}
+	return OS::get_singleton()->get_ticks_usec() - begin;
+}
+
+template <typename M>
+static uint64_t _benchmark_iterate(const M &p_map, int p_rounds, int64_t &r_sum) {
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int r = 0; r < p_rounds; r++) {
+		for (const KeyValue<StringName, int> &E : p_map) {
+			r_sum += E.value;
+		}
+	}
+	return OS::get_singleton()->get_ticks_usec() - begin;
+}
+
+// Run with `--test --test-case="*Benchmark*" --no-skip`.
+TEST_CASE("[FlatHashMap][Benchmark] Compare with HashMap, AHashMap and OAHashMap" * doctest::skip()) {
+	for (int count : { 16, 256, 100000 }) {
+		Hector<StringName> keys;
+		Hector<StringName> missing;
+		for (int i = 0; i < count; i++) {
+			keys.push_back(vformat("benchmark_key_%d", i));
+			missing.push_back(vformat("benchmark_missing_%d", i));
+		}
+		const int rounds = MAX(1, 2000000 / count);
+		int found = 0;
+		int64_t sum = 0;
+
+		print_line(vformat("%d StringName keys (lookups and iterations repeated %d times):", count, rounds));
+		print_line("\tMap\t\tInsert\tHit\tMiss\tIterate (usec)");
+
+		{
+			HashMap<StringName, int> map;
+			uint64_t insert = _benchmark_insert(map, keys);
+			uint64_t hit = _benchmark_lookup(map, keys, rounds, found);
+			uint64_t miss = _benchmark_lookup(map, missing, rounds, found);
+			uint64_t iterate = _benchmark_iterate(map, rounds, sum);
+			print_line(vformat("\tHashMap\t\t%d\t%d\t%d\t%d", insert, hit, miss, iterate));
+		}
+		{
+			AHashMap<StringName, int> map;
+			uint64_t insert = _benchmark_insert(map, keys);
+			uint64_t hit = _benchmark_lookup(map, keys, rounds, found);
+			uint64_t miss = _benchmark_lookup(map, missing, rounds, found);
+			uint64_t iterate = _benchmark_iterate(map, rounds, sum);
+			print_line(vformat("\tAHashMap\t%d\t%d\t%d\t%d", insert, hit, miss, iterate));
+		}
+		{
+			FlatHashMap<StringName, int> map;
+			uint64_t insert = _benchmark_insert(map, keys);
+			uint64_t hit = _benchmark_lookup(map, keys, rounds, found);
+			uint64_t miss = _benchmark_lookup(map, missing, rounds, found);
+			uint64_t iterate = _benchmark_iterate(map, rounds, sum);
+			print_line(vformat("\tFlatHashMap\t%d\t%d\t%d\t%d", insert, hit, miss, iterate));
+		}
+		{
+			OAHashMap<StringName, int> map;
+			uint64_t insert = _benchmark_insert(map, keys);
+			uint64_t hit = _benchmark_lookup(map, keys, rounds, found);
+			uint64_t miss = _benchmark_lookup(map, missing, rounds, found);
+			uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			for (int r = 0; r < rounds; r++) {
+				for (OAHashMap<StringName, int>::Iterator it = map.iter(); it.valid; it = map.next_iter(it)) {
+					sum += *it.value;
+				}
+			}
+			uint64_t iterate = OS::get_singleton()->get_ticks_usec() - begin;
+			print_line(vformat("\tOAHashMap\t%d\t%d\t%d\t%d", insert, hit, miss, iterate));
+		}
+
+		CHECK(found == 4 * rounds * count);
+		CHECK(sum != 0);
+	}
+}
+
+} // namespace TestFlatHashMap
+
+#endif // TEST_FLAT_HASH_MAP_H
@@ -0,0 +1,171 @@
+/**************************************************************************/
+/*  test_frame_arena.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_FRAME_ARENA_H
+#define TEST_FRAME_ARENA_H
+
+#include "core/templates/frame_arena.h"
+#include "core/templates/hash_map.h"
+
+#include "tests/test_macros.h"
+
+namespace TestFrameArena {
+
+TEST_CASE("[FrameArena] LocalHector grows in place") {
+	FrameArena arena(1024);
+	FrameArena::set_current(&arena);
+
+	{
+		FrameLocalHector<int> hector;
+		for (int i = 0; i < 100; i++) {
+			hector.push_back(i);
+		}
+		const int *ptr = hector.ptr();
+		hector.push_back(100);
+		CHECK_MESSAGE(hector.ptr() == ptr, "The last block should grow without moving.");
+
+		bool ok = true;
+		for (int i = 0; i <= 100; i++) {
+			ok = ok && hector[i] == i;
+		}
+		CHECK(ok);
+		CHECK(arena.get_used_bytes() >= 101 * sizeof(int));
+	}
+	CHECK_MESSAGE(arena.get_used_bytes() == 0, "Freeing the last block should return its memory.");
+
+	FrameArena::set_current(nullptr);
+}
+
+TEST_CASE("[FrameArena] Interleaved allocations keep their data") {
+	FrameArena arena(256);
+	FrameArena::set_current(&arena);
+
+	FrameLocalHector<uint64_t> a;
+	FrameLocalHector<uint64_t> b;
+	for (uint64_t i = 0; i < 1000; i++) {
+		a.push_back(i);
+		b.push_back(i * 3);
+	}
+
+	bool ok = true;
+	for (uint64_t i = 0; i < 1000; i++) {
+		ok = ok && a[i] == i && b[i] == i * 3;
+		ok = ok && (uint64_t(a.ptr()) % 16) == 0 && (uint64_t(b.ptr()) % 16) == 0;
+	}
+	CHECK(ok);
+	CHECK(arena.get_chunk_count() > 1);
+
+	a.reset();
+	b.reset();
+	FrameArena::set_current(nullptr);
+}
+
+TEST_CASE("[FrameArena] Frames are double-buffered and recycled") {
+	FrameArena arena(128);
+	FrameArena::set_current(&arena);
+
+	uint8_t *first = (uint8_t *)FrameArenaAllocator::alloc(100);
+	memset(first, 0xAB, 100);
+	for (int i = 0; i < 20; i++) {
+		FrameArenaAllocator::alloc(100);
+	}
+	uint64_t used = arena.get_used_bytes();
+	CHECK(used >= 21 * 100);
+
+	arena.begin_frame();
+	CHECK(arena.get_used_bytes() == 0);
+	uint8_t *second = (uint8_t *)FrameArenaAllocator::alloc(100);
+	CHECK_MESSAGE(second != first, "The previous frame should not be recycled yet.");
+	bool ok = true;
+	for (int i = 0; i < 100; i++) {
+		ok = ok && first[i] == 0xAB;
+	}
+	CHECK(ok);
+
+	// The first frame did not fit one chunk, recycling it coalesces its chunks.
+	arena.begin_frame();
+	uint32_t chunks = arena.get_chunk_count();
+	uint64_t capacity = arena.get_capacity();
+	for (int i = 0; i < 21; i++) {
+		FrameArenaAllocator::alloc(100);
+	}
+	CHECK(arena.get_used_bytes() == used);
+	CHECK_MESSAGE(arena.get_chunk_count() == chunks, "A frame of the same size should not allocate.");
+	CHECK(arena.get_capacity() == capacity);
+
+	FrameArena::set_current(nullptr);
+}
+
+TEST_CASE("[FrameArena] HashMap elements") {
+	FrameArena arena;
+	FrameArena::set_current(&arena);
+
+	{
+		HashMap<int, int, HashMapHasherDefault, HashMapComparatorDefault<int>, FrameTypedAllocator<HashMapElement<int, int>>> map;
+		for (int i = 0; i < 500; i++) {
+			map.insert(i, i * 2);
+		}
+		map.erase(10);
+
+		CHECK(map.size() == 499);
+		CHECK_FALSE(map.has(10));
+		CHECK(map[250] == 500);
+		CHECK(arena.get_used_bytes() >= 499 * sizeof(HashMapElement<int, int>));
+	}
+
+	FrameArena::set_current(nullptr);
+}
+
+TEST_CASE("[FrameArena] Falls back to the heap without an arena") {
+	FrameArena arena;
+	FrameArena::set_current(&arena);
+	FrameLocalHector<int> from_arena;
+	from_arena.push_back(1);
+	FrameArena::set_current(nullptr);
+
+	// Growing an arena block without an arena moves it to the heap.
+	for (int i = 2; i <= 100; i++) {
+		from_arena.push_back(i);
+	}
+	CHECK(from_arena.size() == 100);
+	CHECK(from_arena[0] == 1);
+	CHECK(from_arena[99] == 100);
+	CHECK(arena.get_used_bytes() <= 64);
+
+	FrameLocalHector<int> from_heap;
+	for (int i = 0; i < 100; i++) {
+		from_heap.push_back(i);
+	}
+	CHECK(from_heap[99] == 99);
+}
+
+} // namespace TestFrameArena
+
+#endif // TEST_FRAME_ARENA_H
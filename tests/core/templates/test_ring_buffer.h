@@ -0,0 +1,111 @@
+/**************************************************************************/
+/*  test_ring_buffer.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RING_BUFFER_H
+#define TEST_RING_BUFFER_H
+
+#include "core/templates/ring_buffer.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRingBuffer {
+
+TEST_CASE("[RingBuffer] Bulk read and write across the end") {
+	RingBuffer<int> buffer(3);
+	CHECK(buffer.size() == 8);
+	CHECK(buffer.space_left() == 7);
+
+	const int first[6] = { 0, 1, 2, 3, 4, 5 };
+	CHECK(buffer.write(first, 6) == 6);
+	int out[8] = {};
+	CHECK(buffer.read(out, 6) == 6);
+	CHECK(out[5] == 5);
+
+	// Written at positions 6, 7, 0, 1 and 2.
+	const int second[5] = { 10, 11, 12, 13, 14 };
+	CHECK(buffer.write(second, 5) == 5);
+	CHECK(buffer.data_left() == 5);
+	CHECK(buffer.read(out, 8) == 5);
+	for (int i = 0; i < 5; i++) {
+		CHECK(out[i] == second[i]);
+	}
+	CHECK(buffer.data_left() == 0);
+}
+
+TEST_CASE("[RingBuffer] Reading in place") {
+	RingBuffer<int> buffer(3);
+	const int values[6] = { 0, 1, 2, 3, 4, 5 };
+	buffer.write(values, 6);
+
+	const int *ptr = buffer.get_read_ptr(6);
+	REQUIRE(ptr != nullptr);
+	CHECK(ptr[0] == 0);
+	CHECK(ptr[5] == 5);
+	CHECK_MESSAGE(buffer.data_left() == 6, "Getting the read pointer must not consume the data.");
+	CHECK(buffer.get_read_ptr(7) == nullptr);
+
+	CHECK(buffer.advance_read(6) == 6);
+	CHECK(buffer.data_left() == 0);
+
+	// Wraps around the end, only the part before it is contiguous.
+	buffer.write(values, 4);
+	ptr = buffer.get_read_ptr(2);
+	REQUIRE(ptr != nullptr);
+	CHECK(ptr[0] == 0);
+	CHECK(ptr[1] == 1);
+	CHECK(buffer.get_read_ptr(3) == nullptr);
+	CHECK(buffer.get_read_ptr(4) == nullptr);
+
+	CHECK(buffer.advance_read(2) == 2);
+	ptr = buffer.get_read_ptr(2);
+	REQUIRE(ptr != nullptr);
+	CHECK(ptr[0] == 2);
+	CHECK(ptr[1] == 3);
+}
+
+TEST_CASE("[RingBuffer] Dropping the last written elements") {
+	RingBuffer<int> buffer(3);
+	const int values[7] = { 0, 1, 2, 3, 4, 5, 6 };
+	buffer.write(values, 3);
+	buffer.advance_read(3);
+	buffer.write(values, 7); // Wraps around.
+	CHECK(buffer.space_left() == 0);
+
+	CHECK(buffer.decrease_write(4) == 4);
+	CHECK(buffer.data_left() == 3);
+	int out[3] = {};
+	CHECK(buffer.read(out, 3) == 3);
+	CHECK(out[0] == 0);
+	CHECK(out[2] == 2);
+}
+
+} // namespace TestRingBuffer
+
+#endif // TEST_RING_BUFFER_H
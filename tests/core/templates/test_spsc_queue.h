@@ -0,0 +1,138 @@
+/**************************************************************************/
+/*  test_spsc_queue.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SPSC_QUEUE_H
+#define TEST_SPSC_QUEUE_H
+
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/templates/spsc_queue.h"
+#include "core/variant/variant.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSPSCQueue {
+
+TEST_CASE("[SPSCQueue] Push and pop") {
+	SPSCQueue<int> queue(3);
+	CHECK_EQ(queue.get_capacity(), 4u);
+	CHECK(queue.is_empty());
+	CHECK_EQ(queue.peek(), nullptr);
+
+	int value = -1;
+	CHECK_FALSE(queue.pop(value));
+	CHECK_EQ(value, -1);
+
+	for (int i = 0; i < 4; i++) {
+		CHECK(queue.push(i));
+	}
+	CHECK_FALSE(queue.push(4));
+	CHECK_EQ(queue.size(), 4u);
+
+	REQUIRE_NE(queue.peek(), nullptr);
+	CHECK_EQ(*queue.peek(), 0);
+	for (int i = 0; i < 4; i++) {
+		CHECK(queue.pop(value));
+		CHECK_EQ(value, i);
+	}
+	CHECK(queue.is_empty());
+
+	// Wrap around.
+	for (int i = 0; i < 10; i++) {
+		CHECK(queue.push(i));
+		CHECK(queue.push(i + 100));
+		CHECK(queue.pop(value));
+		CHECK_EQ(value, i);
+		CHECK(queue.pop(value));
+		CHECK_EQ(value, i + 100);
+	}
+	CHECK(queue.is_empty());
+}
+
+TEST_CASE("[SPSCQueue] Popping releases the element") {
+	SPSCQueue<Variant> queue(2);
+	Array array;
+	array.push_back(1);
+	CHECK(queue.push(array));
+	Variant value;
+	CHECK(queue.pop(value));
+	CHECK_EQ(value, Variant(array));
+	value = Variant();
+	// The queue must not keep a reference.
+	array.push_back(2);
+	CHECK_EQ(array.size(), 2);
+	CHECK_FALSE(queue.pop(value));
+}
+
+struct ProducerData {
+	SPSCQueue<uint32_t> *queue = nullptr;
+	uint32_t count = 0;
+};
+
+static void _producer(void *p_userdata) {
+	ProducerData *data = (ProducerData *)p_userdata;
+	for (uint32_t i = 0; i < data->count;) {
+		if (data->queue->push(i)) {
+			i++;
+		} else {
+			OS::get_singleton()->delay_usec(1);
+		}
+	}
+}
+
+TEST_CASE("[SPSCQueue] Threaded order") {
+	SPSCQueue<uint32_t> queue(64);
+	ProducerData data;
+	data.queue = &queue;
+	data.count = 100000;
+
+	Thread thread;
+	thread.start(_producer, &data);
+
+	uint32_t expected = 0;
+	bool in_order = true;
+	while (expected < data.count) {
+		uint32_t value;
+		if (!queue.pop(value)) {
+			OS::get_singleton()->delay_usec(1);
+			continue;
+		}
+		in_order = in_order && value == expected;
+		expected++;
+	}
+	thread.wait_to_finish();
+
+	CHECK(in_order);
+	CHECK(queue.is_empty());
+}
+
+} // namespace TestSPSCQueue
+
+#endif // TEST_SPSC_QUEUE_H
@@ -31,9 +31,12 @@
 #ifndef TEST_WORKER_THREAD_POOL_H
 #define TEST_WORKER_THREAD_POOL_H
 
+#include "core/io/file_access.h"
+#include "core/io/json.h"
 #include "core/object/worker_thread_pool.h"
 
 #include "tests/test_macros.h"
+#include "tests/test_utils.h"
 
 namespace TestWorkerThreadPool {
 
@@ -107,6 +110,94 @@ TEST_CASE("[WorkerThreadPool] Process elements using group tasks") {
 	}
 }
 
+TEST_CASE("[WorkerThreadPool] Process many elements using group tasks") {
+	const int count = 100000;
+	counter.clear();
+	counter.resize(count);
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(static_group_test, (void *)0, count, -1, true);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+	bool all_run_once = true;
+	for (int i = 0; i < count; i++) {
+		all_run_once &= counter[i].get() == 1;
+	}
+	CHECK(all_run_once);
+}
+
+static SafeNumeric<int> run_order;
+
+static void static_ordered_test(void *p_arg) {
+	*(int *)p_arg = run_order.increment();
+}
+
+TEST_CASE("[WorkerThreadPool] Tasks with dependencies run after them") {
+	for (int iterations = 0; iterations < 200; iterations++) {
+		const bool low_priority = Math::rand() % 2;
+		int order[4] = {};
+		run_order.set(0);
+
+		WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+		WorkerThreadPool::TaskID first = pool->add_native_task(static_ordered_test, &order[0], !low_priority);
+		WorkerThreadPool::TaskID second = pool->add_native_task_with_dependencies(static_ordered_test, &order[1], { first }, !low_priority);
+		WorkerThreadPool::TaskID third = pool->add_native_task_with_dependencies(static_ordered_test, &order[2], { first }, low_priority);
+		WorkerThreadPool::TaskID last = pool->add_native_task_with_dependencies(static_ordered_test, &order[3], { second, third }, !low_priority);
+
+		pool->wait_for_task_completion(last);
+		pool->wait_for_task_completion(third);
+		pool->wait_for_task_completion(second);
+		pool->wait_for_task_completion(first);
+
+		CHECK(order[0] < order[1]);
+		CHECK(order[0] < order[2]);
+		CHECK(order[1] < order[3]);
+		CHECK(order[2] < order[3]);
+	}
+
+	SUBCASE("Dependencies already waited for are complete") {
+		int order[2] = {};
+		WorkerThreadPool::TaskID first = WorkerThreadPool::get_singleton()->add_native_task(static_ordered_test, &order[0]);
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(first);
+		WorkerThreadPool::TaskID second = WorkerThreadPool::get_singleton()->add_native_task_with_dependencies(static_ordered_test, &order[1], { first });
+		CHECK_EQ(WorkerThreadPool::get_singleton()->wait_for_task_completion(second), OK);
+		CHECK(order[0] < order[1]);
+	}
+}
+
+static void static_nested_test(void *p_arg) {
+	// Posted from a worker thread, these go to its own deque and may be stolen by other threads.
+	const int count = 16;
+	WorkerThreadPool::TaskID tasks[count];
+	for (int i = 0; i < count; i++) {
+		tasks[i] = WorkerThreadPool::get_singleton()->add_native_task(static_test, (void *)(uintptr_t)((uintptr_t)p_arg * count + i + 1), true);
+	}
+	for (int i = 0; i < count; i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(tasks[i]);
+	}
+}
+
+TEST_CASE("[WorkerThreadPool] Process tasks posted from worker threads") {
+	for (int iterations = 0; iterations < 50; iterations++) {
+		const int count = 8;
+		counter.clear();
+		counter.resize(count * 16 + 1);
+
+		WorkerThreadPool::TaskID tasks[count];
+		for (int i = 0; i < count; i++) {
+			tasks[i] = WorkerThreadPool::get_singleton()->add_native_task(static_nested_test, (void *)(uintptr_t)i, true);
+		}
+		for (int i = 0; i < count; i++) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(tasks[i]);
+		}
+
+		bool all_run_once = true;
+		for (int i = 1; i < count * 16 + 1; i++) {
+			all_run_once &= counter[i].get() == 1;
+		}
+		CHECK(all_run_once);
+		CHECK_EQ(counter[0].get(), count * 16 * 2);
+	}
+}
+
 static void static_test_daemon(void *p_arg) {
 	while (!exit.is_set()) {
 		counter[0].add(1);
@@ -125,6 +216,48 @@ static void static_legit_task(void *p_arg) {
 	counter[1].add(1);
 }
 
+TEST_CASE("[WorkerThreadPool] Trace tasks and save the timeline") {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	pool->set_tracing_enabled(true);
+	CHECK(pool->is_tracing_enabled());
+
+	const int count = 64;
+	counter.clear();
+	counter.resize(count + 1);
+	WorkerThreadPool::TaskID task = pool->add_native_task(static_nested_test, (void *)0, true, "Traced nested task");
+	pool->wait_for_task_completion(task);
+	WorkerThreadPool::GroupID group = pool->add_native_group_task(static_group_test, (void *)0, count, -1, true, "Traced group task");
+	pool->wait_for_group_task_completion(group);
+
+	pool->set_tracing_enabled(false);
+	CHECK_FALSE(pool->is_tracing_enabled());
+
+	const String path = TestUtils::get_temp_path("worker_thread_pool_trace.json");
+	REQUIRE_EQ(pool->save_trace(path), OK);
+	Dictionary trace = JSON::parse_string(FileAccess::get_file_as_string(path));
+	Array events = trace["traceEvents"];
+
+	int nested_events = 0;
+	int group_events = 0;
+	for (const Variant &E : events) {
+		Dictionary event = E;
+		if (event["ph"] != "X") {
+			continue;
+		}
+		CHECK((int64_t)event["dur"] >= 0);
+		CHECK((int)event["tid"] < pool->get_thread_count());
+		if (event["name"] == "Traced nested task") {
+			nested_events++;
+			CHECK_EQ((int64_t)((Dictionary)event["args"])["id"], task);
+		} else if (event["name"] == "Traced group task") {
+			group_events++;
+			CHECK_EQ((int64_t)((Dictionary)event["args"])["id"], group);
+		}
+	}
+	CHECK_EQ(nested_events, 1);
+	CHECK(group_events >= 1);
+}
+
 TEST_CASE("[WorkerThreadPool] Run a yielding daemon as the only hope for other tasks to run") {
 	exit.clear();
 	counter.clear();
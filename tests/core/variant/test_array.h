@@ -329,6 +329,21 @@ TEST_CASE("[Array] slice()") {
 
 	Array slice14 = array.slice(6);
 	CHECK(slice14.size() == 0);
+
+	// A slice of the whole array shares its storage until one of them changes.
+	Array slice15 = array.slice(0);
+	CHECK(slice15 == array);
+	CHECK(slice15.id() != array.id());
+	slice15[0] = 42;
+	CHECK(array[0] == Variant(0));
+	array[1] = 43;
+	CHECK(slice15[1] == Variant(1));
+	array[1] = 1;
+
+	Array slice16 = array.slice(-100, 100);
+	CHECK(slice16 == array);
+	slice16.push_back(6);
+	CHECK(array.size() == 6);
 }
 
 TEST_CASE("[Array] Duplicate array") {
@@ -181,6 +181,26 @@ TEST_CASE("[Dictionary] keys() and values()") {
 	CHECK(int(values[0]) == 3);
 }
 
+TEST_CASE("[Dictionary] Iteration") {
+	Dictionary map;
+	CHECK(map.begin() == map.end());
+
+	map[1] = 3;
+	map["a"] = "b";
+	map[Hector2i(1, 2)] = Array();
+	Array keys = map.keys();
+	Array values = map.values();
+
+	int i = 0;
+	for (const KeyValue<Variant, Variant> &kv : map) {
+		CHECK(kv.key == keys[i]);
+		CHECK(kv.value == values[i]);
+		CHECK(map[kv.key] == kv.value);
+		i++;
+	}
+	CHECK(i == 3);
+}
+
 TEST_CASE("[Dictionary] Duplicate dictionary") {
 	// d = {1: {1: 1}, {2: 2}: [2], [3]: 3}
 	Dictionary k2 = build_dictionary(2, 2);
@@ -31,6 +31,7 @@
 #ifndef TEST_ANIMATION_H
 #define TEST_ANIMATION_H
 
+#include "core/os/os.h"
 #include "scene/resources/animation.h"
 
 #include "tests/test_macros.h"
@@ -309,6 +310,156 @@ TEST_CASE("[Animation] Create Bezier track") {
 	ERR_PRINT_ON;
 }
 
+static Ref<Animation> _create_mocap_animation(int p_bones, double p_length, double p_fps) {
+	// Dense, smoothly varying keys like the ones produced by motion capture.
+	Ref<Animation> animation = memnew(Animation);
+	animation->set_length(p_length);
+	int key_count = int(p_length * p_fps) + 1;
+	for (int i = 0; i < p_bones; i++) {
+		int position_track = animation->add_track(Animation::TYPE_POSITION_3D);
+		int rotation_track = animation->add_track(Animation::TYPE_ROTATION_3D);
+		int scale_track = animation->add_track(Animation::TYPE_SCALE_3D);
+		animation->track_set_path(position_track, NodePath(vformat("Skeleton3D:bone_%d", i)));
+		animation->track_set_path(rotation_track, NodePath(vformat("Skeleton3D:bone_%d", i)));
+		animation->track_set_path(scale_track, NodePath(vformat("Skeleton3D:bone_%d", i)));
+		for (int k = 0; k < key_count; k++) {
+			double time = k / p_fps;
+			real_t phase = time * 2.0 + i * 0.37;
+			animation->position_track_insert_key(position_track, time, Hector3(Math::sin(phase), Math::cos(phase * 0.5), phase * 0.1));
+			animation->rotation_track_insert_key(rotation_track, time, Quaternion(Hector3(0, 1, 0), Math::fmod(phase, real_t(Math_TAU))));
+			animation->scale_track_insert_key(scale_track, time, Hector3(1, 1, 1) * (1.0 + 0.25 * Math::sin(phase * 3.0)));
+		}
+	}
+	int blend_shape_track = animation->add_track(Animation::TYPE_BLEND_SHAPE);
+	animation->track_set_path(blend_shape_track, NodePath("Mesh:smile"));
+	for (int k = 0; k < key_count; k++) {
+		double time = k / p_fps;
+		animation->blend_shape_track_insert_key(blend_shape_track, time, Math::sin(time * 4.0));
+	}
+	return animation;
+}
+
+TEST_CASE("[Animation] Compressed track sampling with cursors") {
+	Ref<Animation> animation = _create_mocap_animation(2, 4.0, 30.0);
+	animation->compress(1024, 30); // Small pages, so sampling crosses page boundaries.
+	REQUIRE(animation->is_compressed());
+
+	LocalHector<Animation::CompressedCursor> cursors;
+	cursors.resize(animation->get_track_count());
+
+	// Forward playback, then a backward seek and forward again, all must match sampling without cursor.
+	LocalHector<double> times;
+	for (double time = 0.0; time <= 4.0; time += 1.0 / 60.0) {
+		times.push_back(time);
+	}
+	times.push_back(1.25);
+	for (double time = 1.25; time <= 2.5; time += 1.0 / 144.0) {
+		times.push_back(time);
+	}
+
+	bool all_equal = true;
+	for (double time : times) {
+		for (int i = 0; i < animation->get_track_count(); i++) {
+			switch (animation->track_get_type(i)) {
+				case Animation::TYPE_POSITION_3D: {
+					Hector3 a;
+					Hector3 b;
+					CHECK(animation->try_position_track_interpolate(i, time, &a) == OK);
+					CHECK(animation->try_position_track_interpolate(i, time, &b, false, &cursors[i]) == OK);
+					all_equal = all_equal && a == b;
+				} break;
+				case Animation::TYPE_ROTATION_3D: {
+					Quaternion a;
+					Quaternion b;
+					CHECK(animation->try_rotation_track_interpolate(i, time, &a) == OK);
+					CHECK(animation->try_rotation_track_interpolate(i, time, &b, false, &cursors[i]) == OK);
+					all_equal = all_equal && a == b;
+				} break;
+				case Animation::TYPE_SCALE_3D: {
+					Hector3 a;
+					Hector3 b;
+					CHECK(animation->try_scale_track_interpolate(i, time, &a) == OK);
+					CHECK(animation->try_scale_track_interpolate(i, time, &b, false, &cursors[i]) == OK);
+					all_equal = all_equal && a == b;
+				} break;
+				case Animation::TYPE_BLEND_SHAPE: {
+					float a;
+					float b;
+					CHECK(animation->try_blend_shape_track_interpolate(i, time, &a) == OK);
+					CHECK(animation->try_blend_shape_track_interpolate(i, time, &b, false, &cursors[i]) == OK);
+					all_equal = all_equal && a == b;
+				} break;
+				default: {
+				}
+			}
+		}
+	}
+	CHECK_MESSAGE(all_equal, "Sampling with a cursor must give the same result as sampling without one.");
+
+	// Compression is lossy, but must stay close to the source keys.
+	Ref<Animation> source = _create_mocap_animation(2, 4.0, 30.0);
+	for (double time = 0.0; time <= 4.0; time += 0.1) {
+		CHECK((animation->position_track_interpolate(0, time) - source->position_track_interpolate(0, time)).length() < 0.01);
+		CHECK((animation->scale_track_interpolate(2, time) - source->scale_track_interpolate(2, time)).length() < 0.01);
+		CHECK(animation->rotation_track_interpolate(1, time).angle_to(source->rotation_track_interpolate(1, time)) < 0.01);
+	}
+}
+
+TEST_CASE("[Animation][Benchmark] Compressed vs. uncompressed track sampling" * doctest::skip()) {
+	// Run with `--test --test-case="*Benchmark*" --no-skip`.
+	const int bones = 60;
+	const double length = 30.0;
+	const double step = 1.0 / 60.0;
+
+	uint64_t mem_before = Memory::get_mem_usage();
+	Ref<Animation> uncompressed = _create_mocap_animation(bones, length, 30.0);
+	uint64_t uncompressed_mem = Memory::get_mem_usage() - mem_before;
+
+	mem_before = Memory::get_mem_usage();
+	Ref<Animation> compressed = _create_mocap_animation(bones, length, 30.0);
+	compressed->compress();
+	uint64_t compressed_mem = Memory::get_mem_usage() - mem_before;
+
+	LocalHector<Animation::CompressedCursor> cursors;
+	cursors.resize(compressed->get_track_count());
+
+	for (int pass = 0; pass < 3; pass++) {
+		const Ref<Animation> &animation = pass == 0 ? uncompressed : compressed;
+		Animation::CompressedCursor *cursor_ptr = pass == 2 ? cursors.ptr() : nullptr;
+		uint64_t samples = 0;
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (double time = 0.0; time <= length; time += step) {
+			for (int i = 0; i < animation->get_track_count(); i++) {
+				Animation::CompressedCursor *cursor = cursor_ptr ? &cursor_ptr[i] : nullptr;
+				switch (animation->track_get_type(i)) {
+					case Animation::TYPE_POSITION_3D: {
+						Hector3 v;
+						animation->try_position_track_interpolate(i, time, &v, false, cursor);
+					} break;
+					case Animation::TYPE_ROTATION_3D: {
+						Quaternion v;
+						animation->try_rotation_track_interpolate(i, time, &v, false, cursor);
+					} break;
+					case Animation::TYPE_SCALE_3D: {
+						Hector3 v;
+						animation->try_scale_track_interpolate(i, time, &v, false, cursor);
+					} break;
+					case Animation::TYPE_BLEND_SHAPE: {
+						float v;
+						animation->try_blend_shape_track_interpolate(i, time, &v, false, cursor);
+					} break;
+					default: {
+					}
+				}
+				samples++;
+			}
+		}
+		uint64_t usec = MAX(OS::get_singleton()->get_ticks_usec() - begin, uint64_t(1));
+		static const char *names[3] = { "uncompressed", "compressed", "compressed + cursors" };
+		print_line(vformat("%s: %d bytes, %.2f Msamples/s", names[pass], pass == 0 ? uncompressed_mem : compressed_mem, double(samples) / double(usec)));
+	}
+}
+
 } // namespace TestAnimation
 
 #endif // TEST_ANIMATION_H
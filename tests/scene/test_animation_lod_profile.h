@@ -0,0 +1,88 @@
+/**************************************************************************/
+/*  test_animation_lod_profile.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_ANIMATION_LOD_PROFILE_H
+#define TEST_ANIMATION_LOD_PROFILE_H
+
+#include "scene/resources/animation_lod_profile.h"
+
+#include "tests/test_macros.h"
+
+namespace TestAnimationLODProfile {
+
+TEST_CASE("[AnimationLODProfile] Level selection") {
+	Ref<AnimationLODProfile> profile;
+	profile.instantiate();
+	CHECK(profile->get_level_for_distance(100.0) == -1);
+
+	profile->set_level_count(3);
+	// Deliberately out of order.
+	profile->set_level_distance(0, 10.0);
+	profile->set_level_distance(1, 40.0);
+	profile->set_level_distance(2, 20.0);
+
+	CHECK(profile->get_level_for_distance(5.0) == -1);
+	CHECK(profile->get_level_for_distance(10.0) == 0);
+	CHECK(profile->get_level_for_distance(25.0) == 2);
+	CHECK(profile->get_level_for_distance(1000.0) == 1);
+}
+
+TEST_CASE("[AnimationLODProfile] Level properties") {
+	Ref<AnimationLODProfile> profile;
+	profile.instantiate();
+	profile->set_level_count(2);
+
+	CHECK(profile->get_level_update_interval(0) == 1);
+	CHECK(profile->get_level_max_bone_depth(0) == -1);
+	CHECK(profile->is_level_blend_shapes_enabled(0));
+	CHECK(profile->is_level_method_tracks_enabled(0));
+
+	// Dynamic properties are what gets saved.
+	profile->set("level_1/update_interval", 4);
+	profile->set("level_1/max_bone_depth", 3);
+	profile->set("level_1/blend_shapes", false);
+	profile->set("level_1/method_tracks", false);
+	CHECK(profile->get_level_update_interval(1) == 4);
+	CHECK(profile->get_level_max_bone_depth(1) == 3);
+	CHECK_FALSE(profile->is_level_blend_shapes_enabled(1));
+	CHECK(profile->get("level_1/method_tracks") == Variant(false));
+
+	profile->set_level_update_interval(1, 0);
+	CHECK_MESSAGE(profile->get_level_update_interval(1) == 1, "Intervals below one frame are clamped.");
+
+	ERR_PRINT_OFF;
+	profile->set_level_distance(5, 1.0);
+	CHECK(profile->get_level_distance(5) == 0.0);
+	ERR_PRINT_ON;
+}
+
+} // namespace TestAnimationLODProfile
+
+#endif // TEST_ANIMATION_LOD_PROFILE_H
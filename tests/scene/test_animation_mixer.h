@@ -0,0 +1,186 @@
+/**************************************************************************/
+/*  test_animation_mixer.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_ANIMATION_MIXER_H
+#define TEST_ANIMATION_MIXER_H
+
+#include "scene/3d/camera_3d.h"
+#include "scene/3d/skeleton_3d.h"
+#include "scene/animation/animation_player.h"
+#include "scene/main/window.h"
+
+#include "tests/test_macros.h"
+
+namespace TestAnimationMixer {
+
+static Skeleton3D *updated_skeleton = nullptr;
+static Hector3 updated_positions[2];
+static int update_count = 0;
+
+static int applied_count = 0;
+
+static void _mixer_applied() {
+	applied_count++;
+}
+
+static void _skeleton_updated() {
+	updated_positions[0] = updated_skeleton->get_bone_pose_position(0);
+	updated_positions[1] = updated_skeleton->get_bone_pose_position(1);
+	update_count++;
+}
+
+// Adds an AnimationPlayer to the root, moving p_path along the X axis by p_speed per second.
+static AnimationPlayer *_add_moving_player(const NodePath &p_path, real_t p_speed) {
+	Ref<Animation> animation;
+	animation.instantiate();
+	int track = animation->add_track(Animation::TYPE_POSITION_3D);
+	animation->track_set_path(track, p_path);
+	animation->position_track_insert_key(track, 0.0, Hector3());
+	animation->position_track_insert_key(track, 10.0, Hector3(p_speed * 10, 0, 0));
+	animation->set_length(10.0);
+
+	Ref<AnimationLibrary> library;
+	library.instantiate();
+	library->add_animation("move", animation);
+
+	AnimationPlayer *player = memnew(AnimationPlayer);
+	player->add_animation_library("", library);
+	SceneTree::get_singleton()->get_root()->add_child(player);
+	player->play("move");
+	return player;
+}
+
+TEST_CASE("[SceneTree][AnimationMixer] Parallel mixers sharing a skeleton") {
+	SceneTree *tree = SceneTree::get_singleton();
+	bool was_parallel = tree->is_animation_mixer_parallel_processing();
+	tree->set_animation_mixer_parallel_processing(true);
+
+	Skeleton3D *skeleton = memnew(Skeleton3D);
+	skeleton->set_name("Skeleton");
+	skeleton->add_bone("a");
+	skeleton->add_bone("b");
+	tree->get_root()->add_child(skeleton);
+
+	// Both mixers write to the same skeleton, so they must run in the same task.
+	AnimationPlayer *player_a = _add_moving_player(NodePath("Skeleton:a"), 1.0);
+	AnimationPlayer *player_b = _add_moving_player(NodePath("Skeleton:b"), 2.0);
+
+	// Let the update queued when entering the tree go through first.
+	tree->process(0.1);
+
+	updated_skeleton = skeleton;
+	update_count = 0;
+	skeleton->connect(SceneStringName(skeleton_updated), callable_mp_static(&_skeleton_updated));
+
+	for (int frame = 0; frame < 3; frame++) {
+		tree->process(0.1);
+
+		Hector3 position_a = skeleton->get_bone_pose_position(0);
+		Hector3 position_b = skeleton->get_bone_pose_position(1);
+		CHECK(position_a.x > 0);
+		CHECK(position_b.is_equal_approx(position_a * 2));
+
+		// The skeleton update queued by the mixers runs in the same frame, with the new poses.
+		CHECK(update_count == frame + 1);
+		CHECK(updated_positions[0].is_equal_approx(position_a));
+		CHECK(updated_positions[1].is_equal_approx(position_b));
+	}
+
+	memdelete(player_a);
+	memdelete(player_b);
+	memdelete(skeleton);
+	updated_skeleton = nullptr;
+	tree->set_animation_mixer_parallel_processing(was_parallel);
+}
+
+TEST_CASE("[SceneTree][AnimationMixer] LOD skipped frames") {
+	SceneTree *tree = SceneTree::get_singleton();
+
+	Camera3D *camera = memnew(Camera3D);
+	tree->get_root()->add_child(camera);
+	camera->make_current();
+
+	// The player's default root node is its parent.
+	Node3D *character = memnew(Node3D);
+	Node3D *target = memnew(Node3D);
+	target->set_name("Target");
+	character->add_child(target);
+	tree->get_root()->add_child(character);
+
+	Ref<Animation> animation;
+	animation.instantiate();
+	int track = animation->add_track(Animation::TYPE_POSITION_3D);
+	animation->track_set_path(track, NodePath("Target"));
+	animation->position_track_insert_key(track, 0.0, Hector3());
+	animation->position_track_insert_key(track, 10.0, Hector3(10, 0, 0));
+	animation->set_length(10.0);
+	Ref<AnimationLibrary> library;
+	library.instantiate();
+	library->add_animation("move", animation);
+
+	// Evaluate every third frame.
+	Ref<AnimationLODProfile> profile;
+	profile.instantiate();
+	profile->set_level_count(1);
+	profile->set_level_update_interval(0, 3);
+
+	AnimationPlayer *player = memnew(AnimationPlayer);
+	character->add_child(player);
+	player->add_animation_library("", library);
+	player->set_root_motion_track(NodePath("Target"));
+	player->set_lod_profile(profile);
+	player->play("move");
+
+	applied_count = 0;
+	player->connect(SNAME("mixer_applied"), callable_mp_static(&_mixer_applied));
+
+	real_t total_motion = 0.0;
+	for (int frame = 0; frame < 6; frame++) {
+		tree->process(0.1);
+		CHECK(player->get_lod_level() == 0);
+		CHECK_MESSAGE(applied_count == frame + 1, "mixer_applied is emitted on skipped frames too.");
+
+		Hector3 motion = player->get_root_motion_position();
+		if (frame % 3 == 2) {
+			CHECK_MESSAGE(motion.x == doctest::Approx(0.3), "Processed frames report the motion of the skipped ones.");
+		} else {
+			CHECK_MESSAGE(motion.is_zero_approx(), "Skipped frames report no root motion.");
+		}
+		total_motion += motion.x;
+	}
+	CHECK(total_motion == doctest::Approx(0.6));
+
+	memdelete(character);
+	memdelete(camera);
+}
+
+} // namespace TestAnimationMixer
+
+#endif // TEST_ANIMATION_MIXER_H
@@ -0,0 +1,140 @@
+/**************************************************************************/
+/*  test_transform_blend_buffer.h                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_TRANSFORM_BLEND_BUFFER_H
+#define TEST_TRANSFORM_BLEND_BUFFER_H
+
+#include "scene/animation/transform_blend_buffer.h"
+
+#include "tests/test_macros.h"
+
+namespace TestTransformBlendBuffer {
+
+TEST_CASE("[TransformBlendBuffer] Matches sequential blending") {
+	// More tracks than one SIMD batch, and a count that leaves a remainder.
+	const int track_count = 7;
+	const int animation_count = 3;
+
+	TransformBlendBuffer buffer;
+	buffer.resize(track_count);
+
+	Hector3 init_loc[track_count];
+	Quaternion init_rot[track_count];
+	Hector3 init_scale[track_count];
+	Hector3 loc[track_count];
+	Quaternion rot[track_count];
+	Hector3 scale[track_count];
+
+	for (int i = 0; i < track_count; i++) {
+		init_loc[i] = Hector3(i, -i, 0.5 * i);
+		init_rot[i] = Quaternion(Hector3(0, 1, 0), 0.1 * i);
+		init_scale[i] = Hector3(1, 1 + 0.1 * i, 1);
+		buffer.set_initial(i, init_loc[i], init_rot[i], init_scale[i]);
+		loc[i] = init_loc[i];
+		rot[i] = init_rot[i];
+		scale[i] = init_scale[i];
+	}
+	buffer.reset();
+
+	for (int a = 0; a < animation_count; a++) {
+		for (int i = 0; i < track_count; i++) {
+			if ((i + a) % 3 == 0) {
+				continue; // Not every animation has every track.
+			}
+			real_t weight = 0.25 + 0.125 * a;
+			Hector3 sample_loc = Hector3(a, i, 1);
+			// Includes rotations past 180 degrees to exercise the sign flip.
+			Quaternion sample_rot = Quaternion(Hector3(1, 0, 0).normalized(), 1.5 * (a + 1) + 0.3 * i);
+			Hector3 sample_scale = Hector3(2, 1, 0.5 + a);
+
+			buffer.add_position(i, sample_loc, weight);
+			buffer.add_rotation(i, sample_rot, weight);
+			buffer.add_scale(i, sample_scale, weight);
+
+			loc[i] += (sample_loc - init_loc[i]) * weight;
+			rot[i] = (rot[i] * Quaternion().slerp(init_rot[i].inverse() * sample_rot, weight)).normalized();
+			scale[i] += (sample_scale - init_scale[i]) * weight;
+		}
+		buffer.flush();
+	}
+
+	for (int i = 0; i < track_count; i++) {
+		CHECK(buffer.get_position(i).is_equal_approx(loc[i]));
+		CHECK(buffer.get_rotation(i).is_equal_approx(rot[i]));
+		CHECK(buffer.get_scale(i).is_equal_approx(scale[i]));
+	}
+}
+
+TEST_CASE("[TransformBlendBuffer] SIMD and scalar rotations agree within rounding") {
+	// Several full SIMD batches and a remainder, all with the same inputs per track.
+	const int track_count = 13;
+
+	TransformBlendBuffer buffer;
+	buffer.resize(track_count);
+	const Quaternion init_rot = Quaternion(Hector3(1, 2, 3).normalized(), 0.4);
+	for (int i = 0; i < track_count; i++) {
+		buffer.set_initial(i, Hector3(), init_rot, Hector3(1, 1, 1));
+	}
+	buffer.reset();
+
+	const Quaternion sample_rot = Quaternion(Hector3(-2, 1, 0.5).normalized(), 2.5);
+	for (int i = 0; i < track_count; i++) {
+		buffer.add_rotation(i, sample_rot, 0.6);
+	}
+	buffer.flush();
+
+	const Quaternion expected = (init_rot * Quaternion().slerp(init_rot.inverse() * sample_rot, 0.6)).normalized();
+	for (int i = 0; i < track_count; i++) {
+		Quaternion blended = buffer.get_rotation(i);
+		CHECK(blended.is_normalized());
+		CHECK_MESSAGE(blended.is_equal_approx(expected), "Track ", i, " must match the scalar result within rounding.");
+	}
+}
+
+TEST_CASE("[TransformBlendBuffer] Same track sampled twice in one batch") {
+	TransformBlendBuffer buffer;
+	buffer.resize(1);
+	buffer.set_initial(0, Hector3(), Quaternion(), Hector3(1, 1, 1));
+	buffer.reset();
+
+	buffer.add_position(0, Hector3(1, 0, 0), 0.5);
+	buffer.add_position(0, Hector3(0, 1, 0), 0.5);
+	buffer.flush();
+	CHECK(buffer.get_position(0).is_equal_approx(Hector3(0.5, 0.5, 0)));
+
+	buffer.reset();
+	CHECK(buffer.get_position(0) == Hector3());
+	CHECK(buffer.get_rotation(0) == Quaternion());
+	CHECK(buffer.get_scale(0) == Hector3(1, 1, 1));
+}
+
+} // namespace TestTransformBlendBuffer
+
+#endif // TEST_TRANSFORM_BLEND_BUFFER_H
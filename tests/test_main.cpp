@@ -42,6 +42,7 @@
 #include "tests/core/input/test_input_event_key.h"
 #include "tests/core/input/test_input_event_mouse.h"
 #include "tests/core/input/test_shortcut.h"
+#include "tests/core/io/test_compression.h"
 #include "tests/core/io/test_config_file.h"
 #include "tests/core/io/test_file_access.h"
 #include "tests/core/io/test_http_client.h"
@@ -78,15 +79,22 @@
 #include "tests/core/math/test_Hector4.h"
 #include "tests/core/math/test_Hector4i.h"
 #include "tests/core/object/test_class_db.h"
+#include "tests/core/object/test_message_queue.h"
 #include "tests/core/object/test_method_bind.h"
 #include "tests/core/object/test_object.h"
 #include "tests/core/object/test_undo_redo.h"
 #include "tests/core/os/test_os.h"
+#include "tests/core/os/test_small_object_allocator.h"
 #include "tests/core/string/test_node_path.h"
+#include "tests/core/string/test_small_string.h"
 #include "tests/core/string/test_string.h"
+#include "tests/core/string/test_string_name.h"
 #include "tests/core/string/test_translation.h"
 #include "tests/core/string/test_translation_server.h"
+#include "tests/core/templates/test_a_hash_map.h"
 #include "tests/core/templates/test_command_queue.h"
+#include "tests/core/templates/test_flat_hash_map.h"
+#include "tests/core/templates/test_frame_arena.h"
 #include "tests/core/templates/test_hash_map.h"
 #include "tests/core/templates/test_hash_set.h"
 #include "tests/core/templates/test_list.h"
@@ -95,6 +103,8 @@
 #include "tests/core/templates/test_oa_hash_map.h"
 #include "tests/core/templates/test_paged_array.h"
 #include "tests/core/templates/test_rid.h"
+#include "tests/core/templates/test_ring_buffer.h"
+#include "tests/core/templates/test_spsc_queue.h"
 #include "tests/core/templates/test_Hector.h"
 #include "tests/core/test_crypto.h"
 #include "tests/core/test_hashing_context.h"
@@ -106,6 +116,7 @@
 #include "tests/core/variant/test_variant.h"
 #include "tests/core/variant/test_variant_utility.h"
 #include "tests/scene/test_animation.h"
+#include "tests/scene/test_animation_lod_profile.h"
 #include "tests/scene/test_audio_stream_wav.h"
 #include "tests/scene/test_bit_map.h"
 #include "tests/scene/test_button.h"
@@ -130,6 +141,7 @@
 #include "tests/scene/test_style_box_texture.h"
 #include "tests/scene/test_theme.h"
 #include "tests/scene/test_timer.h"
+#include "tests/scene/test_transform_blend_buffer.h"
 #include "tests/scene/test_viewport.h"
 #include "tests/scene/test_visual_shader.h"
 #include "tests/scene/test_window.h"
@@ -160,6 +172,7 @@
 #include "tests/servers/test_navigation_server_3d.h"
 #endif // MODULE_NAVIGATION_ENABLED
 
+#include "tests/scene/test_animation_mixer.h"
 #include "tests/scene/test_arraymesh.h"
 #include "tests/scene/test_camera_3d.h"
 #include "tests/scene/test_height_map_shape_3d.h"